@@ -75,6 +75,31 @@ Ref<Resource> ResourceLoader::load_threaded_get(const String &p_path) {
 	return res;
 }
 
+Error ResourceLoader::load_threaded_set_priority(const String &p_path, int p_priority) {
+	return ::ResourceLoader::load_threaded_set_priority(p_path, p_priority);
+}
+
+int ResourceLoader::load_threaded_get_priority(const String &p_path) {
+	return ::ResourceLoader::load_threaded_get_priority(p_path);
+}
+
+Error ResourceLoader::load_threaded_cancel(const String &p_path) {
+	return ::ResourceLoader::load_threaded_cancel(p_path);
+}
+
+void ResourceLoader::set_threaded_load_budget(int p_max_tasks, int64_t p_max_bytes) {
+	ERR_FAIL_COND_MSG(p_max_tasks < 0 || p_max_bytes < 0, "The threaded load budget can't be negative.");
+	::ResourceLoader::set_threaded_load_budget(p_max_tasks, p_max_bytes);
+}
+
+int ResourceLoader::get_threaded_load_max_tasks() {
+	return ::ResourceLoader::get_threaded_load_max_tasks();
+}
+
+int64_t ResourceLoader::get_threaded_load_max_bytes() {
+	return ::ResourceLoader::get_threaded_load_max_bytes();
+}
+
 Ref<Resource> ResourceLoader::load(const String &p_path, const String &p_type_hint, CacheMode p_cache_mode) {
 	Error err = OK;
 	Ref<Resource> ret = ::ResourceLoader::load(p_path, p_type_hint, ResourceFormatLoader::CacheMode(p_cache_mode), &err);
@@ -146,6 +171,12 @@ void ResourceLoader::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("load_threaded_request", "path", "type_hint", "use_sub_threads", "cache_mode"), &ResourceLoader::load_threaded_request, DEFVAL(""), DEFVAL(false), DEFVAL(CACHE_MODE_REUSE));
 	ClassDB::bind_method(D_METHOD("load_threaded_get_status", "path", "progress"), &ResourceLoader::load_threaded_get_status, DEFVAL_ARRAY);
 	ClassDB::bind_method(D_METHOD("load_threaded_get", "path"), &ResourceLoader::load_threaded_get);
+	ClassDB::bind_method(D_METHOD("load_threaded_set_priority", "path", "priority"), &ResourceLoader::load_threaded_set_priority);
+	ClassDB::bind_method(D_METHOD("load_threaded_get_priority", "path"), &ResourceLoader::load_threaded_get_priority);
+	ClassDB::bind_method(D_METHOD("load_threaded_cancel", "path"), &ResourceLoader::load_threaded_cancel);
+	ClassDB::bind_method(D_METHOD("set_threaded_load_budget", "max_tasks", "max_bytes"), &ResourceLoader::set_threaded_load_budget, DEFVAL(0));
+	ClassDB::bind_method(D_METHOD("get_threaded_load_max_tasks"), &ResourceLoader::get_threaded_load_max_tasks);
+	ClassDB::bind_method(D_METHOD("get_threaded_load_max_bytes"), &ResourceLoader::get_threaded_load_max_bytes);
 
 	ClassDB::bind_method(D_METHOD("load", "path", "type_hint", "cache_mode"), &ResourceLoader::load, DEFVAL(""), DEFVAL(CACHE_MODE_REUSE));
 	ClassDB::bind_method(D_METHOD("get_recognized_extensions_for_type", "type"), &ResourceLoader::get_recognized_extensions_for_type);
@@ -73,6 +73,13 @@ public:
 	Error load_threaded_request(const String &p_path, const String &p_type_hint = "", bool p_use_sub_threads = false, CacheMode p_cache_mode = CACHE_MODE_REUSE);
 	ThreadLoadStatus load_threaded_get_status(const String &p_path, Array r_progress = ClassDB::default_array_arg);
 	Ref<Resource> load_threaded_get(const String &p_path);
+	Error load_threaded_set_priority(const String &p_path, int p_priority);
+	int load_threaded_get_priority(const String &p_path);
+	Error load_threaded_cancel(const String &p_path);
+
+	void set_threaded_load_budget(int p_max_tasks, int64_t p_max_bytes);
+	int get_threaded_load_max_tasks();
+	int64_t get_threaded_load_max_bytes();
 
 	Ref<Resource> load(const String &p_path, const String &p_type_hint = "", CacheMode p_cache_mode = CACHE_MODE_REUSE);
 	Vector<String> get_recognized_extensions_for_type(const String &p_type);
@@ -567,6 +567,22 @@ Vector<uint8_t> FileAccess::get_buffer(int64_t p_length) const {
 	return data;
 }
 
+Span<uint8_t> FileAccess::get_buffer_span(uint64_t p_length) {
+	const uint8_t *contents = get_mapped_contents();
+	if (!contents) {
+		return Span<uint8_t>();
+	}
+
+	uint64_t position = get_position();
+	uint64_t length = get_mapped_length();
+	if (position > length || p_length > length - position) {
+		return Span<uint8_t>();
+	}
+
+	seek(position + p_length);
+	return Span<uint8_t>(contents + position, p_length);
+}
+
 String FileAccess::get_as_utf8_string() const {
 	Vector<uint8_t> sourcef;
 	uint64_t len = get_length();
@@ -35,6 +35,7 @@
 #include "core/object/ref_counted.h"
 #include "core/os/memory.h"
 #include "core/string/ustring.h"
+#include "core/templates/span.h"
 #include "core/typedefs.h"
 #include "core/variant/type_info.h"
 
@@ -190,6 +191,15 @@ public:
 
 	virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const = 0; ///< get an array of bytes, needs to be overwritten by children.
 	Vector<uint8_t> get_buffer(int64_t p_length) const;
+
+	// Read-only view of the file when it is backed by a memory mapping, valid until the file is closed.
+	virtual const uint8_t *get_mapped_contents() const { return nullptr; }
+	// Number of bytes of the mapping returned by get_mapped_contents(), the file may have grown since it was mapped.
+	virtual uint64_t get_mapped_length() const { return 0; }
+	// Returns the next p_length bytes without copying and advances the position. Returns an empty span if the
+	// file isn't memory mapped or the mapping has fewer bytes left, in which case the caller should use get_buffer() instead.
+	Span<uint8_t> get_buffer_span(uint64_t p_length);
+
 	virtual String get_line() const;
 	virtual String get_token() const;
 	virtual Vector<String> get_csv_line(const String &p_delim = ",") const;
@@ -30,6 +30,7 @@
 
 #include "file_access_compressed.h"
 
+#include "core/io/marshalls.h"
 #include "core/math/math_funcs_binary.h"
 
 void FileAccessCompressed::configure(const String &p_magic, Compression::Mode p_mode, uint32_t p_block_size) {
@@ -40,6 +41,48 @@ void FileAccessCompressed::configure(const String &p_magic, Compression::Mode p_
 	block_size = p_block_size;
 }
 
+Vector<uint8_t> FileAccessCompressed::compress_buffer(const uint8_t *p_data, uint64_t p_size, const String &p_magic, Compression::Mode p_mode, uint32_t p_block_size) {
+	ERR_FAIL_COND_V(p_block_size == 0, Vector<uint8_t>());
+	ERR_FAIL_COND_V_MSG(p_size > UINT32_MAX, Vector<uint8_t>(), "Compressed files are limited to 4 GiB.");
+
+	CharString mgc = (p_magic + "    ").substr(0, 4).ascii();
+	const uint32_t bc = (p_size / p_block_size) + 1;
+	const uint32_t last_block_size = p_size % p_block_size;
+	const uint64_t header_size = 16 + bc * 4;
+
+	// Temporary buffer for compressed data blocks.
+	LocalVector<uint8_t> temp_cblock;
+	temp_cblock.resize(Compression::get_max_compressed_buffer_size(bc == 1 ? last_block_size : p_block_size, p_mode));
+	uint8_t *temp_cblock_ptr = temp_cblock.ptr();
+
+	Vector<uint8_t> out;
+	out.resize(header_size);
+	uint8_t *w = out.ptrw();
+	memcpy(w, mgc.get_data(), 4); //write header 4
+	encode_uint32(p_mode, &w[4]); //write compression mode 4
+	encode_uint32(p_block_size, &w[8]); //write block size 4
+	encode_uint32(uint32_t(p_size), &w[12]); //max amount of data written 4
+
+	// Compress and store the blocks.
+	for (uint32_t i = 0; i < bc; i++) {
+		uint32_t bl = i == (bc - 1) ? last_block_size : p_block_size;
+		const uint8_t *bp = &p_data[(uint64_t)i * p_block_size];
+
+		const int64_t compressed_size = Compression::compress(temp_cblock_ptr, bp, bl, p_mode);
+		ERR_FAIL_COND_V_MSG(compressed_size < 0, Vector<uint8_t>(), "FileAccessCompressed: Error compressing data.");
+
+		const int64_t ofs = out.size();
+		out.resize(ofs + compressed_size);
+		memcpy(out.ptrw() + ofs, temp_cblock_ptr, compressed_size);
+		encode_uint32(compressed_size, out.ptrw() + 16 + i * 4); // block sizes
+	}
+
+	const int64_t ofs = out.size();
+	out.resize(ofs + 4);
+	memcpy(out.ptrw() + ofs, mgc.get_data(), 4); //magic at the end too
+	return out;
+}
+
 Error FileAccessCompressed::open_after_magic(Ref<FileAccess> p_base) {
 	f = p_base;
 	cmode = (Compression::Mode)f->get_32();
@@ -51,30 +94,99 @@ Error FileAccessCompressed::open_after_magic(Ref<FileAccess> p_base) {
 	read_total = f->get_32();
 	uint32_t bc = (read_total / block_size) + 1;
 	uint64_t acc_ofs = f->get_position() + bc * 4;
-	uint32_t max_bs = 0;
 	for (uint32_t i = 0; i < bc; i++) {
 		ReadBlock rb;
 		rb.offset = acc_ofs;
 		rb.csize = f->get_32();
 		acc_ofs += rb.csize;
-		max_bs = MAX(max_bs, rb.csize);
 		read_blocks.push_back(rb);
 	}
 
-	comp_buffer.resize(max_bs);
 	buffer.resize(block_size);
 	read_ptr = buffer.ptrw();
-	f->get_buffer(comp_buffer.ptrw(), read_blocks[0].csize);
 	at_end = false;
 	read_eof = false;
 	read_block_count = bc;
-	read_block_size = read_blocks.size() == 1 ? read_total : block_size;
-
-	const int64_t ret = Compression::decompress(buffer.ptrw(), read_block_size, comp_buffer.ptr(), read_blocks[0].csize, cmode);
 	read_block = 0;
 	read_pos = 0;
 
-	return ret == -1 ? ERR_FILE_CORRUPT : OK;
+	return _load_block(0) ? OK : ERR_FILE_CORRUPT;
+}
+
+bool FileAccessCompressed::_read_compressed_blocks(BlockBatch &r_batch, uint32_t p_first_block, uint32_t p_block_count) const {
+	// Blocks are stored back to back, so a run of them is read with a single call.
+	const ReadBlock &last = read_blocks[p_first_block + p_block_count - 1];
+	r_batch.first_block = p_first_block;
+	r_batch.block_count = p_block_count;
+	r_batch.comp_offset = read_blocks[p_first_block].offset;
+	r_batch.comp_data.resize(last.offset + last.csize - r_batch.comp_offset);
+	r_batch.results.resize(p_block_count);
+
+	if (f->get_position() != r_batch.comp_offset) {
+		f->seek(r_batch.comp_offset);
+	}
+	return f->get_buffer(r_batch.comp_data.ptr(), r_batch.comp_data.size()) == r_batch.comp_data.size();
+}
+
+void FileAccessCompressed::_decompress_block(uint32_t p_index, BlockBatch *p_batch) const {
+	const ReadBlock &rb = read_blocks[p_batch->first_block + p_index];
+	uint8_t *dst = p_batch->dst + (uint64_t)p_index * block_size;
+	p_batch->results[p_index] = Compression::decompress(dst, read_blocks.size() == 1 ? read_total : block_size, p_batch->comp_data.ptr() + (rb.offset - p_batch->comp_offset), rb.csize, cmode);
+}
+
+bool FileAccessCompressed::_decompress_blocks(BlockBatch &r_batch) const {
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &FileAccessCompressed::_decompress_block, &r_batch, r_batch.block_count, -1, true, SNAME("FileAccessCompressedRead"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+	for (int64_t result : r_batch.results) {
+		if (result == -1) {
+			return false;
+		}
+	}
+	return true;
+}
+
+void FileAccessCompressed::_wait_read_ahead() const {
+	if (read_ahead_task != WorkerThreadPool::INVALID_TASK_ID) {
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(read_ahead_task);
+		read_ahead_task = WorkerThreadPool::INVALID_TASK_ID;
+	}
+}
+
+bool FileAccessCompressed::_load_block(uint32_t p_block) const {
+	read_block_size = p_block == read_block_count - 1 ? read_total % block_size : block_size;
+
+	if (p_block >= read_ahead.first_block && p_block < read_ahead.first_block + read_ahead.block_count) {
+		_wait_read_ahead();
+		const uint32_t index = p_block - read_ahead.first_block;
+		ERR_FAIL_COND_V_MSG(read_ahead.results[index] == -1, false, "Compressed file is corrupt.");
+		memcpy(buffer.ptrw(), read_ahead.dst + (uint64_t)index * block_size, read_block_size);
+		return true;
+	}
+
+	// Read the requested block along with the ones following it, decompress the requested one right away
+	// and leave the others to the WorkerThreadPool until they are needed.
+	_wait_read_ahead();
+	const uint32_t block_count = WorkerThreadPool::get_singleton() ? MIN(READ_AHEAD_BLOCKS, read_block_count - p_block) : 1;
+	if (!_read_compressed_blocks(read_ahead, p_block, block_count)) {
+		read_ahead.block_count = 0;
+		ERR_FAIL_V_MSG(false, "Compressed file is corrupt.");
+	}
+
+	const ReadBlock &rb = read_blocks[p_block];
+	const int64_t ret = Compression::decompress(buffer.ptrw(), read_blocks.size() == 1 ? read_total : block_size, read_ahead.comp_data.ptr(), rb.csize, cmode);
+
+	read_ahead.first_block = p_block + 1;
+	read_ahead.block_count = block_count - 1;
+	if (read_ahead.block_count > 0) {
+		read_ahead_buffer.resize(read_ahead.block_count * block_size);
+		read_ahead.dst = read_ahead_buffer.ptr();
+		read_ahead.results.resize(read_ahead.block_count);
+		read_ahead_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &FileAccessCompressed::_decompress_block, &read_ahead, read_ahead.block_count, -1, true, SNAME("FileAccessCompressedReadAhead"));
+	}
+
+	ERR_FAIL_COND_V_MSG(ret == -1, false, "Compressed file is corrupt.");
+	return true;
 }
 
 Error FileAccessCompressed::open_internal(const String &p_path, int p_mode_flags) {
@@ -120,46 +232,13 @@ void FileAccessCompressed::_close() {
 
 	if (writing) {
 		//save block table and all compressed blocks
-
-		CharString mgc = magic.utf8();
-		f->store_buffer((const uint8_t *)mgc.get_data(), mgc.length()); //write header 4
-		f->store_32(cmode); //write compression mode 4
-		f->store_32(block_size); //write block size 4
-		f->store_32(uint32_t(write_max)); //max amount of data written 4
-		uint32_t bc = (write_max / block_size) + 1;
-
-		for (uint32_t i = 0; i < bc; i++) {
-			f->store_32(0); //compressed sizes, will update later
-		}
-
-		uint32_t last_block_size = write_max % block_size;
-
-		// Temporary buffer for compressed data blocks.
-		LocalVector<uint8_t> temp_cblock;
-		temp_cblock.resize(Compression::get_max_compressed_buffer_size(bc == 1 ? last_block_size : block_size, cmode));
-		uint8_t *temp_cblock_ptr = temp_cblock.ptr();
-
-		// Compress and store the blocks.
-		LocalVector<uint32_t> block_sizes;
-		for (uint32_t i = 0; i < bc; i++) {
-			uint32_t bl = i == (bc - 1) ? last_block_size : block_size;
-			uint8_t *bp = &write_ptr[i * block_size];
-
-			const int64_t compressed_size = Compression::compress(temp_cblock_ptr, bp, bl, cmode);
-			ERR_FAIL_COND_MSG(compressed_size < 0, "FileAccessCompressed: Error compressing data.");
-
-			f->store_buffer(temp_cblock_ptr, (uint64_t)compressed_size);
-			block_sizes.push_back(compressed_size);
-		}
-
-		f->seek(16); //ok write block sizes
-		for (uint32_t i = 0; i < bc; i++) {
-			f->store_32(block_sizes[i]);
-		}
-		f->seek_end();
-		f->store_buffer((const uint8_t *)mgc.get_data(), mgc.length()); //magic at the end too
+		Vector<uint8_t> data = compress_buffer(write_ptr, write_max, magic, cmode, block_size);
+		ERR_FAIL_COND_MSG(data.is_empty(), "FileAccessCompressed: Error compressing data.");
+		f->store_buffer(data);
 	} else {
-		comp_buffer.clear();
+		_wait_read_ahead();
+		read_ahead = BlockBatch();
+		read_ahead_buffer.clear();
 		read_blocks.clear();
 	}
 	buffer.clear();
@@ -204,11 +283,7 @@ void FileAccessCompressed::seek(uint64_t p_position) {
 			uint32_t block_idx = p_position / block_size;
 			if (block_idx != read_block) {
 				read_block = block_idx;
-				f->seek(read_blocks[read_block].offset);
-				f->get_buffer(comp_buffer.ptrw(), read_blocks[read_block].csize);
-				const int64_t ret = Compression::decompress(buffer.ptrw(), read_blocks.size() == 1 ? read_total : block_size, comp_buffer.ptr(), read_blocks[read_block].csize, cmode);
-				ERR_FAIL_COND_MSG(ret == -1, "Compressed file is corrupt.");
-				read_block_size = read_block == read_block_count - 1 ? read_total % block_size : block_size;
+				ERR_FAIL_COND(!_load_block(read_block));
 			}
 
 			read_pos = p_position % block_size;
@@ -279,6 +354,28 @@ uint64_t FileAccessCompressed::get_buffer(uint8_t *p_dst, uint64_t p_length) con
 			return p_length;
 		}
 
+		// Decompress the whole blocks covered by the rest of the request in parallel, straight into the destination.
+		// The last block is left out, as it may be shorter than the block size.
+		const uint32_t next_block = read_block + 1;
+		const uint64_t whole_blocks = next_block < read_block_count - 1 ? MIN((p_length - dst_idx) / block_size, uint64_t(read_block_count - 1 - next_block)) : 0;
+		if (whole_blocks >= PARALLEL_READ_MIN_BLOCKS && WorkerThreadPool::get_singleton()) {
+			BlockBatch batch;
+			ERR_FAIL_COND_V_MSG(!_read_compressed_blocks(batch, next_block, whole_blocks), -1, "Compressed file is corrupt.");
+			batch.dst = p_dst + dst_idx;
+			ERR_FAIL_COND_V_MSG(!_decompress_blocks(batch), -1, "Compressed file is corrupt.");
+
+			dst_idx += whole_blocks * block_size;
+			read_block = next_block + whole_blocks - 1;
+			read_block_size = block_size;
+			read_pos = block_size;
+			// Keep the current block buffered, in case of a seek back into it.
+			memcpy(buffer.ptrw(), p_dst + dst_idx - block_size, block_size);
+
+			if (dst_idx == p_length) {
+				return p_length;
+			}
+		}
+
 		// We're not done yet; try reading the next block.
 		read_block++;
 
@@ -293,10 +390,9 @@ uint64_t FileAccessCompressed::get_buffer(uint8_t *p_dst, uint64_t p_length) con
 		}
 
 		// Read the next block of compressed data.
-		f->get_buffer(comp_buffer.ptrw(), read_blocks[read_block].csize);
-		const int64_t ret = Compression::decompress(buffer.ptrw(), read_blocks.size() == 1 ? read_total : block_size, comp_buffer.ptr(), read_blocks[read_block].csize, cmode);
-		ERR_FAIL_COND_V_MSG(ret == -1, -1, "Compressed file is corrupt.");
-		read_block_size = read_block == read_block_count - 1 ? read_total % block_size : block_size;
+		if (!_load_block(read_block)) {
+			return -1;
+		}
 		read_pos = 0;
 	}
 
@@ -32,6 +32,8 @@
 
 #include "core/io/compression.h"
 #include "core/io/file_access.h"
+#include "core/object/worker_thread_pool.h"
+#include "core/templates/local_vector.h"
 
 class FileAccessCompressed : public FileAccess {
 	GDSOFTCLASS(FileAccessCompressed, FileAccess);
@@ -50,7 +52,25 @@ class FileAccessCompressed : public FileAccess {
 		uint64_t offset;
 	};
 
-	mutable Vector<uint8_t> comp_buffer;
+	// A run of consecutive blocks, read from the file in one go and decompressed on the WorkerThreadPool.
+	struct BlockBatch {
+		uint32_t first_block = 0;
+		uint32_t block_count = 0;
+		uint64_t comp_offset = 0;
+		LocalVector<uint8_t> comp_data;
+		LocalVector<int64_t> results;
+		uint8_t *dst = nullptr;
+	};
+
+	// Blocks are decompressed ahead of the reader, so sequential reads don't wait on decompression.
+	static constexpr uint32_t READ_AHEAD_BLOCKS = 16;
+	// Reads covering at least this many whole blocks decompress them in parallel straight into the destination.
+	static constexpr uint32_t PARALLEL_READ_MIN_BLOCKS = 4;
+
+	mutable BlockBatch read_ahead;
+	mutable LocalVector<uint8_t> read_ahead_buffer;
+	mutable WorkerThreadPool::GroupID read_ahead_task = WorkerThreadPool::INVALID_TASK_ID;
+
 	uint8_t *read_ptr = nullptr;
 	mutable uint32_t read_block = 0;
 	uint32_t read_block_count = 0;
@@ -65,11 +85,20 @@ class FileAccessCompressed : public FileAccess {
 
 	void _close();
 
+	bool _read_compressed_blocks(BlockBatch &r_batch, uint32_t p_first_block, uint32_t p_block_count) const;
+	void _decompress_block(uint32_t p_index, BlockBatch *p_batch) const;
+	bool _decompress_blocks(BlockBatch &r_batch) const;
+	void _wait_read_ahead() const;
+	bool _load_block(uint32_t p_block) const;
+
 public:
 	void configure(const String &p_magic, Compression::Mode p_mode = Compression::MODE_ZSTD, uint32_t p_block_size = 4096);
 
 	Error open_after_magic(Ref<FileAccess> p_base);
 
+	// Returns p_data laid out as a whole compressed file, magic included, or an empty buffer on failure.
+	static Vector<uint8_t> compress_buffer(const uint8_t *p_data, uint64_t p_size, const String &p_magic = "GCMP", Compression::Mode p_mode = Compression::MODE_ZSTD, uint32_t p_block_size = 4096);
+
 	virtual Error open_internal(const String &p_path, int p_mode_flags) override; ///< open a file
 	virtual bool is_open() const override; ///< true when file is open
 
@@ -30,6 +30,7 @@
 
 #include "file_access_pack.h"
 
+#include "core/io/file_access_compressed.h"
 #include "core/io/file_access_encrypted.h"
 #include "core/io/file_access_patched.h"
 #include "core/object/script_language.h"
@@ -46,7 +47,7 @@ Error PackedData::add_pack(const String &p_path, bool p_replace_files, uint64_t
 	return ERR_FILE_UNRECOGNIZED;
 }
 
-void PackedData::add_path(const String &p_pkg_path, const String &p_path, uint64_t p_ofs, uint64_t p_size, const uint8_t *p_md5, PackSource *p_src, bool p_replace_files, bool p_encrypted, bool p_bundle, bool p_delta, const String &p_salt) {
+void PackedData::add_path(const String &p_pkg_path, const String &p_path, uint64_t p_ofs, uint64_t p_size, const uint8_t *p_md5, PackSource *p_src, bool p_replace_files, bool p_encrypted, bool p_bundle, bool p_delta, const String &p_salt, bool p_compressed, uint64_t p_stored_size) {
 	String simplified_path = p_path.simplify_path().trim_prefix("res://");
 	PathMD5 pmd5(simplified_path.md5_buffer());
 
@@ -60,6 +61,8 @@ void PackedData::add_path(const String &p_pkg_path, const String &p_path, uint64
 	pf.salt = p_salt;
 	pf.offset = p_ofs;
 	pf.size = p_size;
+	pf.compressed = p_compressed;
+	pf.stored_size = p_compressed ? p_stored_size : p_size;
 	for (int i = 0; i < 16; i++) {
 		pf.md5[i] = p_md5[i];
 	}
@@ -186,6 +189,31 @@ void PackedData::clear() {
 	delta_patches.clear();
 	_free_packed_dirs(root);
 	root = memnew(PackedDir);
+
+	MutexLock lock(mapped_packs_mutex);
+	mapped_packs.clear(); // Files still open keep their own reference to the mapping.
+}
+
+PackedData::MappedPack PackedData::_get_mapped_pack(const String &p_pack_path) {
+	MutexLock lock(mapped_packs_mutex);
+
+	HashMap<String, MappedPack>::Iterator E = mapped_packs.find(p_pack_path);
+	if (E) {
+		return E->value;
+	}
+
+	// Packs which can't be mapped are remembered too, so they are not reopened for every file.
+	MappedPack mapped_pack;
+	Ref<FileAccess> file = FileAccess::open(p_pack_path, FileAccess::READ);
+	if (file.is_valid()) {
+		mapped_pack.contents = file->get_mapped_contents();
+		if (mapped_pack.contents) {
+			mapped_pack.file = file;
+			mapped_pack.length = file->get_mapped_length();
+		}
+	}
+	mapped_packs.insert(p_pack_path, mapped_pack);
+	return mapped_pack;
 }
 
 PackedData::PackedData() {
@@ -292,7 +320,7 @@ bool PackedSourcePCK::try_open_pack(const String &p_path, bool p_replace_files,
 	uint32_t ver_minor = f->get_32();
 	uint32_t ver_patch = f->get_32(); // Not used for validation.
 
-	ERR_FAIL_COND_V_MSG(version != PACK_FORMAT_VERSION_V4 && version != PACK_FORMAT_VERSION_V3 && version != PACK_FORMAT_VERSION_V2, false, vformat("Pack version unsupported: %d.", version));
+	ERR_FAIL_COND_V_MSG(version != PACK_FORMAT_VERSION_V5 && version != PACK_FORMAT_VERSION_V4 && version != PACK_FORMAT_VERSION_V3 && version != PACK_FORMAT_VERSION_V2, false, vformat("Pack version unsupported: %d.", version));
 	ERR_FAIL_COND_V_MSG(ver_major > GODOT_VERSION_MAJOR || (ver_major == GODOT_VERSION_MAJOR && ver_minor > GODOT_VERSION_MINOR), false, vformat("Pack created with a newer version of the engine: %d.%d.%d.", ver_major, ver_minor, ver_patch));
 
 	uint32_t pack_flags = f->get_32();
@@ -302,15 +330,15 @@ bool PackedSourcePCK::try_open_pack(const String &p_path, bool p_replace_files,
 	String salt;
 
 	uint64_t file_base = f->get_64();
-	if ((version == PACK_FORMAT_VERSION_V4) || (version == PACK_FORMAT_VERSION_V3) || (version == PACK_FORMAT_VERSION_V2 && rel_filebase)) {
+	if ((version >= PACK_FORMAT_VERSION_V3) || (version == PACK_FORMAT_VERSION_V2 && rel_filebase)) {
 		file_base += pck_start_pos;
 	}
 
-	if (version == PACK_FORMAT_VERSION_V3 || version == PACK_FORMAT_VERSION_V4) {
-		// V3/V4: Read directory offset and skip reserved part of the header.
+	if (version >= PACK_FORMAT_VERSION_V3) {
+		// V3/V4/V5: Read directory offset and skip reserved part of the header.
 		uint64_t dir_offset = f->get_64() + pck_start_pos;
-		if (sparse_bundle && enc_directory && version == PACK_FORMAT_VERSION_V4) {
-			// V4: Read encrypted directory salt.
+		if (sparse_bundle && enc_directory && version >= PACK_FORMAT_VERSION_V4) {
+			// V4/V5: Read encrypted directory salt.
 			Vector<uint8_t> salt_data = f->get_buffer(32);
 			salt.append_latin1(Span((const char *)salt_data.ptr(), salt_data.size()));
 		}
@@ -362,11 +390,15 @@ bool PackedSourcePCK::try_open_pack(const String &p_path, bool p_replace_files,
 		uint8_t md5[16];
 		f->get_buffer(md5, 16);
 		uint32_t flags = f->get_32();
+		uint64_t stored_size = size;
+		if (version >= PACK_FORMAT_VERSION_V5) {
+			stored_size = f->get_64();
+		}
 
 		if (flags & PACK_FILE_REMOVAL) { // The file was removed.
 			PackedData::get_singleton()->remove_path(path);
 		} else {
-			PackedData::get_singleton()->add_path(p_path, path, file_base + ofs, size, md5, this, p_replace_files, (flags & PACK_FILE_ENCRYPTED), sparse_bundle, (flags & PACK_FILE_DELTA), salt);
+			PackedData::get_singleton()->add_path(p_path, path, file_base + ofs, size, md5, this, p_replace_files, (flags & PACK_FILE_ENCRYPTED), sparse_bundle, (flags & PACK_FILE_DELTA), salt, (flags & PACK_FILE_COMPRESSED), stored_size);
 		}
 	}
 
@@ -374,7 +406,25 @@ bool PackedSourcePCK::try_open_pack(const String &p_path, bool p_replace_files,
 }
 
 Ref<FileAccess> PackedSourcePCK::get_file(const String &p_path, PackedData::PackedFile *p_file, const Vector<uint8_t> &p_decryption_key) {
-	Ref<FileAccess> file(memnew(FileAccessPack(p_path, *p_file, p_decryption_key)));
+	Ref<FileAccess> file;
+	if (p_file->compressed) {
+		// Read the compressed stream as it is stored in the pack, and decompress it on top.
+		PackedData::PackedFile stored_file = *p_file;
+		stored_file.size = p_file->stored_size;
+		Ref<FileAccess> stored(memnew(FileAccessPack(p_path, stored_file, p_decryption_key)));
+
+		char magic[5] = {};
+		stored->get_buffer((uint8_t *)magic, 4);
+		ERR_FAIL_COND_V_MSG(String(magic) != PACK_FILE_COMPRESSED_MAGIC, Ref<FileAccess>(), vformat(R"(Compressed pack-referenced file "%s" from pack "%s" is corrupt.)", p_path, p_file->pack));
+
+		Ref<FileAccessCompressed> fac;
+		fac.instantiate();
+		Error err = fac->open_after_magic(stored);
+		ERR_FAIL_COND_V_MSG(err != OK, Ref<FileAccess>(), vformat(R"(Can't open compressed pack-referenced file "%s" from pack "%s" due to error "%s".)", p_path, p_file->pack, error_names[err]));
+		file = fac;
+	} else {
+		file = Ref<FileAccess>(memnew(FileAccessPack(p_path, *p_file, p_decryption_key)));
+	}
 
 	if (PackedData::get_singleton()->has_delta_patches(p_path)) {
 		Ref<FileAccessPatched> file_patched;
@@ -449,7 +499,9 @@ void FileAccessPack::seek(uint64_t p_position) {
 		eof = false;
 	}
 
-	f->seek(off + p_position);
+	if (!mapped) {
+		f->seek(off + p_position);
+	}
 	pos = p_position;
 }
 
@@ -483,12 +535,16 @@ uint64_t FileAccessPack::get_buffer(uint8_t *p_dst, uint64_t p_length) const {
 		to_read = (int64_t)pf.size - (int64_t)pos;
 	}
 
-	pos += to_read;
-
 	if (to_read <= 0) {
 		return 0;
 	}
-	f->get_buffer(p_dst, to_read);
+
+	if (mapped) {
+		memcpy(p_dst, mapped + pos, to_read);
+	} else {
+		f->get_buffer(p_dst, to_read);
+	}
+	pos += to_read;
 
 	return to_read;
 }
@@ -497,7 +553,9 @@ void FileAccessPack::set_big_endian(bool p_big_endian) {
 	ERR_FAIL_COND_MSG(f.is_null(), "File must be opened before use.");
 
 	FileAccess::set_big_endian(p_big_endian);
-	f->set_big_endian(p_big_endian);
+	if (!mapped) {
+		f->set_big_endian(p_big_endian);
+	}
 }
 
 Error FileAccessPack::get_error() const {
@@ -521,6 +579,7 @@ bool FileAccessPack::file_exists(const String &p_name) {
 
 void FileAccessPack::close() {
 	f = Ref<FileAccess>();
+	mapped = nullptr;
 }
 
 FileAccessPack::FileAccessPack(const String &p_path, const PackedData::PackedFile &p_file, const Vector<uint8_t> &p_decryption_key) {
@@ -545,10 +604,20 @@ FileAccessPack::FileAccessPack(const String &p_path, const PackedData::PackedFil
 		ERR_FAIL_COND_MSG(err != OK, vformat(R"(Can't open pack-referenced file "%s" from sparse pack "%s" due to error "%s".)", simplified_path, pf.pack, error_names[err]));
 		off = 0; // For the sparse pack offset is always zero.
 	} else {
-		Error err = OK;
-		f = FileAccess::open(pf.pack, FileAccess::READ, &err);
-		ERR_FAIL_COND_MSG(err != OK, vformat(R"(Can't open pack-referenced file "%s" from pack "%s" due to error "%s".)", p_path, pf.pack, error_names[err]));
-		f->seek(pf.offset);
+		if (!pf.encrypted && PackedData::get_singleton()->is_using_memory_mapping()) {
+			// Read straight from the mapped pack, shared with the other files from it.
+			PackedData::MappedPack mapped_pack = PackedData::get_singleton()->_get_mapped_pack(pf.pack);
+			if (mapped_pack.contents && pf.offset <= mapped_pack.length && pf.size <= mapped_pack.length - pf.offset) {
+				f = mapped_pack.file;
+				mapped = mapped_pack.contents + pf.offset;
+			}
+		}
+		if (!mapped) {
+			Error err = OK;
+			f = FileAccess::open(pf.pack, FileAccess::READ, &err);
+			ERR_FAIL_COND_MSG(err != OK, vformat(R"(Can't open pack-referenced file "%s" from pack "%s" due to error "%s".)", p_path, pf.pack, error_names[err]));
+			f->seek(pf.offset);
+		}
 		off = pf.offset;
 	}
 
@@ -33,7 +33,9 @@
 #include "core/io/dir_access.h"
 #include "core/io/file_access.h"
 #include "core/io/resource_uid.h"
+#include "core/os/mutex.h"
 #include "core/string/print_string.h"
+#include "core/templates/hash_map.h"
 #include "core/templates/hash_set.h"
 #include "core/templates/list.h"
 
@@ -43,6 +45,8 @@
 #define PACK_FORMAT_VERSION_V2 2
 #define PACK_FORMAT_VERSION_V3 3
 #define PACK_FORMAT_VERSION_V4 4
+// V5 stores the size each file takes in the pack next to its size, they differ for compressed files.
+#define PACK_FORMAT_VERSION_V5 5
 
 // The current packed file format version number.
 #define PACK_FORMAT_VERSION PACK_FORMAT_VERSION_V4
@@ -57,8 +61,12 @@ enum PackFileFlags {
 	PACK_FILE_ENCRYPTED = 1 << 0,
 	PACK_FILE_REMOVAL = 1 << 1,
 	PACK_FILE_DELTA = 1 << 2,
+	PACK_FILE_COMPRESSED = 1 << 3,
 };
 
+// Magic of the FileAccessCompressed stream holding the data of compressed files (V5).
+#define PACK_FILE_COMPRESSED_MAGIC "GPCK"
+
 class PackSource;
 
 class PackedData {
@@ -69,13 +77,15 @@ class PackedData {
 public:
 	struct PackedFile {
 		String pack;
-		uint64_t offset; //if offset is ZERO, the file was ERASED
+		uint64_t offset; //if offset is ZERO, the file was ERASED, several files with identical contents can share it
 		uint64_t size;
+		uint64_t stored_size; // Bytes taken in the pack, only differs from size for compressed files.
 		uint8_t md5[16];
 		PackSource *src = nullptr;
 		bool encrypted;
 		bool bundle;
 		bool delta;
+		bool compressed = false;
 		String salt;
 	};
 
@@ -114,11 +124,23 @@ private:
 
 	PackedDir *root = nullptr;
 
+	struct MappedPack {
+		Ref<FileAccess> file;
+		const uint8_t *contents = nullptr;
+		uint64_t length = 0;
+	};
+
+	// Pack files opened once and shared by all the FileAccessPack reading from their mapping.
+	HashMap<String, MappedPack> mapped_packs;
+	Mutex mapped_packs_mutex;
+
 	static inline PackedData *singleton = nullptr;
 	bool disabled = false;
+	bool use_memory_mapping = true;
 
 	void _free_packed_dirs(PackedDir *p_dir);
 	void _get_file_paths(PackedDir *p_dir, const String &p_parent_dir, HashSet<String> &r_paths) const;
+	MappedPack _get_mapped_pack(const String &p_pack_path);
 
 	_FORCE_INLINE_ PathMD5 _get_simplified_path(const String &p_path) {
 		String simplified_path = p_path;
@@ -131,7 +153,7 @@ private:
 
 public:
 	void add_pack_source(PackSource *p_source);
-	void add_path(const String &p_pkg_path, const String &p_path, uint64_t p_ofs, uint64_t p_size, const uint8_t *p_md5, PackSource *p_src, bool p_replace_files, bool p_encrypted = false, bool p_bundle = false, bool p_delta = false, const String &p_salt = String()); // for PackSource
+	void add_path(const String &p_pkg_path, const String &p_path, uint64_t p_ofs, uint64_t p_size, const uint8_t *p_md5, PackSource *p_src, bool p_replace_files, bool p_encrypted = false, bool p_bundle = false, bool p_delta = false, const String &p_salt = String(), bool p_compressed = false, uint64_t p_stored_size = 0); // for PackSource
 	void remove_path(const String &p_path);
 	uint8_t *get_file_hash(const String &p_path);
 	Vector<PackedFile> get_delta_patches(const String &p_path) const;
@@ -141,6 +163,9 @@ public:
 	void set_disabled(bool p_disabled) { disabled = p_disabled; }
 	_FORCE_INLINE_ bool is_disabled() const { return disabled; }
 
+	void set_use_memory_mapping(bool p_enabled) { use_memory_mapping = p_enabled; }
+	_FORCE_INLINE_ bool is_using_memory_mapping() const { return use_memory_mapping; }
+
 	static PackedData *get_singleton() { return singleton; }
 	Error add_pack(const String &p_path, bool p_replace_files, uint64_t p_offset, const Vector<uint8_t> &p_decryption_key = Vector<uint8_t>());
 
@@ -189,6 +214,7 @@ class FileAccessPack : public FileAccess {
 	uint64_t off;
 
 	Ref<FileAccess> f;
+	const uint8_t *mapped = nullptr; // Start of the file in the mapped pack, if any.
 	virtual Error open_internal(const String &p_path, int p_mode_flags) override;
 	virtual uint64_t _get_modified_time(const String &p_file) override { return 0; }
 	virtual uint64_t _get_access_time(const String &p_file) override { return 0; }
@@ -216,6 +242,9 @@ public:
 
 	virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const override;
 
+	virtual const uint8_t *get_mapped_contents() const override { return mapped; }
+	virtual uint64_t get_mapped_length() const override { return mapped ? pf.size : 0; }
+
 	virtual void set_big_endian(bool p_big_endian) override;
 
 	virtual Error get_error() const override;
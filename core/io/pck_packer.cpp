@@ -32,11 +32,15 @@
 
 #include "core/crypto/crypto_core.h"
 #include "core/io/file_access.h"
+#include "core/io/file_access_compressed.h"
 #include "core/io/file_access_encrypted.h"
 #include "core/io/file_access_pack.h" // PACK_HEADER_MAGIC, PACK_FORMAT_VERSION
 #include "core/object/class_db.h"
 #include "core/version.h"
 
+// Larger than the default block size for a better ratio, still small enough for seeking.
+static constexpr uint32_t PCK_COMPRESSION_BLOCK_SIZE = 16384;
+
 static int _get_pad(int p_alignment, int p_n) {
 	int rest = p_n % p_alignment;
 	int pad = 0;
@@ -48,6 +52,10 @@ static int _get_pad(int p_alignment, int p_n) {
 }
 
 void PCKPacker::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("set_deduplication_enabled", "enabled"), &PCKPacker::set_deduplication_enabled);
+	ClassDB::bind_method(D_METHOD("is_deduplication_enabled"), &PCKPacker::is_deduplication_enabled);
+	ClassDB::bind_method(D_METHOD("set_compression_enabled", "enabled"), &PCKPacker::set_compression_enabled);
+	ClassDB::bind_method(D_METHOD("is_compression_enabled"), &PCKPacker::is_compression_enabled);
 	ClassDB::bind_method(D_METHOD("pck_start", "pck_path", "alignment", "key", "encrypt_directory"), &PCKPacker::pck_start, DEFVAL(32), DEFVAL("0000000000000000000000000000000000000000000000000000000000000000"), DEFVAL(false));
 	ClassDB::bind_method(D_METHOD("add_file", "target_path", "source_path", "encrypt"), &PCKPacker::add_file, DEFVAL(false));
 	ClassDB::bind_method(D_METHOD("add_file_from_buffer", "target_path", "data", "encrypt"), &PCKPacker::add_file_from_buffer, DEFVAL(false));
@@ -55,6 +63,23 @@ void PCKPacker::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("flush", "verbose"), &PCKPacker::flush, DEFVAL(false));
 }
 
+void PCKPacker::set_deduplication_enabled(bool p_enabled) {
+	deduplication = p_enabled;
+}
+
+bool PCKPacker::is_deduplication_enabled() const {
+	return deduplication;
+}
+
+void PCKPacker::set_compression_enabled(bool p_enabled) {
+	ERR_FAIL_COND_MSG(file.is_valid(), "Compression must be enabled or disabled before calling pck_start().");
+	compression = p_enabled;
+}
+
+bool PCKPacker::is_compression_enabled() const {
+	return compression;
+}
+
 Error PCKPacker::pck_start(const String &p_pck_path, int p_alignment, const String &p_key, bool p_encrypt_directory) {
 	ERR_FAIL_COND_V_MSG((p_key.is_empty() || !p_key.is_valid_hex_number(false) || p_key.length() != 64), ERR_CANT_CREATE, "Invalid Encryption Key (must be 64 characters long).");
 	ERR_FAIL_COND_V_MSG(p_alignment <= 0, ERR_CANT_CREATE, "Invalid alignment, must be greater then 0.");
@@ -91,8 +116,11 @@ Error PCKPacker::pck_start(const String &p_pck_path, int p_alignment, const Stri
 
 	alignment = p_alignment;
 
+	// Compressed files need the sizes they take in the pack, which were added in V5.
+	format_version = compression ? PACK_FORMAT_VERSION_V5 : PACK_FORMAT_VERSION;
+
 	file->store_32(PACK_HEADER_MAGIC);
-	file->store_32(PACK_FORMAT_VERSION);
+	file->store_32(format_version);
 	file->store_32(GODOT_VERSION_MAJOR);
 	file->store_32(GODOT_VERSION_MINOR);
 	file->store_32(GODOT_VERSION_PATCH);
@@ -125,6 +153,7 @@ Error PCKPacker::pck_start(const String &p_pck_path, int p_alignment, const Stri
 	file->seek(file_base);
 
 	files.clear();
+	content_files.clear();
 
 	return OK;
 }
@@ -184,6 +213,33 @@ Error PCKPacker::_add_file(const String &p_target_path, const String &p_source_p
 	}
 	pf.encrypted = p_encrypt;
 
+	// Files with the same contents are stored once, their directory entries point to the same data.
+	String content_key;
+	if (deduplication) {
+		unsigned char hash[32];
+		CryptoCore::sha256(p_data.ptr(), p_data.size(), hash);
+		content_key = String::hex_encode_buffer(hash, 32) + (p_encrypt ? "e" : "");
+
+		HashMap<String, int>::ConstIterator E = content_files.find(content_key);
+		if (E) {
+			const File &stored = files[E->value];
+			pf.ofs = stored.ofs;
+			pf.stored_size = stored.stored_size;
+			pf.compressed = stored.compressed;
+			files.push_back(pf);
+			return OK;
+		}
+	}
+
+	Vector<uint8_t> compressed_data;
+	if (compression) {
+		compressed_data = FileAccessCompressed::compress_buffer(p_data.ptr(), p_data.size(), PACK_FILE_COMPRESSED_MAGIC, Compression::MODE_ZSTD, PCK_COMPRESSION_BLOCK_SIZE);
+		// Keep the data as is when it doesn't compress.
+		pf.compressed = !compressed_data.is_empty() && compressed_data.size() < p_data.size();
+	}
+	const Vector<uint8_t> &stored_data = pf.compressed ? compressed_data : p_data;
+	pf.stored_size = stored_data.size();
+
 	Ref<FileAccess> ftmp = file;
 
 	Ref<FileAccessEncrypted> fae;
@@ -196,7 +252,7 @@ Error PCKPacker::_add_file(const String &p_target_path, const String &p_source_p
 		ftmp = fae;
 	}
 
-	ftmp->store_buffer(p_data);
+	ftmp->store_buffer(stored_data);
 
 	if (fae.is_valid()) {
 		ftmp.unref();
@@ -208,6 +264,9 @@ Error PCKPacker::_add_file(const String &p_target_path, const String &p_source_p
 		file->store_8(0);
 	}
 
+	if (deduplication) {
+		content_files.insert(content_key, files.size());
+	}
 	files.push_back(pf);
 
 	return OK;
@@ -265,7 +324,13 @@ Error PCKPacker::flush(bool p_verbose) {
 		if (files[i].removal) {
 			flags |= PACK_FILE_REMOVAL;
 		}
+		if (files[i].compressed) {
+			flags |= PACK_FILE_COMPRESSED;
+		}
 		fhead->store_32(flags);
+		if (format_version >= PACK_FORMAT_VERSION_V5) {
+			fhead->store_64(files[i].stored_size);
+		}
 
 		if (p_verbose) {
 			print_line(vformat("[%d/%d - %d%%] PCKPacker flush: %s -> %s", i + 1, file_num, float(i + 1) / file_num * 100, files[i].src_path, files[i].path));
@@ -31,6 +31,7 @@
 #pragma once
 
 #include "core/object/ref_counted.h"
+#include "core/templates/hash_map.h"
 
 class FileAccess;
 
@@ -42,6 +43,9 @@ class PCKPacker : public RefCounted {
 
 	Vector<uint8_t> key;
 	bool enc_dir = false;
+	bool deduplication = false;
+	bool compression = false;
+	uint32_t format_version = 0;
 
 	uint64_t file_base = 0;
 	uint64_t file_base_ofs = 0;
@@ -54,15 +58,23 @@ class PCKPacker : public RefCounted {
 		String src_path;
 		uint64_t ofs = 0;
 		uint64_t size = 0;
+		uint64_t stored_size = 0;
 		bool encrypted = false;
+		bool compressed = false;
 		bool removal = false;
 		Vector<uint8_t> md5;
 	};
 	Vector<File> files;
+	HashMap<String, int> content_files; // Content hash to the first file storing it.
 
 	Error _add_file(const String &p_target_path, const String &p_source_path, const Vector<uint8_t> &p_data, bool p_encrypt = false);
 
 public:
+	void set_deduplication_enabled(bool p_enabled);
+	bool is_deduplication_enabled() const;
+	void set_compression_enabled(bool p_enabled);
+	bool is_compression_enabled() const;
+
 	Error pck_start(const String &p_pck_path, int p_alignment = 32, const String &p_key = "0000000000000000000000000000000000000000000000000000000000000000", bool p_encrypt_directory = false);
 	Error add_file(const String &p_target_path, const String &p_source_path, bool p_encrypt = false);
 	Error add_file_from_buffer(const String &p_target_path, const Vector<uint8_t> &p_data, bool p_encrypt = false);
@@ -96,11 +96,16 @@ enum {
 	// Version 4: New string ID for ext/subresources, breaks forward compat.
 	// Version 5: Ability to store script class in the header.
 	// Version 6: Added PackedVector4Array Variant type.
-	FORMAT_VERSION = 6,
+	// Version 7: Aligned the data of numeric packed arrays.
+	FORMAT_VERSION = 7,
 	FORMAT_VERSION_CAN_RENAME_DEPS = 1,
 	FORMAT_VERSION_NO_NODEPATH_PROPERTY = 3,
+	FORMAT_VERSION_ALIGNED_PACKED_ARRAYS = 7,
 };
 
+// Numeric packed arrays start at this alignment in the file, so they can be copied in bulk or used in place.
+static const uint32_t PACKED_ARRAY_ALIGNMENT = 16;
+
 void ResourceLoaderBinary::_advance_padding(uint32_t p_len) {
 	uint32_t extra = 4 - (p_len % 4);
 	if (extra < 4) {
@@ -110,11 +115,35 @@ void ResourceLoaderBinary::_advance_padding(uint32_t p_len) {
 	}
 }
 
+void ResourceLoaderBinary::_advance_alignment() {
+	if (ver_format < FORMAT_VERSION_ALIGNED_PACKED_ARRAYS) {
+		return;
+	}
+	uint32_t padding = f->get_32();
+	if (padding > 0) {
+		f->seek(f->get_position() + padding);
+	}
+}
+
+// Reads the data of a numeric packed array. When the file is memory mapped, it's copied straight from the
+// mapping, where it starts aligned since FORMAT_VERSION_ALIGNED_PACKED_ARRAYS.
+static void read_packed_buffer(uint8_t *dst, Ref<FileAccess> &f, uint64_t size) {
+	if (size == 0) {
+		return;
+	}
+	Span<uint8_t> span = f->get_buffer_span(size);
+	if (span.size() == size) {
+		memcpy(dst, span.ptr(), size);
+	} else {
+		f->get_buffer(dst, size);
+	}
+}
+
 static Error read_reals(real_t *dst, Ref<FileAccess> &f, size_t count) {
 	if (f->real_is_double) {
 		if constexpr (sizeof(real_t) == 8) {
 			// Ideal case with double-precision
-			f->get_buffer((uint8_t *)dst, count * sizeof(double));
+			read_packed_buffer((uint8_t *)dst, f, count * sizeof(double));
 		} else if constexpr (sizeof(real_t) == 4) {
 			// May be slower, but this is for compatibility. Eventually the data should be converted.
 			for (size_t i = 0; i < count; ++i) {
@@ -126,7 +155,7 @@ static Error read_reals(real_t *dst, Ref<FileAccess> &f, size_t count) {
 	} else {
 		if constexpr (sizeof(real_t) == 4) {
 			// Ideal case with float-precision
-			f->get_buffer((uint8_t *)dst, count * sizeof(float));
+			read_packed_buffer((uint8_t *)dst, f, count * sizeof(float));
 		} else if constexpr (sizeof(real_t) == 8) {
 			for (size_t i = 0; i < count; ++i) {
 				dst[i] = f->get_float();
@@ -148,6 +177,10 @@ StringName ResourceLoaderBinary::_get_string() {
 		if (len == 0) {
 			return StringName();
 		}
+		Span<uint8_t> mapped = f->get_buffer_span(len);
+		if (mapped.size() == len) {
+			return String::utf8((const char *)mapped.ptr(), len);
+		}
 		f->get_buffer((uint8_t *)&str_buf[0], len);
 		return String::utf8(&str_buf[0], len);
 	}
@@ -493,11 +526,12 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 		} break;
 		case VARIANT_PACKED_BYTE_ARRAY: {
 			uint32_t len = f->get_32();
+			_advance_alignment();
 
 			Vector<uint8_t> array;
 			array.resize(len);
 			uint8_t *w = array.ptrw();
-			f->get_buffer(w, len);
+			read_packed_buffer(w, f, len);
 			_advance_padding(len);
 
 			r_v = array;
@@ -505,41 +539,45 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 		} break;
 		case VARIANT_PACKED_INT32_ARRAY: {
 			uint32_t len = f->get_32();
+			_advance_alignment();
 
 			Vector<int32_t> array;
 			array.resize(len);
 			int32_t *w = array.ptrw();
-			f->get_buffer((uint8_t *)w, len * sizeof(int32_t));
+			read_packed_buffer((uint8_t *)w, f, len * sizeof(int32_t));
 
 			r_v = array;
 		} break;
 		case VARIANT_PACKED_INT64_ARRAY: {
 			uint32_t len = f->get_32();
+			_advance_alignment();
 
 			Vector<int64_t> array;
 			array.resize(len);
 			int64_t *w = array.ptrw();
-			f->get_buffer((uint8_t *)w, len * sizeof(int64_t));
+			read_packed_buffer((uint8_t *)w, f, len * sizeof(int64_t));
 
 			r_v = array;
 		} break;
 		case VARIANT_PACKED_FLOAT32_ARRAY: {
 			uint32_t len = f->get_32();
+			_advance_alignment();
 
 			Vector<float> array;
 			array.resize(len);
 			float *w = array.ptrw();
-			f->get_buffer((uint8_t *)w, len * sizeof(float));
+			read_packed_buffer((uint8_t *)w, f, len * sizeof(float));
 
 			r_v = array;
 		} break;
 		case VARIANT_PACKED_FLOAT64_ARRAY: {
 			uint32_t len = f->get_32();
+			_advance_alignment();
 
 			Vector<double> array;
 			array.resize(len);
 			double *w = array.ptrw();
-			f->get_buffer((uint8_t *)w, len * sizeof(double));
+			read_packed_buffer((uint8_t *)w, f, len * sizeof(double));
 
 			r_v = array;
 		} break;
@@ -557,6 +595,7 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 		} break;
 		case VARIANT_PACKED_VECTOR2_ARRAY: {
 			uint32_t len = f->get_32();
+			_advance_alignment();
 
 			Vector<Vector2> array;
 			array.resize(len);
@@ -570,6 +609,7 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 		} break;
 		case VARIANT_PACKED_VECTOR3_ARRAY: {
 			uint32_t len = f->get_32();
+			_advance_alignment();
 
 			Vector<Vector3> array;
 			array.resize(len);
@@ -583,18 +623,20 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 		} break;
 		case VARIANT_PACKED_COLOR_ARRAY: {
 			uint32_t len = f->get_32();
+			_advance_alignment();
 
 			Vector<Color> array;
 			array.resize(len);
 			Color *w = array.ptrw();
 			// Colors always use `float` even with double-precision support enabled
 			static_assert(sizeof(Color) == 4 * sizeof(float));
-			f->get_buffer((uint8_t *)w, len * sizeof(float) * 4);
+			read_packed_buffer((uint8_t *)w, f, len * sizeof(float) * 4);
 
 			r_v = array;
 		} break;
 		case VARIANT_PACKED_VECTOR4_ARRAY: {
 			uint32_t len = f->get_32();
+			_advance_alignment();
 
 			Vector<Vector4> array;
 			array.resize(len);
@@ -863,12 +905,16 @@ static String get_ustring(Ref<FileAccess> f) {
 
 String ResourceLoaderBinary::get_unicode_string() {
 	int len = f->get_32();
-	if (len > str_buf.size()) {
-		str_buf.resize(len);
-	}
 	if (len == 0) {
 		return String();
 	}
+	Span<uint8_t> mapped = f->get_buffer_span(len);
+	if (mapped.size() == (uint64_t)len) {
+		return String::utf8((const char *)mapped.ptr(), len);
+	}
+	if (len > str_buf.size()) {
+		str_buf.resize(len);
+	}
 	f->get_buffer((uint8_t *)&str_buf[0], len);
 	return String::utf8(&str_buf[0], len);
 }
@@ -1557,6 +1603,16 @@ void ResourceFormatSaverBinaryInstance::_pad_buffer(Ref<FileAccess> f, int p_byt
 	}
 }
 
+void ResourceFormatSaverBinaryInstance::_align_buffer(Ref<FileAccess> f) {
+	// The padding size is stored, so the data can be read back even if the file is later moved around in chunks.
+	uint64_t data_pos = f->get_position() + 4;
+	uint32_t padding = (PACKED_ARRAY_ALIGNMENT - data_pos % PACKED_ARRAY_ALIGNMENT) % PACKED_ARRAY_ALIGNMENT;
+	f->store_32(padding);
+	for (uint32_t i = 0; i < padding; i++) {
+		f->store_8(0);
+	}
+}
+
 void ResourceFormatSaverBinaryInstance::write_variant(Ref<FileAccess> f, const Variant &p_property, HashMap<Ref<Resource>, int> &resource_map, HashMap<Ref<Resource>, int> &external_resources, HashMap<StringName, int> &string_map, const PropertyInfo &p_hint) {
 	switch (p_property.get_type()) {
 		case Variant::NIL: {
@@ -1861,6 +1917,7 @@ void ResourceFormatSaverBinaryInstance::write_variant(Ref<FileAccess> f, const V
 			Vector<uint8_t> arr = p_property;
 			int len = arr.size();
 			f->store_32(uint32_t(len));
+			_align_buffer(f);
 			const uint8_t *r = arr.ptr();
 			f->store_buffer(r, len);
 			_pad_buffer(f, len);
@@ -1871,9 +1928,14 @@ void ResourceFormatSaverBinaryInstance::write_variant(Ref<FileAccess> f, const V
 			Vector<int32_t> arr = p_property;
 			int len = arr.size();
 			f->store_32(uint32_t(len));
+			_align_buffer(f);
 			const int32_t *r = arr.ptr();
-			for (int i = 0; i < len; i++) {
-				f->store_32(uint32_t(r[i]));
+			if (!f->is_big_endian()) {
+				f->store_buffer((const uint8_t *)r, len * sizeof(int32_t));
+			} else {
+				for (int i = 0; i < len; i++) {
+					f->store_32(uint32_t(r[i]));
+				}
 			}
 
 		} break;
@@ -1882,9 +1944,14 @@ void ResourceFormatSaverBinaryInstance::write_variant(Ref<FileAccess> f, const V
 			Vector<int64_t> arr = p_property;
 			int len = arr.size();
 			f->store_32(uint32_t(len));
+			_align_buffer(f);
 			const int64_t *r = arr.ptr();
-			for (int i = 0; i < len; i++) {
-				f->store_64(uint64_t(r[i]));
+			if (!f->is_big_endian()) {
+				f->store_buffer((const uint8_t *)r, len * sizeof(int64_t));
+			} else {
+				for (int i = 0; i < len; i++) {
+					f->store_64(uint64_t(r[i]));
+				}
 			}
 
 		} break;
@@ -1893,9 +1960,14 @@ void ResourceFormatSaverBinaryInstance::write_variant(Ref<FileAccess> f, const V
 			Vector<float> arr = p_property;
 			int len = arr.size();
 			f->store_32(uint32_t(len));
+			_align_buffer(f);
 			const float *r = arr.ptr();
-			for (int i = 0; i < len; i++) {
-				f->store_float(r[i]);
+			if (!f->is_big_endian()) {
+				f->store_buffer((const uint8_t *)r, len * sizeof(float));
+			} else {
+				for (int i = 0; i < len; i++) {
+					f->store_float(r[i]);
+				}
 			}
 
 		} break;
@@ -1904,9 +1976,14 @@ void ResourceFormatSaverBinaryInstance::write_variant(Ref<FileAccess> f, const V
 			Vector<double> arr = p_property;
 			int len = arr.size();
 			f->store_32(uint32_t(len));
+			_align_buffer(f);
 			const double *r = arr.ptr();
-			for (int i = 0; i < len; i++) {
-				f->store_double(r[i]);
+			if (!f->is_big_endian()) {
+				f->store_buffer((const uint8_t *)r, len * sizeof(double));
+			} else {
+				for (int i = 0; i < len; i++) {
+					f->store_double(r[i]);
+				}
 			}
 
 		} break;
@@ -1926,10 +2003,16 @@ void ResourceFormatSaverBinaryInstance::write_variant(Ref<FileAccess> f, const V
 			Vector<Vector2> arr = p_property;
 			int len = arr.size();
 			f->store_32(uint32_t(len));
+			_align_buffer(f);
 			const Vector2 *r = arr.ptr();
-			for (int i = 0; i < len; i++) {
-				f->store_real(r[i].x);
-				f->store_real(r[i].y);
+			if (!f->is_big_endian()) {
+				// Reals are stored with the size of real_t, see FORMAT_FLAG_REAL_T_IS_DOUBLE.
+				f->store_buffer((const uint8_t *)r, len * sizeof(Vector2));
+			} else {
+				for (int i = 0; i < len; i++) {
+					f->store_real(r[i].x);
+					f->store_real(r[i].y);
+				}
 			}
 		} break;
 
@@ -1938,11 +2021,16 @@ void ResourceFormatSaverBinaryInstance::write_variant(Ref<FileAccess> f, const V
 			Vector<Vector3> arr = p_property;
 			int len = arr.size();
 			f->store_32(uint32_t(len));
+			_align_buffer(f);
 			const Vector3 *r = arr.ptr();
-			for (int i = 0; i < len; i++) {
-				f->store_real(r[i].x);
-				f->store_real(r[i].y);
-				f->store_real(r[i].z);
+			if (!f->is_big_endian()) {
+				f->store_buffer((const uint8_t *)r, len * sizeof(Vector3));
+			} else {
+				for (int i = 0; i < len; i++) {
+					f->store_real(r[i].x);
+					f->store_real(r[i].y);
+					f->store_real(r[i].z);
+				}
 			}
 		} break;
 
@@ -1951,12 +2039,17 @@ void ResourceFormatSaverBinaryInstance::write_variant(Ref<FileAccess> f, const V
 			Vector<Color> arr = p_property;
 			int len = arr.size();
 			f->store_32(uint32_t(len));
+			_align_buffer(f);
 			const Color *r = arr.ptr();
-			for (int i = 0; i < len; i++) {
-				f->store_float(r[i].r);
-				f->store_float(r[i].g);
-				f->store_float(r[i].b);
-				f->store_float(r[i].a);
+			if (!f->is_big_endian()) {
+				f->store_buffer((const uint8_t *)r, len * sizeof(Color));
+			} else {
+				for (int i = 0; i < len; i++) {
+					f->store_float(r[i].r);
+					f->store_float(r[i].g);
+					f->store_float(r[i].b);
+					f->store_float(r[i].a);
+				}
 			}
 
 		} break;
@@ -1965,12 +2058,17 @@ void ResourceFormatSaverBinaryInstance::write_variant(Ref<FileAccess> f, const V
 			Vector<Vector4> arr = p_property;
 			int len = arr.size();
 			f->store_32(uint32_t(len));
+			_align_buffer(f);
 			const Vector4 *r = arr.ptr();
-			for (int i = 0; i < len; i++) {
-				f->store_real(r[i].x);
-				f->store_real(r[i].y);
-				f->store_real(r[i].z);
-				f->store_real(r[i].w);
+			if (!f->is_big_endian()) {
+				f->store_buffer((const uint8_t *)r, len * sizeof(Vector4));
+			} else {
+				for (int i = 0; i < len; i++) {
+					f->store_real(r[i].x);
+					f->store_real(r[i].y);
+					f->store_real(r[i].z);
+					f->store_real(r[i].w);
+				}
 			}
 
 		} break;
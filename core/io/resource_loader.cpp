@@ -35,6 +35,7 @@
 #include "core/core_bind.h"
 #include "core/io/dir_access.h"
 #include "core/io/file_access.h"
+#include "core/io/marshalls.h"
 #include "core/io/resource_importer.h"
 #include "core/object/callable_mp.h"
 #include "core/object/class_db.h"
@@ -651,6 +652,28 @@ void ResourceLoader::_run_load_task(void *p_userdata) {
 		load_task.status = THREAD_LOAD_FAILED;
 	} else {
 		load_task.status = THREAD_LOAD_LOADED;
+
+		// Remember what this resource loaded, so the next threaded load of it can start them all upfront.
+		// Refreshed on every load, since the resource may have changed since the last one.
+		if (load_task.loaded_dependencies.is_empty()) {
+			load_dependencies.erase(load_task.local_path);
+		} else {
+			Vector<String> dependencies;
+			for (const String &E : load_task.loaded_dependencies) {
+				dependencies.push_back(E);
+			}
+			load_dependencies[load_task.local_path] = dependencies;
+		}
+	}
+	load_task.loaded_dependencies.clear();
+
+	_release_prefetch_tokens(load_task);
+
+	if (load_task.budgeted) {
+		load_task.budgeted = false;
+		load_tasks_in_flight--;
+		load_bytes_in_flight -= load_task.budget_bytes;
+		_dispatch_queued_load_tasks();
 	}
 
 	if (load_task.cond_var && load_task.need_wait) {
@@ -698,6 +721,7 @@ String ResourceLoader::_validate_local_path(const String &p_path) {
 }
 
 Error ResourceLoader::load_threaded_request(const String &p_path, const String &p_type_hint, bool p_use_sub_threads, CacheMode p_cache_mode) {
+	_release_cancelled_load_tokens();
 	Ref<ResourceLoader::LoadToken> token = _load_start(p_path, p_type_hint, p_use_sub_threads ? LOAD_THREAD_DISTRIBUTE : LOAD_THREAD_SPAWN_SINGLE, p_cache_mode, true);
 	return token.is_valid() ? OK : FAILED;
 }
@@ -753,12 +777,26 @@ Ref<ResourceLoader::LoadToken> ResourceLoader::_load_start(const String &p_path,
 
 	bool ignoring_cache = p_cache_mode == CACHE_MODE_IGNORE || p_cache_mode == CACHE_MODE_IGNORE_DEEP;
 
+	// Read and estimated before taking the lock, since they have to look at the files.
+	if (p_for_user && p_thread_mode == LOAD_THREAD_DISTRIBUTE && p_cache_mode == CACHE_MODE_REUSE) {
+		_read_load_dependencies();
+	}
+	uint64_t budget_bytes = 0;
+	if (p_for_user && p_thread_mode != LOAD_THREAD_FROM_CURRENT) {
+		budget_bytes = _estimate_load_size(local_path);
+	}
+
 	Ref<LoadToken> load_token;
 	bool must_not_register = false;
 	ThreadLoadTask *load_task_ptr = nullptr;
 	{
 		MutexLock thread_load_lock(thread_load_mutex);
 
+		if (curr_load_task && curr_load_task->started_load) {
+			// Requested by the loader of the current task, not prefetched for it.
+			curr_load_task->loaded_dependencies.insert(local_path);
+		}
+
 		if (p_for_user) {
 			LoadToken *existing_token = _load_threaded_request_reuse_user_token(p_path);
 			if (existing_token) {
@@ -828,6 +866,13 @@ Ref<ResourceLoader::LoadToken> ResourceLoader::_load_start(const String &p_path,
 			}
 		}
 
+		// User loads wait their turn by priority if there's a budget for them.
+		bool queue = p_for_user && !must_not_register && p_thread_mode != LOAD_THREAD_FROM_CURRENT && (max_load_tasks_in_flight || max_load_bytes_in_flight);
+
+		if (p_for_user && p_thread_mode == LOAD_THREAD_DISTRIBUTE && p_cache_mode == CACHE_MODE_REUSE && !must_not_register && !queue) {
+			_prefetch_dependencies(*load_task_ptr);
+		}
+
 		// It's important to keep the token alive because until the load completes,
 		// which includes before the thread start, it may happen that no one is grabbing
 		// the token anymore so it's released.
@@ -841,6 +886,11 @@ Ref<ResourceLoader::LoadToken> ResourceLoader::_load_start(const String &p_path,
 			} else {
 				load_task_ptr->thread_id = Thread::get_caller_id();
 			}
+		} else if (queue) {
+			load_task_ptr->queued = true;
+			load_task_ptr->budget_bytes = budget_bytes;
+			queued_load_tasks.push_back(load_task_ptr);
+			_dispatch_queued_load_tasks();
 		} else {
 			load_task_ptr->task_id = WorkerThreadPool::get_singleton()->add_native_task(&ResourceLoader::_run_load_task, load_task_ptr);
 		}
@@ -853,6 +903,238 @@ Ref<ResourceLoader::LoadToken> ResourceLoader::_load_start(const String &p_path,
 	return load_token;
 }
 
+// Gathers the path and all the known dependencies down its tree, breadth first.
+void ResourceLoader::_gather_load_dependencies(const String &p_path, LocalVector<String> &r_dependencies) {
+	HashSet<String> visited;
+	visited.insert(p_path);
+	r_dependencies.push_back(p_path);
+	for (uint32_t i = 0; i < r_dependencies.size(); i++) {
+		const Vector<String> *direct_dependencies = load_dependencies.getptr(r_dependencies[i]);
+		if (!direct_dependencies) {
+			continue;
+		}
+		for (const String &dependency : *direct_dependencies) {
+			if (!visited.has(dependency)) {
+				visited.insert(dependency);
+				r_dependencies.push_back(dependency);
+			}
+		}
+	}
+}
+
+void ResourceLoader::_read_load_dependencies() {
+	{
+		MutexLock thread_load_lock(thread_load_mutex);
+		if (load_dependencies_read) {
+			return;
+		}
+	}
+
+	// Read outside of the lock. The file is only written on export, so it's fine for it to be missing.
+	Dictionary graph;
+	const String path = get_load_dependencies_file();
+	if (FileAccess::exists(path)) {
+		Error err = OK;
+		Vector<uint8_t> buffer = FileAccess::get_file_as_bytes(path, &err);
+		Variant decoded;
+		if (err == OK && !buffer.is_empty() && decode_variant(decoded, buffer.ptr(), buffer.size()) == OK && decoded.get_type() == Variant::DICTIONARY) {
+			graph = decoded;
+		}
+	}
+
+	MutexLock thread_load_lock(thread_load_mutex);
+	if (load_dependencies_read) {
+		return; // Another thread got there first.
+	}
+	load_dependencies_read = true;
+	for (const KeyValue<Variant, Variant> &E : graph) {
+		// What was recorded by the loads done in the meantime is more recent.
+		if (!load_dependencies.has(E.key)) {
+			load_dependencies[E.key] = PackedStringArray(E.value);
+		}
+	}
+}
+
+void ResourceLoader::_prefetch_dependencies(ThreadLoadTask &p_load_task) {
+	if (!load_dependencies.has(p_load_task.local_path)) {
+		return;
+	}
+
+	LocalVector<String> dependencies;
+	_gather_load_dependencies(p_load_task.local_path, dependencies);
+
+	// Start the deepest ones first, since everything above them waits on them anyway.
+	// These only queue tasks, so it's fine to do it while the mutex is held.
+	// They are parented to the task being started, so they count towards its progress.
+	ThreadLoadTask *curr_load_task_backup = curr_load_task;
+	curr_load_task = &p_load_task;
+	for (uint32_t i = dependencies.size() - 1; i > 0; i--) {
+		const String &dependency = dependencies[i];
+		if (thread_load_tasks.has(dependency) || ResourceCache::has(dependency)) {
+			continue;
+		}
+		Ref<LoadToken> token = _load_start(dependency, "", LOAD_THREAD_DISTRIBUTE, CACHE_MODE_REUSE);
+		if (token.is_valid()) {
+			token->reference();
+			p_load_task.prefetch_tokens.push_back(token.ptr());
+		}
+	}
+	curr_load_task = curr_load_task_backup;
+}
+
+void ResourceLoader::_release_prefetch_tokens(ThreadLoadTask &p_load_task) {
+	// Dependencies that turned out not to be needed may still be loading. Don't wait for them,
+	// let them be released once done like cancelled loads.
+	for (LoadToken *token : p_load_task.prefetch_tokens) {
+		ThreadLoadTask *prefetch_task = token->task_if_unregistered ? token->task_if_unregistered : thread_load_tasks.getptr(token->local_path);
+		if (prefetch_task && prefetch_task->parent_task == &p_load_task) {
+			// The task may be gone by the time someone else awaits the dependency.
+			prefetch_task->parent_task = nullptr;
+		}
+		cancelled_load_tokens.push_back(token);
+	}
+	p_load_task.prefetch_tokens.clear();
+}
+
+uint64_t ResourceLoader::_estimate_load_size(const String &p_path) {
+	// The size of the files to read is a good enough estimate of the memory that will be needed.
+	LocalVector<String> paths;
+	{
+		MutexLock thread_load_lock(thread_load_mutex);
+		if (!max_load_tasks_in_flight && !max_load_bytes_in_flight) {
+			return 0; // Not queued, so not needed.
+		}
+		_gather_load_dependencies(p_path, paths);
+	}
+
+	uint64_t size = 0;
+	for (uint32_t i = 0; i < paths.size(); i++) {
+		if (i > 0 && ResourceCache::has(paths[i])) {
+			continue;
+		}
+		String path = _path_remap(paths[i]);
+		if (!FileAccess::exists(path) && FileAccess::exists(path + ".import")) {
+			path = ResourceFormatImporter::get_singleton()->get_internal_resource_path(path);
+		}
+		if (!path.is_empty() && FileAccess::exists(path)) {
+			size += MAX(FileAccess::get_size(path), 0);
+		}
+	}
+	return size;
+}
+
+void ResourceLoader::_dispatch_load_task(ThreadLoadTask &p_load_task) {
+	DEV_ASSERT(p_load_task.queued);
+
+	queued_load_tasks.erase(&p_load_task);
+	p_load_task.queued = false;
+	p_load_task.budgeted = true;
+	load_tasks_in_flight++;
+	load_bytes_in_flight += p_load_task.budget_bytes;
+
+	if (p_load_task.use_sub_threads && p_load_task.cache_mode == CACHE_MODE_REUSE) {
+		_prefetch_dependencies(p_load_task);
+	}
+
+	p_load_task.task_id = WorkerThreadPool::get_singleton()->add_native_task(&ResourceLoader::_run_load_task, &p_load_task);
+}
+
+void ResourceLoader::_dispatch_queued_load_tasks() {
+	while (!queued_load_tasks.is_empty()) {
+		// Highest priority first, and in request order among equals.
+		uint32_t next = 0;
+		for (uint32_t i = 1; i < queued_load_tasks.size(); i++) {
+			if (queued_load_tasks[i]->priority > queued_load_tasks[next]->priority) {
+				next = i;
+			}
+		}
+
+		ThreadLoadTask *load_task = queued_load_tasks[next];
+		// Always let one through, even if it's bigger than the whole budget.
+		if (load_tasks_in_flight > 0) {
+			if (max_load_tasks_in_flight && load_tasks_in_flight >= max_load_tasks_in_flight) {
+				break;
+			}
+			if (max_load_bytes_in_flight && load_bytes_in_flight + load_task->budget_bytes > max_load_bytes_in_flight) {
+				break;
+			}
+		}
+
+		_dispatch_load_task(*load_task);
+	}
+}
+
+void ResourceLoader::_release_cancelled_load_tokens() {
+	LocalVector<LoadToken *> done_tokens;
+	{
+		MutexLock thread_load_lock(thread_load_mutex);
+		for (uint32_t i = 0; i < cancelled_load_tokens.size(); i++) {
+			LoadToken *load_token = cancelled_load_tokens[i];
+			const ThreadLoadTask *load_task = load_token->task_if_unregistered ? load_token->task_if_unregistered : thread_load_tasks.getptr(load_token->local_path);
+			if (!load_task || load_task->status != THREAD_LOAD_IN_PROGRESS) {
+				done_tokens.push_back(load_token);
+				cancelled_load_tokens.remove_at_unordered(i);
+				i--;
+			}
+		}
+	}
+
+	// Outside of the lock, since it may have to wait for the task to exit.
+	for (LoadToken *load_token : done_tokens) {
+		if (load_token->unreference()) {
+			memdelete(load_token);
+		}
+	}
+}
+
+ResourceLoader::ThreadLoadTask *ResourceLoader::_get_user_load_task(const String &p_path) {
+	LoadToken *load_token = user_load_tokens[p_path];
+	if (load_token->task_if_unregistered) {
+		return load_token->task_if_unregistered;
+	}
+	return thread_load_tasks.getptr(load_token->local_path);
+}
+
+String ResourceLoader::get_load_dependencies_file() {
+	return ProjectSettings::get_singleton()->get_project_data_path().path_join("load_dependencies.bin");
+}
+
+Vector<uint8_t> ResourceLoader::encode_load_dependencies(const Vector<String> &p_paths) {
+	Dictionary graph;
+	for (const String &path : p_paths) {
+		List<String> dependencies;
+		get_dependencies(path, &dependencies);
+
+		PackedStringArray dependency_paths;
+		for (const String &dependency : dependencies) {
+			// Dependencies may come as "uid::type::path", keep the path only.
+			String dependency_path = ResourceUID::ensure_path(dependency.get_slice("::", 0));
+			if (dependency_path.is_empty() || !dependency_path.begins_with("res://")) {
+				dependency_path = dependency.get_slice("::", 2);
+			}
+			if (!dependency_path.is_empty()) {
+				dependency_paths.push_back(dependency_path);
+			}
+		}
+		if (!dependency_paths.is_empty()) {
+			graph[path] = dependency_paths;
+		}
+	}
+
+	if (graph.is_empty()) {
+		return Vector<uint8_t>();
+	}
+
+	int len = 0;
+	Error err = encode_variant(graph, nullptr, len);
+	ERR_FAIL_COND_V(err != OK, Vector<uint8_t>());
+
+	Vector<uint8_t> buffer;
+	buffer.resize(len);
+	encode_variant(graph, buffer.ptrw(), len);
+	return buffer;
+}
+
 float ResourceLoader::_dependency_get_progress(const String &p_path) {
 	if (thread_load_tasks.has(p_path)) {
 		ThreadLoadTask &load_task = thread_load_tasks[p_path];
@@ -934,6 +1216,8 @@ Ref<Resource> ResourceLoader::load_threaded_get(const String &p_path, Error *r_e
 		*r_error = OK;
 	}
 
+	_release_cancelled_load_tokens();
+
 	Ref<Resource> res;
 	{
 		MutexLock thread_load_lock(thread_load_mutex);
@@ -967,6 +1251,10 @@ Ref<Resource> ResourceLoader::load_threaded_get(const String &p_path, Error *r_e
 				load_task_ptr = &thread_load_tasks[load_token->local_path];
 			}
 
+			if (load_task_ptr->queued) {
+				_dispatch_load_task(*load_task_ptr);
+			}
+
 			while (load_task_ptr->status == THREAD_LOAD_IN_PROGRESS) {
 				thread_load_lock.temp_unlock();
 				bool exit = !_ensure_load_progress();
@@ -1000,6 +1288,101 @@ Ref<Resource> ResourceLoader::load_threaded_get(const String &p_path, Error *r_e
 	return res;
 }
 
+Error ResourceLoader::load_threaded_set_priority(const String &p_path, int p_priority) {
+	MutexLock thread_load_lock(thread_load_mutex);
+
+	if (!user_load_tokens.has(p_path)) {
+		print_verbose("load_threaded_set_priority(): No threaded load for resource path '" + p_path + "' has been initiated or its result has already been collected.");
+		return ERR_INVALID_PARAMETER;
+	}
+
+	ThreadLoadTask *load_task = _get_user_load_task(p_path);
+	ERR_FAIL_NULL_V_MSG(load_task, ERR_BUG, "Bug in ResourceLoader logic, please report.");
+	load_task->priority = p_priority;
+
+	return OK;
+}
+
+int ResourceLoader::load_threaded_get_priority(const String &p_path) {
+	MutexLock thread_load_lock(thread_load_mutex);
+
+	if (!user_load_tokens.has(p_path)) {
+		return 0;
+	}
+
+	ThreadLoadTask *load_task = _get_user_load_task(p_path);
+	ERR_FAIL_NULL_V_MSG(load_task, 0, "Bug in ResourceLoader logic, please report.");
+	return load_task->priority;
+}
+
+Error ResourceLoader::load_threaded_cancel(const String &p_path) {
+	_release_cancelled_load_tokens();
+
+	MutexLock thread_load_lock(thread_load_mutex);
+
+	if (!user_load_tokens.has(p_path)) {
+		print_verbose("load_threaded_cancel(): No threaded load for resource path '" + p_path + "' has been initiated or its result has already been collected.");
+		return ERR_INVALID_PARAMETER;
+	}
+
+	LoadToken *load_token = user_load_tokens[p_path];
+	DEV_ASSERT(load_token->user_rc >= 1);
+
+	// Like collecting the result, this only gives up one of the requests for the path.
+	load_token->user_rc--;
+	if (load_token->user_rc > 0) {
+		return OK;
+	}
+	load_token->user_path.clear();
+	user_load_tokens.erase(p_path);
+
+	ThreadLoadTask *load_task = load_token->task_if_unregistered ? load_token->task_if_unregistered : thread_load_tasks.getptr(load_token->local_path);
+	if (load_task && load_task->queued && load_token->get_reference_count() == 2) {
+		// Nobody else is interested in it, so it doesn't need to run at all.
+		// Drop the reference the task would have released when done.
+		queued_load_tasks.erase(load_task);
+		load_task->queued = false;
+		load_task->status = THREAD_LOAD_FAILED;
+		load_task->error = ERR_SKIP;
+		load_task->need_wait = false;
+		load_token->unreference();
+	}
+
+	if (load_task && load_task->status == THREAD_LOAD_IN_PROGRESS) {
+		// Can't be stopped, so let it finish and release it afterwards.
+		cancelled_load_tokens.push_back(load_token);
+	} else if (load_token->unreference()) {
+		memdelete(load_token);
+	}
+
+	print_lt("CANCEL: user load tokens: " + itos(user_load_tokens.size()));
+
+	return OK;
+}
+
+void ResourceLoader::set_threaded_load_budget(uint32_t p_max_tasks, uint64_t p_max_bytes) {
+	MutexLock thread_load_lock(thread_load_mutex);
+	max_load_tasks_in_flight = p_max_tasks;
+	max_load_bytes_in_flight = p_max_bytes;
+
+	if (!max_load_tasks_in_flight && !max_load_bytes_in_flight) {
+		// No budget anymore, let everything through.
+		while (!queued_load_tasks.is_empty()) {
+			_dispatch_load_task(*queued_load_tasks[0]);
+		}
+	} else {
+		_dispatch_queued_load_tasks();
+	}
+}
+
+uint32_t ResourceLoader::get_threaded_load_max_tasks() {
+	return max_load_tasks_in_flight;
+}
+
+uint64_t ResourceLoader::get_threaded_load_max_bytes() {
+	return max_load_bytes_in_flight;
+}
+
 Ref<Resource> ResourceLoader::_load_complete(LoadToken &p_load_token, Error *r_error) {
 	MutexLock thread_load_lock(thread_load_mutex);
 	return _load_complete_inner(p_load_token, r_error, thread_load_lock);
@@ -1043,6 +1426,11 @@ Ref<Resource> ResourceLoader::_load_complete_inner(LoadToken &p_load_token, Erro
 
 		ThreadLoadTask &load_task = thread_load_tasks[p_load_token.local_path];
 
+		if (load_task.queued) {
+			// Someone needs it now, so it can't wait for its turn anymore.
+			_dispatch_load_task(load_task);
+		}
+
 		if (load_task.status == THREAD_LOAD_IN_PROGRESS) {
 			DEV_ASSERT((load_task.task_id == 0) != (load_task.thread_id == 0));
 
@@ -1591,6 +1979,14 @@ void ResourceLoader::clear_thread_load_tasks() {
 	MutexLock thread_load_lock(thread_load_mutex);
 	cleaning_tasks = true;
 
+	// Tasks waiting for their turn will never run now.
+	for (ThreadLoadTask *load_task : queued_load_tasks) {
+		load_task->queued = false;
+		load_task->status = THREAD_LOAD_FAILED;
+		load_task->need_wait = false;
+	}
+	queued_load_tasks.clear();
+
 	while (true) {
 		bool none_running = true;
 		for (int tid : yielders) {
@@ -1631,6 +2027,13 @@ void ResourceLoader::clear_thread_load_tasks() {
 		user_token->unreference();
 	}
 
+	for (LoadToken *load_token : cancelled_load_tokens) {
+		load_token->unreference();
+	}
+	cancelled_load_tokens.clear();
+	load_tasks_in_flight = 0;
+	load_bytes_in_flight = 0;
+
 	thread_load_tasks.clear();
 	thread_waiting_on.clear();
 	// yielders is already guaranteed to be empty now
@@ -1802,6 +2205,16 @@ bool ResourceLoader::cleaning_tasks = false;
 
 HashMap<String, ResourceLoader::LoadToken *> ResourceLoader::user_load_tokens;
 
+HashMap<String, Vector<String>> ResourceLoader::load_dependencies;
+bool ResourceLoader::load_dependencies_read = false;
+
+LocalVector<ResourceLoader::ThreadLoadTask *> ResourceLoader::queued_load_tasks;
+uint32_t ResourceLoader::max_load_tasks_in_flight = 0;
+uint64_t ResourceLoader::max_load_bytes_in_flight = 0;
+uint32_t ResourceLoader::load_tasks_in_flight = 0;
+uint64_t ResourceLoader::load_bytes_in_flight = 0;
+LocalVector<ResourceLoader::LoadToken *> ResourceLoader::cancelled_load_tokens;
+
 SelfList<Resource>::List ResourceLoader::remapped_list;
 HashMap<String, Vector<String>> ResourceLoader::translation_remaps;
 
@@ -103,6 +103,7 @@ typedef void (*ResourceLoadedCallback)(Ref<Resource> p_resource, const String &p
 class ResourceLoader {
 	friend class LoadToken;
 	friend class CoreBind::ResourceLoader;
+	friend class TestResourceLoaderInternalsAccessor;
 
 	enum {
 		MAX_LOADERS = 64
@@ -197,6 +198,10 @@ private:
 		LocalVector<Ref<Resource>> resource_dependencies; // We need to keep these alive for as long as the task is alive at least.
 		ThreadLoadTask *parent_task = nullptr;
 		HashSet<String> sub_tasks;
+		HashSet<String> loaded_dependencies; // Loads requested while running, recorded into load_dependencies when done.
+		LocalVector<LoadToken *> prefetch_tokens; // Dependencies started ahead of time, referenced until this task is done.
+		int priority = 0;
+		uint64_t budget_bytes = 0; // Estimated size, counted towards the in-flight budget while running.
 
 		bool awaited : 1; // If it's in the pool, this helps not awaiting from more than one dependent thread.
 		bool need_wait : 1;
@@ -205,6 +210,8 @@ private:
 		bool started_load : 1;
 		bool finished_load : 1;
 		bool connections_propagated : 1;
+		bool queued : 1; // Waiting for room in the in-flight budget before being handed to the pool.
+		bool budgeted : 1; // Counted towards the in-flight budget.
 
 		struct ResourceChangedConnection {
 			Resource *source = nullptr;
@@ -220,7 +227,9 @@ private:
 				use_sub_threads(false),
 				started_load(false),
 				finished_load(false),
-				connections_propagated(false) {}
+				connections_propagated(false),
+				queued(false),
+				budgeted(false) {}
 	};
 	static void _run_load_task(void *p_userdata);
 
@@ -239,6 +248,32 @@ private:
 
 	static HashMap<String, LoadToken *> user_load_tokens;
 
+	// Direct dependencies of resources, from the file written on export and from the loads done so far.
+	// Used to start loading all the dependencies of a threaded load at once. Guarded by thread_load_mutex.
+	static HashMap<String, Vector<String>> load_dependencies;
+	static bool load_dependencies_read;
+
+	static void _gather_load_dependencies(const String &p_path, LocalVector<String> &r_dependencies);
+	static void _read_load_dependencies(); // Takes thread_load_mutex, must be called without it.
+	static void _prefetch_dependencies(ThreadLoadTask &p_load_task);
+	static void _release_prefetch_tokens(ThreadLoadTask &p_load_task);
+
+	// User loads waiting for room in the in-flight budget, dispatched by priority. Guarded by thread_load_mutex.
+	static LocalVector<ThreadLoadTask *> queued_load_tasks;
+	static uint32_t max_load_tasks_in_flight;
+	static uint64_t max_load_bytes_in_flight;
+	static uint32_t load_tasks_in_flight;
+	static uint64_t load_bytes_in_flight;
+
+	// Loads whose user gave up on them while running, released once done.
+	static LocalVector<LoadToken *> cancelled_load_tokens;
+
+	static uint64_t _estimate_load_size(const String &p_path); // Takes thread_load_mutex, must be called without it.
+	static void _dispatch_load_task(ThreadLoadTask &p_load_task);
+	static void _dispatch_queued_load_tasks();
+	static void _release_cancelled_load_tokens();
+	static ThreadLoadTask *_get_user_load_task(const String &p_path);
+
 	static float _dependency_get_progress(const String &p_path);
 
 	static bool _ensure_load_progress();
@@ -249,6 +284,13 @@ public:
 	static Error load_threaded_request(const String &p_path, const String &p_type_hint = "", bool p_use_sub_threads = false, CacheMode p_cache_mode = CACHE_MODE_REUSE);
 	static ThreadLoadStatus load_threaded_get_status(const String &p_path, float *r_progress = nullptr);
 	static Ref<Resource> load_threaded_get(const String &p_path, Error *r_error = nullptr);
+	static Error load_threaded_set_priority(const String &p_path, int p_priority);
+	static int load_threaded_get_priority(const String &p_path);
+	static Error load_threaded_cancel(const String &p_path);
+
+	static void set_threaded_load_budget(uint32_t p_max_tasks, uint64_t p_max_bytes);
+	static uint32_t get_threaded_load_max_tasks();
+	static uint64_t get_threaded_load_max_bytes();
 
 	static bool is_within_load() { return load_nesting > 0; }
 
@@ -268,6 +310,8 @@ public:
 	static ResourceUID::ID get_resource_uid(const String &p_path);
 	static bool should_create_uid_file(const String &p_path);
 	static void get_dependencies(const String &p_path, List<String> *p_dependencies, bool p_add_types = false);
+	static String get_load_dependencies_file();
+	static Vector<uint8_t> encode_load_dependencies(const Vector<String> &p_paths);
 	static Error rename_dependencies(const String &p_path, const HashMap<String, String> &p_map);
 	static bool is_import_valid(const String &p_path);
 	static String get_import_group_file(const String &p_path);
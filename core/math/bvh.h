@@ -52,6 +52,7 @@
 
 #include "core/math/bvh_tree.h"
 #include "core/math/geometry_3d.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/os/mutex.h"
 
 #include <climits> // INT_MAX
@@ -73,6 +74,14 @@ public:
 		_thread_safe = p_enable;
 	}
 
+	// when enabled, the tree queries of the collision pairing are spread over worker threads
+	// when enough items have changed. The pair / unpair callbacks are still sent from the calling
+	// thread, in the same order as when pairing serially.
+	void params_set_thread_pairing(bool p_enable) {
+		BVH_LOCKED_FUNCTION
+		_thread_pairing = p_enable;
+	}
+
 	// these 2 are crucial for fine tuning, and can be applied manually
 	// see the variable declarations for more info.
 	void params_set_node_expansion(real_t p_value) {
@@ -383,6 +392,49 @@ public:
 		return params.result_count_overall;
 	}
 
+	// Culls many segments at once. The segments traverse the tree in packets, which are spread
+	// over worker threads when there are enough of them. The hits of segment i are the
+	// results from r_offsets[i] up to (but excluding) r_offsets[i + 1].
+	void cull_segments(const POINT *p_from, const POINT *p_to, uint32_t p_count, LocalVector<T *> &r_results, LocalVector<int> &r_subindices, LocalVector<uint32_t> &r_offsets, const T *p_tester, uint32_t p_tree_collision_mask = 0xFFFFFFFF) {
+		BVH_LOCKED_FUNCTION
+
+		SegmentBatch batch;
+		batch.from = p_from;
+		batch.to = p_to;
+		batch.count = p_count;
+		batch.tester = p_tester;
+		batch.tree_collision_mask = p_tree_collision_mask;
+
+		if (_segment_hits.size() < p_count) {
+			_segment_hits.resize(p_count);
+		}
+
+		uint32_t num_packets = (p_count + SEGMENT_PACKET_SIZE - 1) / SEGMENT_PACKET_SIZE;
+		if (p_count >= THREAD_SEGMENTS_MIN_COUNT) {
+			// the tree is only read here, the lock prevents it being modified meanwhile
+			WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &BVH_Manager::_cull_segment_packet_thread, &batch, num_packets, -1, true, SNAME("BVHCullSegments"));
+			WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+		} else {
+			for (uint32_t n = 0; n < num_packets; n++) {
+				_cull_segment_packet_thread(n, &batch);
+			}
+		}
+
+		// translate the hits, in segment order
+		r_results.clear();
+		r_subindices.clear();
+		r_offsets.resize(p_count + 1);
+		for (uint32_t n = 0; n < p_count; n++) {
+			r_offsets[n] = r_results.size();
+			for (const uint32_t ref_id : _segment_hits[n]) {
+				const typename BVHTREE_CLASS::ItemExtra &ex = tree._extra[ref_id];
+				r_results.push_back(ex.userdata);
+				r_subindices.push_back(ex.subindex);
+			}
+		}
+		r_offsets[p_count] = r_results.size();
+	}
+
 	int cull_point(const POINT &p_point, T **p_result_array, int p_result_max, const T *p_tester, uint32_t p_tree_collision_mask = 0xFFFFFFFF, int *p_subindex_array = nullptr) {
 		BVH_LOCKED_FUNCTION
 		typename BVHTREE_CLASS::CullParams params;
@@ -430,6 +482,73 @@ public:
 	}
 
 private:
+	static constexpr uint32_t SEGMENT_PACKET_SIZE = BVHABB_CLASS::SEGMENT_PACKET_SIZE;
+
+	struct SegmentBatch {
+		const POINT *from = nullptr;
+		const POINT *to = nullptr;
+		uint32_t count = 0;
+		const T *tester = nullptr;
+		uint32_t tree_collision_mask = 0;
+	};
+
+	void _cull_segment_packet_thread(uint32_t p_packet, SegmentBatch *p_batch) {
+		uint32_t first = p_packet * SEGMENT_PACKET_SIZE;
+		uint32_t num_lanes = MIN(SEGMENT_PACKET_SIZE, p_batch->count - first);
+
+		typename BVHABB_CLASS::SegmentPacket packet;
+		for (uint32_t lane = 0; lane < num_lanes; lane++) {
+			packet.set_lane(lane, p_batch->from[first + lane], p_batch->to[first + lane]);
+			_segment_hits[first + lane].clear();
+		}
+
+		uint32_t lane_mask = (1 << num_lanes) - 1;
+		tree.cull_segment_packet(packet, lane_mask, p_batch->tester, p_batch->tree_collision_mask, &_segment_hits[first]);
+	}
+
+	// find the potential enterers for a changed item, reading the tree only,
+	// so this can be called from multiple threads at once.
+	void _find_enterer_candidates(BVHHandle p_handle, LocalVector<uint32_t> &r_hits) {
+		typename BVHTREE_CLASS::CullParams params;
+
+		params.result_count_overall = 0;
+		params.result_max = INT_MAX;
+		params.result_array = nullptr;
+		params.subindex_array = nullptr;
+		params.hits = &r_hits;
+
+		// use the expanded aabb for pairing
+		params.abb.from(tree._pairs[p_handle.id()].expanded_aabb);
+		tree.item_fill_cullparams(p_handle, params);
+
+		tree.cull_aabb(params, false);
+
+		// remove the hits that can never pair, the rest is decided serially by _collide
+		// (keeping the cull order, for determinism)
+		const typename BVHTREE_CLASS::ItemExtra &exa = _get_extra(p_handle);
+		uint32_t num_candidates = 0;
+		for (const uint32_t ref_id : r_hits) {
+			if (ref_id == p_handle.id()) {
+				continue;
+			}
+
+			const typename BVHTREE_CLASS::ItemExtra &exb = tree._extra[ref_id];
+			if ((exa.userdata == exb.userdata) && exa.userdata) {
+				continue;
+			}
+			if (!USER_PAIR_TEST_FUNCTION::user_pair_check(exa.userdata, exb.userdata)) {
+				continue;
+			}
+
+			r_hits[num_candidates++] = ref_id;
+		}
+		r_hits.resize(num_candidates);
+	}
+
+	void _find_enterer_candidates_thread(uint32_t p_index, void *p_userdata) {
+		_find_enterer_candidates(changed_items[p_index], _pairing_hits[p_index]);
+	}
+
 	// do this after moving etc.
 	void _check_for_collisions(bool p_full_check = false) {
 		if (!changed_items.size()) {
@@ -437,6 +556,33 @@ private:
 			return;
 		}
 
+		if (_thread_pairing && changed_items.size() >= THREAD_PAIRING_MIN_ITEMS) {
+			// the tree queries are independent of each other as nothing is moved during pairing
+			if (_pairing_hits.size() < changed_items.size()) {
+				_pairing_hits.resize(changed_items.size());
+			}
+
+			WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &BVH_Manager::_find_enterer_candidates_thread, (void *)nullptr, changed_items.size(), -1, true, SNAME("BVHPairing"));
+			WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+			// the pairs themselves are modified serially, in changed item order
+			for (uint32_t i = 0; i < changed_items.size(); i++) {
+				const BVHHandle &h = changed_items[i];
+
+				BVHABB_CLASS abb;
+				abb.from(tree._pairs[h.id()].expanded_aabb);
+				_find_leavers(h, abb, p_full_check);
+
+				for (const uint32_t ref_id : _pairing_hits[i]) {
+					BVHHandle h_collidee;
+					h_collidee.set_id(ref_id);
+					_collide(h, h_collidee);
+				}
+			}
+			_reset();
+			return;
+		}
+
 		typename BVHTREE_CLASS::CullParams params;
 
 		params.result_count_overall = 0;
@@ -800,6 +946,19 @@ private:
 
 	// local toggle for turning on and off thread safety in project settings
 	bool _thread_safe = BVH_THREAD_SAFE;
+
+	// below this number of changed items, pairing is not worth spreading over threads
+	static const uint32_t THREAD_PAIRING_MIN_ITEMS = 128;
+	bool _thread_pairing = false;
+
+	// one list of enterer candidates per changed item, reused between ticks
+	LocalVector<LocalVector<uint32_t>> _pairing_hits;
+
+	// below this number of segments, batched segment culling stays on the calling thread
+	static const uint32_t THREAD_SEGMENTS_MIN_COUNT = 256;
+
+	// one list of hits per segment for cull_segments, reused between calls
+	LocalVector<LocalVector<uint32_t>> _segment_hits;
 };
 
 #undef BVHTREE_CLASS
@@ -50,6 +50,24 @@ struct BVH_ABB {
 		POINT to;
 	};
 
+	// a packet of segments tested together against the same box,
+	// stored per axis so the lanes can be processed with SIMD
+	static constexpr int SEGMENT_PACKET_SIZE = 8;
+
+	struct SegmentPacket {
+		real_t from[POINT::AXIS_COUNT][SEGMENT_PACKET_SIZE] = {};
+		real_t inv_dir[POINT::AXIS_COUNT][SEGMENT_PACKET_SIZE] = {};
+
+		void set_lane(int p_lane, const POINT &p_from, const POINT &p_to) {
+			for (int axis = 0; axis < POINT::AXIS_COUNT; ++axis) {
+				real_t dir = p_to[axis] - p_from[axis];
+				from[axis][p_lane] = p_from[axis];
+				// a huge value rather than infinity, so a segment lying on a slab plane never gives NaN
+				inv_dir[axis][p_lane] = (dir == 0) ? 1e30f : (1 / dir);
+			}
+		}
+	};
+
 	enum IntersectResult {
 		IR_MISS = 0,
 		IR_PARTIAL,
@@ -205,6 +223,40 @@ struct BVH_ABB {
 		return bb.intersects_segment(p_s.from, p_s.to);
 	}
 
+	// returns the lanes of p_lane_mask whose segment intersects the box, as a mask
+	uint32_t intersects_segment_packet(const SegmentPacket &p_packet, uint32_t p_lane_mask) const {
+		real_t t_enter[SEGMENT_PACKET_SIZE];
+		real_t t_exit[SEGMENT_PACKET_SIZE];
+		for (int lane = 0; lane < SEGMENT_PACKET_SIZE; lane++) {
+			t_enter[lane] = 0;
+			t_exit[lane] = 1;
+		}
+
+		// slab test, branchless over the lanes
+		for (int axis = 0; axis < POINT::AXIS_COUNT; ++axis) {
+			const real_t slab_min = min[axis];
+			const real_t slab_max = -neg_max[axis];
+			const real_t *from = p_packet.from[axis];
+			const real_t *inv_dir = p_packet.inv_dir[axis];
+
+			for (int lane = 0; lane < SEGMENT_PACKET_SIZE; lane++) {
+				real_t t0 = (slab_min - from[lane]) * inv_dir[lane];
+				real_t t1 = (slab_max - from[lane]) * inv_dir[lane];
+				t_enter[lane] = MAX(t_enter[lane], MIN(t0, t1));
+				t_exit[lane] = MIN(t_exit[lane], MAX(t0, t1));
+			}
+		}
+
+		uint32_t result = 0;
+		for (int lane = 0; lane < SEGMENT_PACKET_SIZE; lane++) {
+			// slightly conservative, the exact test is left to the narrowphase
+			if (t_enter[lane] <= t_exit[lane] + (real_t)CMP_EPSILON) {
+				result |= 1 << lane;
+			}
+		}
+		return result & p_lane_mask;
+	}
+
 	bool intersects_point(const POINT &p_pt) const {
 		if (_any_lessthan(-p_pt, neg_max)) {
 			return false;
@@ -939,6 +939,24 @@ public:
 	static int get_object_count();
 };
 
+#ifdef DEBUG_ENABLED
+// Prevents the object from being freed while one of its methods is being called.
+struct _ObjectDebugLock {
+	ObjectID obj_id;
+
+	_ObjectDebugLock(Object *p_obj) {
+		obj_id = p_obj->get_instance_id();
+		p_obj->_lock_index.ref();
+	}
+	~_ObjectDebugLock() {
+		Object *obj_ptr = ObjectDB::get_instance(obj_id);
+		if (likely(obj_ptr)) {
+			obj_ptr->_lock_index.unref();
+		}
+	}
+};
+#endif // DEBUG_ENABLED
+
 // Using `RequiredResult<T>` as the return type indicates that null will only be returned in the case of an error.
 // This allows GDExtension language bindings to use the appropriate error handling mechanism for that language
 // when null is returned (for example, throwing an exception), rather than simply returning the value.
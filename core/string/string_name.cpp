@@ -32,6 +32,7 @@
 
 #include "core/os/mutex.h"
 #include "core/os/os.h"
+#include "core/os/thread.h"
 #include "core/string/print_string.h"
 #include "core/templates/paged_allocator.h"
 
@@ -40,9 +41,23 @@ struct StringName::Table {
 	constexpr static uint32_t TABLE_LEN = 1 << TABLE_BITS;
 	constexpr static uint32_t TABLE_MASK = TABLE_LEN - 1;
 
+	// Each lock guards the buckets with the same low bits, so threads looking up
+	// different names rarely wait on each other.
+	constexpr static uint32_t LOCK_BITS = 6;
+	constexpr static uint32_t LOCK_COUNT = 1 << LOCK_BITS;
+	constexpr static uint32_t LOCK_MASK = LOCK_COUNT - 1;
+
+	struct alignas(Thread::CACHE_LINE_BYTES) Lock {
+		BinaryMutex mutex;
+	};
+
 	static inline _Data *table[TABLE_LEN];
-	static inline BinaryMutex mutex;
-	static inline PagedAllocator<_Data> allocator;
+	static inline Lock locks[LOCK_COUNT];
+	static inline PagedAllocator<_Data, true> allocator;
+
+	_FORCE_INLINE_ static BinaryMutex &get_mutex(uint32_t p_idx) {
+		return locks[p_idx & LOCK_MASK].mutex;
+	}
 };
 
 void StringName::setup() {
@@ -54,7 +69,9 @@ void StringName::setup() {
 }
 
 void StringName::cleanup() {
-	MutexLock lock(Table::mutex);
+	for (uint32_t i = 0; i < Table::LOCK_COUNT; i++) {
+		Table::locks[i].mutex.lock();
+	}
 
 #ifdef DEBUG_ENABLED
 	if (unlikely(debug_stringname)) {
@@ -105,13 +122,18 @@ void StringName::cleanup() {
 		print_verbose(vformat("StringName: %d unclaimed string names at exit.", lost_strings));
 	}
 	configured = false;
+
+	for (uint32_t i = 0; i < Table::LOCK_COUNT; i++) {
+		Table::locks[i].mutex.unlock();
+	}
 }
 
 void StringName::unref() {
 	ERR_FAIL_COND(!configured);
 
 	if (_data && _data->refcount.unref()) {
-		MutexLock lock(Table::mutex);
+		const uint32_t idx = _data->hash & Table::TABLE_MASK;
+		MutexLock lock(Table::get_mutex(idx));
 
 		if (CoreGlobals::leak_reporting_enabled && _data->static_count.get() > 0) {
 			ERR_PRINT("BUG: Unreferenced static string to 0: " + _data->name);
@@ -119,7 +141,6 @@ void StringName::unref() {
 		if (_data->prev) {
 			_data->prev->next = _data->next;
 		} else {
-			const uint32_t idx = _data->hash & Table::TABLE_MASK;
 			Table::table[idx] = _data->next;
 		}
 
@@ -214,7 +235,7 @@ StringName::StringName(const char *p_name, bool p_static) {
 	const uint32_t hash = String::hash(p_name);
 	const uint32_t idx = hash & Table::TABLE_MASK;
 
-	MutexLock lock(Table::mutex);
+	MutexLock lock(Table::get_mutex(idx));
 	_data = Table::table[idx];
 
 	while (_data) {
@@ -271,7 +292,7 @@ StringName::StringName(const String &p_name, bool p_static) {
 	const uint32_t hash = p_name.hash();
 	const uint32_t idx = hash & Table::TABLE_MASK;
 
-	MutexLock lock(Table::mutex);
+	MutexLock lock(Table::get_mutex(idx));
 	_data = Table::table[idx];
 
 	while (_data) {
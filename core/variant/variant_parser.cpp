@@ -37,23 +37,26 @@
 #include "core/object/script_language.h"
 #include "core/string/string_buffer.h"
 
-char32_t VariantParser::Stream::get_char() {
-	// is within buffer?
-	if (readahead_pointer < readahead_filled) {
-		return readahead_buffer[readahead_pointer++];
-	}
-
+char32_t VariantParser::Stream::_fill_and_get_char() {
 	// attempt to readahead
 	readahead_filled = _read_buffer(readahead_buffer, readahead_enabled ? READAHEAD_SIZE : 1);
 	if (readahead_filled) {
-		readahead_pointer = 0;
+		readahead_pointer = 1;
+		return readahead_buffer[0];
 	} else {
 		// EOF
 		readahead_pointer = 1;
 		eof = true;
 		return 0;
 	}
-	return get_char();
+}
+
+uint32_t VariantParser::Stream::_get_pending_chars() const {
+	uint32_t pending = readahead_pointer < readahead_filled ? readahead_filled - readahead_pointer : 0;
+	if (saved) {
+		pending++;
+	}
+	return pending;
 }
 
 bool VariantParser::Stream::is_eof() const {
@@ -71,10 +74,33 @@ bool VariantParser::StreamFile::_is_eof() const {
 	return f->eof_reached();
 }
 
+uint64_t VariantParser::StreamFile::get_position() const {
+	// Characters are read one byte each.
+	return f->get_position() - _get_pending_chars();
+}
+
 uint32_t VariantParser::StreamFile::_read_buffer(char32_t *p_buffer, uint32_t p_num_chars) {
 	// The buffer is assumed to include at least one character (for null terminator)
 	ERR_FAIL_COND_V(!p_num_chars, 0);
 
+	// Read straight from memory if the file is mapped.
+	uint64_t available = 0;
+	if (f->get_mapped_contents()) {
+		const uint64_t position = f->get_position();
+		const uint64_t mapped_length = f->get_mapped_length();
+		available = position < mapped_length ? mapped_length - position : 0;
+	}
+	if (available > 0) {
+		Span<uint8_t> mapped = f->get_buffer_span(MIN(available, (uint64_t)p_num_chars));
+		if (!mapped.is_empty()) {
+			const uint8_t *src = mapped.ptr();
+			for (uint32_t n = 0; n < mapped.size(); n++) {
+				p_buffer[n] = src[n];
+			}
+			return mapped.size();
+		}
+	}
+
 	uint8_t *temp = (uint8_t *)alloca(p_num_chars);
 	uint64_t num_read = f->get_buffer(temp, p_num_chars);
 	ERR_FAIL_COND_V(num_read == UINT64_MAX, 0);
@@ -275,7 +301,20 @@ Error VariantParser::get_token(Stream *p_stream, Token &r_token, int &line, Stri
 				[[fallthrough]];
 			}
 			case '"': {
-				String str;
+				// UTF-8 streams give one byte per character, decode them all at once at the end.
+				const bool utf8 = p_stream->is_utf8();
+				LocalVector<char> utf8_str;
+				StringBuffer<> str;
+				auto append = [&](char32_t p_char) {
+					if (!utf8) {
+						str += p_char;
+					} else if (p_char <= 0xff) {
+						utf8_str.push_back(char(p_char));
+					} else {
+						ERR_PRINT(vformat("Invalid unicode codepoint (%x) in UTF-8 string.", (uint32_t)p_char));
+						utf8_str.push_back(0x20);
+					}
+				};
 				char32_t prev = 0;
 				while (true) {
 					char32_t ch = p_stream->get_char();
@@ -378,7 +417,7 @@ Error VariantParser::get_token(Stream *p_stream, Token &r_token, int &line, Stri
 							r_token.type = TK_ERROR;
 							return ERR_PARSE_ERROR;
 						}
-						str += res;
+						append(res);
 					} else {
 						if (prev != 0) {
 							r_err_str = "Invalid UTF-16 sequence in string, unpaired lead surrogate";
@@ -388,7 +427,7 @@ Error VariantParser::get_token(Stream *p_stream, Token &r_token, int &line, Stri
 						if (ch == '\n') {
 							line++;
 						}
-						str += ch;
+						append(ch);
 					}
 				}
 				if (prev != 0) {
@@ -397,18 +436,13 @@ Error VariantParser::get_token(Stream *p_stream, Token &r_token, int &line, Stri
 					return ERR_PARSE_ERROR;
 				}
 
-				if (p_stream->is_utf8()) {
-					// Re-interpret the string we built as ascii.
-					CharString string_as_ascii = str.ascii(true);
-					str.clear();
-					str.append_utf8(string_as_ascii);
-				}
+				String value = utf8 ? String::utf8(utf8_str.ptr(), utf8_str.size()) : str.as_string();
 				if (string_name) {
 					r_token.type = TK_STRING_NAME;
-					r_token.value = StringName(str);
+					r_token.value = StringName(value);
 				} else {
 					r_token.type = TK_STRING;
-					r_token.value = str;
+					r_token.value = value;
 				}
 				return OK;
 
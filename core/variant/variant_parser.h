@@ -44,15 +44,26 @@ public:
 		uint32_t readahead_filled = 0;
 		bool eof = false;
 
+		char32_t _fill_and_get_char();
+
 	protected:
 		bool readahead_enabled = true;
 		virtual uint32_t _read_buffer(char32_t *p_buffer, uint32_t p_num_chars) = 0;
 		virtual bool _is_eof() const = 0;
 
+		// Characters already taken from the source, but not yet returned by get_char().
+		uint32_t _get_pending_chars() const;
+
 	public:
 		char32_t saved = 0;
 
-		char32_t get_char();
+		_FORCE_INLINE_ char32_t get_char() {
+			// is within buffer?
+			if (likely(readahead_pointer < readahead_filled)) {
+				return readahead_buffer[readahead_pointer++];
+			}
+			return _fill_and_get_char();
+		}
 		virtual bool is_utf8() const = 0;
 		bool is_eof() const;
 
@@ -68,6 +79,8 @@ public:
 		Ref<FileAccess> f;
 
 		virtual bool is_utf8() const override;
+		// Position in the file of the next character to parse, which may be behind the one of the file due to readahead.
+		uint64_t get_position() const;
 
 		StreamFile(bool p_readahead_enabled = true) { readahead_enabled = p_readahead_enabled; }
 	};
@@ -35,6 +35,7 @@
 #include "core/string/ustring.h"
 
 #include <fcntl.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
 #include <sys/types.h>
 #if !defined(__FreeBSD__) && !defined(__OpenBSD__) && !defined(__NetBSD__) && !defined(WEB_ENABLED)
@@ -200,6 +201,13 @@ void FileAccessUnix::_close() {
 		return;
 	}
 
+	if (mapped_contents) {
+		munmap((void *)mapped_contents, mapped_length);
+		mapped_contents = nullptr;
+		mapped_length = 0;
+	}
+	mapping_failed = false;
+
 	fclose(f);
 	f = nullptr;
 
@@ -305,6 +313,37 @@ uint64_t FileAccessUnix::get_buffer(uint8_t *p_dst, uint64_t p_length) const {
 	return read;
 }
 
+const uint8_t *FileAccessUnix::get_mapped_contents() const {
+#ifdef WEB_ENABLED
+	// Emscripten emulates mmap by copying the file, which is worse than reading it.
+	return nullptr;
+#else
+	if (mapped_contents || mapping_failed) {
+		return mapped_contents;
+	}
+	// Only map files opened read-only, writes through the stream would not be reflected in the mapping.
+	if (!f || (flags & READ_WRITE) != READ) {
+		return nullptr;
+	}
+
+	uint64_t length = get_length();
+	if (length == 0 || length > SIZE_MAX) {
+		mapping_failed = true;
+		return nullptr;
+	}
+
+	void *data = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fileno(f), 0);
+	if (data == MAP_FAILED) {
+		mapping_failed = true;
+		return nullptr;
+	}
+
+	mapped_contents = (const uint8_t *)data;
+	mapped_length = length;
+	return mapped_contents;
+#endif
+}
+
 Error FileAccessUnix::get_error() const {
 	return last_error;
 }
@@ -46,6 +46,10 @@ class FileAccessUnix : public FileAccess {
 	String path;
 	String path_src;
 
+	mutable const uint8_t *mapped_contents = nullptr;
+	mutable uint64_t mapped_length = 0;
+	mutable bool mapping_failed = false;
+
 	void _close();
 
 #if defined(TOOLS_ENABLED)
@@ -70,6 +74,8 @@ public:
 	virtual bool eof_reached() const override; ///< reading passed EOF
 
 	virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const override;
+	virtual const uint8_t *get_mapped_contents() const override;
+	virtual uint64_t get_mapped_length() const override { return mapped_length; }
 
 	virtual Error get_error() const override; ///< get last error
 
@@ -447,18 +447,39 @@ Error EditorExportPlatform::_save_pack_file(const Ref<EditorExportPreset> &p_pre
 	sd.ofs = (pd->use_sparse_pck) ? 0 : pd->f->get_position();
 	sd.size = p_data.size();
 	sd.delta = p_delta;
-	Error err = _encrypt_and_store_data(ftmp, simplified_path, p_data, p_enc_in_filters, p_enc_ex_filters, p_key, p_seed, sd.encrypted);
-	if (err != OK) {
-		return err;
-	}
-	if (!pd->use_sparse_pck) {
-		ERR_FAIL_COND_V(pd->f->get_position() - sd.ofs < (uint64_t)p_data.size(), ERR_FILE_CANT_WRITE);
+
+	// Files with the same contents are stored once, their directory entries point to the same data.
+	// Only done without encryption, as the data of encrypted files is never identical.
+	String content_key;
+	const uint64_t *stored_ofs = nullptr;
+	if (!pd->use_sparse_pck && p_key.is_empty()) {
+		unsigned char hash[32];
+		CryptoCore::sha256(p_data.ptr(), p_data.size(), hash);
+		content_key = String::hex_encode_buffer(hash, 32);
+		stored_ofs = pd->content_ofs.getptr(content_key);
 	}
 
-	if (!pd->use_sparse_pck) {
-		int pad = _get_pad(PCK_PADDING, pd->f->get_position());
-		for (int i = 0; i < pad; i++) {
-			pd->f->store_8(0);
+	Error err = OK;
+	if (stored_ofs) {
+		sd.ofs = *stored_ofs;
+	} else {
+		err = _encrypt_and_store_data(ftmp, simplified_path, p_data, p_enc_in_filters, p_enc_ex_filters, p_key, p_seed, sd.encrypted);
+		if (err != OK) {
+			return err;
+		}
+		if (!pd->use_sparse_pck) {
+			ERR_FAIL_COND_V(pd->f->get_position() - sd.ofs < (uint64_t)p_data.size(), ERR_FILE_CANT_WRITE);
+		}
+
+		if (!pd->use_sparse_pck) {
+			int pad = _get_pad(PCK_PADDING, pd->f->get_position());
+			for (int i = 0; i < pad; i++) {
+				pd->f->store_8(0);
+			}
+		}
+
+		if (!content_key.is_empty()) {
+			pd->content_ofs.insert(content_key, sd.ofs);
 		}
 	}
 
@@ -1828,6 +1849,22 @@ Error EditorExportPlatform::export_project_files(const Ref<EditorExportPreset> &
 		return err;
 	}
 
+	// Store which resources each scene and resource pulls in, so threaded loads can start them upfront.
+	Vector<String> dependency_roots;
+	for (const String &path : paths) {
+		const String extension = path.get_extension().to_lower();
+		if (extension == "tscn" || extension == "scn" || extension == "tres" || extension == "res") {
+			dependency_roots.push_back(path);
+		}
+	}
+	Vector<uint8_t> load_dependencies = ResourceLoader::encode_load_dependencies(dependency_roots);
+	if (!load_dependencies.is_empty()) {
+		err = save_proxy.save_file(p_preset, p_udata, ResourceLoader::get_load_dependencies_file(), load_dependencies, idx, total, enc_in_filters, enc_ex_filters, key, seed, false);
+		if (err != OK) {
+			return err;
+		}
+	}
+
 	Dictionary int_export = get_internal_export_files(p_preset, p_debug);
 	for (const KeyValue<Variant, Variant> &int_export_kv : int_export) {
 		const PackedByteArray &array = int_export_kv.value;
@@ -99,6 +99,7 @@ public:
 		String salt;
 		Ref<FileAccess> f;
 		Vector<SavedData> file_ofs;
+		HashMap<String, uint64_t> content_ofs; // Content hash to the offset of the data.
 		EditorProgress *ep = nullptr;
 		Vector<SharedObject> *so_files = nullptr;
 		bool use_sparse_pck = false;
@@ -32,6 +32,7 @@
 
 #include "core/config/project_settings.h"
 #include "core/extension/gdextension_manager.h"
+#include "core/io/config_file.h"
 #include "core/io/dir_access.h"
 #include "core/io/file_access.h"
 #include "core/io/resource_importer.h"
@@ -42,8 +43,10 @@
 #include "core/object/worker_thread_pool.h"
 #include "core/os/os.h"
 #include "core/variant/variant_parser.h"
+#include "core/version.h"
 #include "editor/doc/editor_help.h"
 #include "editor/editor_node.h"
+#include "editor/file_system/editor_import_benchmark.h"
 #include "editor/file_system/editor_paths.h"
 #include "editor/inspector/editor_resource_preview.h"
 #include "editor/script/script_editor_plugin.h"
@@ -2810,6 +2813,108 @@ Error EditorFileSystem::_reimport_group(const String &p_group_file, const Vector
 	return err;
 }
 
+void EditorFileSystem::_update_import_cache_path() {
+	import_cache_path = String(EDITOR_GET("filesystem/import/import_cache_path")).strip_edges();
+}
+
+bool EditorFileSystem::_fetch_cached_import(const String &p_cache_path, const String &p_key, const String &p_base_path, List<String> *r_import_variants, Variant *r_metadata) {
+	const String entry_dir = p_cache_path.path_join(p_key.left(2)).path_join(p_key);
+
+	Ref<ConfigFile> manifest;
+	manifest.instantiate();
+	if (manifest->load(entry_dir.path_join("manifest.cfg")) != OK) {
+		return false;
+	}
+
+	const PackedStringArray suffixes = manifest->get_value("import", "files", PackedStringArray());
+	if (suffixes.is_empty()) {
+		return false;
+	}
+
+	Ref<DirAccess> da = DirAccess::create(DirAccess::ACCESS_FILESYSTEM);
+	const String base_path = ProjectSettings::get_singleton()->globalize_path(p_base_path);
+	for (const String &suffix : suffixes) {
+		if (da->copy(entry_dir.path_join(suffix.md5_text()), base_path + suffix) != OK) {
+			return false;
+		}
+	}
+
+	const PackedStringArray variants = manifest->get_value("import", "variants", PackedStringArray());
+	for (const String &variant : variants) {
+		r_import_variants->push_back(variant);
+	}
+	*r_metadata = manifest->get_value("import", "metadata", Variant());
+	return true;
+}
+
+void EditorFileSystem::_store_cached_import(const String &p_cache_path, const String &p_key, const String &p_base_path, const String &p_save_extension, const List<String> &p_import_variants, const Variant &p_metadata) {
+	const String entry_dir = p_cache_path.path_join(p_key.left(2)).path_join(p_key);
+	if (FileAccess::exists(entry_dir.path_join("manifest.cfg"))) {
+		return;
+	}
+
+	// The destinations, and the editor-only files some importers write next to them (e.g. textures
+	// scaled with the editor). Only these are probed, the imported directory is shared by the whole project.
+	PackedStringArray candidates;
+	if (p_import_variants.is_empty()) {
+		candidates.push_back("." + p_save_extension);
+	}
+	for (const String &variant : p_import_variants) {
+		candidates.push_back("." + variant + "." + p_save_extension);
+	}
+	candidates.push_back(".editor." + p_save_extension);
+	candidates.push_back(".editor.meta");
+
+	const String base_path = ProjectSettings::get_singleton()->globalize_path(p_base_path);
+	PackedStringArray suffixes;
+	for (const String &suffix : candidates) {
+		if (FileAccess::exists(base_path + suffix)) {
+			suffixes.push_back(suffix);
+		}
+	}
+	if (suffixes.is_empty()) {
+		return;
+	}
+
+	// Entries are written to a private directory and renamed into place once complete, so other editors
+	// sharing the cache never see a partial entry. If another one stored the same key first, it is kept.
+	const String temp_dir = vformat("%s.%d.%d.tmp", entry_dir, OS::get_singleton()->get_process_id(), (uint64_t)Thread::get_caller_id());
+	ERR_FAIL_COND_MSG(DirAccess::make_dir_recursive_absolute(temp_dir) != OK, "Cannot create import cache directory '" + temp_dir + "'.");
+	Ref<DirAccess> da = DirAccess::create(DirAccess::ACCESS_FILESYSTEM);
+	bool stored = true;
+	for (const String &suffix : suffixes) {
+		if (da->copy(base_path + suffix, temp_dir.path_join(suffix.md5_text())) != OK) {
+			stored = false;
+			break;
+		}
+	}
+
+	if (stored) {
+		PackedStringArray variants;
+		for (const String &variant : p_import_variants) {
+			variants.push_back(variant);
+		}
+
+		// Entries without a manifest are ignored.
+		Ref<ConfigFile> manifest;
+		manifest.instantiate();
+		manifest->set_value("import", "files", suffixes);
+		manifest->set_value("import", "variants", variants);
+		if (p_metadata != Variant()) {
+			manifest->set_value("import", "metadata", p_metadata);
+		}
+		stored = manifest->save(temp_dir.path_join("manifest.cfg")) == OK && da->rename(temp_dir, entry_dir) == OK;
+	}
+
+	if (!stored) {
+		Ref<DirAccess> temp_da = DirAccess::open(temp_dir);
+		if (temp_da.is_valid()) {
+			temp_da->erase_contents_recursive();
+		}
+		da->remove(temp_dir);
+	}
+}
+
 Error EditorFileSystem::_reimport_file(const String &p_file, const HashMap<StringName, Variant> &p_custom_options, const String &p_custom_importer, Variant *p_generator_parameters, bool p_update_file_system) {
 	print_verbose(vformat("EditorFileSystem: Importing file: %s", p_file));
 	uint64_t start_time = OS::get_singleton()->get_ticks_msec();
@@ -2939,7 +3044,35 @@ Error EditorFileSystem::_reimport_file(const String &p_file, const HashMap<Strin
 	List<String> import_variants;
 	List<String> gen_files;
 	Variant meta;
-	Error err = importer->import(uid, p_file, base_path, params, &import_variants, &gen_files, &meta);
+
+	// Results of importers that only depend on the source file and its options can be shared
+	// between projects and machines through a content-addressed cache.
+	String cache_key;
+	if (!import_cache_path.is_empty() && importer->can_cache_import_result()) {
+		String key_data = FileAccess::get_sha256(p_file);
+		key_data += "\n" + String(GODOT_VERSION_FULL_CONFIG);
+		key_data += "\n" + importer->get_importer_name() + "\n" + itos(importer->get_format_version());
+		key_data += "\n" + importer->get_import_settings_string();
+		key_data += "\n" + p_file + "\n" + ResourceUID::get_singleton()->id_to_text(uid);
+		for (const ResourceImporter::ImportOption &E : opts) {
+			String value;
+			VariantWriter::write_to_string(params[E.option.name], value);
+			key_data += "\n" + String(E.option.name) + "=" + value;
+		}
+		cache_key = key_data.sha256_text();
+	}
+
+	const uint64_t import_start_usec = OS::get_singleton()->get_ticks_usec();
+	Error err;
+	if (!cache_key.is_empty() && _fetch_cached_import(import_cache_path, cache_key, base_path, &import_variants, &meta)) {
+		err = OK;
+	} else {
+		err = importer->import(uid, p_file, base_path, params, &import_variants, &gen_files, &meta);
+		if (err == OK && !cache_key.is_empty() && gen_files.is_empty()) {
+			_store_cached_import(import_cache_path, cache_key, base_path, importer->get_save_extension(), import_variants, meta);
+		}
+	}
+	const uint64_t import_time_usec = OS::get_singleton()->get_ticks_usec() - import_start_usec;
 
 	// As import is complete, save the .import file.
 
@@ -3046,6 +3179,17 @@ Error EditorFileSystem::_reimport_file(const String &p_file, const HashMap<Strin
 		}
 	}
 
+	if (EditorImportBenchmark::is_enabled()) {
+		uint64_t bytes_written = 0;
+		for (const String &path : dest_paths) {
+			Ref<FileAccess> f = FileAccess::open(path, FileAccess::READ);
+			if (f.is_valid()) {
+				bytes_written += f->get_length();
+			}
+		}
+		EditorImportBenchmark::record_import(importer->get_importer_name(), import_time_usec, bytes_written);
+	}
+
 	if (p_update_file_system) {
 		// Update cpos, newly created files could've changed the index of the reimported p_file.
 		_find_file(p_file, &fs, cpos);
@@ -3248,7 +3392,7 @@ void EditorFileSystem::_refresh_filesystem() {
 
 void EditorFileSystem::_reimport_thread(uint32_t p_index, ImportThreadData *p_import_data) {
 	ResourceLoader::set_is_import_thread(true);
-	int file_idx = p_import_data->reimport_from + int(p_index);
+	int file_idx = p_import_data->file_indices[p_index];
 	_reimport_file(p_import_data->reimport_files[file_idx].path);
 	ResourceLoader::set_is_import_thread(false);
 
@@ -3259,6 +3403,8 @@ void EditorFileSystem::reimport_files(const Vector<String> &p_files) {
 	ERR_FAIL_COND_MSG(importing, "Attempted to call reimport_files() recursively, this is not allowed.");
 	importing = true;
 
+	_update_import_cache_path();
+
 	Vector<String> reloads;
 
 	EditorProgress *ep = memnew(EditorProgress("reimport", TTR("(Re)Importing Assets"), p_files.size()));
@@ -3335,74 +3481,82 @@ void EditorFileSystem::reimport_files(const Vector<String> &p_files) {
 	bool use_multiple_threads = false;
 #endif
 
-	int from = 0;
+	// Files are sorted by import order, and files only depend on files with a lower order. Within each order,
+	// the files of all the threaded importers are imported together on the worker threads, then the rest of
+	// them are imported on this thread.
+	int progress = 0;
 	Semaphore imported_sem;
-	for (int i = 0; i < reimport_files.size(); i++) {
-		if (groups_to_reimport.has(reimport_files[i].path)) {
-			from = i + 1;
-			continue;
-		}
-
-		if (use_multiple_threads && reimport_files[i].threaded) {
-			if (i + 1 == reimport_files.size() || reimport_files[i + 1].importer != reimport_files[from].importer || groups_to_reimport.has(reimport_files[i + 1].path)) {
-				if (from - i == 0) {
-					// Single file, do not use threads.
-					ep->step(reimport_files[i].path.get_file(), i, false);
-					_reimport_file(reimport_files[i].path);
-				} else {
-					Ref<ResourceImporter> importer = ResourceFormatImporter::get_singleton()->get_importer_by_name(reimport_files[from].importer);
-					if (importer.is_null()) {
-						ERR_PRINT(vformat("Invalid importer for \"%s\".", reimport_files[from].importer));
-						from = i + 1;
-						continue;
+	int level_from = 0;
+	while (level_from < reimport_files.size()) {
+		int level_to = level_from + 1;
+		while (level_to < reimport_files.size() && reimport_files[level_to].order == reimport_files[level_from].order) {
+			level_to++;
+		}
+
+		LocalVector<int> threaded_files;
+		LocalVector<Ref<ResourceImporter>> threaded_importers;
+		if (use_multiple_threads) {
+			for (int i = level_from; i < level_to; i++) {
+				const ImportFile &ifile = reimport_files[i];
+				if (!ifile.threaded || groups_to_reimport.has(ifile.path)) {
+					continue;
+				}
+				if (threaded_files.is_empty() || reimport_files[threaded_files[threaded_files.size() - 1]].importer != ifile.importer) {
+					Ref<ResourceImporter> importer = ResourceFormatImporter::get_singleton()->get_importer_by_name(ifile.importer);
+					if (importer.is_valid()) {
+						threaded_importers.push_back(importer);
 					}
+				}
+				threaded_files.push_back(i);
+			}
+		}
 
-					importer->import_threaded_begin();
-
-					ImportThreadData tdata;
-					tdata.reimport_from = from;
-					tdata.reimport_files = reimport_files.ptr();
-					tdata.imported_sem = &imported_sem;
-
-					int item_count = i - from + 1;
-					WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &EditorFileSystem::_reimport_thread, &tdata, item_count, -1, false, vformat(TTR("Import resources of type: %s"), reimport_files[from].importer));
+		// A single file is not worth the threading overhead.
+		const bool import_threaded = threaded_files.size() > 1;
+		if (import_threaded) {
+			for (Ref<ResourceImporter> &importer : threaded_importers) {
+				importer->import_threaded_begin();
+			}
 
-					int imported_count = 0;
-					while (true) {
-						while (true) {
-							ep->step(reimport_files[imported_count].path.get_file(), from + imported_count, false);
-							if (imported_sem.try_wait()) {
-								imported_count++;
-								break;
-							}
-						}
-						if (imported_count == item_count) {
-							break;
-						}
-					}
+			ImportThreadData tdata;
+			tdata.reimport_files = reimport_files.ptr();
+			tdata.file_indices = threaded_files.ptr();
+			tdata.imported_sem = &imported_sem;
 
-					WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
-					DEV_ASSERT(!imported_sem.try_wait());
+			WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &EditorFileSystem::_reimport_thread, &tdata, threaded_files.size(), -1, false, TTR("Import resources"));
 
-					importer->import_threaded_end();
+			uint32_t imported_count = 0;
+			while (imported_count < threaded_files.size()) {
+				ep->step(reimport_files[threaded_files[imported_count]].path.get_file(), progress + imported_count, false);
+				if (imported_sem.try_wait()) {
+					imported_count++;
 				}
-
-				from = i + 1;
 			}
+			progress += imported_count;
 
-		} else {
-			ep->step(reimport_files[i].path.get_file(), i, false);
-			_reimport_file(reimport_files[i].path);
+			WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+			DEV_ASSERT(!imported_sem.try_wait());
+
+			for (Ref<ResourceImporter> &importer : threaded_importers) {
+				importer->import_threaded_end();
+			}
+		}
 
-			// We need to increment the counter, maybe the next file is multithreaded
-			// and doesn't have the same importer.
-			from = i + 1;
+		for (int i = level_from; i < level_to; i++) {
+			const ImportFile &ifile = reimport_files[i];
+			if (groups_to_reimport.has(ifile.path) || (import_threaded && ifile.threaded)) {
+				continue;
+			}
+			ep->step(ifile.path.get_file(), progress++, false);
+			_reimport_file(ifile.path);
 		}
+
+		level_from = level_to;
 	}
 
 	// Reimport groups.
 
-	from = reimport_files.size();
+	int from = reimport_files.size();
 
 	if (groups_to_reimport.size()) {
 		HashMap<String, Vector<String>> group_files;
@@ -3448,6 +3602,7 @@ Error EditorFileSystem::reimport_append(const String &p_file, const HashMap<Stri
 	// Emit the resource_reimporting signal for the single file before the actual importation.
 	emit_signal(SNAME("resources_reimporting"), reloads);
 
+	_update_import_cache_path();
 	Error ret = _reimport_file(p_file, p_custom_options, p_custom_importer, &p_generator_parameters);
 
 	// Emit the resource_reimported signal for the single file we just reimported.
@@ -144,6 +144,7 @@ public:
 
 class EditorFileSystem : public Node {
 	GDCLASS(EditorFileSystem, Node);
+	friend class TestEditorFileSystemInternalsAccessor;
 
 	_THREAD_SAFE_CLASS_
 
@@ -185,6 +186,7 @@ class EditorFileSystem : public Node {
 	SafeFlag filesystem_changed_queued;
 	bool scanning = false;
 	bool importing = false;
+	String import_cache_path;
 	bool first_scan = true;
 	bool scan_changes_pending = false;
 	float scan_total;
@@ -276,6 +278,10 @@ class EditorFileSystem : public Node {
 	Error _reimport_file(const String &p_file, const HashMap<StringName, Variant> &p_custom_options = HashMap<StringName, Variant>(), const String &p_custom_importer = String(), Variant *generator_parameters = nullptr, bool p_update_file_system = true);
 	Error _reimport_group(const String &p_group_file, const Vector<String> &p_files);
 
+	void _update_import_cache_path();
+	static bool _fetch_cached_import(const String &p_cache_path, const String &p_key, const String &p_base_path, List<String> *r_import_variants, Variant *r_metadata);
+	static void _store_cached_import(const String &p_cache_path, const String &p_key, const String &p_base_path, const String &p_save_extension, const List<String> &p_import_variants, const Variant &p_metadata);
+
 	bool _test_for_reimport(const String &p_path, const String &p_expected_import_md5);
 	bool _is_test_for_reimport_needed(const String &p_path, uint64_t p_last_modification_time, uint64_t p_modification_time, uint64_t p_last_import_modification_time, uint64_t p_import_modification_time, const Vector<String> &p_import_dest_paths);
 	bool _can_import_file(const String &p_path);
@@ -352,8 +358,8 @@ class EditorFileSystem : public Node {
 	void _refresh_filesystem();
 
 	struct ImportThreadData {
-		const ImportFile *reimport_files;
-		int reimport_from;
+		const ImportFile *reimport_files = nullptr;
+		const int *file_indices = nullptr;
 		Semaphore *imported_sem = nullptr;
 	};
 
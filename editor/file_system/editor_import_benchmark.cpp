@@ -0,0 +1,378 @@
+/**************************************************************************/
+/*  editor_import_benchmark.cpp                                           */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "editor_import_benchmark.h"
+
+#include "core/crypto/crypto_core.h"
+#include "core/io/dir_access.h"
+#include "core/io/file_access.h"
+#include "core/io/image.h"
+#include "core/io/json.h"
+#include "core/io/marshalls.h"
+#include "core/math/random_pcg.h"
+#include "core/os/os.h"
+#include "core/version.h"
+
+Error EditorImportBenchmark::_save_texture(const String &p_path, int p_index) {
+	const int size = 256;
+	RandomPCG rng(p_index + 1);
+
+	Vector<uint8_t> data;
+	data.resize(size * size * 4);
+	uint8_t *w = data.ptrw();
+	for (int y = 0; y < size; y++) {
+		for (int x = 0; x < size; x++) {
+			// Gradients and patterns with some noise, so that compression has some actual work to do.
+			uint8_t *pixel = &w[(y * size + x) * 4];
+			pixel[0] = uint8_t(x + p_index * 7);
+			pixel[1] = uint8_t(y * 2);
+			pixel[2] = uint8_t(((x ^ y) & 0xC0) | (rng.rand() & 0x3F));
+			pixel[3] = 255;
+		}
+	}
+
+	Ref<Image> image = Image::create_from_data(size, size, false, Image::FORMAT_RGBA8, data);
+	ERR_FAIL_COND_V(image.is_null(), ERR_CANT_CREATE);
+	return image->save_png(p_path);
+}
+
+Error EditorImportBenchmark::_save_obj_mesh(const String &p_path, int p_index) {
+	const int grid = 32;
+
+	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::WRITE);
+	ERR_FAIL_COND_V_MSG(f.is_null(), ERR_CANT_CREATE, vformat("Cannot create file '%s'.", p_path));
+
+	for (int y = 0; y <= grid; y++) {
+		for (int x = 0; x <= grid; x++) {
+			const float height = Math::sin(x * 0.3f + p_index) * Math::cos(y * 0.2f);
+			f->store_line(vformat("v %f %f %f", x, height, y));
+		}
+	}
+	for (int y = 0; y <= grid; y++) {
+		for (int x = 0; x <= grid; x++) {
+			f->store_line(vformat("vt %f %f", float(x) / grid, float(y) / grid));
+		}
+	}
+	f->store_line("vn 0 1 0");
+
+	for (int y = 0; y < grid; y++) {
+		for (int x = 0; x < grid; x++) {
+			// OBJ indices are 1-based.
+			const int a = y * (grid + 1) + x + 1;
+			const int b = a + 1;
+			const int c = a + grid + 1;
+			const int d = c + 1;
+			f->store_line(vformat("f %d/%d/1 %d/%d/1 %d/%d/1", a, a, c, c, b, b));
+			f->store_line(vformat("f %d/%d/1 %d/%d/1 %d/%d/1", b, b, c, c, d, d));
+		}
+	}
+	return OK;
+}
+
+Error EditorImportBenchmark::_save_gltf_scene(const String &p_path, int p_index) {
+	const int grid = 16;
+	const int vertex_count = (grid + 1) * (grid + 1);
+	const int index_count = grid * grid * 6;
+	const int positions_size = vertex_count * 3 * sizeof(float);
+	const int indices_size = index_count * sizeof(uint16_t);
+
+	Vector<uint8_t> buffer;
+	buffer.resize(positions_size + indices_size);
+	uint8_t *w = buffer.ptrw();
+
+	float max_height = 0.0f;
+	for (int y = 0; y <= grid; y++) {
+		for (int x = 0; x <= grid; x++) {
+			const float height = Math::sin(x * 0.5f + p_index) * Math::cos(y * 0.5f);
+			max_height = MAX(max_height, Math::abs(height));
+			w += encode_float(x, w);
+			w += encode_float(height, w);
+			w += encode_float(y, w);
+		}
+	}
+	for (int y = 0; y < grid; y++) {
+		for (int x = 0; x < grid; x++) {
+			const int a = y * (grid + 1) + x;
+			const int b = a + 1;
+			const int c = a + grid + 1;
+			const int d = c + 1;
+			for (int index : { a, c, b, b, c, d }) {
+				w += encode_uint16(index, w);
+			}
+		}
+	}
+
+	Dictionary asset;
+	asset["version"] = "2.0";
+
+	Dictionary gltf_buffer;
+	gltf_buffer["byteLength"] = buffer.size();
+	gltf_buffer["uri"] = "data:application/octet-stream;base64," + CryptoCore::b64_encode_str(buffer.ptr(), buffer.size());
+
+	Dictionary positions_view;
+	positions_view["buffer"] = 0;
+	positions_view["byteOffset"] = 0;
+	positions_view["byteLength"] = positions_size;
+	positions_view["target"] = 34962; // ARRAY_BUFFER
+
+	Dictionary indices_view;
+	indices_view["buffer"] = 0;
+	indices_view["byteOffset"] = positions_size;
+	indices_view["byteLength"] = indices_size;
+	indices_view["target"] = 34963; // ELEMENT_ARRAY_BUFFER
+
+	Dictionary positions_accessor;
+	positions_accessor["bufferView"] = 0;
+	positions_accessor["componentType"] = 5126; // FLOAT
+	positions_accessor["count"] = vertex_count;
+	positions_accessor["type"] = "VEC3";
+	positions_accessor["min"] = Array({ 0, -max_height, 0 });
+	positions_accessor["max"] = Array({ grid, max_height, grid });
+
+	Dictionary indices_accessor;
+	indices_accessor["bufferView"] = 1;
+	indices_accessor["componentType"] = 5123; // UNSIGNED_SHORT
+	indices_accessor["count"] = index_count;
+	indices_accessor["type"] = "SCALAR";
+
+	Dictionary attributes;
+	attributes["POSITION"] = 0;
+	Dictionary primitive;
+	primitive["attributes"] = attributes;
+	primitive["indices"] = 1;
+	Dictionary mesh;
+	mesh["primitives"] = Array({ primitive });
+
+	// A root node with a few instances of the mesh.
+	const int instance_count = 8;
+	Array nodes;
+	Array children;
+	for (int i = 0; i < instance_count; i++) {
+		children.push_back(i + 1);
+	}
+	Dictionary root;
+	root["name"] = vformat("Scene%d", p_index);
+	root["children"] = children;
+	nodes.push_back(root);
+	for (int i = 0; i < instance_count; i++) {
+		Dictionary node;
+		node["name"] = vformat("Mesh%d", i);
+		node["mesh"] = 0;
+		node["translation"] = Array({ i * grid, 0, 0 });
+		nodes.push_back(node);
+	}
+
+	Dictionary scene;
+	scene["nodes"] = Array({ 0 });
+
+	Dictionary gltf;
+	gltf["asset"] = asset;
+	gltf["buffers"] = Array({ gltf_buffer });
+	gltf["bufferViews"] = Array({ positions_view, indices_view });
+	gltf["accessors"] = Array({ positions_accessor, indices_accessor });
+	gltf["meshes"] = Array({ mesh });
+	gltf["nodes"] = nodes;
+	gltf["scenes"] = Array({ scene });
+	gltf["scene"] = 0;
+
+	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::WRITE);
+	ERR_FAIL_COND_V_MSG(f.is_null(), ERR_CANT_CREATE, vformat("Cannot create file '%s'.", p_path));
+	f->store_string(JSON::stringify(gltf, "\t", false));
+	return OK;
+}
+
+Error EditorImportBenchmark::_save_script(const String &p_path, int p_index) {
+	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::WRITE);
+	ERR_FAIL_COND_V_MSG(f.is_null(), ERR_CANT_CREATE, vformat("Cannot create file '%s'.", p_path));
+
+	f->store_line("extends Node3D");
+	f->store_line("");
+	f->store_line(vformat("@export var speed := %d.0", p_index % 10 + 1));
+	f->store_line("var _time := 0.0");
+	f->store_line("");
+	f->store_line("");
+	f->store_line("func _process(delta: float) -> void:");
+	f->store_line("\t_time += delta * speed");
+	f->store_line("\trotation.y = sin(_time)");
+
+	for (int i = 0; i < 10; i++) {
+		f->store_line("");
+		f->store_line("");
+		f->store_line(vformat("func compute_%d(values: PackedInt32Array) -> int:", i));
+		f->store_line(vformat("\tvar total := %d", p_index));
+		f->store_line("\tfor value in values:");
+		f->store_line(vformat("\t\tif value %% %d == 0:", i + 2));
+		f->store_line("\t\t\ttotal += value");
+		f->store_line("\t\telse:");
+		f->store_line(vformat("\t\t\ttotal -= value * %d", i));
+		f->store_line("\treturn total");
+	}
+	return OK;
+}
+
+Error EditorImportBenchmark::_save_text_scene(const String &p_path, int p_index, const String &p_texture, const String &p_mesh, const String &p_script) {
+	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::WRITE);
+	ERR_FAIL_COND_V_MSG(f.is_null(), ERR_CANT_CREATE, vformat("Cannot create file '%s'.", p_path));
+
+	f->store_line("[gd_scene format=3]");
+	f->store_line("");
+	f->store_line(vformat("[ext_resource type=\"Script\" path=\"%s\" id=\"1\"]", p_script));
+	f->store_line(vformat("[ext_resource type=\"Texture2D\" path=\"%s\" id=\"2\"]", p_texture));
+	f->store_line(vformat("[ext_resource type=\"Mesh\" path=\"%s\" id=\"3\"]", p_mesh));
+	f->store_line("");
+	f->store_line(vformat("[node name=\"Scene%d\" type=\"Node3D\"]", p_index));
+	f->store_line("script = ExtResource(\"1\")");
+	f->store_line("");
+	f->store_line("[node name=\"Mesh\" type=\"MeshInstance3D\" parent=\".\"]");
+	f->store_line("mesh = ExtResource(\"3\")");
+	f->store_line("");
+	f->store_line("[node name=\"Sprite\" type=\"Sprite3D\" parent=\".\"]");
+	f->store_line("texture = ExtResource(\"2\")");
+	return OK;
+}
+
+Error EditorImportBenchmark::create_temp_project() {
+	ERR_FAIL_COND_V(!temp_project_dir.is_empty(), ERR_ALREADY_IN_USE);
+
+	const String dir = OS::get_singleton()->get_cache_path().path_join(vformat("godot_import_benchmark_%d", OS::get_singleton()->get_process_id()));
+	{
+		// Left behind by a run that didn't finish.
+		Ref<DirAccess> da = DirAccess::open(dir);
+		if (da.is_valid()) {
+			Error err = da->erase_contents_recursive();
+			ERR_FAIL_COND_V_MSG(err != OK, err, vformat("Cannot clear the import benchmark project '%s'.", dir));
+		}
+	}
+	Error err = DirAccess::make_dir_recursive_absolute(dir);
+	ERR_FAIL_COND_V_MSG(err != OK, err, vformat("Cannot create the import benchmark project '%s'.", dir));
+	temp_project_dir = dir;
+
+	Ref<FileAccess> f = FileAccess::open(dir.path_join("project.godot"), FileAccess::WRITE);
+	ERR_FAIL_COND_V_MSG(f.is_null(), ERR_CANT_CREATE, vformat("Cannot create the import benchmark project '%s'.", dir));
+	f->store_line("config_version=5");
+	f->store_line("");
+	f->store_line("[application]");
+	f->store_line("");
+	f->store_line("config/name=\"Import Benchmark\"");
+	f.unref();
+
+	return OS::get_singleton()->set_cwd(dir);
+}
+
+void EditorImportBenchmark::remove_temp_project() {
+	if (temp_project_dir.is_empty()) {
+		return;
+	}
+
+	Ref<DirAccess> da = DirAccess::open(temp_project_dir);
+	if (da.is_valid() && da->erase_contents_recursive() == OK) {
+		DirAccess::remove_absolute(temp_project_dir);
+	} else {
+		WARN_PRINT(vformat("Cannot remove the import benchmark project '%s'.", temp_project_dir));
+	}
+	temp_project_dir = String();
+}
+
+Error EditorImportBenchmark::generate_project(int p_size) {
+	ERR_FAIL_COND_V(p_size <= 0, ERR_INVALID_PARAMETER);
+
+	const String dir = get_project_dir();
+	Error err = DirAccess::make_dir_recursive_absolute(dir);
+	ERR_FAIL_COND_V_MSG(err != OK, err, vformat("Cannot create the import benchmark directory '%s'.", dir));
+
+	for (int i = 0; i < p_size; i++) {
+		const String texture = dir.path_join(vformat("texture_%d.png", i));
+		const String mesh = dir.path_join(vformat("mesh_%d.obj", i));
+		const String script = dir.path_join(vformat("script_%d.gd", i));
+
+		err = _save_texture(texture, i);
+		ERR_FAIL_COND_V(err != OK, err);
+		err = _save_obj_mesh(mesh, i);
+		ERR_FAIL_COND_V(err != OK, err);
+		err = _save_gltf_scene(dir.path_join(vformat("scene_%d.gltf", i)), i);
+		ERR_FAIL_COND_V(err != OK, err);
+		err = _save_script(script, i);
+		ERR_FAIL_COND_V(err != OK, err);
+		err = _save_text_scene(dir.path_join(vformat("scene_%d.tscn", i)), i, texture, mesh, script);
+		ERR_FAIL_COND_V(err != OK, err);
+	}
+
+	MutexLock lock(mutex);
+	importer_stats.clear();
+	project_size = p_size;
+	start_usec = OS::get_singleton()->get_ticks_usec();
+	enabled = true;
+	return OK;
+}
+
+void EditorImportBenchmark::record_import(const String &p_importer, uint64_t p_time_usec, uint64_t p_bytes_written) {
+	MutexLock lock(mutex);
+	ImporterStats &stats = importer_stats[p_importer];
+	stats.files++;
+	stats.time_usec += p_time_usec;
+	stats.bytes_written += p_bytes_written;
+}
+
+Error EditorImportBenchmark::save_report(const String &p_path) {
+	MutexLock lock(mutex);
+	ERR_FAIL_COND_V(!enabled, ERR_UNCONFIGURED);
+
+	Dictionary importers;
+	uint64_t total_files = 0;
+	uint64_t total_bytes_written = 0;
+	for (const KeyValue<String, ImporterStats> &E : importer_stats) {
+		Dictionary stats;
+		stats["files"] = E.value.files;
+		stats["time_usec"] = E.value.time_usec;
+		stats["bytes_written"] = E.value.bytes_written;
+		importers[E.key] = stats;
+
+		total_files += E.value.files;
+		total_bytes_written += E.value.bytes_written;
+	}
+
+	Dictionary report;
+	report["version"] = GODOT_VERSION_FULL_BUILD;
+	report["project_size"] = project_size;
+	// Time spent in each importer is summed over all the threads, this is the time taken by the editor to start and import everything.
+	report["wall_time_usec"] = OS::get_singleton()->get_ticks_usec() - start_usec;
+	report["peak_memory_bytes"] = OS::get_singleton()->get_static_memory_peak_usage();
+	report["files"] = total_files;
+	report["bytes_written"] = total_bytes_written;
+	report["importers"] = importers;
+
+	enabled = false;
+	importer_stats.clear();
+
+	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::WRITE);
+	ERR_FAIL_COND_V_MSG(f.is_null(), ERR_CANT_CREATE, vformat("Cannot write the import benchmark report to '%s'.", p_path));
+	f->store_string(JSON::stringify(report, "\t", false) + "\n");
+	return OK;
+}
@@ -0,0 +1,77 @@
+/**************************************************************************/
+/*  editor_import_benchmark.h                                             */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/os/mutex.h"
+#include "core/string/ustring.h"
+#include "core/templates/hash_map.h"
+
+// Generates a synthetic project and measures how long importing it takes.
+// Used by the `--import-benchmark` command line option.
+class EditorImportBenchmark {
+	struct ImporterStats {
+		uint32_t files = 0;
+		uint64_t time_usec = 0;
+		uint64_t bytes_written = 0;
+	};
+
+	static inline bool enabled = false;
+	static inline int project_size = 0;
+	static inline uint64_t start_usec = 0;
+	static inline BinaryMutex mutex;
+	static inline HashMap<String, ImporterStats> importer_stats;
+	static inline String temp_project_dir;
+
+	static Error _save_texture(const String &p_path, int p_index);
+	static Error _save_obj_mesh(const String &p_path, int p_index);
+	static Error _save_gltf_scene(const String &p_path, int p_index);
+	static Error _save_script(const String &p_path, int p_index);
+	static Error _save_text_scene(const String &p_path, int p_index, const String &p_texture, const String &p_mesh, const String &p_script);
+
+public:
+	static constexpr int DEFAULT_PROJECT_SIZE = 100;
+
+	static String get_project_dir() { return "res://import_benchmark"; }
+
+	// Creates an empty project in a temporary directory and makes it the current directory,
+	// so that the benchmark doesn't touch the project it was started from.
+	static Error create_temp_project();
+	// Removes the temporary project, once the editor is done with it.
+	static void remove_temp_project();
+
+	// Fills the benchmark directory with `p_size` files of each kind, and starts recording imports.
+	static Error generate_project(int p_size);
+
+	static bool is_enabled() { return enabled; }
+	static void record_import(const String &p_importer, uint64_t p_time_usec, uint64_t p_bytes_written);
+
+	static Error save_report(const String &p_path);
+};
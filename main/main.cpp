@@ -123,6 +123,7 @@
 #include "editor/doc/editor_help.h"
 #include "editor/editor_node.h"
 #include "editor/file_system/editor_file_system.h"
+#include "editor/file_system/editor_import_benchmark.h"
 #include "editor/file_system/editor_paths.h"
 #include "editor/gui/progress_dialog.h"
 #include "editor/project_manager/project_manager.h"
@@ -228,6 +229,8 @@ static bool auto_build_solutions = false;
 static String debug_server_uri;
 static bool wait_for_import = false;
 static bool restore_editor_window_layout = true;
+static String import_benchmark_file;
+static int import_benchmark_size = EditorImportBenchmark::DEFAULT_PROJECT_SIZE;
 #ifndef DISABLE_DEPRECATED
 static int converter_max_kb_file = 4 * 1024; // 4MB
 static int converter_max_line_length = 100000;
@@ -698,6 +701,9 @@ void Main::print_help(const char *p_binary) {
 #endif // defined(OVERRIDE_PATH_ENABLED)
 #ifdef TOOLS_ENABLED
 	print_help_option("--import", "Starts the editor, waits for any resources to be imported, and then quits.\n", CLI_OPTION_AVAILABILITY_EDITOR);
+	print_help_option("--import-benchmark <path>", "Generates a synthetic set of textures, meshes, scenes and scripts, imports it like --import, and saves the time and memory used and the bytes written by each importer to the given file in JSON format.\n", CLI_OPTION_AVAILABILITY_EDITOR);
+	print_help_option("", "The files are generated in a temporary project, which is removed once done. The current project isn't opened or modified.\n");
+	print_help_option("--import-benchmark-size <count>", "Number of files of each kind generated by --import-benchmark (default: 100).\n", CLI_OPTION_AVAILABILITY_EDITOR);
 	print_help_option("--export-release <preset> <path>", "Export the project in release mode using the given preset and output path. The preset name should match one defined in \"export_presets.cfg\".\n", CLI_OPTION_AVAILABILITY_EDITOR);
 	print_help_option("", "<path> should be absolute or relative to the project directory, and include the filename for the binary (e.g. \"builds/game.exe\").\n");
 	print_help_option("", "The target directory must exist.\n");
@@ -1680,6 +1686,26 @@ Error Main::setup(const char *execpath, int argc, char *argv[], bool p_second_ph
 			cmdline_tool = true;
 			wait_for_import = true;
 			quit_after = 1;
+		} else if (arg == "--import-benchmark") {
+			if (N) {
+				editor = true;
+				cmdline_tool = true;
+				wait_for_import = true;
+				quit_after = 1;
+				import_benchmark_file = N->get();
+				N = N->next();
+			} else {
+				OS::get_singleton()->print("Missing <path> argument for --import-benchmark <path>, aborting.\n");
+				goto error;
+			}
+		} else if (arg == "--import-benchmark-size") {
+			if (N) {
+				import_benchmark_size = N->get().to_int();
+				N = N->next();
+			} else {
+				OS::get_singleton()->print("Missing <count> argument for --import-benchmark-size <count>, aborting.\n");
+				goto error;
+			}
 		} else if (arg == "--export-release" || arg == "--export-debug" ||
 				arg == "--export-pack" || arg == "--export-patch") { // Export project
 			// Actually handling is done in start().
@@ -2076,6 +2102,18 @@ Error Main::setup(const char *execpath, int argc, char *argv[], bool p_second_ph
 				"Error: Command line arguments implied opening both editor and project manager, which is not possible. Aborting.\n");
 		goto error;
 	}
+
+	if (!import_benchmark_file.is_empty()) {
+		// The report path is relative to the directory the benchmark was started from.
+		if (import_benchmark_file.is_relative_path()) {
+			import_benchmark_file = OS::get_singleton()->get_cwd().path_join(import_benchmark_file);
+		}
+		if (EditorImportBenchmark::create_temp_project() != OK) {
+			OS::get_singleton()->print("Error: Can't create the import benchmark project. Aborting.\n");
+			goto error;
+		}
+		project_path = ".";
+	}
 #endif
 
 #if defined(DEBUG_ENABLED) || defined(TOOLS_ENABLED)
@@ -4603,6 +4641,12 @@ int Main::start() {
 				translation_server->get_editor_domain()->set_pseudolocalization_enabled(true);
 			}
 
+			if (!import_benchmark_file.is_empty()) {
+				// Generate the files before the editor starts scanning the project.
+				Error err = EditorImportBenchmark::generate_project(import_benchmark_size);
+				ERR_FAIL_COND_V_MSG(err != OK, EXIT_FAILURE, "Error: Can't generate the import benchmark project.");
+			}
+
 			editor_node = memnew(EditorNode);
 			sml->get_root()->add_child(editor_node);
 
@@ -5161,6 +5205,9 @@ bool Main::iteration() {
 	if (wait_for_import && EditorFileSystem::get_singleton() && EditorFileSystem::get_singleton()->doing_first_scan()) {
 		exit = false;
 	}
+	if (exit && EditorImportBenchmark::is_enabled()) {
+		EditorImportBenchmark::save_report(import_benchmark_file);
+	}
 #endif
 
 	if (fixed_fps != -1) {
@@ -5282,6 +5329,7 @@ void Main::cleanup(bool p_force) {
 	uninitialize_modules(MODULE_INITIALIZATION_LEVEL_EDITOR);
 	unregister_editor_types();
 
+	EditorImportBenchmark::remove_temp_project();
 #endif
 
 	ImageLoader::cleanup();
@@ -3,6 +3,19 @@ def can_build(env, platform):
     return True
 
 
+def get_opts(platform):
+    from SCons.Variables import PathVariable
+
+    return [
+        PathVariable(
+            "gdscript_native_code",
+            "Path to a C++ file generated by the GDScript native code export, compiled into the build",
+            "",
+            PathVariable.PathAccept,
+        ),
+    ]
+
+
 def configure(env):
     pass
 
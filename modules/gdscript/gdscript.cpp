@@ -41,6 +41,7 @@
 #include "core/io/resource_loader.h"
 #include "core/object/callable_mp.h"
 #include "core/object/class_db.h"
+#include "core/os/os.h"
 #include "core/templates/rb_set.h"
 
 #ifdef TOOLS_ENABLED
@@ -1441,6 +1442,8 @@ void GDScript::clear() {
 		}
 	}
 
+	compile_id = 0;
+
 	for (const KeyValue<StringName, GDScriptFunction *> &E : member_functions) {
 		functions_to_clear.insert(E.value);
 	}
@@ -2872,6 +2875,8 @@ GDScriptLanguage::GDScriptLanguage() {
 	_debug_max_call_stack = GLOBAL_DEF_RST(PropertyInfo(Variant::INT, "debug/settings/gdscript/max_call_stack", PROPERTY_HINT_RANGE, "512," + itos(GDScriptFunction::MAX_CALL_DEPTH - 1) + ",1"), 1024);
 	track_call_stack = GLOBAL_DEF_RST("debug/settings/gdscript/always_track_call_stacks", false);
 	track_locals = GLOBAL_DEF_RST("debug/settings/gdscript/always_track_local_variables", false);
+	// Set by the "gdscript/optimize_bytecode" export option, see GDScriptOptimizer.
+	optimize_bytecode = OS::get_singleton()->has_feature("gdscript_optimized");
 
 #ifdef DEBUG_ENABLED
 	track_call_stack = true;
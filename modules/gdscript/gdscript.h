@@ -61,6 +61,10 @@ class GDScript : public Script {
 	bool reloading = false;
 	bool _is_abstract = false;
 
+	// Changes every time the class is compiled, zero while it has no code. Used to validate the inline caches of the VM.
+	uint64_t compile_id = 0;
+	static inline SafeNumeric<uint64_t> last_compile_id{ 0 };
+
 	struct MemberInfo {
 		int index = 0;
 		StringName setter;
@@ -429,6 +433,7 @@ class GDScriptLanguage : public ScriptLanguage {
 
 	bool track_call_stack = false;
 	bool track_locals = false;
+	bool optimize_bytecode = false;
 
 	static CallLevel *_get_stack_level(uint32_t p_level);
 
@@ -561,6 +566,8 @@ public:
 
 	_FORCE_INLINE_ bool should_track_call_stack() const { return track_call_stack; }
 	_FORCE_INLINE_ bool should_track_locals() const { return track_locals; }
+	_FORCE_INLINE_ bool should_optimize_bytecode() const { return optimize_bytecode; }
+	void set_optimize_bytecode(bool p_enabled) { optimize_bytecode = p_enabled; }
 	_FORCE_INLINE_ int get_global_array_size() const { return global_array.size(); }
 	_FORCE_INLINE_ Variant *get_global_array() { return _global_array; }
 	_FORCE_INLINE_ const HashMap<StringName, int> &get_global_map() const { return globals; }
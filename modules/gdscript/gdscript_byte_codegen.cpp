@@ -383,6 +383,15 @@ GDScriptFunction *GDScriptByteCodeGenerator::write_end() {
 		function->_methods_count = 0;
 	}
 
+	if (inline_cache_count) {
+		function->inline_caches.resize(inline_cache_count);
+		function->_inline_caches_ptr = function->inline_caches.ptr();
+		function->_inline_caches_count = inline_cache_count;
+	} else {
+		function->_inline_caches_ptr = nullptr;
+		function->_inline_caches_count = 0;
+	}
+
 	if (lambdas_map.size()) {
 		function->lambdas.resize(lambdas_map.size());
 		function->_lambdas_ptr = function->lambdas.ptrw();
@@ -584,6 +593,164 @@ void GDScriptByteCodeGenerator::write_unary_operator(const Address &p_target, Va
 	}
 }
 
+static GDScriptFunction::Opcode get_typed_operator_opcode(Variant::Operator p_operator, Variant::Type p_left_type, Variant::Type p_right_type) {
+	if (p_left_type != p_right_type) {
+		if (p_operator == Variant::OP_MULTIPLY && p_right_type == Variant::FLOAT) {
+			if (p_left_type == Variant::VECTOR2) {
+				return GDScriptFunction::OPCODE_OPERATOR_MULTIPLY_VECTOR2_FLOAT;
+			}
+			if (p_left_type == Variant::VECTOR3) {
+				return GDScriptFunction::OPCODE_OPERATOR_MULTIPLY_VECTOR3_FLOAT;
+			}
+		}
+		return GDScriptFunction::OPCODE_END;
+	}
+
+	// Int division and modulo are left out, they need the division by zero check.
+	switch (p_left_type) {
+		case Variant::INT: {
+			switch (p_operator) {
+				case Variant::OP_ADD:
+					return GDScriptFunction::OPCODE_OPERATOR_ADD_INT;
+				case Variant::OP_SUBTRACT:
+					return GDScriptFunction::OPCODE_OPERATOR_SUBTRACT_INT;
+				case Variant::OP_MULTIPLY:
+					return GDScriptFunction::OPCODE_OPERATOR_MULTIPLY_INT;
+				case Variant::OP_EQUAL:
+					return GDScriptFunction::OPCODE_OPERATOR_EQUAL_INT;
+				case Variant::OP_NOT_EQUAL:
+					return GDScriptFunction::OPCODE_OPERATOR_NOT_EQUAL_INT;
+				case Variant::OP_LESS:
+					return GDScriptFunction::OPCODE_OPERATOR_LESS_INT;
+				case Variant::OP_LESS_EQUAL:
+					return GDScriptFunction::OPCODE_OPERATOR_LESS_EQUAL_INT;
+				case Variant::OP_GREATER:
+					return GDScriptFunction::OPCODE_OPERATOR_GREATER_INT;
+				case Variant::OP_GREATER_EQUAL:
+					return GDScriptFunction::OPCODE_OPERATOR_GREATER_EQUAL_INT;
+				default:
+					return GDScriptFunction::OPCODE_END;
+			}
+		}
+		case Variant::FLOAT: {
+			switch (p_operator) {
+				case Variant::OP_ADD:
+					return GDScriptFunction::OPCODE_OPERATOR_ADD_FLOAT;
+				case Variant::OP_SUBTRACT:
+					return GDScriptFunction::OPCODE_OPERATOR_SUBTRACT_FLOAT;
+				case Variant::OP_MULTIPLY:
+					return GDScriptFunction::OPCODE_OPERATOR_MULTIPLY_FLOAT;
+				case Variant::OP_DIVIDE:
+					return GDScriptFunction::OPCODE_OPERATOR_DIVIDE_FLOAT;
+				case Variant::OP_EQUAL:
+					return GDScriptFunction::OPCODE_OPERATOR_EQUAL_FLOAT;
+				case Variant::OP_NOT_EQUAL:
+					return GDScriptFunction::OPCODE_OPERATOR_NOT_EQUAL_FLOAT;
+				case Variant::OP_LESS:
+					return GDScriptFunction::OPCODE_OPERATOR_LESS_FLOAT;
+				case Variant::OP_LESS_EQUAL:
+					return GDScriptFunction::OPCODE_OPERATOR_LESS_EQUAL_FLOAT;
+				case Variant::OP_GREATER:
+					return GDScriptFunction::OPCODE_OPERATOR_GREATER_FLOAT;
+				case Variant::OP_GREATER_EQUAL:
+					return GDScriptFunction::OPCODE_OPERATOR_GREATER_EQUAL_FLOAT;
+				default:
+					return GDScriptFunction::OPCODE_END;
+			}
+		}
+		case Variant::VECTOR2: {
+			switch (p_operator) {
+				case Variant::OP_ADD:
+					return GDScriptFunction::OPCODE_OPERATOR_ADD_VECTOR2;
+				case Variant::OP_SUBTRACT:
+					return GDScriptFunction::OPCODE_OPERATOR_SUBTRACT_VECTOR2;
+				case Variant::OP_MULTIPLY:
+					return GDScriptFunction::OPCODE_OPERATOR_MULTIPLY_VECTOR2;
+				case Variant::OP_DIVIDE:
+					return GDScriptFunction::OPCODE_OPERATOR_DIVIDE_VECTOR2;
+				default:
+					return GDScriptFunction::OPCODE_END;
+			}
+		}
+		case Variant::VECTOR3: {
+			switch (p_operator) {
+				case Variant::OP_ADD:
+					return GDScriptFunction::OPCODE_OPERATOR_ADD_VECTOR3;
+				case Variant::OP_SUBTRACT:
+					return GDScriptFunction::OPCODE_OPERATOR_SUBTRACT_VECTOR3;
+				case Variant::OP_MULTIPLY:
+					return GDScriptFunction::OPCODE_OPERATOR_MULTIPLY_VECTOR3;
+				case Variant::OP_DIVIDE:
+					return GDScriptFunction::OPCODE_OPERATOR_DIVIDE_VECTOR3;
+				default:
+					return GDScriptFunction::OPCODE_END;
+			}
+		}
+		default:
+			return GDScriptFunction::OPCODE_END;
+	}
+}
+
+bool GDScriptByteCodeGenerator::is_int_constant_one(const Address &p_address) const {
+	if (p_address.mode != Address::CONSTANT) {
+		return false;
+	}
+	for (const KeyValue<Variant, int> &E : constant_map) {
+		if (E.value == int(p_address.address)) {
+			return E.key.get_type() == Variant::INT && int64_t(E.key) == 1;
+		}
+	}
+	return false;
+}
+
+// If the condition is the result of the typed comparison just written, turns it into a fused compare and jump.
+// Returns the position of the jump destination to patch, or -1 if nothing was fused.
+int GDScriptByteCodeGenerator::write_fused_jump_if_not(const Address &p_condition) {
+	if (typed_operator_pos < 0 || typed_operator_pos + 4 != opcodes.size() || p_condition.mode != Address::TEMPORARY || p_condition.address != typed_operator_temporary) {
+		return -1;
+	}
+	const int opcode = opcodes[typed_operator_pos];
+	if (opcode < GDScriptFunction::OPCODE_OPERATOR_EQUAL_INT || opcode > GDScriptFunction::OPCODE_OPERATOR_GREATER_EQUAL_FLOAT) {
+		return -1;
+	}
+
+	// Comparison opcodes and fused jumps are declared in the same order.
+	// The result operand becomes the jump destination, so it must not be patched with the temporary's address.
+	temporaries.write[typed_operator_temporary].bytecode_indices.erase(typed_operator_pos + 3);
+	opcodes.write[typed_operator_pos] = GDScriptFunction::OPCODE_JUMP_IF_NOT_EQUAL_INT + (opcode - GDScriptFunction::OPCODE_OPERATOR_EQUAL_INT);
+	typed_operator_pos = -1;
+	typed_operator_temporary = -1;
+	return opcodes.size() - 1;
+}
+
+// Makes a compound assignment to a typed local, like `i += 1`, operate on the local directly instead of going through a temporary.
+bool GDScriptByteCodeGenerator::write_typed_operator_in_place(const Address &p_target, const Address &p_source) {
+	if (typed_operator_pos < 0 || typed_operator_pos + 4 != opcodes.size() || p_source.mode != Address::TEMPORARY || p_source.address != typed_operator_temporary) {
+		return false;
+	}
+	if ((p_target.mode != Address::LOCAL_VARIABLE && p_target.mode != Address::FUNCTION_PARAMETER) || !HAS_BUILTIN_TYPE(p_target) || opcodes[typed_operator_pos + 1] != address_of(p_target)) {
+		return false;
+	}
+	const int opcode = opcodes[typed_operator_pos];
+	if (opcode < GDScriptFunction::OPCODE_OPERATOR_ADD_INT || opcode > GDScriptFunction::OPCODE_OPERATOR_MULTIPLY_VECTOR3_FLOAT) {
+		return false;
+	}
+	// The target is the left operand, so it already holds the result type.
+
+	// The temporary is no longer written.
+	temporaries.write[typed_operator_temporary].bytecode_indices.erase(typed_operator_pos + 3);
+	if (typed_operator_step != 0) {
+		opcodes.resize(typed_operator_pos);
+		append_opcode(typed_operator_step > 0 ? GDScriptFunction::OPCODE_INCREMENT_INT : GDScriptFunction::OPCODE_DECREMENT_INT);
+		append(p_target);
+	} else {
+		opcodes.write[typed_operator_pos + 3] = address_of(p_target);
+	}
+	typed_operator_pos = -1;
+	typed_operator_temporary = -1;
+	return true;
+}
+
 void GDScriptByteCodeGenerator::write_binary_operator(const Address &p_target, Variant::Operator p_operator, const Address &p_left_operand, const Address &p_right_operand) {
 	bool valid = HAS_BUILTIN_TYPE(p_left_operand) && HAS_BUILTIN_TYPE(p_right_operand);
 
@@ -613,6 +780,21 @@ void GDScriptByteCodeGenerator::write_binary_operator(const Address &p_target, V
 			}
 		}
 
+		GDScriptFunction::Opcode typed_opcode = get_typed_operator_opcode(p_operator, p_left_operand.type.builtin_type, p_right_operand.type.builtin_type);
+		if (typed_opcode != GDScriptFunction::OPCODE_END) {
+			typed_operator_pos = opcodes.size();
+			typed_operator_temporary = p_target.mode == Address::TEMPORARY ? p_target.address : -1;
+			typed_operator_step = 0;
+			if ((typed_opcode == GDScriptFunction::OPCODE_OPERATOR_ADD_INT || typed_opcode == GDScriptFunction::OPCODE_OPERATOR_SUBTRACT_INT) && is_int_constant_one(p_right_operand)) {
+				typed_operator_step = typed_opcode == GDScriptFunction::OPCODE_OPERATOR_ADD_INT ? 1 : -1;
+			}
+			append_opcode(typed_opcode);
+			append(p_left_operand);
+			append(p_right_operand);
+			append(p_target);
+			return;
+		}
+
 		// Gather specific operator.
 		Variant::ValidatedOperatorEvaluator op_func = Variant::get_validated_operator_evaluator(p_operator, p_left_operand.type.builtin_type, p_right_operand.type.builtin_type);
 
@@ -694,17 +876,25 @@ void GDScriptByteCodeGenerator::write_type_test(const Address &p_target, const A
 }
 
 void GDScriptByteCodeGenerator::write_and_left_operand(const Address &p_left_operand) {
-	append_opcode(GDScriptFunction::OPCODE_JUMP_IF_NOT);
-	append(p_left_operand);
-	logic_op_jump_pos1.push_back(opcodes.size());
-	append(0); // Jump target, will be patched.
+	int jump_pos = write_fused_jump_if_not(p_left_operand);
+	if (jump_pos < 0) {
+		append_opcode(GDScriptFunction::OPCODE_JUMP_IF_NOT);
+		append(p_left_operand);
+		jump_pos = opcodes.size();
+		append(0); // Jump target, will be patched.
+	}
+	logic_op_jump_pos1.push_back(jump_pos);
 }
 
 void GDScriptByteCodeGenerator::write_and_right_operand(const Address &p_right_operand) {
-	append_opcode(GDScriptFunction::OPCODE_JUMP_IF_NOT);
-	append(p_right_operand);
-	logic_op_jump_pos2.push_back(opcodes.size());
-	append(0); // Jump target, will be patched.
+	int jump_pos = write_fused_jump_if_not(p_right_operand);
+	if (jump_pos < 0) {
+		append_opcode(GDScriptFunction::OPCODE_JUMP_IF_NOT);
+		append(p_right_operand);
+		jump_pos = opcodes.size();
+		append(0); // Jump target, will be patched.
+	}
+	logic_op_jump_pos2.push_back(jump_pos);
 }
 
 void GDScriptByteCodeGenerator::write_end_and(const Address &p_target) {
@@ -758,10 +948,14 @@ void GDScriptByteCodeGenerator::write_start_ternary(const Address &p_target) {
 }
 
 void GDScriptByteCodeGenerator::write_ternary_condition(const Address &p_condition) {
-	append_opcode(GDScriptFunction::OPCODE_JUMP_IF_NOT);
-	append(p_condition);
-	ternary_jump_fail_pos.push_back(opcodes.size());
-	append(0); // Jump target, will be patched.
+	int jump_pos = write_fused_jump_if_not(p_condition);
+	if (jump_pos < 0) {
+		append_opcode(GDScriptFunction::OPCODE_JUMP_IF_NOT);
+		append(p_condition);
+		jump_pos = opcodes.size();
+		append(0); // Jump target, will be patched.
+	}
+	ternary_jump_fail_pos.push_back(jump_pos);
 }
 
 void GDScriptByteCodeGenerator::write_ternary_true_expr(const Address &p_expr) {
@@ -862,6 +1056,7 @@ void GDScriptByteCodeGenerator::write_set_named(const Address &p_target, const S
 	append(p_target);
 	append(p_source);
 	append(p_name);
+	append(add_inline_cache());
 }
 
 void GDScriptByteCodeGenerator::write_get_named(const Address &p_target, const StringName &p_name, const Address &p_source) {
@@ -880,6 +1075,7 @@ void GDScriptByteCodeGenerator::write_get_named(const Address &p_target, const S
 	append(p_source);
 	append(p_target);
 	append(p_name);
+	append(add_inline_cache());
 }
 
 void GDScriptByteCodeGenerator::write_set_member(const Address &p_value, const StringName &p_name) {
@@ -969,6 +1165,10 @@ void GDScriptByteCodeGenerator::write_assign_with_conversion(const Address &p_ta
 }
 
 void GDScriptByteCodeGenerator::write_assign(const Address &p_target, const Address &p_source) {
+	if (write_typed_operator_in_place(p_target, p_source)) {
+		return;
+	}
+
 	if (p_target.type.kind == GDScriptDataType::BUILTIN && p_target.type.builtin_type == Variant::ARRAY && p_target.type.has_container_element_type(0)) {
 		const GDScriptDataType &element_type = p_target.type.get_container_element_type(0);
 		append_opcode(GDScriptFunction::OPCODE_ASSIGN_TYPED_ARRAY);
@@ -1093,6 +1293,7 @@ void GDScriptByteCodeGenerator::write_call(const Address &p_target, const Addres
 	append(ct.target);
 	append(p_arguments.size());
 	append(p_function_name);
+	append(add_inline_cache());
 	ct.cleanup();
 }
 
@@ -1118,6 +1319,7 @@ void GDScriptByteCodeGenerator::write_call_async(const Address &p_target, const
 	append(ct.target);
 	append(p_arguments.size());
 	append(p_function_name);
+	append(add_inline_cache());
 	ct.cleanup();
 }
 
@@ -1352,6 +1554,7 @@ void GDScriptByteCodeGenerator::write_call_self(const Address &p_target, const S
 	append(ct.target);
 	append(p_arguments.size());
 	append(p_function_name);
+	append(add_inline_cache());
 	ct.cleanup();
 }
 
@@ -1365,6 +1568,7 @@ void GDScriptByteCodeGenerator::write_call_self_async(const Address &p_target, c
 	append(ct.target);
 	append(p_arguments.size());
 	append(p_function_name);
+	append(add_inline_cache());
 	ct.cleanup();
 }
 
@@ -1378,6 +1582,7 @@ void GDScriptByteCodeGenerator::write_call_script_function(const Address &p_targ
 	append(ct.target);
 	append(p_arguments.size());
 	append(p_function_name);
+	append(add_inline_cache());
 	ct.cleanup();
 }
 
@@ -1512,10 +1717,14 @@ void GDScriptByteCodeGenerator::write_await(const Address &p_target, const Addre
 }
 
 void GDScriptByteCodeGenerator::write_if(const Address &p_condition) {
-	append_opcode(GDScriptFunction::OPCODE_JUMP_IF_NOT);
-	append(p_condition);
-	if_jmp_addrs.push_back(opcodes.size());
-	append(0); // Jump destination, will be patched.
+	int jump_pos = write_fused_jump_if_not(p_condition);
+	if (jump_pos < 0) {
+		append_opcode(GDScriptFunction::OPCODE_JUMP_IF_NOT);
+		append(p_condition);
+		jump_pos = opcodes.size();
+		append(0); // Jump destination, will be patched.
+	}
+	if_jmp_addrs.push_back(jump_pos);
 }
 
 void GDScriptByteCodeGenerator::write_else() {
@@ -1787,10 +1996,14 @@ void GDScriptByteCodeGenerator::start_while_condition() {
 
 void GDScriptByteCodeGenerator::write_while(const Address &p_condition) {
 	// Condition check.
-	append_opcode(GDScriptFunction::OPCODE_JUMP_IF_NOT);
-	append(p_condition);
-	while_jmp_addrs.push_back(opcodes.size());
-	append(0); // End of loop address, will be patched.
+	int jump_pos = write_fused_jump_if_not(p_condition);
+	if (jump_pos < 0) {
+		append_opcode(GDScriptFunction::OPCODE_JUMP_IF_NOT);
+		append(p_condition);
+		jump_pos = opcodes.size();
+		append(0); // End of loop address, will be patched.
+	}
+	while_jmp_addrs.push_back(jump_pos);
 }
 
 void GDScriptByteCodeGenerator::write_endwhile() {
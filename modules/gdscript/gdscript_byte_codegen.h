@@ -122,6 +122,7 @@ class GDScriptByteCodeGenerator : public GDScriptCodeGenerator {
 	RBMap<GDScriptUtilityFunctions::FunctionPtr, int> gds_utilities_map;
 	RBMap<MethodBind *, int> method_bind_map;
 	RBMap<GDScriptFunction *, int> lambdas_map;
+	int inline_cache_count = 0;
 
 #ifdef DEBUG_ENABLED
 	// Keep method and property names for pointer and validated operations.
@@ -156,6 +157,11 @@ class GDScriptByteCodeGenerator : public GDScriptCodeGenerator {
 	List<int> logic_op_jump_pos1;
 	List<int> logic_op_jump_pos2;
 
+	// Last typed operator instruction, so the instruction consuming its result can be fused with it.
+	int typed_operator_pos = -1;
+	int typed_operator_temporary = -1; // Temporary holding the result, if any.
+	int typed_operator_step = 0; // 1 or -1 if it adds or subtracts the integer constant 1.
+
 	List<Address> ternary_result;
 	List<int> ternary_jump_fail_pos;
 	List<int> ternary_jump_skip_pos;
@@ -353,7 +359,14 @@ class GDScriptByteCodeGenerator : public GDScriptCodeGenerator {
 		return pos;
 	}
 
+	int add_inline_cache() {
+		return inline_cache_count++;
+	}
+
 	CallTarget get_call_target(const Address &p_target, Variant::Type p_type = Variant::NIL);
+	bool is_int_constant_one(const Address &p_address) const;
+	int write_fused_jump_if_not(const Address &p_condition);
+	bool write_typed_operator_in_place(const Address &p_target, const Address &p_source);
 
 	int address_of(const Address &p_address) {
 		switch (p_address.mode) {
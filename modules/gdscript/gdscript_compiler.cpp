@@ -34,6 +34,8 @@
 #include "gdscript_analyzer.h"
 #include "gdscript_byte_codegen.h"
 #include "gdscript_cache.h"
+#include "gdscript_native_code.h"
+#include "gdscript_optimizer.h"
 #include "gdscript_utility_functions.h"
 
 #include "core/config/engine.h"
@@ -251,6 +253,73 @@ static bool _can_use_validate_call(const MethodBind *p_method, const Vector<GDSc
 	return true;
 }
 
+static bool _is_same_builtin_type(const GDScriptParser::DataType &p_a, const GDScriptParser::DataType &p_b) {
+	return p_a.is_hard_type() && p_b.is_hard_type() && p_a.kind == GDScriptParser::DataType::BUILTIN && p_b.kind == GDScriptParser::DataType::BUILTIN &&
+			p_a.builtin_type == p_b.builtin_type && !p_a.has_container_element_types() && !p_b.has_container_element_types();
+}
+
+static bool _is_inlinable_expression(const GDScriptParser::ExpressionNode *p_expression, int &r_budget) {
+	if (p_expression == nullptr || --r_budget < 0) {
+		return false;
+	}
+	if (p_expression->is_constant) {
+		return true;
+	}
+
+	switch (p_expression->type) {
+		case GDScriptParser::Node::IDENTIFIER:
+			return static_cast<const GDScriptParser::IdentifierNode *>(p_expression)->source == GDScriptParser::IdentifierNode::FUNCTION_PARAMETER;
+		case GDScriptParser::Node::BINARY_OPERATOR: {
+			const GDScriptParser::BinaryOpNode *binary_op = static_cast<const GDScriptParser::BinaryOpNode *>(p_expression);
+			return _is_inlinable_expression(binary_op->left_operand, r_budget) && _is_inlinable_expression(binary_op->right_operand, r_budget);
+		}
+		case GDScriptParser::Node::UNARY_OPERATOR:
+			return _is_inlinable_expression(static_cast<const GDScriptParser::UnaryOpNode *>(p_expression)->operand, r_budget);
+		case GDScriptParser::Node::TERNARY_OPERATOR: {
+			const GDScriptParser::TernaryOpNode *ternary_op = static_cast<const GDScriptParser::TernaryOpNode *>(p_expression);
+			return _is_inlinable_expression(ternary_op->condition, r_budget) && _is_inlinable_expression(ternary_op->true_expr, r_budget) && _is_inlinable_expression(ternary_op->false_expr, r_budget);
+		}
+		default:
+			return false;
+	}
+}
+
+// Returns the expression computed by a static function of the class that only returns an expression of its parameters,
+// or `nullptr` if the call can't be replaced by it.
+static const GDScriptParser::ExpressionNode *_get_inlinable_call(const GDScriptParser::ClassNode *p_class, const GDScriptParser::CallNode *p_call) {
+	if (p_class == nullptr || !p_call->is_static || !p_class->has_function(p_call->function_name)) {
+		return nullptr;
+	}
+
+	const GDScriptParser::FunctionNode *function = p_class->get_member(p_call->function_name).function;
+	if (!function->resolved_body || function->is_coroutine || function->is_vararg() || function->body == nullptr || function->body->statements.size() != 1) {
+		return nullptr;
+	}
+	if (function->parameters.size() != p_call->arguments.size()) {
+		return nullptr;
+	}
+	for (int i = 0; i < function->parameters.size(); i++) {
+		if (!_is_same_builtin_type(function->parameters[i]->get_datatype(), p_call->arguments[i]->get_datatype())) {
+			return nullptr;
+		}
+	}
+
+	const GDScriptParser::Node *statement = function->body->statements[0];
+	if (statement->type != GDScriptParser::Node::RETURN) {
+		return nullptr;
+	}
+	const GDScriptParser::ReturnNode *return_node = static_cast<const GDScriptParser::ReturnNode *>(statement);
+	if (return_node->return_value == nullptr || return_node->use_conversion || !_is_same_builtin_type(return_node->return_value->get_datatype(), function->get_datatype())) {
+		return nullptr;
+	}
+
+	int budget = 16;
+	if (!_is_inlinable_expression(return_node->return_value, budget)) {
+		return nullptr;
+	}
+	return return_node->return_value;
+}
+
 GDScriptCodeGenerator::Address GDScriptCompiler::_parse_expression(CodeGen &codegen, Error &r_error, const GDScriptParser::ExpressionNode *p_expression, bool p_root, bool p_initializer) {
 	if (p_expression->is_constant && !(p_expression->get_datatype().is_meta_type && p_expression->get_datatype().kind == GDScriptParser::DataType::CLASS)) {
 		return codegen.add_constant(p_expression->reduced_value);
@@ -623,7 +692,35 @@ GDScriptCodeGenerator::Address GDScriptCompiler::_parse_expression(CodeGen &code
 				arguments.push_back(arg);
 			}
 
-			if (!call->is_super && call->callee->type == GDScriptParser::Node::IDENTIFIER && GDScriptParser::get_builtin_type(call->function_name) < Variant::VARIANT_MAX) {
+			const GDScriptParser::ExpressionNode *inlined_expression = nullptr;
+			if (GDScriptLanguage::get_singleton()->should_optimize_bytecode() && !is_awaited && !call->is_super && call->callee->type == GDScriptParser::Node::IDENTIFIER) {
+				inlined_expression = _get_inlinable_call(codegen.class_node, call);
+			}
+
+			if (inlined_expression) {
+				// Small static function, compute its result in place with the arguments as parameters.
+				const GDScriptParser::FunctionNode *function = codegen.class_node->get_member(call->function_name).function;
+				HashMap<StringName, GDScriptCodeGenerator::Address> parameters(codegen.parameters);
+				codegen.parameters.clear();
+				for (int i = 0; i < function->parameters.size(); i++) {
+					codegen.parameters[function->parameters[i]->identifier->name] = arguments[i];
+				}
+				GDScriptCodeGenerator::Address value = _parse_expression(codegen, r_error, inlined_expression);
+				codegen.parameters = parameters;
+				if (r_error) {
+					return GDScriptCodeGenerator::Address();
+				}
+				if (result.mode != GDScriptCodeGenerator::Address::NIL) {
+					gen->write_assign(result, value);
+				}
+				bool is_argument = false;
+				for (const GDScriptCodeGenerator::Address &argument : arguments) {
+					is_argument = is_argument || (argument.mode == value.mode && argument.address == value.address);
+				}
+				if (value.mode == GDScriptCodeGenerator::Address::TEMPORARY && !is_argument) {
+					gen->pop_temporary();
+				}
+			} else if (!call->is_super && call->callee->type == GDScriptParser::Node::IDENTIFIER && GDScriptParser::get_builtin_type(call->function_name) < Variant::VARIANT_MAX) {
 				gen->write_construct(result, GDScriptParser::get_builtin_type(call->function_name), arguments);
 			} else if (!call->is_super && call->callee->type == GDScriptParser::Node::IDENTIFIER && Variant::has_utility_function(call->function_name)) {
 				// Variant utility function.
@@ -2521,6 +2618,14 @@ GDScriptFunction *GDScriptCompiler::_parse_function(Error &r_error, GDScript *p_
 		}
 	}
 
+	if (GDScriptLanguage::get_singleton()->should_optimize_bytecode()) {
+		GDScriptOptimizer::optimize_function(gd_function);
+	}
+
+	if (GDScriptNativeCode::has_functions()) {
+		gd_function->_native_code = GDScriptNativeCode::find_function(gd_function);
+	}
+
 	gd_function->method_info = method_info;
 
 	if (!is_implicit_initializer && !is_implicit_ready && !p_for_lambda) {
@@ -2705,6 +2810,7 @@ Error GDScriptCompiler::_prepare_compilation(GDScript *p_script, const GDScriptP
 	p_script->native = Ref<GDScriptNativeClass>();
 	p_script->base = Ref<GDScript>();
 	p_script->members.clear();
+	p_script->compile_id = 0;
 
 	// This makes possible to clear script constants and member_functions without heap-use-after-free errors.
 	HashMap<StringName, Variant> constants;
@@ -3097,6 +3203,7 @@ Error GDScriptCompiler::_compile_class(GDScript *p_script, const GDScriptParser:
 
 	p_script->_static_default_init();
 
+	p_script->compile_id = GDScript::last_compile_id.increment();
 	p_script->valid = true;
 	return OK;
 }
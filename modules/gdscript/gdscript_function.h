@@ -34,14 +34,18 @@
 
 #include "core/object/ref_counted.h"
 #include "core/object/script_language.h"
+#include "core/os/mutex.h"
 #include "core/os/thread.h"
 #include "core/string/string_name.h"
+#include "core/templates/local_vector.h"
 #include "core/templates/pair.h"
+#include "core/templates/safe_refcount.h"
 #include "core/templates/self_list.h"
 #include "core/variant/variant.h"
 
 class GDScriptInstance;
 class GDScript;
+struct GDScriptNativeFrame;
 
 class GDScriptDataType {
 public:
@@ -152,6 +156,37 @@ public:
 	enum Opcode {
 		OPCODE_OPERATOR,
 		OPCODE_OPERATOR_VALIDATED,
+		OPCODE_OPERATOR_ADD_INT,
+		OPCODE_OPERATOR_ADD_FLOAT,
+		OPCODE_OPERATOR_ADD_VECTOR2,
+		OPCODE_OPERATOR_ADD_VECTOR3,
+		OPCODE_OPERATOR_SUBTRACT_INT,
+		OPCODE_OPERATOR_SUBTRACT_FLOAT,
+		OPCODE_OPERATOR_SUBTRACT_VECTOR2,
+		OPCODE_OPERATOR_SUBTRACT_VECTOR3,
+		OPCODE_OPERATOR_MULTIPLY_INT,
+		OPCODE_OPERATOR_MULTIPLY_FLOAT,
+		OPCODE_OPERATOR_MULTIPLY_VECTOR2,
+		OPCODE_OPERATOR_MULTIPLY_VECTOR3,
+		OPCODE_OPERATOR_DIVIDE_FLOAT,
+		OPCODE_OPERATOR_DIVIDE_VECTOR2,
+		OPCODE_OPERATOR_DIVIDE_VECTOR3,
+		OPCODE_OPERATOR_MULTIPLY_VECTOR2_FLOAT,
+		OPCODE_OPERATOR_MULTIPLY_VECTOR3_FLOAT,
+		OPCODE_OPERATOR_EQUAL_INT,
+		OPCODE_OPERATOR_EQUAL_FLOAT,
+		OPCODE_OPERATOR_NOT_EQUAL_INT,
+		OPCODE_OPERATOR_NOT_EQUAL_FLOAT,
+		OPCODE_OPERATOR_LESS_INT,
+		OPCODE_OPERATOR_LESS_FLOAT,
+		OPCODE_OPERATOR_LESS_EQUAL_INT,
+		OPCODE_OPERATOR_LESS_EQUAL_FLOAT,
+		OPCODE_OPERATOR_GREATER_INT,
+		OPCODE_OPERATOR_GREATER_FLOAT,
+		OPCODE_OPERATOR_GREATER_EQUAL_INT,
+		OPCODE_OPERATOR_GREATER_EQUAL_FLOAT,
+		OPCODE_INCREMENT_INT,
+		OPCODE_DECREMENT_INT,
 		OPCODE_TYPE_TEST_BUILTIN,
 		OPCODE_TYPE_TEST_ARRAY,
 		OPCODE_TYPE_TEST_DICTIONARY,
@@ -212,6 +247,18 @@ public:
 		OPCODE_JUMP,
 		OPCODE_JUMP_IF,
 		OPCODE_JUMP_IF_NOT,
+		OPCODE_JUMP_IF_NOT_EQUAL_INT,
+		OPCODE_JUMP_IF_NOT_EQUAL_FLOAT,
+		OPCODE_JUMP_IF_NOT_NOT_EQUAL_INT,
+		OPCODE_JUMP_IF_NOT_NOT_EQUAL_FLOAT,
+		OPCODE_JUMP_IF_NOT_LESS_INT,
+		OPCODE_JUMP_IF_NOT_LESS_FLOAT,
+		OPCODE_JUMP_IF_NOT_LESS_EQUAL_INT,
+		OPCODE_JUMP_IF_NOT_LESS_EQUAL_FLOAT,
+		OPCODE_JUMP_IF_NOT_GREATER_INT,
+		OPCODE_JUMP_IF_NOT_GREATER_FLOAT,
+		OPCODE_JUMP_IF_NOT_GREATER_EQUAL_INT,
+		OPCODE_JUMP_IF_NOT_GREATER_EQUAL_FLOAT,
 		OPCODE_JUMP_TO_DEF_ARGUMENT,
 		OPCODE_JUMP_IF_SHARED,
 		OPCODE_RETURN,
@@ -337,11 +384,16 @@ public:
 		StringName identifier;
 	};
 
+	// Function generated ahead of time from the bytecode, see GDScriptNativeCode.
+	typedef void (*NativeCode)(GDScriptNativeFrame &p_frame, Variant &r_ret);
+
 private:
 	friend class GDScript;
 	friend class GDScriptCompiler;
 	friend class GDScriptByteCodeGenerator;
 	friend class GDScriptLanguage;
+	friend class GDScriptNativeCode;
+	friend class GDScriptOptimizer;
 
 	StringName name;
 	StringName source;
@@ -382,6 +434,46 @@ private:
 	Vector<MethodBind *> methods;
 	Vector<GDScriptFunction *> lambdas;
 
+	// Remembers what the untyped OPCODE_GET_NAMED, OPCODE_SET_NAMED and OPCODE_CALL* instructions resolved
+	// to for the last few receiver types (native class and script) they were executed with.
+	// Entries are never modified once published, so the VM reads them without locking.
+	struct InlineCache {
+		enum Kind : uint8_t {
+			KIND_NATIVE_GETTER,
+			KIND_NATIVE_SETTER,
+			KIND_NATIVE_METHOD,
+			KIND_SCRIPT_MEMBER,
+			KIND_SCRIPT_FUNCTION,
+		};
+
+		struct Entry {
+			Kind kind = KIND_NATIVE_METHOD;
+			StringName native_class;
+			uint64_t script_id = 0; // GDScript::compile_id of the receiver's script, zero if it has none.
+			MethodBind *method = nullptr;
+			GDScriptFunction *function = nullptr;
+			const GDScriptDataType *member_type = nullptr;
+			int member_index = -1;
+		};
+
+		static constexpr uint32_t MAX_ENTRIES = 4;
+		// Stop trying to fill the cache after this many receivers that can't be cached.
+		static constexpr uint32_t MAX_MISSES = 16;
+
+		Entry entries[MAX_ENTRIES];
+		SafeNumeric<uint32_t> count;
+		SafeNumeric<uint32_t> misses;
+	};
+
+	enum InlineCacheAccess {
+		INLINE_CACHE_GET,
+		INLINE_CACHE_SET,
+		INLINE_CACHE_CALL,
+	};
+
+	LocalVector<InlineCache> inline_caches;
+	static inline BinaryMutex inline_cache_mutex;
+
 	int _code_size = 0;
 	int _default_arg_count = 0;
 	int _constant_count = 0;
@@ -399,6 +491,7 @@ private:
 	int _gds_utilities_count = 0;
 	int _methods_count = 0;
 	int _lambdas_count = 0;
+	int _inline_caches_count = 0;
 
 	int *_code_ptr = nullptr;
 	const int *_default_arg_ptr = nullptr;
@@ -417,6 +510,8 @@ private:
 	const GDScriptUtilityFunctions::FunctionPtr *_gds_utilities_ptr = nullptr;
 	MethodBind **_methods_ptr = nullptr;
 	GDScriptFunction **_lambdas_ptr = nullptr;
+	InlineCache *_inline_caches_ptr = nullptr;
+	NativeCode _native_code = nullptr;
 
 #ifdef DEBUG_ENABLED
 	CharString func_cname;
@@ -455,6 +550,13 @@ private:
 	String _get_callable_call_error(const String &p_where, const Callable &p_callable, const Variant **p_argptrs, int p_argcount, const Variant &p_ret, const Callable::CallError &p_err) const;
 	Variant _get_default_variant_for_data_type(const GDScriptDataType &p_data_type);
 
+	_FORCE_INLINE_ static const InlineCache::Entry *_inline_cache_find(const InlineCache &p_cache, const Variant *p_base, Object *&r_object, GDScriptInstance *&r_instance);
+	_FORCE_INLINE_ static bool _inline_cache_get(const InlineCache &p_cache, const Variant *p_base, Variant &r_ret);
+	_FORCE_INLINE_ static bool _inline_cache_set(const InlineCache &p_cache, const Variant *p_base, const Variant *p_value, bool &r_valid);
+	_FORCE_INLINE_ static bool _inline_cache_call(const InlineCache &p_cache, const Variant *p_base, const Variant **p_args, int p_argcount, Variant &r_ret, Callable::CallError &r_err);
+	static bool _inline_cache_resolve(InlineCacheAccess p_access, const Variant *p_base, const StringName &p_name, InlineCache::Entry &r_entry);
+	static void _inline_cache_update(InlineCache &p_cache, InlineCacheAccess p_access, const Variant *p_base, const StringName &p_name);
+
 public:
 	static constexpr int MAX_CALL_DEPTH = 2048; // Limit to try to avoid crash because of a stack overflow.
 
@@ -0,0 +1,559 @@
+/**************************************************************************/
+/*  gdscript_native_code.cpp                                              */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+#include "gdscript_native_code.h"
+
+#include "gdscript.h"
+
+#include "core/variant/variant_internal.h"
+
+void GDScriptNativeCode::register_function(uint64_t p_hash, GDScriptFunction::NativeCode p_code) {
+	ERR_FAIL_NULL(p_code);
+	functions[p_hash] = p_code;
+}
+
+GDScriptFunction::NativeCode GDScriptNativeCode::find_function(const GDScriptFunction *p_function) {
+	if (functions.is_empty() || !can_compile(p_function)) {
+		return nullptr;
+	}
+	HashMap<uint64_t, GDScriptFunction::NativeCode>::ConstIterator E = functions.find(hash_function(p_function));
+	return E ? E->value : nullptr;
+}
+
+// Returns the size of the instruction at `p_ip`, or 0 if it can't be lowered to native code.
+// The jump target of the instruction, if any, is stored in `r_jump`.
+static int _get_instruction_size(const int *p_code, int p_ip, int p_code_size, int &r_jump) {
+	const int *code = &p_code[p_ip];
+	r_jump = -1;
+
+	switch (code[0]) {
+		case GDScriptFunction::OPCODE_OPERATOR_VALIDATED:
+			return 5;
+		case GDScriptFunction::OPCODE_INCREMENT_INT:
+		case GDScriptFunction::OPCODE_DECREMENT_INT:
+		case GDScriptFunction::OPCODE_ASSIGN_NULL:
+		case GDScriptFunction::OPCODE_ASSIGN_TRUE:
+		case GDScriptFunction::OPCODE_ASSIGN_FALSE:
+		case GDScriptFunction::OPCODE_TYPE_ADJUST_BOOL:
+		case GDScriptFunction::OPCODE_TYPE_ADJUST_INT:
+		case GDScriptFunction::OPCODE_TYPE_ADJUST_FLOAT:
+		case GDScriptFunction::OPCODE_TYPE_ADJUST_VECTOR2:
+		case GDScriptFunction::OPCODE_TYPE_ADJUST_VECTOR2I:
+		case GDScriptFunction::OPCODE_TYPE_ADJUST_VECTOR3:
+		case GDScriptFunction::OPCODE_TYPE_ADJUST_VECTOR3I:
+		case GDScriptFunction::OPCODE_RETURN:
+		case GDScriptFunction::OPCODE_LINE:
+			return 2;
+		case GDScriptFunction::OPCODE_ASSIGN:
+		case GDScriptFunction::OPCODE_RETURN_TYPED_BUILTIN:
+			return 3;
+		case GDScriptFunction::OPCODE_ASSIGN_TYPED_BUILTIN:
+			return 4;
+		case GDScriptFunction::OPCODE_JUMP:
+			r_jump = code[1];
+			return 2;
+		case GDScriptFunction::OPCODE_JUMP_IF:
+		case GDScriptFunction::OPCODE_JUMP_IF_NOT:
+			r_jump = code[2];
+			return 3;
+		case GDScriptFunction::OPCODE_CONSTRUCT_VALIDATED:
+			if (p_ip + 1 >= p_code_size) {
+				return 0;
+			}
+			return code[1] + 4;
+		case GDScriptFunction::OPCODE_ITERATE_BEGIN_INT:
+		case GDScriptFunction::OPCODE_ITERATE_INT:
+			r_jump = code[4];
+			return 5;
+		case GDScriptFunction::OPCODE_ITERATE_RANGE:
+			r_jump = code[5];
+			return 6;
+		case GDScriptFunction::OPCODE_ITERATE_BEGIN_RANGE:
+			r_jump = code[6];
+			return 7;
+		case GDScriptFunction::OPCODE_END:
+			return 1;
+		default:
+			break;
+	}
+
+	if (code[0] >= GDScriptFunction::OPCODE_OPERATOR_ADD_INT && code[0] <= GDScriptFunction::OPCODE_OPERATOR_GREATER_EQUAL_FLOAT) {
+		return 4;
+	}
+	if (code[0] >= GDScriptFunction::OPCODE_JUMP_IF_NOT_EQUAL_INT && code[0] <= GDScriptFunction::OPCODE_JUMP_IF_NOT_GREATER_EQUAL_FLOAT) {
+		r_jump = code[3];
+		return 4;
+	}
+	return 0;
+}
+
+// Returns the address operands of the instruction at `p_code`, which only holds addresses after the opcode
+// except for the instructions listed here.
+static void _get_instruction_addresses(const int *p_code, int p_size, LocalVector<int> &r_addresses) {
+	r_addresses.clear();
+	int first = 1;
+	int count = p_size - 1;
+
+	switch (p_code[0]) {
+		case GDScriptFunction::OPCODE_OPERATOR_VALIDATED:
+			count = 3;
+			break;
+		case GDScriptFunction::OPCODE_LINE:
+		case GDScriptFunction::OPCODE_JUMP:
+			count = 0;
+			break;
+		case GDScriptFunction::OPCODE_JUMP_IF:
+		case GDScriptFunction::OPCODE_JUMP_IF_NOT:
+		case GDScriptFunction::OPCODE_RETURN_TYPED_BUILTIN:
+			count = 1;
+			break;
+		case GDScriptFunction::OPCODE_ASSIGN_TYPED_BUILTIN:
+			count = 2;
+			break;
+		case GDScriptFunction::OPCODE_CONSTRUCT_VALIDATED:
+			first = 2;
+			count = p_code[1];
+			break;
+		default:
+			// Iterators and fused jumps end with the jump target.
+			if (p_code[0] >= GDScriptFunction::OPCODE_JUMP_IF_NOT_EQUAL_INT && p_code[0] <= GDScriptFunction::OPCODE_JUMP_IF_NOT_GREATER_EQUAL_FLOAT) {
+				count = 2;
+			} else if (p_code[0] == GDScriptFunction::OPCODE_ITERATE_BEGIN_INT || p_code[0] == GDScriptFunction::OPCODE_ITERATE_INT || p_code[0] == GDScriptFunction::OPCODE_ITERATE_RANGE || p_code[0] == GDScriptFunction::OPCODE_ITERATE_BEGIN_RANGE) {
+				count = p_size - 2;
+			}
+			break;
+	}
+
+	for (int i = 0; i < count; i++) {
+		r_addresses.push_back(p_code[first + i]);
+	}
+}
+
+bool GDScriptNativeCode::can_compile(const GDScriptFunction *p_function) {
+	ERR_FAIL_NULL_V(p_function, false);
+
+	if (p_function->_code_size == 0 || p_function->_default_arg_count > 0 || p_function->is_vararg()) {
+		return false;
+	}
+
+	for (int i = 0; i < p_function->_constant_count; i++) {
+		// Object, callable and container constants can't be hashed reliably across runs.
+		if (p_function->_constants_ptr[i].get_type() >= Variant::RID) {
+			return false;
+		}
+	}
+
+	const int *code = p_function->_code_ptr;
+	const int code_size = p_function->_code_size;
+	LocalVector<int> addresses;
+	int ip = 0;
+	while (ip < code_size) {
+		int jump = -1;
+		int size = _get_instruction_size(code, ip, code_size, jump);
+		if (size == 0 || ip + size > code_size) {
+			return false;
+		}
+		if (jump != -1 && (jump < 0 || jump > code_size)) {
+			return false;
+		}
+
+		_get_instruction_addresses(&code[ip], size, addresses);
+		for (int address : addresses) {
+			int type = (address & GDScriptFunction::ADDR_TYPE_MASK) >> GDScriptFunction::ADDR_BITS;
+			int index = address & GDScriptFunction::ADDR_MASK;
+			if (type == GDScriptFunction::ADDR_TYPE_STACK) {
+				if (index >= p_function->_stack_size) {
+					return false;
+				}
+			} else if (type == GDScriptFunction::ADDR_TYPE_CONSTANT) {
+				if (index >= p_function->_constant_count) {
+					return false;
+				}
+			} else {
+				// Members need an instance and their layout can change without changing the function.
+				return false;
+			}
+		}
+
+		ip += size;
+	}
+
+	return true;
+}
+
+static uint64_t _get_operator_id(Variant::ValidatedOperatorEvaluator p_evaluator) {
+	static const HashMap<uint64_t, uint64_t> ids = []() {
+		HashMap<uint64_t, uint64_t> map;
+		for (int op = 0; op < Variant::OP_MAX; op++) {
+			for (int a = 0; a < Variant::VARIANT_MAX; a++) {
+				for (int b = 0; b < Variant::VARIANT_MAX; b++) {
+					Variant::ValidatedOperatorEvaluator evaluator = Variant::get_validated_operator_evaluator((Variant::Operator)op, (Variant::Type)a, (Variant::Type)b);
+					if (evaluator && !map.has((uint64_t)evaluator)) {
+						map.insert((uint64_t)evaluator, ((uint64_t)op << 16) | ((uint64_t)a << 8) | (uint64_t)b);
+					}
+				}
+			}
+		}
+		return map;
+	}();
+
+	HashMap<uint64_t, uint64_t>::ConstIterator E = ids.find((uint64_t)p_evaluator);
+	return E ? E->value : UINT64_MAX;
+}
+
+static uint64_t _get_constructor_id(Variant::ValidatedConstructor p_constructor) {
+	static const HashMap<uint64_t, uint64_t> ids = []() {
+		HashMap<uint64_t, uint64_t> map;
+		for (int type = 0; type < Variant::VARIANT_MAX; type++) {
+			for (int i = 0; i < Variant::get_constructor_count((Variant::Type)type); i++) {
+				Variant::ValidatedConstructor constructor = Variant::get_validated_constructor((Variant::Type)type, i);
+				if (constructor && !map.has((uint64_t)constructor)) {
+					map.insert((uint64_t)constructor, ((uint64_t)type << 8) | (uint64_t)i);
+				}
+			}
+		}
+		return map;
+	}();
+
+	HashMap<uint64_t, uint64_t>::ConstIterator E = ids.find((uint64_t)p_constructor);
+	return E ? E->value : UINT64_MAX;
+}
+
+uint64_t GDScriptNativeCode::hash_function(const GDScriptFunction *p_function) {
+	ERR_FAIL_NULL_V(p_function, 0);
+
+	const int *code = p_function->_code_ptr;
+	const int code_size = p_function->_code_size;
+
+	// Line instructions are only emitted when the call stack is tracked, which depends on the build and the
+	// project settings, so they are left out and jump targets are hashed relative to the code without them.
+	LocalVector<int> positions;
+	positions.resize(code_size + 1);
+	int position = 0;
+	int ip = 0;
+	while (ip < code_size) {
+		int jump = -1;
+		int size = _get_instruction_size(code, ip, code_size, jump);
+		ERR_FAIL_COND_V_MSG(size == 0 || ip + size > code_size, 0, "Only functions that can be compiled to native code can be hashed.");
+		for (int i = 0; i < size; i++) {
+			positions[ip + i] = position;
+		}
+		if (code[ip] != GDScriptFunction::OPCODE_LINE) {
+			position += size;
+		}
+		ip += size;
+	}
+	positions[code_size] = position;
+
+	uint64_t hash = hash_djb2_one_64(position);
+	ip = 0;
+	while (ip < code_size) {
+		int jump = -1;
+		int size = _get_instruction_size(code, ip, code_size, jump);
+		if (code[ip] != GDScriptFunction::OPCODE_LINE) {
+			// The jump target is always the last operand.
+			int hashed_size = jump != -1 ? size - 1 : size;
+			for (int i = 0; i < hashed_size; i++) {
+				hash = hash_djb2_one_64(code[ip + i], hash);
+			}
+			if (jump != -1) {
+				hash = hash_djb2_one_64(positions[jump], hash);
+			}
+		}
+		ip += size;
+	}
+	hash = hash_djb2_one_64(p_function->_stack_size, hash);
+	for (const Pair<int, Variant::Type> &E : p_function->temporary_slots) {
+		hash = hash_djb2_one_64(E.first, hash);
+		hash = hash_djb2_one_64(E.second, hash);
+	}
+	for (int i = 0; i < p_function->_constant_count; i++) {
+		hash = hash_djb2_one_64(p_function->_constants_ptr[i].get_type(), hash);
+		hash = hash_djb2_one_64(p_function->_constants_ptr[i].hash(), hash);
+	}
+	// The tables are indexed by the bytecode, so what they point to is part of the function.
+	for (int i = 0; i < p_function->_operator_funcs_count; i++) {
+		hash = hash_djb2_one_64(_get_operator_id(p_function->_operator_funcs_ptr[i]), hash);
+	}
+	for (int i = 0; i < p_function->_constructors_count; i++) {
+		hash = hash_djb2_one_64(_get_constructor_id(p_function->_constructors_ptr[i]), hash);
+	}
+
+	return hash;
+}
+
+void GDScriptNativeCode::assign_typed_builtin(Variant &r_dst, const Variant &p_src, Variant::Type p_type) {
+	if (p_src.get_type() == p_type) {
+		r_dst = p_src;
+		return;
+	}
+
+	const Variant *src = &p_src;
+	Callable::CallError ce;
+	Variant::construct(p_type, r_dst, &src, 1, ce);
+}
+
+void GDScriptNativeCode::return_typed_builtin(const Variant &p_value, Variant::Type p_type, Variant &r_ret) {
+	if (p_value.get_type() == p_type) {
+		r_ret = p_value;
+		return;
+	}
+
+	Callable::CallError ce;
+	if (Variant::can_convert_strict(p_value.get_type(), p_type)) {
+		const Variant *value = &p_value;
+		Variant::construct(p_type, r_ret, &value, 1, ce);
+	} else {
+		ERR_PRINT(vformat(R"(Trying to return a value of type "%s" from a function whose return type is "%s".)", Variant::get_type_name(p_value.get_type()), Variant::get_type_name(p_type)));
+		Variant::construct(p_type, r_ret, nullptr, 0, ce);
+	}
+}
+
+#ifdef TOOLS_ENABLED
+
+static String _address(int p_address) {
+	int type = (p_address & GDScriptFunction::ADDR_TYPE_MASK) >> GDScriptFunction::ADDR_BITS;
+	int index = p_address & GDScriptFunction::ADDR_MASK;
+	return vformat(type == GDScriptFunction::ADDR_TYPE_CONSTANT ? "c[%d]" : "s[%d]", index);
+}
+
+static String _typed_operand(int p_address, const char *p_getter) {
+	return vformat("*VariantInternal::%s(&%s)", p_getter, _address(p_address));
+}
+
+String GDScriptNativeCode::compile_function(const GDScriptFunction *p_function, const String &p_symbol) {
+	ERR_FAIL_COND_V(!can_compile(p_function), String());
+
+	const int *code = p_function->_code_ptr;
+	const int code_size = p_function->_code_size;
+
+	// Only emit labels where something jumps to, so the generated code doesn't trigger unused label warnings.
+	HashSet<int> targets;
+	int ip = 0;
+	while (ip < code_size) {
+		int jump = -1;
+		ip += _get_instruction_size(code, ip, code_size, jump);
+		if (jump != -1) {
+			targets.insert(jump);
+		}
+	}
+
+	static const char *typed_getters[] = { "get_int", "get_float", "get_vector2", "get_vector3" };
+	static const char *typed_operators[] = { "+", "-", "*" };
+	static const char *comparisons[] = { "==", "!=", "<", "<=", ">", ">=" };
+	static const char *type_adjusts[] = { "bool", "int64_t", "double", "Vector2", "Vector2i", "Vector3", "Vector3i" };
+
+	String body;
+	ip = 0;
+	while (ip < code_size) {
+		const int *c = &code[ip];
+		int jump = -1;
+		int size = _get_instruction_size(code, ip, code_size, jump);
+
+		if (targets.has(ip)) {
+			body += vformat("L%d:\n", ip);
+		}
+
+		String line;
+		switch (c[0]) {
+			case GDScriptFunction::OPCODE_OPERATOR_VALIDATED: {
+				line = vformat("p_frame.operator_funcs[%d](&%s, &%s, &%s);", c[4], _address(c[1]), _address(c[2]), _address(c[3]));
+			} break;
+			case GDScriptFunction::OPCODE_OPERATOR_MULTIPLY_VECTOR2_FLOAT:
+			case GDScriptFunction::OPCODE_OPERATOR_MULTIPLY_VECTOR3_FLOAT: {
+				const char *getter = c[0] == GDScriptFunction::OPCODE_OPERATOR_MULTIPLY_VECTOR2_FLOAT ? "get_vector2" : "get_vector3";
+				line = vformat("%s = %s * real_t(%s);", _typed_operand(c[3], getter), _typed_operand(c[1], getter), _typed_operand(c[2], "get_float"));
+			} break;
+			case GDScriptFunction::OPCODE_OPERATOR_DIVIDE_FLOAT:
+			case GDScriptFunction::OPCODE_OPERATOR_DIVIDE_VECTOR2:
+			case GDScriptFunction::OPCODE_OPERATOR_DIVIDE_VECTOR3: {
+				const char *getter = typed_getters[c[0] - GDScriptFunction::OPCODE_OPERATOR_DIVIDE_FLOAT + 1];
+				line = vformat("%s = %s / %s;", _typed_operand(c[3], getter), _typed_operand(c[1], getter), _typed_operand(c[2], getter));
+			} break;
+			case GDScriptFunction::OPCODE_INCREMENT_INT: {
+				line = vformat("(%s)++;", _typed_operand(c[1], "get_int"));
+			} break;
+			case GDScriptFunction::OPCODE_DECREMENT_INT: {
+				line = vformat("(%s)--;", _typed_operand(c[1], "get_int"));
+			} break;
+			case GDScriptFunction::OPCODE_ASSIGN: {
+				line = vformat("%s = %s;", _address(c[1]), _address(c[2]));
+			} break;
+			case GDScriptFunction::OPCODE_ASSIGN_NULL: {
+				line = vformat("%s = Variant();", _address(c[1]));
+			} break;
+			case GDScriptFunction::OPCODE_ASSIGN_TRUE: {
+				line = vformat("%s = true;", _address(c[1]));
+			} break;
+			case GDScriptFunction::OPCODE_ASSIGN_FALSE: {
+				line = vformat("%s = false;", _address(c[1]));
+			} break;
+			case GDScriptFunction::OPCODE_ASSIGN_TYPED_BUILTIN: {
+				line = vformat("GDScriptNativeCode::assign_typed_builtin(%s, %s, Variant::Type(%d));", _address(c[1]), _address(c[2]), c[3]);
+			} break;
+			case GDScriptFunction::OPCODE_TYPE_ADJUST_BOOL:
+			case GDScriptFunction::OPCODE_TYPE_ADJUST_INT:
+			case GDScriptFunction::OPCODE_TYPE_ADJUST_FLOAT: {
+				line = vformat("VariantTypeAdjust<%s>::adjust(&%s);", type_adjusts[c[0] - GDScriptFunction::OPCODE_TYPE_ADJUST_BOOL], _address(c[1]));
+			} break;
+			case GDScriptFunction::OPCODE_TYPE_ADJUST_VECTOR2:
+			case GDScriptFunction::OPCODE_TYPE_ADJUST_VECTOR2I: {
+				line = vformat("VariantTypeAdjust<%s>::adjust(&%s);", type_adjusts[c[0] - GDScriptFunction::OPCODE_TYPE_ADJUST_VECTOR2 + 3], _address(c[1]));
+			} break;
+			case GDScriptFunction::OPCODE_TYPE_ADJUST_VECTOR3:
+			case GDScriptFunction::OPCODE_TYPE_ADJUST_VECTOR3I: {
+				line = vformat("VariantTypeAdjust<%s>::adjust(&%s);", type_adjusts[c[0] - GDScriptFunction::OPCODE_TYPE_ADJUST_VECTOR3 + 5], _address(c[1]));
+			} break;
+			case GDScriptFunction::OPCODE_CONSTRUCT_VALIDATED: {
+				int argc = c[c[1] + 2];
+				int constructor = c[c[1] + 3];
+				if (argc == 0) {
+					line = vformat("p_frame.constructors[%d](&%s, nullptr);", constructor, _address(c[2]));
+				} else {
+					String args;
+					for (int i = 0; i < argc; i++) {
+						args += (i > 0 ? ", &" : "&") + _address(c[2 + i]);
+					}
+					line = vformat("{ const Variant *args[] = { %s }; p_frame.constructors[%d](&%s, args); }", args, constructor, _address(c[2 + argc]));
+				}
+			} break;
+			case GDScriptFunction::OPCODE_JUMP: {
+				line = vformat("goto L%d;", c[1]);
+			} break;
+			case GDScriptFunction::OPCODE_JUMP_IF: {
+				line = vformat("if (%s.booleanize()) { goto L%d; }", _address(c[1]), c[2]);
+			} break;
+			case GDScriptFunction::OPCODE_JUMP_IF_NOT: {
+				line = vformat("if (!%s.booleanize()) { goto L%d; }", _address(c[1]), c[2]);
+			} break;
+			case GDScriptFunction::OPCODE_ITERATE_BEGIN_INT: {
+				line = vformat("VariantInternal::initialize(&%s, Variant::INT);\n", _address(c[1]));
+				line += vformat("\t%s = 0;\n", _typed_operand(c[1], "get_int"));
+				line += vformat("\tif (%s <= 0) { goto L%d; }\n", _typed_operand(c[2], "get_int"), c[4]);
+				line += vformat("\tVariantInternal::initialize(&%s, Variant::INT);\n", _address(c[3]));
+				line += vformat("\t%s = 0;", _typed_operand(c[3], "get_int"));
+			} break;
+			case GDScriptFunction::OPCODE_ITERATE_INT: {
+				line = vformat("if (++%s >= %s) { goto L%d; }\n", _typed_operand(c[1], "get_int"), _typed_operand(c[2], "get_int"), c[4]);
+				line += vformat("\t%s = %s;", _typed_operand(c[3], "get_int"), _typed_operand(c[1], "get_int"));
+			} break;
+			case GDScriptFunction::OPCODE_ITERATE_BEGIN_RANGE: {
+				line = vformat("{\n\t\tconst int64_t from = %s, to = %s, step = %s;\n", _typed_operand(c[2], "get_int"), _typed_operand(c[3], "get_int"), _typed_operand(c[4], "get_int"));
+				line += vformat("\t\tVariantInternal::initialize(&%s, Variant::INT);\n", _address(c[1]));
+				line += vformat("\t\t%s = from;\n", _typed_operand(c[1], "get_int"));
+				line += vformat("\t\tif (from == to || (from < to ? step <= 0 : step >= 0)) { goto L%d; }\n", c[6]);
+				line += vformat("\t\tVariantInternal::initialize(&%s, Variant::INT);\n", _address(c[5]));
+				line += vformat("\t\t%s = from;\n\t}", _typed_operand(c[5], "get_int"));
+			} break;
+			case GDScriptFunction::OPCODE_ITERATE_RANGE: {
+				line = vformat("{\n\t\tconst int64_t to = %s, step = %s;\n", _typed_operand(c[2], "get_int"), _typed_operand(c[3], "get_int"));
+				line += vformat("\t\tint64_t &count = %s;\n", _typed_operand(c[1], "get_int"));
+				line += "\t\tcount += step;\n";
+				line += vformat("\t\tif ((step < 0 && count <= to) || (step > 0 && count >= to)) { goto L%d; }\n", c[5]);
+				line += vformat("\t\t%s = count;\n\t}", _typed_operand(c[4], "get_int"));
+			} break;
+			case GDScriptFunction::OPCODE_RETURN: {
+				line = vformat("r_ret = %s;\n\treturn;", _address(c[1]));
+			} break;
+			case GDScriptFunction::OPCODE_RETURN_TYPED_BUILTIN: {
+				line = vformat("GDScriptNativeCode::return_typed_builtin(%s, Variant::Type(%d), r_ret);\n\treturn;", _address(c[1]), c[2]);
+			} break;
+			case GDScriptFunction::OPCODE_LINE: {
+				// Lines are only tracked for the debugger, which always runs the bytecode.
+			} break;
+			case GDScriptFunction::OPCODE_END: {
+				line = "return;";
+			} break;
+			default: {
+				if (c[0] >= GDScriptFunction::OPCODE_OPERATOR_ADD_INT && c[0] <= GDScriptFunction::OPCODE_OPERATOR_MULTIPLY_VECTOR3) {
+					int index = c[0] - GDScriptFunction::OPCODE_OPERATOR_ADD_INT;
+					const char *getter = typed_getters[index % 4];
+					line = vformat("%s = %s %s %s;", _typed_operand(c[3], getter), _typed_operand(c[1], getter), typed_operators[index / 4], _typed_operand(c[2], getter));
+				} else if (c[0] >= GDScriptFunction::OPCODE_OPERATOR_EQUAL_INT && c[0] <= GDScriptFunction::OPCODE_OPERATOR_GREATER_EQUAL_FLOAT) {
+					int index = c[0] - GDScriptFunction::OPCODE_OPERATOR_EQUAL_INT;
+					const char *getter = typed_getters[index % 2];
+					line = vformat("%s = %s %s %s;", _typed_operand(c[3], "get_bool"), _typed_operand(c[1], getter), comparisons[index / 2], _typed_operand(c[2], getter));
+				} else if (c[0] >= GDScriptFunction::OPCODE_JUMP_IF_NOT_EQUAL_INT && c[0] <= GDScriptFunction::OPCODE_JUMP_IF_NOT_GREATER_EQUAL_FLOAT) {
+					int index = c[0] - GDScriptFunction::OPCODE_JUMP_IF_NOT_EQUAL_INT;
+					const char *getter = typed_getters[index % 2];
+					line = vformat("if (!(%s %s %s)) { goto L%d; }", _typed_operand(c[1], getter), comparisons[index / 2], _typed_operand(c[2], getter), c[3]);
+				} else {
+					ERR_FAIL_V_MSG(String(), vformat("Unsupported opcode %d in native code generation.", c[0]));
+				}
+			} break;
+		}
+
+		if (!line.is_empty()) {
+			body += "\t" + line + "\n";
+		}
+		ip += size;
+	}
+
+	if (targets.has(code_size)) {
+		body += vformat("L%d:\n\treturn;\n", code_size);
+	}
+
+	String script_path = p_function->get_script() ? p_function->get_script()->get_script_path() : String();
+
+	String source = vformat("// %s::%s\n", script_path, p_function->get_name());
+	source += vformat("static void %s(GDScriptNativeFrame &p_frame, Variant &r_ret) {\n", p_symbol);
+	source += "\tVariant *s = p_frame.stack;\n";
+	source += "\tVariant *c = p_frame.constants;\n";
+	source += "\t(void)s;\n\t(void)c;\n";
+	source += body;
+	source += "}\n";
+	return source;
+}
+
+String GDScriptNativeCode::generate_source(const Vector<const GDScriptFunction *> &p_functions) {
+	String source = "// This file is generated by the GDScript native code export, do not edit.\n";
+	source += "// Build the export templates with `gdscript_native_code=<path to this file>` to use it.\n\n";
+	source += "#include \"modules/gdscript/gdscript_native_code.h\"\n\n";
+	source += "#include \"core/variant/variant_internal.h\"\n\n";
+
+	String registration;
+	int count = 0;
+	for (const GDScriptFunction *function : p_functions) {
+		String symbol = vformat("gdscript_native_%d", count);
+		String code = compile_function(function, symbol);
+		if (code.is_empty()) {
+			continue;
+		}
+		source += code + "\n";
+		registration += vformat("\tGDScriptNativeCode::register_function(0x%sULL, &%s);\n", String::num_uint64(hash_function(function), 16), symbol);
+		count++;
+	}
+
+	source += "void register_gdscript_native_code() {\n";
+	source += registration;
+	source += "}\n";
+	return source;
+}
+
+#endif // TOOLS_ENABLED
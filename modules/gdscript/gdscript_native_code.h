@@ -0,0 +1,81 @@
+/**************************************************************************/
+/*  gdscript_native_code.h                                                */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "gdscript_function.h"
+
+#include "core/templates/hash_map.h"
+
+// State shared between GDScriptFunction::call() and the native code of a function.
+struct GDScriptNativeFrame {
+	Variant *stack = nullptr;
+	Variant *constants = nullptr;
+	const Variant::ValidatedOperatorEvaluator *operator_funcs = nullptr;
+	const Variant::ValidatedConstructor *constructors = nullptr;
+};
+
+// Ahead-of-time lowering of fully typed GDScript functions to C++.
+//
+// The export generates a C++ file with the functions that only use typed opcodes (see `can_compile()`).
+// An engine built with `gdscript_native_code=<file>` registers them on startup, keyed by a hash of the bytecode
+// they were generated from, and GDScriptFunction::call() runs them instead of the VM when the compiled bytecode
+// is identical. Anything else, or any function that changed since the export, keeps running in the VM.
+class GDScriptNativeCode {
+	static inline HashMap<uint64_t, GDScriptFunction::NativeCode> functions;
+	static inline bool enabled = true;
+
+public:
+	// Disabling runs every function in the VM, to compare both.
+	static void set_enabled(bool p_enabled) { enabled = p_enabled; }
+	static bool is_enabled() { return enabled; }
+
+	static void register_function(uint64_t p_hash, GDScriptFunction::NativeCode p_code);
+	static bool has_functions() { return !functions.is_empty(); }
+	static GDScriptFunction::NativeCode find_function(const GDScriptFunction *p_function);
+	static bool has_native_code(const GDScriptFunction *p_function) { return p_function->_native_code != nullptr; }
+
+	static bool can_compile(const GDScriptFunction *p_function);
+	static uint64_t hash_function(const GDScriptFunction *p_function);
+
+#ifdef TOOLS_ENABLED
+	static String compile_function(const GDScriptFunction *p_function, const String &p_symbol);
+	static String generate_source(const Vector<const GDScriptFunction *> &p_functions);
+#endif
+
+	// Used by the generated code.
+	static void assign_typed_builtin(Variant &r_dst, const Variant &p_src, Variant::Type p_type);
+	static void return_typed_builtin(const Variant &p_value, Variant::Type p_type, Variant &r_ret);
+};
+
+#ifdef GDSCRIPT_NATIVE_CODE_ENABLED
+// Defined by the generated source.
+void register_gdscript_native_code();
+#endif
@@ -0,0 +1,589 @@
+/**************************************************************************/
+/*  gdscript_optimizer.cpp                                                */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+#include "gdscript_optimizer.h"
+
+#include "core/templates/hash_set.h"
+
+bool GDScriptOptimizer::decode_instruction(const int *p_code, int p_ip, int p_code_size, Instruction &r_instruction) {
+	const int *code = &p_code[p_ip];
+	r_instruction = Instruction();
+	r_instruction.ip = p_ip;
+
+	int size = 0;
+	switch (code[0]) {
+		case GDScriptFunction::OPCODE_OPERATOR: {
+			size = 7 + sizeof(Variant::ValidatedOperatorEvaluator) / sizeof(*p_code);
+			r_instruction.reads = LocalVector<int>({ 1, 2 });
+			r_instruction.writes = LocalVector<int>({ 3 });
+			r_instruction.replaces = true;
+		} break;
+		case GDScriptFunction::OPCODE_OPERATOR_VALIDATED: {
+			size = 5;
+			r_instruction.reads = LocalVector<int>({ 1, 2 });
+			r_instruction.writes = LocalVector<int>({ 3 });
+		} break;
+		case GDScriptFunction::OPCODE_INCREMENT_INT:
+		case GDScriptFunction::OPCODE_DECREMENT_INT: {
+			size = 2;
+			r_instruction.reads = LocalVector<int>({ 1 });
+			r_instruction.writes = LocalVector<int>({ 1 });
+		} break;
+		case GDScriptFunction::OPCODE_GET_MEMBER: {
+			size = 3;
+			r_instruction.writes = LocalVector<int>({ 1 });
+			r_instruction.replaces = true;
+		} break;
+		case GDScriptFunction::OPCODE_SET_MEMBER: {
+			size = 3;
+			r_instruction.reads = LocalVector<int>({ 1 });
+		} break;
+		case GDScriptFunction::OPCODE_ASSIGN: {
+			size = 3;
+			r_instruction.reads = LocalVector<int>({ 2 });
+			r_instruction.writes = LocalVector<int>({ 1 });
+			r_instruction.replaces = true;
+		} break;
+		case GDScriptFunction::OPCODE_ASSIGN_NULL:
+		case GDScriptFunction::OPCODE_ASSIGN_TRUE:
+		case GDScriptFunction::OPCODE_ASSIGN_FALSE: {
+			size = 2;
+			r_instruction.writes = LocalVector<int>({ 1 });
+			r_instruction.replaces = true;
+		} break;
+		case GDScriptFunction::OPCODE_ASSIGN_TYPED_BUILTIN: {
+			size = 4;
+			r_instruction.reads = LocalVector<int>({ 2 });
+			r_instruction.writes = LocalVector<int>({ 1 });
+			r_instruction.replaces = true;
+		} break;
+		case GDScriptFunction::OPCODE_CONSTRUCT_VALIDATED:
+		case GDScriptFunction::OPCODE_CALL_UTILITY_VALIDATED:
+		case GDScriptFunction::OPCODE_CALL_GDSCRIPT_UTILITY:
+		case GDScriptFunction::OPCODE_CALL_BUILTIN_TYPE_VALIDATED: {
+			// Arguments, (base,) target, argument count and function index.
+			if (p_ip + 1 >= p_code_size) {
+				return false;
+			}
+			const int count = code[1];
+			size = count + 4;
+			if (count < 1 || p_ip + size > p_code_size) {
+				return false;
+			}
+			const bool has_base = code[0] == GDScriptFunction::OPCODE_CALL_BUILTIN_TYPE_VALIDATED;
+			const int argc = code[count + 2];
+			if (argc != count - (has_base ? 2 : 1)) {
+				return false;
+			}
+			for (int i = 0; i < argc; i++) {
+				r_instruction.reads.push_back(2 + i);
+			}
+			if (has_base) {
+				// Methods of value types modify the base in place.
+				r_instruction.reads.push_back(2 + argc);
+				r_instruction.writes.push_back(2 + argc);
+			}
+			r_instruction.writes.push_back(count + 1);
+			// Validated utility functions and methods write the result in place, the target is adjusted beforehand.
+			r_instruction.replaces = code[0] == GDScriptFunction::OPCODE_CONSTRUCT_VALIDATED || code[0] == GDScriptFunction::OPCODE_CALL_GDSCRIPT_UTILITY;
+		} break;
+		case GDScriptFunction::OPCODE_JUMP: {
+			size = 2;
+			r_instruction.jump = 1;
+		} break;
+		case GDScriptFunction::OPCODE_JUMP_IF:
+		case GDScriptFunction::OPCODE_JUMP_IF_NOT: {
+			size = 3;
+			r_instruction.reads = LocalVector<int>({ 1 });
+			r_instruction.jump = 2;
+		} break;
+		case GDScriptFunction::OPCODE_ITERATE_BEGIN_INT:
+		case GDScriptFunction::OPCODE_ITERATE_INT: {
+			// The iterator is only written when the loop runs.
+			size = 5;
+			r_instruction.reads = LocalVector<int>({ 2 });
+			if (code[0] == GDScriptFunction::OPCODE_ITERATE_INT) {
+				r_instruction.reads.push_back(1);
+			}
+			r_instruction.writes = LocalVector<int>({ 1, 3 });
+			r_instruction.jump = 4;
+		} break;
+		case GDScriptFunction::OPCODE_ITERATE_BEGIN_RANGE: {
+			size = 7;
+			r_instruction.reads = LocalVector<int>({ 2, 3, 4 });
+			r_instruction.writes = LocalVector<int>({ 1, 5 });
+			r_instruction.jump = 6;
+		} break;
+		case GDScriptFunction::OPCODE_ITERATE_RANGE: {
+			size = 6;
+			r_instruction.reads = LocalVector<int>({ 1, 2, 3 });
+			r_instruction.writes = LocalVector<int>({ 1, 4 });
+			r_instruction.jump = 5;
+		} break;
+		case GDScriptFunction::OPCODE_RETURN: {
+			size = 2;
+			r_instruction.reads = LocalVector<int>({ 1 });
+		} break;
+		case GDScriptFunction::OPCODE_RETURN_TYPED_BUILTIN: {
+			size = 3;
+			r_instruction.reads = LocalVector<int>({ 1 });
+		} break;
+		case GDScriptFunction::OPCODE_LINE: {
+			size = 2;
+		} break;
+		case GDScriptFunction::OPCODE_END: {
+			size = 1;
+		} break;
+		default: {
+			if (code[0] >= GDScriptFunction::OPCODE_OPERATOR_ADD_INT && code[0] <= GDScriptFunction::OPCODE_OPERATOR_GREATER_EQUAL_FLOAT) {
+				size = 4;
+				r_instruction.reads = LocalVector<int>({ 1, 2 });
+				r_instruction.writes = LocalVector<int>({ 3 });
+			} else if (code[0] >= GDScriptFunction::OPCODE_JUMP_IF_NOT_EQUAL_INT && code[0] <= GDScriptFunction::OPCODE_JUMP_IF_NOT_GREATER_EQUAL_FLOAT) {
+				size = 4;
+				r_instruction.reads = LocalVector<int>({ 1, 2 });
+				r_instruction.jump = 3;
+			} else if (code[0] >= GDScriptFunction::OPCODE_TYPE_ADJUST_BOOL && code[0] <= GDScriptFunction::OPCODE_TYPE_ADJUST_PACKED_VECTOR4_ARRAY) {
+				// Keeps the value when it already has the type.
+				size = 2;
+				r_instruction.reads = LocalVector<int>({ 1 });
+				r_instruction.writes = LocalVector<int>({ 1 });
+			} else {
+				return false;
+			}
+		} break;
+	}
+
+	if (p_ip + size > p_code_size) {
+		return false;
+	}
+	r_instruction.size = size;
+	return true;
+}
+
+static int _get_stack_slot(int p_address) {
+	if (((p_address & GDScriptFunction::ADDR_TYPE_MASK) >> GDScriptFunction::ADDR_BITS) != GDScriptFunction::ADDR_TYPE_STACK) {
+		return -1;
+	}
+	return p_address & GDScriptFunction::ADDR_MASK;
+}
+
+static bool _is_type_adjust(int p_opcode) {
+	return p_opcode >= GDScriptFunction::OPCODE_TYPE_ADJUST_BOOL && p_opcode <= GDScriptFunction::OPCODE_TYPE_ADJUST_PACKED_VECTOR4_ARRAY;
+}
+
+static bool _is_exit(int p_opcode) {
+	return p_opcode == GDScriptFunction::OPCODE_RETURN || p_opcode == GDScriptFunction::OPCODE_RETURN_TYPED_BUILTIN || p_opcode == GDScriptFunction::OPCODE_END;
+}
+
+static bool _operand_used(const int *p_code, const GDScriptOptimizer::Instruction &p_instruction, const LocalVector<int> &p_operands, int p_address) {
+	for (int operand : p_operands) {
+		if (p_code[p_instruction.ip + operand] == p_address) {
+			return true;
+		}
+	}
+	return false;
+}
+
+// Whether the value in `p_address` is overwritten before being read again, looking from `p_from` to the end of its block.
+static bool _is_dead_after(const int *p_code, const LocalVector<GDScriptOptimizer::Instruction> &p_instructions, const LocalVector<bool> &p_block_starts, uint32_t p_from, int p_address) {
+	for (uint32_t i = p_from; i < p_instructions.size(); i++) {
+		const GDScriptOptimizer::Instruction &instruction = p_instructions[i];
+		if (p_block_starts[i]) {
+			// Reachable from elsewhere, don't look further.
+			return false;
+		}
+		if (instruction.removed) {
+			continue;
+		}
+		if (_operand_used(p_code, instruction, instruction.reads, p_address)) {
+			return false;
+		}
+		if (_operand_used(p_code, instruction, instruction.writes, p_address)) {
+			// Writes in place rely on the type set by the previous value.
+			return instruction.replaces;
+		}
+		if (instruction.jump != -1) {
+			return false;
+		}
+		if (_is_exit(p_code[instruction.ip])) {
+			return true;
+		}
+	}
+	return true;
+}
+
+// Replaces the reads of locals that are only ever assigned a constant, at the start of the function, by the constant.
+static void _propagate_constants(GDScriptFunction *p_function, int *p_code, const LocalVector<GDScriptOptimizer::Instruction> &p_instructions, const LocalVector<bool> &p_block_starts, int p_first_local, const Variant *p_constants) {
+	const int stack_size = p_function->get_max_stack_size();
+
+	// The first block runs before any other instruction.
+	uint32_t entry_end = 1;
+	while (entry_end < p_instructions.size() && !p_block_starts[entry_end]) {
+		entry_end++;
+	}
+
+	LocalVector<int> write_count;
+	LocalVector<int> writer;
+	LocalVector<int> first_read;
+	write_count.resize_initialized(stack_size);
+	writer.resize_initialized(stack_size);
+	first_read.resize(stack_size);
+	for (int &read : first_read) {
+		read = -1;
+	}
+
+	for (uint32_t i = 0; i < p_instructions.size(); i++) {
+		const GDScriptOptimizer::Instruction &instruction = p_instructions[i];
+		for (int operand : instruction.writes) {
+			int slot = _get_stack_slot(p_code[instruction.ip + operand]);
+			if (slot >= p_first_local && slot < stack_size) {
+				write_count[slot]++;
+				writer[slot] = i;
+			}
+		}
+		for (int operand : instruction.reads) {
+			int slot = _get_stack_slot(p_code[instruction.ip + operand]);
+			if (slot >= p_first_local && slot < stack_size && first_read[slot] == -1) {
+				first_read[slot] = i;
+			}
+		}
+	}
+
+	for (int slot = p_first_local; slot < stack_size; slot++) {
+		if (write_count[slot] != 1 || (uint32_t)writer[slot] >= entry_end || (first_read[slot] != -1 && first_read[slot] <= writer[slot])) {
+			continue;
+		}
+
+		const int *code = &p_code[p_instructions[writer[slot]].ip];
+		if (code[0] != GDScriptFunction::OPCODE_ASSIGN && code[0] != GDScriptFunction::OPCODE_ASSIGN_TYPED_BUILTIN) {
+			continue;
+		}
+		const int source = code[2];
+		if (((source & GDScriptFunction::ADDR_TYPE_MASK) >> GDScriptFunction::ADDR_BITS) != GDScriptFunction::ADDR_TYPE_CONSTANT) {
+			continue;
+		}
+		// Only value types, containers and objects could be modified through the local.
+		const Variant::Type type = p_constants[source & GDScriptFunction::ADDR_MASK].get_type();
+		if (type >= Variant::RID || (code[0] == GDScriptFunction::OPCODE_ASSIGN_TYPED_BUILTIN && type != code[3])) {
+			continue;
+		}
+
+		const int address = slot | (GDScriptFunction::ADDR_TYPE_STACK << GDScriptFunction::ADDR_BITS);
+		for (uint32_t i = writer[slot] + 1; i < p_instructions.size(); i++) {
+			const GDScriptOptimizer::Instruction &instruction = p_instructions[i];
+			for (int operand : instruction.reads) {
+				if (p_code[instruction.ip + operand] == address) {
+					p_code[instruction.ip + operand] = source;
+				}
+			}
+		}
+	}
+}
+
+// Makes an instruction write its result directly where the next assignment copies it, when nothing else reads it.
+static void _fold_assignments(int *p_code, LocalVector<GDScriptOptimizer::Instruction> &p_instructions, const LocalVector<bool> &p_block_starts, int p_first_local) {
+	for (uint32_t i = 1; i < p_instructions.size(); i++) {
+		GDScriptOptimizer::Instruction &assign = p_instructions[i];
+		const GDScriptOptimizer::Instruction &previous = p_instructions[i - 1];
+		if (p_code[assign.ip] != GDScriptFunction::OPCODE_ASSIGN || p_block_starts[i] || previous.removed) {
+			continue;
+		}
+		if (!previous.replaces || previous.writes.size() != 1 || previous.jump != -1) {
+			continue;
+		}
+
+		const int temp_address = p_code[previous.ip + previous.writes[0]];
+		const int target_address = p_code[assign.ip + 1];
+		if (p_code[assign.ip + 2] != temp_address || temp_address == target_address) {
+			continue;
+		}
+		if (_get_stack_slot(temp_address) < p_first_local || _get_stack_slot(target_address) < GDScriptFunction::FIXED_ADDRESSES_MAX) {
+			continue;
+		}
+		// The target can't be overwritten while it's still an operand.
+		if (_operand_used(p_code, previous, previous.reads, target_address)) {
+			continue;
+		}
+		if (!_is_dead_after(p_code, p_instructions, p_block_starts, i + 1, temp_address)) {
+			continue;
+		}
+
+		p_code[previous.ip + previous.writes[0]] = target_address;
+		assign.removed = true;
+	}
+}
+
+// Removes type adjustments of slots that are replaced before being read.
+static void _remove_type_adjusts(const int *p_code, LocalVector<GDScriptOptimizer::Instruction> &p_instructions, const LocalVector<bool> &p_block_starts) {
+	for (uint32_t i = 0; i < p_instructions.size(); i++) {
+		GDScriptOptimizer::Instruction &adjust = p_instructions[i];
+		if (adjust.removed || !_is_type_adjust(p_code[adjust.ip])) {
+			continue;
+		}
+
+		const int address = p_code[adjust.ip + 1];
+		for (uint32_t j = i + 1; j < p_instructions.size() && !p_block_starts[j]; j++) {
+			GDScriptOptimizer::Instruction &instruction = p_instructions[j];
+			if (instruction.removed) {
+				continue;
+			}
+			if (p_code[instruction.ip] == p_code[adjust.ip] && p_code[instruction.ip + 1] == address) {
+				// Adjusting to the same type again does nothing.
+				instruction.removed = true;
+				continue;
+			}
+			if (_operand_used(p_code, instruction, instruction.reads, address)) {
+				break;
+			}
+			if (_operand_used(p_code, instruction, instruction.writes, address)) {
+				adjust.removed = instruction.replaces;
+				break;
+			}
+			if (instruction.jump != -1 || _is_exit(p_code[instruction.ip])) {
+				break;
+			}
+		}
+	}
+}
+
+static bool _is_removable_store(int p_opcode) {
+	switch (p_opcode) {
+		case GDScriptFunction::OPCODE_ASSIGN:
+		case GDScriptFunction::OPCODE_ASSIGN_NULL:
+		case GDScriptFunction::OPCODE_ASSIGN_TRUE:
+		case GDScriptFunction::OPCODE_ASSIGN_FALSE:
+		case GDScriptFunction::OPCODE_ASSIGN_TYPED_BUILTIN:
+		case GDScriptFunction::OPCODE_CONSTRUCT_VALIDATED:
+			return true;
+		default:
+			return _is_type_adjust(p_opcode) || (p_opcode >= GDScriptFunction::OPCODE_OPERATOR_ADD_INT && p_opcode <= GDScriptFunction::OPCODE_OPERATOR_GREATER_EQUAL_FLOAT);
+	}
+}
+
+// Removes the side effect free instructions writing to locals that are never read.
+static void _remove_dead_stores(const int *p_code, LocalVector<GDScriptOptimizer::Instruction> &p_instructions, int p_first_local, int p_stack_size) {
+	LocalVector<int> reads;
+	reads.resize(p_stack_size);
+
+	bool changed = true;
+	while (changed) {
+		changed = false;
+
+		for (int &count : reads) {
+			count = 0;
+		}
+		for (const GDScriptOptimizer::Instruction &instruction : p_instructions) {
+			// Adjustments only read the slot to keep its value.
+			if (instruction.removed || _is_type_adjust(p_code[instruction.ip])) {
+				continue;
+			}
+			for (int operand : instruction.reads) {
+				int slot = _get_stack_slot(p_code[instruction.ip + operand]);
+				if (slot >= 0 && slot < p_stack_size) {
+					reads[slot]++;
+				}
+			}
+		}
+
+		for (GDScriptOptimizer::Instruction &instruction : p_instructions) {
+			if (instruction.removed || instruction.writes.size() != 1 || !_is_removable_store(p_code[instruction.ip])) {
+				continue;
+			}
+			int slot = _get_stack_slot(p_code[instruction.ip + instruction.writes[0]]);
+			if (slot >= p_first_local && slot < p_stack_size && reads[slot] == 0) {
+				instruction.removed = true;
+				changed = true;
+			}
+		}
+	}
+}
+
+void GDScriptOptimizer::optimize_function(GDScriptFunction *p_function) {
+	ERR_FAIL_NULL(p_function);
+
+	// Default arguments add entry points in the middle of the code.
+	if (p_function->_code_size == 0 || p_function->_default_arg_count > 0 || p_function->is_vararg()) {
+		return;
+	}
+
+	int *code = p_function->_code_ptr;
+	const int code_size = p_function->_code_size;
+	const int stack_size = p_function->_stack_size;
+
+	LocalVector<Instruction> instructions;
+	HashSet<int> targets;
+	int ip = 0;
+	while (ip < code_size) {
+		Instruction instruction;
+		if (!decode_instruction(code, ip, code_size, instruction)) {
+			return;
+		}
+		for (int operand : instruction.reads) {
+			if (_get_stack_slot(code[ip + operand]) >= stack_size) {
+				return;
+			}
+		}
+		for (int operand : instruction.writes) {
+			if (_get_stack_slot(code[ip + operand]) >= stack_size) {
+				return;
+			}
+		}
+		if (instruction.jump != -1) {
+			int target = code[ip + instruction.jump];
+			if (target < 0 || target > code_size) {
+				return;
+			}
+			targets.insert(target);
+		}
+		ip += instruction.size;
+		instructions.push_back(instruction);
+	}
+
+	// Jumps must land on instructions.
+	HashSet<int> instruction_ips;
+	for (const Instruction &instruction : instructions) {
+		instruction_ips.insert(instruction.ip);
+	}
+	for (int target : targets) {
+		if (target != code_size && !instruction_ips.has(target)) {
+			return;
+		}
+	}
+
+	LocalVector<bool> block_starts;
+	block_starts.resize(instructions.size());
+	for (uint32_t i = 0; i < instructions.size(); i++) {
+		const Instruction &previous = instructions[i > 0 ? i - 1 : 0];
+		block_starts[i] = i == 0 || targets.has(instructions[i].ip) || previous.jump != -1 || _is_exit(code[previous.ip]);
+	}
+
+	const int first_local = GDScriptFunction::FIXED_ADDRESSES_MAX + p_function->_argument_count;
+	_propagate_constants(p_function, code, instructions, block_starts, first_local, p_function->_constants_ptr);
+
+	// The debugger lists the locals from their slots and source lines, so when they are tracked
+	// the code keeps every instruction and slot, only the reads are replaced in place.
+	if (!p_function->stack_debug.is_empty()) {
+		return;
+	}
+
+	_fold_assignments(code, instructions, block_starts, first_local);
+	_remove_type_adjusts(code, instructions, block_starts);
+	_remove_dead_stores(code, instructions, first_local, stack_size);
+
+	// Reuse the slots that are no longer used.
+	LocalVector<int> slots;
+	slots.resize(stack_size);
+	for (int i = 0; i < stack_size; i++) {
+		slots[i] = i < first_local ? i : -1;
+	}
+	for (const Instruction &instruction : instructions) {
+		if (instruction.removed) {
+			continue;
+		}
+		for (int operand : instruction.reads) {
+			int slot = _get_stack_slot(code[instruction.ip + operand]);
+			if (slot >= 0) {
+				slots[slot] = slot;
+			}
+		}
+		for (int operand : instruction.writes) {
+			int slot = _get_stack_slot(code[instruction.ip + operand]);
+			if (slot >= 0) {
+				slots[slot] = slot;
+			}
+		}
+	}
+	int new_stack_size = 0;
+	for (int &slot : slots) {
+		if (slot != -1) {
+			slot = new_stack_size++;
+		}
+	}
+
+	// Positions of the instructions once the removed ones are gone, removed instructions map to the next one.
+	HashMap<int, int> positions;
+	int new_code_size = 0;
+	for (const Instruction &instruction : instructions) {
+		positions[instruction.ip] = new_code_size;
+		if (!instruction.removed) {
+			new_code_size += instruction.size;
+		}
+	}
+	positions[code_size] = new_code_size;
+
+	if (new_code_size == code_size && new_stack_size == stack_size) {
+		return;
+	}
+
+	Vector<int> new_code;
+	new_code.resize(new_code_size);
+	int *dst = new_code.ptrw();
+	LocalVector<int> remapped;
+	for (const Instruction &instruction : instructions) {
+		if (instruction.removed) {
+			continue;
+		}
+		memcpy(dst, &code[instruction.ip], sizeof(int) * instruction.size);
+
+		remapped.clear();
+		for (int operand : instruction.reads) {
+			remapped.push_back(operand);
+		}
+		for (int operand : instruction.writes) {
+			if (!remapped.has(operand)) {
+				remapped.push_back(operand);
+			}
+		}
+		for (int operand : remapped) {
+			int slot = _get_stack_slot(dst[operand]);
+			if (slot >= 0) {
+				dst[operand] = slots[slot] | (GDScriptFunction::ADDR_TYPE_STACK << GDScriptFunction::ADDR_BITS);
+			}
+		}
+		if (instruction.jump != -1) {
+			dst[instruction.jump] = positions[dst[instruction.jump]];
+		}
+
+		dst += instruction.size;
+	}
+
+	TightLocalVector<Pair<int, Variant::Type>> temporary_slots;
+	for (const Pair<int, Variant::Type> &E : p_function->temporary_slots) {
+		if (slots[E.first] != -1) {
+			temporary_slots.push_back(Pair(slots[E.first], E.second));
+		}
+	}
+
+	p_function->code = new_code;
+	p_function->_code_ptr = &p_function->code.write[0];
+	p_function->_code_size = new_code_size;
+	p_function->temporary_slots = temporary_slots;
+	p_function->_stack_size = new_stack_size;
+}
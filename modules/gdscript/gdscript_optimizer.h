@@ -0,0 +1,56 @@
+/**************************************************************************/
+/*  gdscript_optimizer.h                                                  */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+#pragma once
+
+#include "gdscript_function.h"
+
+#include "core/templates/local_vector.h"
+
+// Optimization pass over the bytecode of a compiled function, enabled by the "gdscript/optimize_bytecode" export option.
+//
+// It only runs on functions made of instructions it can decode (see `decode_instruction()`), which covers typed and
+// validated operations, assignments, loops over ranges and validated calls. It propagates constants assigned once to
+// locals, folds an assignment into the instruction that computed its source, removes type adjustments and stores
+// that are never observed, then drops the stack slots that are no longer used.
+class GDScriptOptimizer {
+public:
+	struct Instruction {
+		int ip = 0;
+		int size = 0;
+		int jump = -1; // Offset of the jump target operand, if any.
+		LocalVector<int> reads; // Offsets of the address operands that are read.
+		LocalVector<int> writes; // Offsets of the address operands that are written.
+		bool replaces = false; // Whether the writes replace the whole value, rather than modifying it in place.
+		bool removed = false;
+	};
+
+	static bool decode_instruction(const int *p_code, int p_ip, int p_code_size, Instruction &r_instruction);
+	static void optimize_function(GDScriptFunction *p_function);
+};
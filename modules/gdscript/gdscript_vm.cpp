@@ -31,10 +31,13 @@
 #include "gdscript.h"
 #include "gdscript_function.h"
 #include "gdscript_lambda_callable.h"
+#include "gdscript_native_code.h"
 
+#include "core/config/engine.h"
 #include "core/object/class_db.h"
 #include "core/os/os.h"
 #include "core/profiling/profiling.h"
+#include "scene/scene_string_names.h"
 
 #ifdef DEBUG_ENABLED
 
@@ -117,6 +120,255 @@ void GDScriptFunction::_profile_native_call(uint64_t p_t_taken, const String &p_
 
 #endif // DEBUG_ENABLED
 
+const GDScriptFunction::InlineCache::Entry *GDScriptFunction::_inline_cache_find(const InlineCache &p_cache, const Variant *p_base, Object *&r_object, GDScriptInstance *&r_instance) {
+	const uint32_t count = p_cache.count.get();
+	if (count == 0 || p_base->get_type() != Variant::OBJECT) {
+		return nullptr;
+	}
+
+	Object *obj = p_base->get_validated_object();
+	if (unlikely(!obj)) {
+		return nullptr;
+	}
+
+	GDScriptInstance *instance = nullptr;
+	uint64_t script_id = 0;
+	ScriptInstance *si = obj->get_script_instance();
+	if (si) {
+		if (si->is_placeholder() || si->get_language() != GDScriptLanguage::get_singleton()) {
+			return nullptr;
+		}
+		instance = static_cast<GDScriptInstance *>(si);
+		script_id = instance->script->compile_id;
+		if (script_id == 0) {
+			return nullptr;
+		}
+	}
+
+	const StringName &native_class = obj->get_class_name();
+	for (uint32_t i = 0; i < count; i++) {
+		const InlineCache::Entry &entry = p_cache.entries[i];
+		if (entry.script_id == script_id && entry.native_class == native_class) {
+			r_object = obj;
+			r_instance = instance;
+			return &entry;
+		}
+	}
+	return nullptr;
+}
+
+bool GDScriptFunction::_inline_cache_get(const InlineCache &p_cache, const Variant *p_base, Variant &r_ret) {
+	Object *obj = nullptr;
+	GDScriptInstance *instance = nullptr;
+	const InlineCache::Entry *entry = _inline_cache_find(p_cache, p_base, obj, instance);
+	if (!entry) {
+		return false;
+	}
+
+	switch (entry->kind) {
+		case InlineCache::KIND_NATIVE_GETTER: {
+			Callable::CallError ce;
+			r_ret = entry->method->call(obj, nullptr, 0, ce);
+			return true;
+		}
+		case InlineCache::KIND_SCRIPT_MEMBER: {
+			r_ret = instance->members[entry->member_index];
+			return true;
+		}
+		default: {
+			return false;
+		}
+	}
+}
+
+bool GDScriptFunction::_inline_cache_set(const InlineCache &p_cache, const Variant *p_base, const Variant *p_value, bool &r_valid) {
+	Object *obj = nullptr;
+	GDScriptInstance *instance = nullptr;
+	const InlineCache::Entry *entry = _inline_cache_find(p_cache, p_base, obj, instance);
+	if (!entry) {
+		return false;
+	}
+
+	switch (entry->kind) {
+		case InlineCache::KIND_NATIVE_SETTER: {
+			Callable::CallError ce;
+			entry->method->call(obj, &p_value, 1, ce);
+			r_valid = ce.error == Callable::CallError::CALL_OK;
+			return true;
+		}
+		case InlineCache::KIND_SCRIPT_MEMBER: {
+			// Values that need a conversion take the slow path.
+			if (!entry->member_type->is_type(*p_value)) {
+				return false;
+			}
+			instance->members[entry->member_index] = *p_value;
+			r_valid = true;
+			return true;
+		}
+		default: {
+			return false;
+		}
+	}
+}
+
+bool GDScriptFunction::_inline_cache_call(const InlineCache &p_cache, const Variant *p_base, const Variant **p_args, int p_argcount, Variant &r_ret, Callable::CallError &r_err) {
+	Object *obj = nullptr;
+	GDScriptInstance *instance = nullptr;
+	const InlineCache::Entry *entry = _inline_cache_find(p_cache, p_base, obj, instance);
+	if (!entry) {
+		return false;
+	}
+
+#ifdef DEBUG_ENABLED
+	_ObjectDebugLock debug_lock(obj);
+#endif
+
+	switch (entry->kind) {
+		case InlineCache::KIND_NATIVE_METHOD: {
+			r_ret = entry->method->call(obj, p_args, p_argcount, r_err);
+			return true;
+		}
+		case InlineCache::KIND_SCRIPT_FUNCTION: {
+			r_ret = entry->function->call(instance, p_args, p_argcount, r_err);
+			return true;
+		}
+		default: {
+			return false;
+		}
+	}
+}
+
+bool GDScriptFunction::_inline_cache_resolve(InlineCacheAccess p_access, const Variant *p_base, const StringName &p_name, InlineCache::Entry &r_entry) {
+	if (p_base->get_type() != Variant::OBJECT) {
+		return false;
+	}
+	Object *obj = p_base->get_validated_object();
+	if (!obj) {
+		return false;
+	}
+	if (p_access == INLINE_CACHE_CALL && (p_name == CoreStringName(free_) || p_name == SceneStringName(_ready))) {
+		// Both are special cased by Object::callp() and GDScriptInstance::callp().
+		return false;
+	}
+#ifdef TOOLS_ENABLED
+	if (p_access == INLINE_CACHE_SET && Engine::get_singleton()->is_editor_hint()) {
+		// Object::set() also marks the object as edited.
+		return false;
+	}
+#endif
+
+	ScriptInstance *si = obj->get_script_instance();
+	if (si) {
+		if (si->is_placeholder() || si->get_language() != GDScriptLanguage::get_singleton()) {
+			return false;
+		}
+
+		GDScriptInstance *instance = static_cast<GDScriptInstance *>(si);
+		GDScript *script = instance->script.ptr();
+		if (!script->valid || script->compile_id == 0) {
+			return false;
+		}
+		r_entry.script_id = script->compile_id;
+
+		if (p_access == INLINE_CACHE_CALL) {
+			HashMap<StringName, GDScriptFunction *>::ConstIterator E = script->member_functions.find(p_name);
+			if (E) {
+				r_entry.kind = InlineCache::KIND_SCRIPT_FUNCTION;
+				r_entry.native_class = obj->get_class_name();
+				r_entry.function = E->value;
+				return true;
+			}
+		} else {
+			HashMap<StringName, GDScript::MemberInfo>::ConstIterator E = script->member_indices.find(p_name);
+			if (E) {
+				if (E->value.getter || E->value.setter) {
+					return false;
+				}
+				r_entry.kind = InlineCache::KIND_SCRIPT_MEMBER;
+				r_entry.native_class = obj->get_class_name();
+				r_entry.member_index = E->value.index;
+				r_entry.member_type = &E->value.data_type;
+				return true;
+			}
+		}
+
+		// Only cache the native lookup if no script in the chain can intercept it.
+		const GDScriptLanguage *lang = GDScriptLanguage::get_singleton();
+		for (const GDScript *sptr = script; sptr; sptr = sptr->base.ptr()) {
+			switch (p_access) {
+				case INLINE_CACHE_GET: {
+					if (sptr->constants.has(p_name) || sptr->static_variables_indices.has(p_name) || sptr->_signals.has(p_name) || sptr->member_functions.has(p_name) || sptr->subclasses.has(p_name) || sptr->member_functions.has(lang->strings._get)) {
+						return false;
+					}
+				} break;
+				case INLINE_CACHE_SET: {
+					if (sptr->static_variables_indices.has(p_name) || sptr->member_functions.has(lang->strings._set)) {
+						return false;
+					}
+				} break;
+				case INLINE_CACHE_CALL: {
+					if (sptr->member_functions.has(p_name)) {
+						return false;
+					}
+				} break;
+			}
+		}
+	}
+
+	const StringName &native_class = obj->get_class_name();
+	const ClassDB::APIType api = ClassDB::get_api_type(native_class);
+	if (api != ClassDB::API_CORE && api != ClassDB::API_EDITOR) {
+		// Extension classes may intercept property access.
+		return false;
+	}
+	r_entry.native_class = native_class;
+
+	if (p_access == INLINE_CACHE_CALL) {
+		r_entry.kind = InlineCache::KIND_NATIVE_METHOD;
+		r_entry.method = ClassDB::get_method(native_class, p_name);
+		return r_entry.method != nullptr;
+	}
+
+	bool is_property = false;
+	if (ClassDB::get_property_index(native_class, p_name, &is_property) >= 0 || !is_property) {
+		// Indexed properties need an extra argument.
+		return false;
+	}
+	const StringName accessor = p_access == INLINE_CACHE_GET ? ClassDB::get_property_getter(native_class, p_name) : ClassDB::get_property_setter(native_class, p_name);
+	if (accessor == StringName()) {
+		return false;
+	}
+	r_entry.kind = p_access == INLINE_CACHE_GET ? InlineCache::KIND_NATIVE_GETTER : InlineCache::KIND_NATIVE_SETTER;
+	r_entry.method = ClassDB::get_method(native_class, accessor);
+	return r_entry.method != nullptr;
+}
+
+void GDScriptFunction::_inline_cache_update(InlineCache &p_cache, InlineCacheAccess p_access, const Variant *p_base, const StringName &p_name) {
+	if (p_cache.count.get() >= InlineCache::MAX_ENTRIES || p_cache.misses.get() >= InlineCache::MAX_MISSES) {
+		return;
+	}
+
+	InlineCache::Entry entry;
+	if (!_inline_cache_resolve(p_access, p_base, p_name, entry)) {
+		p_cache.misses.increment();
+		return;
+	}
+
+	MutexLock lock(inline_cache_mutex);
+	const uint32_t count = p_cache.count.get();
+	if (count >= InlineCache::MAX_ENTRIES) {
+		return;
+	}
+	for (uint32_t i = 0; i < count; i++) {
+		if (p_cache.entries[i].script_id == entry.script_id && p_cache.entries[i].native_class == entry.native_class) {
+			// Another thread got there first.
+			return;
+		}
+	}
+	p_cache.entries[count] = entry;
+	p_cache.count.set(count + 1);
+}
+
 Variant GDScriptFunction::_get_default_variant_for_data_type(const GDScriptDataType &p_data_type) {
 	if (p_data_type.kind == GDScriptDataType::BUILTIN) {
 		if (p_data_type.builtin_type == Variant::ARRAY) {
@@ -256,6 +508,37 @@ void (*type_init_function_table[])(Variant *) = {
 	static const void *switch_table_ops[] = { \
 		&&OPCODE_OPERATOR, \
 		&&OPCODE_OPERATOR_VALIDATED, \
+		&&OPCODE_OPERATOR_ADD_INT, \
+		&&OPCODE_OPERATOR_ADD_FLOAT, \
+		&&OPCODE_OPERATOR_ADD_VECTOR2, \
+		&&OPCODE_OPERATOR_ADD_VECTOR3, \
+		&&OPCODE_OPERATOR_SUBTRACT_INT, \
+		&&OPCODE_OPERATOR_SUBTRACT_FLOAT, \
+		&&OPCODE_OPERATOR_SUBTRACT_VECTOR2, \
+		&&OPCODE_OPERATOR_SUBTRACT_VECTOR3, \
+		&&OPCODE_OPERATOR_MULTIPLY_INT, \
+		&&OPCODE_OPERATOR_MULTIPLY_FLOAT, \
+		&&OPCODE_OPERATOR_MULTIPLY_VECTOR2, \
+		&&OPCODE_OPERATOR_MULTIPLY_VECTOR3, \
+		&&OPCODE_OPERATOR_DIVIDE_FLOAT, \
+		&&OPCODE_OPERATOR_DIVIDE_VECTOR2, \
+		&&OPCODE_OPERATOR_DIVIDE_VECTOR3, \
+		&&OPCODE_OPERATOR_MULTIPLY_VECTOR2_FLOAT, \
+		&&OPCODE_OPERATOR_MULTIPLY_VECTOR3_FLOAT, \
+		&&OPCODE_OPERATOR_EQUAL_INT, \
+		&&OPCODE_OPERATOR_EQUAL_FLOAT, \
+		&&OPCODE_OPERATOR_NOT_EQUAL_INT, \
+		&&OPCODE_OPERATOR_NOT_EQUAL_FLOAT, \
+		&&OPCODE_OPERATOR_LESS_INT, \
+		&&OPCODE_OPERATOR_LESS_FLOAT, \
+		&&OPCODE_OPERATOR_LESS_EQUAL_INT, \
+		&&OPCODE_OPERATOR_LESS_EQUAL_FLOAT, \
+		&&OPCODE_OPERATOR_GREATER_INT, \
+		&&OPCODE_OPERATOR_GREATER_FLOAT, \
+		&&OPCODE_OPERATOR_GREATER_EQUAL_INT, \
+		&&OPCODE_OPERATOR_GREATER_EQUAL_FLOAT, \
+		&&OPCODE_INCREMENT_INT, \
+		&&OPCODE_DECREMENT_INT, \
 		&&OPCODE_TYPE_TEST_BUILTIN, \
 		&&OPCODE_TYPE_TEST_ARRAY, \
 		&&OPCODE_TYPE_TEST_DICTIONARY, \
@@ -316,6 +599,18 @@ void (*type_init_function_table[])(Variant *) = {
 		&&OPCODE_JUMP, \
 		&&OPCODE_JUMP_IF, \
 		&&OPCODE_JUMP_IF_NOT, \
+		&&OPCODE_JUMP_IF_NOT_EQUAL_INT, \
+		&&OPCODE_JUMP_IF_NOT_EQUAL_FLOAT, \
+		&&OPCODE_JUMP_IF_NOT_NOT_EQUAL_INT, \
+		&&OPCODE_JUMP_IF_NOT_NOT_EQUAL_FLOAT, \
+		&&OPCODE_JUMP_IF_NOT_LESS_INT, \
+		&&OPCODE_JUMP_IF_NOT_LESS_FLOAT, \
+		&&OPCODE_JUMP_IF_NOT_LESS_EQUAL_INT, \
+		&&OPCODE_JUMP_IF_NOT_LESS_EQUAL_FLOAT, \
+		&&OPCODE_JUMP_IF_NOT_GREATER_INT, \
+		&&OPCODE_JUMP_IF_NOT_GREATER_FLOAT, \
+		&&OPCODE_JUMP_IF_NOT_GREATER_EQUAL_INT, \
+		&&OPCODE_JUMP_IF_NOT_GREATER_EQUAL_FLOAT, \
 		&&OPCODE_JUMP_TO_DEF_ARGUMENT, \
 		&&OPCODE_JUMP_IF_SHARED, \
 		&&OPCODE_RETURN, \
@@ -745,6 +1040,13 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 	bool awaited = false;
 	Variant *variant_addresses[ADDR_TYPE_MAX] = { stack, _constants_ptr, p_instance ? p_instance->members.ptr() : nullptr };
 
+	if (_native_code && GDScriptNativeCode::is_enabled() && !p_state && !EngineDebugger::is_active()) {
+		// The function was compiled ahead of time, see GDScriptNativeCode. The debugger needs the bytecode to step through lines.
+		GDScriptNativeFrame native_frame{ stack, _constants_ptr, _operator_funcs_ptr, _constructors_ptr };
+		_native_code(native_frame, retvalue);
+		goto native_code_exit;
+	}
+
 #ifdef DEBUG_ENABLED
 	OPCODE_WHILE(ip < _code_size) {
 		int last_opcode = _code_ptr[ip];
@@ -857,6 +1159,89 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			}
 			DISPATCH_OPCODE;
 
+#define OPCODE_OPERATOR_TYPED(m_name, m_get_ret, m_get, m_op) \
+	OPCODE(OPCODE_OPERATOR_##m_name) { \
+		CHECK_SPACE(4); \
+		GET_VARIANT_PTR(a, 0); \
+		GET_VARIANT_PTR(b, 1); \
+		GET_VARIANT_PTR(dst, 2); \
+		*VariantInternal::m_get_ret(dst) = *VariantInternal::m_get(a) m_op *VariantInternal::m_get(b); \
+		ip += 4; \
+	} \
+	DISPATCH_OPCODE
+
+			OPCODE_OPERATOR_TYPED(ADD_INT, get_int, get_int, +);
+			OPCODE_OPERATOR_TYPED(ADD_FLOAT, get_float, get_float, +);
+			OPCODE_OPERATOR_TYPED(ADD_VECTOR2, get_vector2, get_vector2, +);
+			OPCODE_OPERATOR_TYPED(ADD_VECTOR3, get_vector3, get_vector3, +);
+			OPCODE_OPERATOR_TYPED(SUBTRACT_INT, get_int, get_int, -);
+			OPCODE_OPERATOR_TYPED(SUBTRACT_FLOAT, get_float, get_float, -);
+			OPCODE_OPERATOR_TYPED(SUBTRACT_VECTOR2, get_vector2, get_vector2, -);
+			OPCODE_OPERATOR_TYPED(SUBTRACT_VECTOR3, get_vector3, get_vector3, -);
+			OPCODE_OPERATOR_TYPED(MULTIPLY_INT, get_int, get_int, *);
+			OPCODE_OPERATOR_TYPED(MULTIPLY_FLOAT, get_float, get_float, *);
+			OPCODE_OPERATOR_TYPED(MULTIPLY_VECTOR2, get_vector2, get_vector2, *);
+			OPCODE_OPERATOR_TYPED(MULTIPLY_VECTOR3, get_vector3, get_vector3, *);
+			OPCODE_OPERATOR_TYPED(DIVIDE_FLOAT, get_float, get_float, /);
+			OPCODE_OPERATOR_TYPED(DIVIDE_VECTOR2, get_vector2, get_vector2, /);
+			OPCODE_OPERATOR_TYPED(DIVIDE_VECTOR3, get_vector3, get_vector3, /);
+			OPCODE_OPERATOR_TYPED(EQUAL_INT, get_bool, get_int, ==);
+			OPCODE_OPERATOR_TYPED(EQUAL_FLOAT, get_bool, get_float, ==);
+			OPCODE_OPERATOR_TYPED(NOT_EQUAL_INT, get_bool, get_int, !=);
+			OPCODE_OPERATOR_TYPED(NOT_EQUAL_FLOAT, get_bool, get_float, !=);
+			OPCODE_OPERATOR_TYPED(LESS_INT, get_bool, get_int, <);
+			OPCODE_OPERATOR_TYPED(LESS_FLOAT, get_bool, get_float, <);
+			OPCODE_OPERATOR_TYPED(LESS_EQUAL_INT, get_bool, get_int, <=);
+			OPCODE_OPERATOR_TYPED(LESS_EQUAL_FLOAT, get_bool, get_float, <=);
+			OPCODE_OPERATOR_TYPED(GREATER_INT, get_bool, get_int, >);
+			OPCODE_OPERATOR_TYPED(GREATER_FLOAT, get_bool, get_float, >);
+			OPCODE_OPERATOR_TYPED(GREATER_EQUAL_INT, get_bool, get_int, >=);
+			OPCODE_OPERATOR_TYPED(GREATER_EQUAL_FLOAT, get_bool, get_float, >=);
+
+			OPCODE(OPCODE_OPERATOR_MULTIPLY_VECTOR2_FLOAT) {
+				CHECK_SPACE(4);
+
+				GET_VARIANT_PTR(a, 0);
+				GET_VARIANT_PTR(b, 1);
+				GET_VARIANT_PTR(dst, 2);
+				*VariantInternal::get_vector2(dst) = *VariantInternal::get_vector2(a) * real_t(*VariantInternal::get_float(b));
+
+				ip += 4;
+			}
+			DISPATCH_OPCODE;
+
+			OPCODE(OPCODE_OPERATOR_MULTIPLY_VECTOR3_FLOAT) {
+				CHECK_SPACE(4);
+
+				GET_VARIANT_PTR(a, 0);
+				GET_VARIANT_PTR(b, 1);
+				GET_VARIANT_PTR(dst, 2);
+				*VariantInternal::get_vector3(dst) = *VariantInternal::get_vector3(a) * real_t(*VariantInternal::get_float(b));
+
+				ip += 4;
+			}
+			DISPATCH_OPCODE;
+
+			OPCODE(OPCODE_INCREMENT_INT) {
+				CHECK_SPACE(2);
+
+				GET_VARIANT_PTR(value, 0);
+				(*VariantInternal::get_int(value))++;
+
+				ip += 2;
+			}
+			DISPATCH_OPCODE;
+
+			OPCODE(OPCODE_DECREMENT_INT) {
+				CHECK_SPACE(2);
+
+				GET_VARIANT_PTR(value, 0);
+				(*VariantInternal::get_int(value))--;
+
+				ip += 2;
+			}
+			DISPATCH_OPCODE;
+
 			OPCODE(OPCODE_TYPE_TEST_BUILTIN) {
 				CHECK_SPACE(4);
 
@@ -1201,7 +1586,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			DISPATCH_OPCODE;
 
 			OPCODE(OPCODE_SET_NAMED) {
-				CHECK_SPACE(3);
+				CHECK_SPACE(4);
 
 				GET_VARIANT_PTR(dst, 0);
 				GET_VARIANT_PTR(value, 1);
@@ -1211,8 +1596,17 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				GD_ERR_BREAK(indexname < 0 || indexname >= _global_names_count);
 				const StringName *index = &_global_names_ptr[indexname];
 
-				bool valid;
-				dst->set_named(*index, *value, valid);
+				int cache_idx = _code_ptr[ip + 4];
+				GD_ERR_BREAK(cache_idx < 0 || cache_idx >= _inline_caches_count);
+				InlineCache &cache = _inline_caches_ptr[cache_idx];
+
+				bool valid = false;
+				if (!_inline_cache_set(cache, dst, value, valid)) {
+					dst->set_named(*index, *value, valid);
+					if (valid) {
+						_inline_cache_update(cache, INLINE_CACHE_SET, dst, *index);
+					}
+				}
 
 #ifdef DEBUG_ENABLED
 				if (!valid) {
@@ -1233,7 +1627,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 					OPCODE_BREAK;
 				}
 #endif
-				ip += 4;
+				ip += 5;
 			}
 			DISPATCH_OPCODE;
 
@@ -1253,7 +1647,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			DISPATCH_OPCODE;
 
 			OPCODE(OPCODE_GET_NAMED) {
-				CHECK_SPACE(4);
+				CHECK_SPACE(5);
 
 				GET_VARIANT_PTR(src, 0);
 				GET_VARIANT_PTR(dst, 1);
@@ -1263,22 +1657,27 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				GD_ERR_BREAK(indexname < 0 || indexname >= _global_names_count);
 				const StringName *index = &_global_names_ptr[indexname];
 
-				bool valid;
-#ifdef DEBUG_ENABLED
-				//allow better error message in cases where src and dst are the same stack position
-				Variant ret = src->get_named(*index, valid);
+				int cache_idx = _code_ptr[ip + 4];
+				GD_ERR_BREAK(cache_idx < 0 || cache_idx >= _inline_caches_count);
+				InlineCache &cache = _inline_caches_ptr[cache_idx];
 
-#else
-				*dst = src->get_named(*index, valid);
-#endif
+				// Allow better error message in cases where src and dst are the same stack position.
+				Variant ret;
+				bool valid = _inline_cache_get(cache, src, ret);
+				if (!valid) {
+					ret = src->get_named(*index, valid);
+					if (valid) {
+						_inline_cache_update(cache, INLINE_CACHE_GET, src, *index);
+					}
+				}
 #ifdef DEBUG_ENABLED
 				if (!valid) {
 					err_text = "Invalid access to property or key '" + index->string() + "' on a base object of type '" + _get_var_type(src) + "'.";
 					OPCODE_BREAK;
 				}
-				*dst = ret;
 #endif
-				ip += 4;
+				*dst = ret;
+				ip += 5;
 			}
 			DISPATCH_OPCODE;
 
@@ -1901,7 +2300,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				bool call_async = (_code_ptr[ip]) == OPCODE_CALL_ASYNC;
 #endif
 				LOAD_INSTRUCTION_ARGS
-				CHECK_SPACE(3 + instr_arg_count);
+				CHECK_SPACE(4 + instr_arg_count);
 
 				ip += instr_arg_count;
 
@@ -1912,6 +2311,10 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				GD_ERR_BREAK(methodname_idx < 0 || methodname_idx >= _global_names_count);
 				const StringName *methodname = &_global_names_ptr[methodname_idx];
 
+				int cache_idx = _code_ptr[ip + 3];
+				GD_ERR_BREAK(cache_idx < 0 || cache_idx >= _inline_caches_count);
+				InlineCache &cache = _inline_caches_ptr[cache_idx];
+
 				GodotProfileZoneScriptSystemCall(methodname, source, name, *methodname, line);
 
 				GET_INSTRUCTION_ARG(base, argc);
@@ -1932,7 +2335,12 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				Callable::CallError err;
 				if (call_ret) {
 					GET_INSTRUCTION_ARG(ret, argc + 1);
-					base->callp(*methodname, (const Variant **)argptrs, argc, temp_ret, err);
+					if (!_inline_cache_call(cache, base, (const Variant **)argptrs, argc, temp_ret, err)) {
+						base->callp(*methodname, (const Variant **)argptrs, argc, temp_ret, err);
+						if (err.error == Callable::CallError::CALL_OK) {
+							_inline_cache_update(cache, INLINE_CACHE_CALL, base, *methodname);
+						}
+					}
 					*ret = temp_ret;
 #ifdef DEBUG_ENABLED
 					if (ret->get_type() == Variant::NIL) {
@@ -1962,7 +2370,12 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 					}
 #endif
 				} else {
-					base->callp(*methodname, (const Variant **)argptrs, argc, temp_ret, err);
+					if (!_inline_cache_call(cache, base, (const Variant **)argptrs, argc, temp_ret, err)) {
+						base->callp(*methodname, (const Variant **)argptrs, argc, temp_ret, err);
+						if (err.error == Callable::CallError::CALL_OK) {
+							_inline_cache_update(cache, INLINE_CACHE_CALL, base, *methodname);
+						}
+					}
 				}
 #ifdef DEBUG_ENABLED
 
@@ -2017,7 +2430,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				}
 #endif // DEBUG_ENABLED
 
-				ip += 3;
+				ip += 4;
 			}
 			DISPATCH_OPCODE;
 
@@ -2773,6 +3186,34 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			}
 			DISPATCH_OPCODE;
 
+#define OPCODE_JUMP_IF_NOT_TYPED(m_name, m_get, m_op) \
+	OPCODE(OPCODE_JUMP_IF_NOT_##m_name) { \
+		CHECK_SPACE(4); \
+		GET_VARIANT_PTR(a, 0); \
+		GET_VARIANT_PTR(b, 1); \
+		if (!(*VariantInternal::m_get(a) m_op *VariantInternal::m_get(b))) { \
+			int to = _code_ptr[ip + 3]; \
+			GD_ERR_BREAK(to < 0 || to > _code_size); \
+			ip = to; \
+		} else { \
+			ip += 4; \
+		} \
+	} \
+	DISPATCH_OPCODE
+
+			OPCODE_JUMP_IF_NOT_TYPED(EQUAL_INT, get_int, ==);
+			OPCODE_JUMP_IF_NOT_TYPED(EQUAL_FLOAT, get_float, ==);
+			OPCODE_JUMP_IF_NOT_TYPED(NOT_EQUAL_INT, get_int, !=);
+			OPCODE_JUMP_IF_NOT_TYPED(NOT_EQUAL_FLOAT, get_float, !=);
+			OPCODE_JUMP_IF_NOT_TYPED(LESS_INT, get_int, <);
+			OPCODE_JUMP_IF_NOT_TYPED(LESS_FLOAT, get_float, <);
+			OPCODE_JUMP_IF_NOT_TYPED(LESS_EQUAL_INT, get_int, <=);
+			OPCODE_JUMP_IF_NOT_TYPED(LESS_EQUAL_FLOAT, get_float, <=);
+			OPCODE_JUMP_IF_NOT_TYPED(GREATER_INT, get_int, >);
+			OPCODE_JUMP_IF_NOT_TYPED(GREATER_FLOAT, get_float, >);
+			OPCODE_JUMP_IF_NOT_TYPED(GREATER_EQUAL_INT, get_int, >=);
+			OPCODE_JUMP_IF_NOT_TYPED(GREATER_EQUAL_FLOAT, get_float, >=);
+
 			OPCODE(OPCODE_JUMP_TO_DEF_ARGUMENT) {
 				CHECK_SPACE(2);
 				ip = _default_arg_ptr[defarg];
@@ -3975,6 +4416,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 	}
 
 	OPCODES_OUT
+native_code_exit:
 #ifdef DEBUG_ENABLED
 	if (GDScriptLanguage::get_singleton()->profiling) {
 		uint64_t time_taken = OS::get_singleton()->get_ticks_usec() - function_start_time;
@@ -32,6 +32,7 @@
 
 #include "gdscript.h"
 #include "gdscript_cache.h"
+#include "gdscript_native_code.h"
 #include "gdscript_parser.h"
 #include "gdscript_resource_format.h"
 #include "gdscript_tokenizer_buffer.h"
@@ -87,18 +88,99 @@ class GDScriptExportPlugin : public EditorExportPlugin {
 	static constexpr EditorExportPreset::ScriptExportMode DEFAULT_SCRIPT_MODE = EditorExportPreset::MODE_SCRIPT_BINARY_TOKENS_COMPRESSED;
 	EditorExportPreset::ScriptExportMode script_mode = DEFAULT_SCRIPT_MODE;
 
+	String native_code_path;
+	bool optimize_bytecode = false;
+	Vector<Ref<GDScript>> native_code_scripts;
+	Vector<const GDScriptFunction *> native_code_functions;
+
+	void _add_native_code_functions(const Ref<GDScript> &p_script) {
+		for (const KeyValue<StringName, GDScriptFunction *> &E : p_script->get_member_functions()) {
+			if (GDScriptNativeCode::can_compile(E.value)) {
+				native_code_functions.push_back(E.value);
+			}
+		}
+		for (const KeyValue<GDScriptFunction *, GDScript::LambdaInfo> &E : p_script->get_lambda_info()) {
+			if (GDScriptNativeCode::can_compile(E.key)) {
+				native_code_functions.push_back(E.key);
+			}
+		}
+		for (const KeyValue<StringName, Ref<GDScript>> &E : p_script->get_subclasses()) {
+			_add_native_code_functions(E.value);
+		}
+	}
+
 protected:
+	virtual void _get_export_options(const Ref<EditorExportPlatform> &p_export_platform, List<EditorExportPlatform::ExportOption> *r_options) const override {
+		r_options->push_back(EditorExportPlatform::ExportOption(PropertyInfo(Variant::STRING, "gdscript/native_code_output", PROPERTY_HINT_GLOBAL_SAVE_FILE, "*.cpp"), ""));
+		r_options->push_back(EditorExportPlatform::ExportOption(PropertyInfo(Variant::BOOL, "gdscript/optimize_bytecode"), false));
+	}
+
+	virtual PackedStringArray _get_export_features(const Ref<EditorExportPlatform> &p_export_platform, bool p_debug) const override {
+		PackedStringArray ret;
+
+		Ref<EditorExportPreset> preset = get_export_preset();
+		ERR_FAIL_COND_V(preset.is_null(), ret);
+
+		// Enables GDScriptOptimizer in the exported project.
+		if (get_option("gdscript/optimize_bytecode")) {
+			ret.append("gdscript_optimized");
+		}
+		return ret;
+	}
+
 	virtual void _export_begin(const HashSet<String> &p_features, bool p_debug, const String &p_path, int p_flags) override {
 		script_mode = DEFAULT_SCRIPT_MODE;
+		native_code_path = String();
+		optimize_bytecode = false;
+		native_code_scripts.clear();
+		native_code_functions.clear();
 
 		const Ref<EditorExportPreset> &preset = get_export_preset();
 		if (preset.is_valid()) {
 			script_mode = preset->get_script_export_mode();
+			native_code_path = get_option("gdscript/native_code_output");
+			optimize_bytecode = get_option("gdscript/optimize_bytecode");
 		}
 	}
 
+	// Compiles a copy of the script the way the exported project does, so the native code matches its bytecode.
+	Ref<GDScript> _compile_optimized(const Ref<GDScript> &p_script) {
+		Ref<GDScript> copy;
+		copy.instantiate();
+		copy->set_source_code(p_script->get_source_code());
+		copy->set_path_cache(p_script->get_path());
+
+		GDScriptLanguage *language = GDScriptLanguage::get_singleton();
+		const bool was_optimizing = language->should_optimize_bytecode();
+		language->set_optimize_bytecode(true);
+		const Error err = copy->reload();
+		language->set_optimize_bytecode(was_optimizing);
+
+		if (err != OK || !copy->is_valid()) {
+			WARN_PRINT(vformat("GDScript: Cannot compile optimized bytecode of \"%s\", no native code is generated for it.", p_script->get_path()));
+			return Ref<GDScript>();
+		}
+		return copy;
+	}
+
 	virtual void _export_file(const String &p_path, const String &p_type, const HashSet<String> &p_features) override {
-		if (p_path.get_extension() != "gd" || script_mode == EditorExportPreset::MODE_SCRIPT_TEXT) {
+		if (p_path.get_extension() != "gd") {
+			return;
+		}
+
+		if (!native_code_path.is_empty()) {
+			Ref<GDScript> scr = ResourceLoader::load(p_path);
+			if (optimize_bytecode && scr.is_valid() && scr->is_valid()) {
+				scr = _compile_optimized(scr);
+			}
+			if (scr.is_valid() && scr->is_valid()) {
+				// Keep the script alive so its functions are valid until the source is generated.
+				native_code_scripts.push_back(scr);
+				_add_native_code_functions(scr);
+			}
+		}
+
+		if (script_mode == EditorExportPreset::MODE_SCRIPT_TEXT) {
 			return;
 		}
 
@@ -117,6 +199,22 @@ protected:
 		add_file(p_path.get_basename() + ".gdc", file, true);
 	}
 
+	virtual void _export_end() override {
+		if (!native_code_path.is_empty()) {
+			Error err;
+			Ref<FileAccess> f = FileAccess::open(native_code_path, FileAccess::WRITE, &err);
+			if (f.is_valid()) {
+				f->store_string(GDScriptNativeCode::generate_source(native_code_functions));
+				print_line(vformat("GDScript: Generated native code for %d functions in \"%s\".", native_code_functions.size(), native_code_path));
+			} else {
+				ERR_PRINT(vformat("Cannot write GDScript native code to \"%s\": %s.", native_code_path, error_names[err]));
+			}
+		}
+
+		native_code_functions.clear();
+		native_code_scripts.clear();
+	}
+
 public:
 	virtual String get_name() const override { return "GDScript"; }
 };
@@ -152,6 +250,10 @@ void initialize_gdscript_module(ModuleInitializationLevel p_level) {
 		gdscript_cache = memnew(GDScriptCache);
 
 		GDScriptUtilityFunctions::register_functions();
+
+#ifdef GDSCRIPT_NATIVE_CODE_ENABLED
+		register_gdscript_native_code();
+#endif
 	}
 
 #ifdef TOOLS_ENABLED
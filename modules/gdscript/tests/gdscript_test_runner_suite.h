@@ -31,6 +31,7 @@
 #pragma once
 
 #include "../gdscript_cache.h"
+#include "../gdscript_native_code.h"
 #include "gdscript_test_runner.h"
 
 #include "core/io/file_access.h"
@@ -112,6 +113,115 @@ TEST_CASE("[Modules][GDScript] Loading keeps ResourceCache and GDScriptCache in
 	CHECK(TestGDScriptCacheAccessor::has_full(path));
 }
 
+TEST_CASE("[Modules][GDScript] Native code is only generated for typed functions") {
+	GDScriptLanguage::get_singleton()->init();
+	const String source = R"(
+static func typed_sum(count: int) -> int:
+	var total := 0
+	for i in range(count):
+		if i > 2:
+			total += i * 2
+	return total
+
+static func untyped_sum(count):
+	var total = 0
+	for i in count:
+		total += i
+	return total
+)";
+
+	Ref<GDScript> gdscript = memnew(GDScript);
+	gdscript->set_source_code(source);
+	ERR_PRINT_OFF;
+	REQUIRE(gdscript->reload() == OK);
+	ERR_PRINT_ON;
+
+	const GDScriptFunction *typed = gdscript->get_member_functions()[StringName("typed_sum")];
+	const GDScriptFunction *untyped = gdscript->get_member_functions()[StringName("untyped_sum")];
+	CHECK(GDScriptNativeCode::can_compile(typed));
+	CHECK_FALSE(GDScriptNativeCode::can_compile(untyped));
+
+	// The hash identifies the same bytecode across compilations.
+	Ref<GDScript> other = memnew(GDScript);
+	other->set_source_code(source);
+	ERR_PRINT_OFF;
+	REQUIRE(other->reload() == OK);
+	ERR_PRINT_ON;
+	CHECK(GDScriptNativeCode::hash_function(typed) == GDScriptNativeCode::hash_function(other->get_member_functions()[StringName("typed_sum")]));
+
+#ifdef TOOLS_ENABLED
+	Vector<const GDScriptFunction *> functions;
+	functions.push_back(typed);
+	const String generated = GDScriptNativeCode::generate_source(functions);
+	CHECK(generated.contains("static void gdscript_native_0(GDScriptNativeFrame &p_frame, Variant &r_ret)"));
+	CHECK(generated.contains(vformat("GDScriptNativeCode::register_function(0x%sULL, &gdscript_native_0);", String::num_uint64(GDScriptNativeCode::hash_function(typed), 16))));
+#endif // TOOLS_ENABLED
+
+	CHECK(gdscript->call(SNAME("typed_sum"), 6) == Variant(24));
+
+	// Exported projects with optimized bytecode run different code, so their native code is generated from it.
+	GDScriptLanguage::get_singleton()->set_optimize_bytecode(true);
+	Ref<GDScript> optimized = memnew(GDScript);
+	optimized->set_source_code(source);
+	ERR_PRINT_OFF;
+	const Error err = optimized->reload();
+	ERR_PRINT_ON;
+	GDScriptLanguage::get_singleton()->set_optimize_bytecode(false);
+	REQUIRE(err == OK);
+
+	const GDScriptFunction *optimized_typed = optimized->get_member_functions()[StringName("typed_sum")];
+	CHECK(GDScriptNativeCode::can_compile(optimized_typed));
+	CHECK(GDScriptNativeCode::hash_function(optimized_typed) != GDScriptNativeCode::hash_function(typed));
+	CHECK(optimized->call(SNAME("typed_sum"), 6) == Variant(24));
+}
+
+TEST_CASE("[Modules][GDScript] Optimized bytecode gives the same results") {
+	GDScriptLanguage::get_singleton()->init();
+	const String source = R"(
+static func scaled(x: int) -> int:
+	return x * 3 + 1
+
+static func magnitude(x: float) -> float:
+	return x if x > 0.0 else -x
+
+static func compute(count: int) -> int:
+	var step := 2
+	var total := 0
+	for i in range(count):
+		total += scaled(i) * step
+	return total
+
+static func distance(a: float, b: float) -> float:
+	return magnitude(a - b) + magnitude(b - a)
+)";
+
+	Ref<GDScript> plain = memnew(GDScript);
+	plain->set_source_code(source);
+	ERR_PRINT_OFF;
+	REQUIRE(plain->reload() == OK);
+	ERR_PRINT_ON;
+
+	GDScriptLanguage::get_singleton()->set_optimize_bytecode(true);
+	Ref<GDScript> optimized = memnew(GDScript);
+	optimized->set_source_code(source);
+	ERR_PRINT_OFF;
+	const Error err = optimized->reload();
+	ERR_PRINT_ON;
+	GDScriptLanguage::get_singleton()->set_optimize_bytecode(false);
+	REQUIRE(err == OK);
+
+	CHECK(plain->call(SNAME("compute"), 4) == Variant(44));
+	CHECK(optimized->call(SNAME("compute"), 4) == Variant(44));
+	CHECK(optimized->call(SNAME("compute"), 0) == Variant(0));
+	CHECK(plain->call(SNAME("distance"), 1.5, 4.0) == Variant(5.0));
+	CHECK(optimized->call(SNAME("distance"), 1.5, 4.0) == Variant(5.0));
+
+	// The constant local and the copies of the inlined results no longer need a slot.
+	const GDScriptFunction *plain_compute = plain->get_member_functions()[StringName("compute")];
+	const GDScriptFunction *optimized_compute = optimized->get_member_functions()[StringName("compute")];
+	CHECK(optimized_compute->get_max_stack_size() < plain_compute->get_max_stack_size());
+}
+
 TEST_CASE("[Modules][GDScript] Validate built-in API") {
 	GDScriptLanguage *lang = GDScriptLanguage::get_singleton();
 
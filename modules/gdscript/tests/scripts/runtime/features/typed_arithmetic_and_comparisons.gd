@@ -0,0 +1,68 @@
+# Typed int/float/vector operations, fused comparison jumps and in-place
+# compound assignments must behave like the generic operators.
+
+func count_up(n: int) -> int:
+	var i: int = 0
+	var total: int = 0
+	while i < n:
+		total += i * 2 - 1
+		i += 1
+	return total
+
+func count_down(n: int) -> int:
+	var steps := 0
+	while n > 0:
+		n -= 1
+		steps += 1
+	return steps
+
+func integrate(steps: int) -> Vector2:
+	var position := Vector2.ZERO
+	var velocity := Vector2(1.5, -2.0)
+	var delta := 0.5
+	for _i in steps:
+		velocity -= Vector2(0.0, 0.25)
+		position += velocity * delta
+	return position
+
+func compare_floats(a: float, b: float) -> Array:
+	var results := []
+	if a == b:
+		results.push_back("==")
+	if a != b:
+		results.push_back("!=")
+	if a < b:
+		results.push_back("<")
+	if a <= b:
+		results.push_back("<=")
+	if a > b:
+		results.push_back(">")
+	if a >= b:
+		results.push_back(">=")
+	return results
+
+func test():
+	print(count_up(10))
+	print(count_down(7))
+	print(integrate(4))
+	print(compare_floats(1.0, 2.0))
+	print(compare_floats(2.0, 2.0))
+	print(compare_floats(3.0, 2.0))
+
+	var a: int = 3
+	var b: int = 5
+	var less: bool = a < b
+	print(less, " ", a >= b, " ", "yes" if a != b else "no")
+	if a < b and b < 10:
+		print("in range")
+
+	var v3 := Vector3(1, 2, 3)
+	v3 *= 2.0
+	v3 /= Vector3(2, 4, 6)
+	v3 += Vector3.ONE
+	print(v3)
+
+	var f: float = 1.0
+	f /= 4.0
+	f -= 0.125
+	print(f)
@@ -0,0 +1,55 @@
+# Untyped member accesses and calls must keep resolving per receiver when
+# the same instruction sees many different receiver types.
+
+class A:
+	var value = "A"
+	func name():
+		return "A"
+
+class B extends A:
+	var extra = 0
+	func name():
+		return "B"
+
+class C:
+	var value = "C":
+		get:
+			return "C (getter)"
+	func name():
+		return "C"
+
+class D:
+	var value: int = 0
+	func _get(property):
+		if property == &"label":
+			return "D (_get)"
+		return null
+	func name():
+		return "D"
+
+func get_value(obj):
+	return obj.value
+
+func call_name(obj):
+	return obj.name()
+
+func set_value(obj, new_value):
+	obj.value = new_value
+
+func test():
+	var receivers = [A.new(), B.new(), C.new(), D.new(), A.new(), B.new()]
+	for i in 2:
+		for receiver in receivers:
+			print(get_value(receiver), " ", call_name(receiver))
+
+	var d = D.new()
+	set_value(d, 1)
+	set_value(d, 2.5)
+	print(d.value)
+	print(d.label)
+
+	var nodes = [Node2D.new(), Control.new(), Node2D.new()]
+	for node in nodes:
+		node.name = "Named"
+		print(node.name, " ", node.get_class())
+		node.free()
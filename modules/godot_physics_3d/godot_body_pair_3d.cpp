@@ -37,6 +37,7 @@
 
 #define MIN_VELOCITY 0.0001
 #define MAX_BIAS_ROTATION (Math::PI / 8)
+#define MANIFOLD_REUSE_MAX_ROTATION 0.002
 
 void GodotBodyPair3D::_contact_added_callback(const Vector3 &p_point_A, int p_index_A, const Vector3 &p_point_B, int p_index_B, const Vector3 &normal, void *p_userdata) {
 	GodotBodyPair3D *pair = static_cast<GodotBodyPair3D *>(p_userdata);
@@ -252,6 +253,31 @@ bool GodotBodyPair3D::_test_ccd(real_t p_step, GodotBody3D *p_A, int p_shape_A,
 	return true;
 }
 
+bool GodotBodyPair3D::_can_reuse_manifold(const Transform3D &p_relative_xform, const GodotShape3D *p_shape_A, const GodotShape3D *p_shape_B) const {
+	if (!manifold_valid || !collided || contact_count == 0) {
+		return false;
+	}
+
+	// The shapes may have been modified since.
+	if (manifold_aabb_A != p_shape_A->get_aabb() || manifold_aabb_B != p_shape_B->get_aabb()) {
+		return false;
+	}
+
+	// Moving less than the recycle radius would only give back the same contacts.
+	real_t max_offset = space->get_contact_recycle_radius() * 0.5;
+	if (p_relative_xform.origin.distance_squared_to(manifold_xform.origin) > max_offset * max_offset) {
+		return false;
+	}
+
+	for (int i = 0; i < 3; i++) {
+		if (p_relative_xform.basis.get_column(i).distance_squared_to(manifold_xform.basis.get_column(i)) > MANIFOLD_REUSE_MAX_ROTATION * MANIFOLD_REUSE_MAX_ROTATION) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
 real_t combine_bounce(GodotBody3D *A, GodotBody3D *B) {
 	return CLAMP(A->get_bounce() + B->get_bounce(), 0, 1);
 }
@@ -265,6 +291,7 @@ bool GodotBodyPair3D::setup(real_t p_step) {
 
 	if (!A->interacts_with(B) || A->has_exception(B->get_self()) || B->has_exception(A->get_self())) {
 		collided = false;
+		manifold_valid = false;
 		return false;
 	}
 
@@ -277,12 +304,14 @@ bool GodotBodyPair3D::setup(real_t p_step) {
 			report_contacts_only = true;
 		} else {
 			collided = false;
+			manifold_valid = false;
 			return false;
 		}
 	}
 
 	offset_B = B->get_transform().get_origin() - A->get_transform().get_origin();
 
+	int prev_contact_count = contact_count;
 	validate_contacts();
 
 	const Vector3 &offset_A = A->get_transform().get_origin();
@@ -296,8 +325,23 @@ bool GodotBodyPair3D::setup(real_t p_step) {
 	GodotShape3D *shape_A_ptr = A->get_shape(shape_A);
 	GodotShape3D *shape_B_ptr = B->get_shape(shape_B);
 
+	Transform3D relative_xform = xform_A.affine_inverse() * xform_B;
+	// A manifold that lost contacts is stale and needs the narrowphase to refill it.
+	if (contact_count == prev_contact_count && _can_reuse_manifold(relative_xform, shape_A_ptr, shape_B_ptr)) {
+		// Resting contact, keep the manifold along with its accumulated impulses.
+		for (int i = 0; i < contact_count; i++) {
+			contacts[i].used = true;
+		}
+		return true;
+	}
+
 	collided = GodotCollisionSolver3D::solve_static(shape_A_ptr, xform_A, shape_B_ptr, xform_B, _contact_added_callback, this, &sep_axis);
 
+	manifold_valid = collided;
+	manifold_xform = relative_xform;
+	manifold_aabb_A = shape_A_ptr->get_aabb();
+	manifold_aabb_B = shape_B_ptr->get_aabb();
+
 	if (!collided) {
 		if (A->is_continuous_collision_detection_enabled() && collide_A) {
 			check_ccd = true;
@@ -96,11 +96,19 @@ class GodotBodyPair3D : public GodotBodyContact3D {
 	Contact contacts[MAX_CONTACTS];
 	int contact_count = 0;
 
+	// Relative transform and shape bounds when the narrowphase last ran, the contacts
+	// are kept without running it again while the shapes are at rest relative to each other.
+	Transform3D manifold_xform;
+	AABB manifold_aabb_A;
+	AABB manifold_aabb_B;
+	bool manifold_valid = false;
+
 	static void _contact_added_callback(const Vector3 &p_point_A, int p_index_A, const Vector3 &p_point_B, int p_index_B, const Vector3 &normal, void *p_userdata);
 
 	void contact_added_callback(const Vector3 &p_point_A, int p_index_A, const Vector3 &p_point_B, int p_index_B, const Vector3 &normal);
 
 	void validate_contacts();
+	bool _can_reuse_manifold(const Transform3D &p_relative_xform, const GodotShape3D *p_shape_A, const GodotShape3D *p_shape_B) const;
 	bool _test_ccd(real_t p_step, GodotBody3D *p_A, int p_shape_A, const Transform3D &p_xform_A, GodotBody3D *p_B, int p_shape_B, const Transform3D &p_xform_B);
 
 public:
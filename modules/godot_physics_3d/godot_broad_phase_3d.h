@@ -31,6 +31,7 @@
 #pragma once
 
 #include "core/math/aabb.h"
+#include "core/templates/local_vector.h"
 
 class GodotCollisionObject3D;
 
@@ -58,6 +59,8 @@ public:
 	virtual int cull_point(const Vector3 &p_point, GodotCollisionObject3D **p_results, int p_max_results, int *p_result_indices = nullptr) = 0;
 	virtual int cull_segment(const Vector3 &p_from, const Vector3 &p_to, GodotCollisionObject3D **p_results, int p_max_results, int *p_result_indices = nullptr) = 0;
 	virtual int cull_aabb(const AABB &p_aabb, GodotCollisionObject3D **p_results, int p_max_results, int *p_result_indices = nullptr) = 0;
+	// The results of segment i are from r_offsets[i] to r_offsets[i + 1] (excluded).
+	virtual void cull_segments(const Vector3 *p_from, const Vector3 *p_to, int p_count, LocalVector<GodotCollisionObject3D *> &r_results, LocalVector<int> &r_result_indices, LocalVector<uint32_t> &r_offsets) = 0;
 
 	virtual void set_pair_callback(PairCallback p_pair_callback, void *p_userdata) = 0;
 	virtual void set_unpair_callback(UnpairCallback p_unpair_callback, void *p_userdata) = 0;
@@ -36,9 +36,22 @@
 #include "nav_region_iteration_2d.h"
 
 #include "core/config/project_settings.h"
+#include "core/templates/sort_array.h"
 
 using namespace Nav2D;
 
+struct PolygonBVHCmpX {
+	bool operator()(const PolygonBVHNode &p_left, const PolygonBVHNode &p_right) const {
+		return p_left.rect.get_center().x < p_right.rect.get_center().x;
+	}
+};
+
+struct PolygonBVHCmpY {
+	bool operator()(const PolygonBVHNode &p_left, const PolygonBVHNode &p_right) const {
+		return p_left.rect.get_center().y < p_right.rect.get_center().y;
+	}
+};
+
 PointKey NavMapBuilder2D::get_point_key(const Vector2 &p_pos, const Vector2 &p_cell_size) {
 	const int x = static_cast<int>(Math::floor(p_pos.x / p_cell_size.x));
 	const int y = static_cast<int>(Math::floor(p_pos.y / p_cell_size.y));
@@ -61,6 +74,8 @@ void NavMapBuilder2D::build_navmap_iteration(NavMapIterationBuild2D &r_build) {
 
 	_build_step_gather_region_polygons(r_build);
 
+	_build_step_polygon_bvh(r_build);
+
 	_build_step_find_edge_connection_pairs(r_build);
 
 	_build_step_merge_edge_connection_pairs(r_build);
@@ -99,6 +114,91 @@ void NavMapBuilder2D::_build_step_gather_region_polygons(NavMapIterationBuild2D
 	r_build.polygon_count = polygon_count;
 }
 
+void NavMapBuilder2D::_build_step_polygon_bvh(NavMapIterationBuild2D &r_build) {
+	NavMapIteration2D *map_iteration = r_build.map_iteration;
+
+	const LocalVector<Ref<NavRegionIteration2D>> &regions = map_iteration->region_iterations;
+	LocalVector<PolygonBVHNode> &polygon_bvh = map_iteration->polygon_bvh;
+	LocalVector<LocalVector<real_t>> &regions_polygons_accumulated_area = map_iteration->regions_polygons_accumulated_area;
+
+	polygon_bvh.clear();
+	map_iteration->polygon_bvh_root = -1;
+
+	regions_polygons_accumulated_area.clear();
+	regions_polygons_accumulated_area.resize(regions.size());
+
+	LocalVector<PolygonBVHNode> leaves;
+	leaves.reserve(r_build.polygon_count);
+
+	for (uint32_t region_index = 0; region_index < regions.size(); region_index++) {
+		const LocalVector<Polygon> &polygons = regions[region_index]->navmesh_polygons;
+
+		LocalVector<real_t> &accumulated_area = regions_polygons_accumulated_area[region_index];
+		accumulated_area.resize(polygons.size());
+		real_t region_accumulated_area = 0.0;
+
+		for (uint32_t polygon_index = 0; polygon_index < polygons.size(); polygon_index++) {
+			const Polygon &polygon = polygons[polygon_index];
+
+			region_accumulated_area += polygon.surface_area;
+			accumulated_area[polygon_index] = region_accumulated_area;
+
+			// Skip polygons that failed to build, they are not valid query results.
+			if (polygon.vertices.size() < 3) {
+				continue;
+			}
+
+			PolygonBVHNode leaf;
+			leaf.polygon = &polygon;
+			leaf.rect.position = polygon.vertices[0];
+			for (uint32_t point_id = 1; point_id < polygon.vertices.size(); point_id++) {
+				leaf.rect.expand_to(polygon.vertices[point_id]);
+			}
+			leaves.push_back(leaf);
+		}
+	}
+
+	if (leaves.is_empty()) {
+		return;
+	}
+
+	// A binary tree with one polygon per leaf never has more than twice the leaf count in nodes.
+	polygon_bvh.reserve(leaves.size() * 2);
+	map_iteration->polygon_bvh_root = _build_polygon_bvh_node(polygon_bvh, leaves.ptr(), leaves.size());
+}
+
+int32_t NavMapBuilder2D::_build_polygon_bvh_node(LocalVector<PolygonBVHNode> &r_bvh, PolygonBVHNode *p_leaves, uint32_t p_size) {
+	if (p_size == 1) {
+		r_bvh.push_back(p_leaves[0]);
+		return r_bvh.size() - 1;
+	}
+
+	Rect2 rect = p_leaves[0].rect;
+	for (uint32_t i = 1; i < p_size; i++) {
+		rect = rect.merge(p_leaves[i].rect);
+	}
+
+	// Split at the median along the longest axis, this keeps the tree balanced.
+	const uint32_t half_size = p_size / 2;
+	if (rect.size.x >= rect.size.y) {
+		SortArray<PolygonBVHNode, PolygonBVHCmpX> sort_x;
+		sort_x.nth_element(0, p_size, half_size, p_leaves);
+	} else {
+		SortArray<PolygonBVHNode, PolygonBVHCmpY> sort_y;
+		sort_y.nth_element(0, p_size, half_size, p_leaves);
+	}
+
+	const int32_t left = _build_polygon_bvh_node(r_bvh, p_leaves, half_size);
+	const int32_t right = _build_polygon_bvh_node(r_bvh, p_leaves + half_size, p_size - half_size);
+
+	PolygonBVHNode node;
+	node.rect = rect;
+	node.left = left;
+	node.right = right;
+	r_bvh.push_back(node);
+	return r_bvh.size() - 1;
+}
+
 void NavMapBuilder2D::_build_step_find_edge_connection_pairs(NavMapIterationBuild2D &r_build) {
 	PerformanceData &performance_data = r_build.performance_data;
 	NavMapIteration2D *map_iteration = r_build.map_iteration;
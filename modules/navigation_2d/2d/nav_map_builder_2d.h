@@ -36,12 +36,15 @@ struct NavMapIterationBuild2D;
 
 class NavMapBuilder2D {
 	static void _build_step_gather_region_polygons(NavMapIterationBuild2D &r_build);
+	static void _build_step_polygon_bvh(NavMapIterationBuild2D &r_build);
 	static void _build_step_find_edge_connection_pairs(NavMapIterationBuild2D &r_build);
 	static void _build_step_merge_edge_connection_pairs(NavMapIterationBuild2D &r_build);
 	static void _build_step_edge_connection_margin_connections(NavMapIterationBuild2D &r_build);
 	static void _build_step_navlink_connections(NavMapIterationBuild2D &r_build);
 	static void _build_update_map_iteration(NavMapIterationBuild2D &r_build);
 
+	static int32_t _build_polygon_bvh_node(LocalVector<Nav2D::PolygonBVHNode> &r_bvh, Nav2D::PolygonBVHNode *p_leaves, uint32_t p_size);
+
 public:
 	static Nav2D::PointKey get_point_key(const Vector2 &p_pos, const Vector2 &p_cell_size);
 
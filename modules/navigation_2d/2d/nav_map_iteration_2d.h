@@ -85,6 +85,13 @@ struct NavMapIteration2D {
 
 	LocalVector<Nav2D::Polygon> navlink_polygons;
 
+	// Bounding volume hierarchy over all region polygons, used by the closest point queries.
+	LocalVector<Nav2D::PolygonBVHNode> polygon_bvh;
+	int32_t polygon_bvh_root = -1;
+
+	// Accumulated polygon surface areas of each region, used by the uniform random point queries.
+	LocalVector<LocalVector<real_t>> regions_polygons_accumulated_area;
+
 	HashMap<NavRegion2D *, Ref<NavRegionIteration2D>> region_ptr_to_region_iteration;
 
 	LocalVector<NavMeshQueries2D::PathQuerySlot> path_query_slots;
@@ -99,6 +106,9 @@ struct NavMapIteration2D {
 		external_region_connections.clear();
 		navbases_polygons_external_connections.clear();
 		navlink_polygons.clear();
+		polygon_bvh.clear();
+		polygon_bvh_root = -1;
+		regions_polygons_accumulated_area.clear();
 		region_ptr_to_region_iteration.clear();
 	}
 };
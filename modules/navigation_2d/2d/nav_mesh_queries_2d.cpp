@@ -85,36 +85,7 @@ Vector2 NavMeshQueries2D::polygons_get_random_point(const LocalVector<Polygon> &
 		uint32_t rrp_polygon_index = region_E->value;
 		ERR_FAIL_UNSIGNED_INDEX_V(rrp_polygon_index, region_polygons.size(), Vector2());
 
-		const Polygon &rr_polygon = region_polygons[rrp_polygon_index];
-
-		real_t accumulated_polygon_area = 0;
-		RBMap<real_t, uint32_t> polygon_area_map;
-
-		for (uint32_t rpp_index = 2; rpp_index < rr_polygon.vertices.size(); rpp_index++) {
-			real_t triangle_area = Triangle2(rr_polygon.vertices[0], rr_polygon.vertices[rpp_index - 1], rr_polygon.vertices[rpp_index]).get_area();
-
-			if (triangle_area == 0.0) {
-				continue;
-			}
-			polygon_area_map[accumulated_polygon_area] = rpp_index;
-			accumulated_polygon_area += triangle_area;
-		}
-		if (polygon_area_map.is_empty() || accumulated_polygon_area == 0) {
-			// All faces have no real surface / no area.
-			return Vector2();
-		}
-
-		real_t polygon_area_map_pos = Math::random(real_t(0), accumulated_polygon_area);
-
-		RBMap<real_t, uint32_t>::Iterator polygon_E = polygon_area_map.find_closest(polygon_area_map_pos);
-		ERR_FAIL_COND_V(!polygon_E, Vector2());
-		uint32_t rrp_face_index = polygon_E->value;
-		ERR_FAIL_UNSIGNED_INDEX_V(rrp_face_index, rr_polygon.vertices.size(), Vector2());
-
-		const Triangle2 triangle(rr_polygon.vertices[0], rr_polygon.vertices[rrp_face_index - 1], rr_polygon.vertices[rrp_face_index]);
-
-		Vector2 triangle_random_position = triangle.get_random_point_inside();
-		return triangle_random_position;
+		return _polygon_get_random_point(region_polygons[rrp_polygon_index]);
 
 	} else {
 		uint32_t rrp_polygon_index = Math::random(int(0), region_polygons.size() - 1);
@@ -892,63 +863,46 @@ ClosestPointQueryResult NavMeshQueries2D::map_iteration_get_closest_point_info(c
 	ClosestPointQueryResult result;
 	real_t closest_point_distance_squared = FLT_MAX;
 
-	// TODO: Check for further 2D improvements.
+	const LocalVector<PolygonBVHNode> &polygon_bvh = p_map_iteration.polygon_bvh;
+	if (p_map_iteration.polygon_bvh_root < 0) {
+		return result;
+	}
 
-	const LocalVector<Ref<NavRegionIteration2D>> &regions = p_map_iteration.region_iterations;
-	for (const Ref<NavRegionIteration2D> &region : regions) {
-		for (const Polygon &polygon : region->get_navmesh_polygons()) {
-			real_t cross = -(polygon.vertices[1] - polygon.vertices[0]).cross(polygon.vertices[2] - polygon.vertices[0]);
-			Vector2 closest_on_polygon;
-			real_t closest = FLT_MAX;
-			bool inside = true;
-			Vector2 previous = polygon.vertices[polygon.vertices.size() - 1];
-			for (uint32_t point_id = 0; point_id < polygon.vertices.size(); ++point_id) {
-				Vector2 edge = polygon.vertices[point_id] - previous;
-				Vector2 to_point = p_point - previous;
-				real_t edge_to_point_cross = -edge.cross(to_point);
-				bool clockwise = (edge_to_point_cross * cross) > 0;
-				// If we are not clockwise, the point will never be inside the polygon and so the closest point will be on an edge.
-				if (!clockwise) {
-					inside = false;
-					real_t point_projected_on_edge = edge.dot(to_point);
-					real_t edge_square = edge.length_squared();
-
-					if (point_projected_on_edge > edge_square) {
-						real_t distance = polygon.vertices[point_id].distance_squared_to(p_point);
-						if (distance < closest) {
-							closest_on_polygon = polygon.vertices[point_id];
-							closest = distance;
-						}
-					} else if (point_projected_on_edge < 0.0) {
-						real_t distance = previous.distance_squared_to(p_point);
-						if (distance < closest) {
-							closest_on_polygon = previous;
-							closest = distance;
-						}
-					} else {
-						// If we project on this edge, this will be the closest point.
-						real_t percent = point_projected_on_edge / edge_square;
-						closest_on_polygon = previous + percent * edge;
-						break;
-					}
-				}
-				previous = polygon.vertices[point_id];
-			}
+	int32_t stack[POLYGON_BVH_STACK_SIZE];
+	uint32_t stack_size = 0;
 
-			if (inside) {
-				closest_point_distance_squared = 0.0;
-				result.point = p_point;
-				result.owner = polygon.owner->get_self();
+	stack[stack_size++] = p_map_iteration.polygon_bvh_root;
+	while (stack_size > 0) {
+		const PolygonBVHNode &node = polygon_bvh[stack[--stack_size]];
+		if (_rect_get_distance_squared_to_point(node.rect, p_point) >= closest_point_distance_squared) {
+			continue;
+		}
 
-				break;
-			} else {
-				real_t distance = closest_on_polygon.distance_squared_to(p_point);
-				if (distance < closest_point_distance_squared) {
-					closest_point_distance_squared = distance;
-					result.point = closest_on_polygon;
-					result.owner = polygon.owner->get_self();
+		if (node.polygon) {
+			Vector2 closest_on_polygon;
+			const real_t distance_squared = _polygon_get_closest_point(*node.polygon, p_point, closest_on_polygon);
+			if (distance_squared < closest_point_distance_squared) {
+				closest_point_distance_squared = distance_squared;
+				result.point = closest_on_polygon;
+				result.owner = node.polygon->owner->get_self();
+
+				if (closest_point_distance_squared == 0.0) {
+					// The point is inside the polygon, nothing can be closer.
+					break;
 				}
 			}
+			continue;
+		}
+
+		// Visit the nearest child first so that the other one is more likely to be culled.
+		const real_t left_distance_squared = _rect_get_distance_squared_to_point(polygon_bvh[node.left].rect, p_point);
+		const real_t right_distance_squared = _rect_get_distance_squared_to_point(polygon_bvh[node.right].rect, p_point);
+		if (left_distance_squared < right_distance_squared) {
+			stack[stack_size++] = node.right;
+			stack[stack_size++] = node.left;
+		} else {
+			stack[stack_size++] = node.left;
+			stack[stack_size++] = node.right;
 		}
 	}
 
@@ -1004,9 +958,25 @@ Vector2 NavMeshQueries2D::map_iteration_get_random_point(const NavMapIteration2D
 		uint32_t random_region_index = E->value;
 		ERR_FAIL_UNSIGNED_INDEX_V(random_region_index, accessible_regions.size(), Vector2());
 
-		const Ref<NavRegionIteration2D> &random_region = p_map_iteration.region_iterations[accessible_regions[random_region_index]];
+		const uint32_t random_region_iteration_index = accessible_regions[random_region_index];
+		const Ref<NavRegionIteration2D> &random_region = p_map_iteration.region_iterations[random_region_iteration_index];
+		const LocalVector<real_t> &accumulated_area = p_map_iteration.regions_polygons_accumulated_area[random_region_iteration_index];
+		ERR_FAIL_COND_V(accumulated_area.is_empty(), Vector2());
+
+		// Binary search the first polygon whose accumulated surface area exceeds the random position.
+		const real_t random_area_position = Math::random(real_t(0), accumulated_area[accumulated_area.size() - 1]);
+		uint32_t low = 0;
+		uint32_t high = accumulated_area.size() - 1;
+		while (low < high) {
+			const uint32_t middle = (low + high) / 2;
+			if (accumulated_area[middle] > random_area_position) {
+				high = middle;
+			} else {
+				low = middle + 1;
+			}
+		}
 
-		return NavMeshQueries2D::polygons_get_random_point(random_region->navmesh_polygons, p_navigation_layers, p_uniformly);
+		return _polygon_get_random_point(random_region->navmesh_polygons[low]);
 
 	} else {
 		uint32_t random_region_index = Math::random(int(0), accessible_regions.size() - 1);
@@ -1108,6 +1078,92 @@ static bool _line_intersects_segment(const Vector2 &p_line_normal, real_t p_line
 	return true;
 }
 
+real_t NavMeshQueries2D::_rect_get_distance_squared_to_point(const Rect2 &p_rect, const Vector2 &p_point) {
+	return p_point.clamp(p_rect.position, p_rect.position + p_rect.size).distance_squared_to(p_point);
+}
+
+real_t NavMeshQueries2D::_polygon_get_closest_point(const Polygon &p_polygon, const Vector2 &p_point, Vector2 &r_closest_point) {
+	const LocalVector<Vector2> &vertices = p_polygon.vertices;
+
+	real_t cross = -(vertices[1] - vertices[0]).cross(vertices[2] - vertices[0]);
+	Vector2 closest_on_polygon;
+	real_t closest = FLT_MAX;
+	bool inside = true;
+	Vector2 previous = vertices[vertices.size() - 1];
+	for (uint32_t point_id = 0; point_id < vertices.size(); ++point_id) {
+		Vector2 edge = vertices[point_id] - previous;
+		Vector2 to_point = p_point - previous;
+		real_t edge_to_point_cross = -edge.cross(to_point);
+		bool clockwise = (edge_to_point_cross * cross) > 0;
+		// If we are not clockwise, the point will never be inside the polygon and so the closest point will be on an edge.
+		if (!clockwise) {
+			inside = false;
+			real_t point_projected_on_edge = edge.dot(to_point);
+			real_t edge_square = edge.length_squared();
+
+			if (point_projected_on_edge > edge_square) {
+				real_t distance = vertices[point_id].distance_squared_to(p_point);
+				if (distance < closest) {
+					closest_on_polygon = vertices[point_id];
+					closest = distance;
+				}
+			} else if (point_projected_on_edge < 0.0) {
+				real_t distance = previous.distance_squared_to(p_point);
+				if (distance < closest) {
+					closest_on_polygon = previous;
+					closest = distance;
+				}
+			} else {
+				// If we project on this edge, this will be the closest point.
+				real_t percent = point_projected_on_edge / edge_square;
+				closest_on_polygon = previous + percent * edge;
+				break;
+			}
+		}
+		previous = vertices[point_id];
+	}
+
+	if (inside) {
+		r_closest_point = p_point;
+		return 0.0;
+	}
+
+	r_closest_point = closest_on_polygon;
+	return closest_on_polygon.distance_squared_to(p_point);
+}
+
+Vector2 NavMeshQueries2D::_polygon_get_random_point(const Polygon &p_polygon) {
+	const LocalVector<Vector2> &vertices = p_polygon.vertices;
+
+	real_t accumulated_polygon_area = 0;
+	RBMap<real_t, uint32_t> polygon_area_map;
+
+	for (uint32_t rpp_index = 2; rpp_index < vertices.size(); rpp_index++) {
+		real_t triangle_area = Triangle2(vertices[0], vertices[rpp_index - 1], vertices[rpp_index]).get_area();
+
+		if (triangle_area == 0.0) {
+			continue;
+		}
+		polygon_area_map[accumulated_polygon_area] = rpp_index;
+		accumulated_polygon_area += triangle_area;
+	}
+	if (polygon_area_map.is_empty() || accumulated_polygon_area == 0) {
+		// All faces have no real surface / no area.
+		return Vector2();
+	}
+
+	real_t polygon_area_map_pos = Math::random(real_t(0), accumulated_polygon_area);
+
+	RBMap<real_t, uint32_t>::Iterator polygon_E = polygon_area_map.find_closest(polygon_area_map_pos);
+	ERR_FAIL_COND_V(!polygon_E, Vector2());
+	uint32_t rrp_face_index = polygon_E->value;
+	ERR_FAIL_UNSIGNED_INDEX_V(rrp_face_index, vertices.size(), Vector2());
+
+	const Triangle2 triangle(vertices[0], vertices[rrp_face_index - 1], vertices[rrp_face_index]);
+
+	return triangle.get_random_point_inside();
+}
+
 void NavMeshQueries2D::_query_task_clip_path(NavMeshPathQueryTask2D &p_query_task, const NavigationPoly *p_from_poly, const Vector2 &p_to_point, const NavigationPoly *p_to_poly) {
 	Vector2 from = p_query_task.path_points[p_query_task.path_points.size() - 1];
 	const LocalVector<NavigationPoly> &p_navigation_polys = p_query_task.path_query_slot->path_corridor;
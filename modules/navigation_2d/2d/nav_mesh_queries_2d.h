@@ -46,6 +46,9 @@ struct NavMapIteration2D;
 
 class NavMeshQueries2D {
 public:
+	// Polygon BVH traversal stack size, the median split keeps the tree depth at log2 of the polygon count.
+	static constexpr uint32_t POLYGON_BVH_STACK_SIZE = 64;
+
 	struct PathQuerySlot {
 		LocalVector<Nav2D::NavigationPoly> path_corridor;
 		Heap<Nav2D::NavigationPoly *, Nav2D::NavPolyTravelCostGreaterThan, Nav2D::NavPolyHeapIndexer> traversable_polys;
@@ -134,6 +137,10 @@ public:
 	static Nav2D::ClosestPointQueryResult map_iteration_get_closest_point_info(const NavMapIteration2D &p_map_iteration, const Vector2 &p_point);
 	static Vector2 map_iteration_get_random_point(const NavMapIteration2D &p_map_iteration, uint32_t p_navigation_layers, bool p_uniformly);
 
+	static real_t _rect_get_distance_squared_to_point(const Rect2 &p_rect, const Vector2 &p_point);
+	static real_t _polygon_get_closest_point(const Nav2D::Polygon &p_polygon, const Vector2 &p_point, Vector2 &r_closest_point);
+	static Vector2 _polygon_get_random_point(const Nav2D::Polygon &p_polygon);
+
 	static void map_query_path(NavMap2D *p_map, const Ref<NavigationPathQueryParameters2D> &p_query_parameters, Ref<NavigationPathQueryResult2D> p_query_result, const Callable &p_callback);
 
 	static void query_task_map_iteration_get_path(NavMeshPathQueryTask2D &p_query_task, const NavMapIteration2D &p_map_iteration);
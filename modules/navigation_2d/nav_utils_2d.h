@@ -30,6 +30,7 @@
 
 #pragma once
 
+#include "core/math/rect2.h"
 #include "core/math/vector2.h"
 #include "core/templates/hashfuncs.h"
 #include "core/templates/local_vector.h"
@@ -105,6 +106,17 @@ struct Polygon {
 	real_t surface_area = 0.0;
 };
 
+struct PolygonBVHNode {
+	Rect2 rect;
+
+	/// Child node indices, -1 on leaf nodes.
+	int32_t left = -1;
+	int32_t right = -1;
+
+	/// Polygon of a leaf node.
+	const Polygon *polygon = nullptr;
+};
+
 struct NavigationPoly {
 	/// This poly.
 	const Polygon *poly = nullptr;
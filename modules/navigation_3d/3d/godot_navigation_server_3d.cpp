@@ -206,6 +206,34 @@ bool GodotNavigationServer3D::map_get_use_edge_connections(RID p_map) const {
 	return map->get_use_edge_connections();
 }
 
+COMMAND_2(map_set_use_hierarchical_pathfinding, RID, p_map, bool, p_enabled) {
+	NavMap3D *map = map_owner.get_or_null(p_map);
+	ERR_FAIL_NULL(map);
+
+	map->set_use_hierarchical_pathfinding(p_enabled);
+}
+
+bool GodotNavigationServer3D::map_get_use_hierarchical_pathfinding(RID p_map) const {
+	NavMap3D *map = map_owner.get_or_null(p_map);
+	ERR_FAIL_NULL_V(map, false);
+
+	return map->get_use_hierarchical_pathfinding();
+}
+
+COMMAND_2(map_set_use_avoidance_spatial_hash, RID, p_map, bool, p_enabled) {
+	NavMap3D *map = map_owner.get_or_null(p_map);
+	ERR_FAIL_NULL(map);
+
+	map->set_use_avoidance_spatial_hash(p_enabled);
+}
+
+bool GodotNavigationServer3D::map_get_use_avoidance_spatial_hash(RID p_map) const {
+	NavMap3D *map = map_owner.get_or_null(p_map);
+	ERR_FAIL_NULL_V(map, false);
+
+	return map->get_use_avoidance_spatial_hash();
+}
+
 COMMAND_2(map_set_edge_connection_margin, RID, p_map, real_t, p_connection_margin) {
 	NavMap3D *map = map_owner.get_or_null(p_map);
 	ERR_FAIL_NULL(map);
@@ -1255,6 +1283,9 @@ COMMAND_1(free_rid, RID, p_object) {
 			obstacle->set_map(nullptr);
 		}
 
+		// Batched path queries still running against this map need to finish before it is gone.
+		_release_path_query_batches_map(map);
+
 		int map_index = active_maps.find(map);
 		if (map_index >= 0) {
 			active_maps.remove_at(map_index);
@@ -1369,6 +1400,8 @@ void GodotNavigationServer3D::sync() {
 	if (navmesh_generator_3d) {
 		navmesh_generator_3d->sync();
 	}
+
+	_sync_path_query_batches();
 }
 
 void GodotNavigationServer3D::process(double p_delta_time) {
@@ -1403,6 +1436,8 @@ void GodotNavigationServer3D::physics_process(double p_delta_time) {
 	int _new_pm_edge_connection_count = 0;
 	int _new_pm_edge_free_count = 0;
 	int _new_pm_obstacle_count = 0;
+	int _new_pm_path_cache_hit_count = 0;
+	int _new_pm_path_cache_miss_count = 0;
 
 	MutexLock lock(operations_mutex);
 	for (uint32_t i(0); i < active_maps.size(); i++) {
@@ -1419,6 +1454,8 @@ void GodotNavigationServer3D::physics_process(double p_delta_time) {
 		_new_pm_edge_connection_count += active_maps[i]->get_pm_edge_connection_count();
 		_new_pm_edge_free_count += active_maps[i]->get_pm_edge_free_count();
 		_new_pm_obstacle_count += active_maps[i]->get_pm_obstacle_count();
+		_new_pm_path_cache_hit_count += active_maps[i]->get_pm_path_cache_hit_count();
+		_new_pm_path_cache_miss_count += active_maps[i]->get_pm_path_cache_miss_count();
 	}
 
 	pm_region_count = _new_pm_region_count;
@@ -1430,6 +1467,8 @@ void GodotNavigationServer3D::physics_process(double p_delta_time) {
 	pm_edge_connection_count = _new_pm_edge_connection_count;
 	pm_edge_free_count = _new_pm_edge_free_count;
 	pm_obstacle_count = _new_pm_obstacle_count;
+	pm_path_cache_hit_count = _new_pm_path_cache_hit_count;
+	pm_path_cache_miss_count = _new_pm_path_cache_miss_count;
 }
 
 void GodotNavigationServer3D::init() {
@@ -1440,6 +1479,7 @@ void GodotNavigationServer3D::init() {
 
 void GodotNavigationServer3D::finish() {
 	flush_queries();
+	_cleanup_path_query_batches();
 	if (navmesh_generator_3d) {
 		navmesh_generator_3d->finish();
 		memdelete(navmesh_generator_3d);
@@ -1457,6 +1497,126 @@ void GodotNavigationServer3D::query_path(const Ref<NavigationPathQueryParameters
 	NavMeshQueries3D::map_query_path(map, p_query_parameters, p_query_result, p_callback);
 }
 
+void GodotNavigationServer3D::query_paths_async(const TypedArray<NavigationPathQueryParameters3D> &p_query_parameters, const TypedArray<NavigationPathQueryResult3D> &p_query_results, const Callable &p_callback) {
+	ERR_FAIL_COND_MSG(p_query_parameters.size() != p_query_results.size(), "The number of path query parameters and path query results must be the same.");
+
+	const uint32_t query_count = p_query_parameters.size();
+
+	LocalVector<NavMap3D *> query_maps;
+	query_maps.resize(query_count);
+
+	for (uint32_t i = 0; i < query_count; i++) {
+		const Ref<NavigationPathQueryParameters3D> query_parameters = p_query_parameters[i];
+		const Ref<NavigationPathQueryResult3D> query_result = p_query_results[i];
+		ERR_FAIL_COND_MSG(query_parameters.is_null(), vformat("Path query parameters at index %d are null.", i));
+		ERR_FAIL_COND_MSG(query_result.is_null(), vformat("Path query result at index %d is null.", i));
+
+		query_maps[i] = map_owner.get_or_null(query_parameters->get_map());
+		ERR_FAIL_NULL_MSG(query_maps[i], vformat("Path query parameters at index %d use an invalid map.", i));
+	}
+
+	NavMeshQueries3D::NavMeshPathQueryBatch3D *query_batch = memnew(NavMeshQueries3D::NavMeshPathQueryBatch3D);
+	query_batch->callback = p_callback;
+	query_batch->query_tasks.resize(query_count);
+	query_batch->query_map_iterations.resize(query_count);
+
+	// All queries against the same map share one map iteration for the whole batch.
+	HashMap<NavMap3D *, NavMapIteration3D *> map_iterations;
+
+	for (uint32_t i = 0; i < query_count; i++) {
+		NavMeshQueries3D::NavMeshPathQueryTask3D &query_task = query_batch->query_tasks[i];
+		NavMeshQueries3D::query_task_setup(query_task, p_query_parameters[i]);
+		query_task.query_result = p_query_results[i];
+
+		NavMap3D *map = query_maps[i];
+		HashMap<NavMap3D *, NavMapIteration3D *>::Iterator E = map_iterations.find(map);
+		if (!E) {
+			NavMapIteration3D *map_iteration = map->acquire_iteration();
+			if (map_iteration) {
+				query_batch->maps.push_back(map);
+				query_batch->map_iterations.push_back(map_iteration);
+			}
+			E = map_iterations.insert(map, map_iteration);
+		}
+		query_batch->query_map_iterations[i] = E->value;
+	}
+
+	if (query_count > 0) {
+		query_batch->group_task_id = WorkerThreadPool::get_singleton()->add_native_group_task(&NavMeshQueries3D::_query_batch_thread_query_path, query_batch, query_count, -1, false, SNAME("NavMeshQueriesBatch3D"));
+	}
+
+	MutexLock lock(path_query_batches_mutex);
+	path_query_batches.push_back(query_batch);
+}
+
+void GodotNavigationServer3D::_sync_path_query_batches() {
+	LocalVector<NavMeshQueries3D::NavMeshPathQueryBatch3D *> finished_batches;
+	{
+		MutexLock lock(path_query_batches_mutex);
+
+		if (path_query_batches.is_empty()) {
+			return;
+		}
+
+		LocalVector<NavMeshQueries3D::NavMeshPathQueryBatch3D *> running_batches;
+		for (NavMeshQueries3D::NavMeshPathQueryBatch3D *query_batch : path_query_batches) {
+			if (query_batch->group_task_id != WorkerThreadPool::INVALID_TASK_ID) {
+				if (!WorkerThreadPool::get_singleton()->is_group_task_completed(query_batch->group_task_id)) {
+					running_batches.push_back(query_batch);
+					continue;
+				}
+				WorkerThreadPool::get_singleton()->wait_for_group_task_completion(query_batch->group_task_id);
+			}
+			finished_batches.push_back(query_batch);
+		}
+		path_query_batches = running_batches;
+	}
+
+	// Callbacks are dispatched without holding the lock so that they can submit new batches.
+	for (NavMeshQueries3D::NavMeshPathQueryBatch3D *query_batch : finished_batches) {
+		for (uint32_t i = 0; i < query_batch->maps.size(); i++) {
+			query_batch->maps[i]->release_iteration(query_batch->map_iterations[i]);
+		}
+		if (query_batch->callback.is_valid()) {
+			NavMeshQueries3D::emit_callback(query_batch->callback);
+		}
+		memdelete(query_batch);
+	}
+}
+
+void GodotNavigationServer3D::_release_path_query_batches_map(NavMap3D *p_map) {
+	MutexLock lock(path_query_batches_mutex);
+
+	for (NavMeshQueries3D::NavMeshPathQueryBatch3D *query_batch : path_query_batches) {
+		int64_t map_index = query_batch->maps.find(p_map);
+		if (map_index < 0) {
+			continue;
+		}
+		if (query_batch->group_task_id != WorkerThreadPool::INVALID_TASK_ID) {
+			WorkerThreadPool::get_singleton()->wait_for_group_task_completion(query_batch->group_task_id);
+			query_batch->group_task_id = WorkerThreadPool::INVALID_TASK_ID;
+		}
+		p_map->release_iteration(query_batch->map_iterations[map_index]);
+		query_batch->maps.remove_at_unordered(map_index);
+		query_batch->map_iterations.remove_at_unordered(map_index);
+	}
+}
+
+void GodotNavigationServer3D::_cleanup_path_query_batches() {
+	MutexLock lock(path_query_batches_mutex);
+
+	for (NavMeshQueries3D::NavMeshPathQueryBatch3D *query_batch : path_query_batches) {
+		if (query_batch->group_task_id != WorkerThreadPool::INVALID_TASK_ID) {
+			WorkerThreadPool::get_singleton()->wait_for_group_task_completion(query_batch->group_task_id);
+		}
+		for (uint32_t i = 0; i < query_batch->maps.size(); i++) {
+			query_batch->maps[i]->release_iteration(query_batch->map_iterations[i]);
+		}
+		memdelete(query_batch);
+	}
+	path_query_batches.clear();
+}
+
 RID GodotNavigationServer3D::source_geometry_parser_create() {
 	RWLockWrite write_lock(geometry_parser_rwlock);
 
@@ -1544,6 +1704,12 @@ int GodotNavigationServer3D::get_process_info(ProcessInfo p_info) const {
 		case INFO_OBSTACLE_COUNT: {
 			return pm_obstacle_count;
 		} break;
+		case INFO_PATH_CACHE_HIT_COUNT: {
+			return pm_path_cache_hit_count;
+		} break;
+		case INFO_PATH_CACHE_MISS_COUNT: {
+			return pm_path_cache_miss_count;
+		} break;
 	}
 
 	return 0;
@@ -82,6 +82,13 @@ class GodotNavigationServer3D : public NavigationServer3D {
 
 	NavMeshGenerator3D *navmesh_generator_3d = nullptr;
 
+	Mutex path_query_batches_mutex;
+	LocalVector<NavMeshQueries3D::NavMeshPathQueryBatch3D *> path_query_batches;
+
+	void _sync_path_query_batches();
+	void _release_path_query_batches_map(NavMap3D *p_map);
+	void _cleanup_path_query_batches();
+
 	// Performance Monitor
 	int pm_region_count = 0;
 	int pm_agent_count = 0;
@@ -92,6 +99,8 @@ class GodotNavigationServer3D : public NavigationServer3D {
 	int pm_edge_connection_count = 0;
 	int pm_edge_free_count = 0;
 	int pm_obstacle_count = 0;
+	int pm_path_cache_hit_count = 0;
+	int pm_path_cache_miss_count = 0;
 
 public:
 	GodotNavigationServer3D();
@@ -120,6 +129,12 @@ public:
 	COMMAND_2(map_set_use_edge_connections, RID, p_map, bool, p_enabled);
 	virtual bool map_get_use_edge_connections(RID p_map) const override;
 
+	COMMAND_2(map_set_use_hierarchical_pathfinding, RID, p_map, bool, p_enabled);
+	virtual bool map_get_use_hierarchical_pathfinding(RID p_map) const override;
+
+	COMMAND_2(map_set_use_avoidance_spatial_hash, RID, p_map, bool, p_enabled);
+	virtual bool map_get_use_avoidance_spatial_hash(RID p_map) const override;
+
 	COMMAND_2(map_set_edge_connection_margin, RID, p_map, real_t, p_connection_margin);
 	virtual real_t map_get_edge_connection_margin(RID p_map) const override;
 
@@ -293,6 +308,7 @@ public:
 	virtual void finish() override;
 
 	virtual void query_path(const Ref<NavigationPathQueryParameters3D> &p_query_parameters, Ref<NavigationPathQueryResult3D> p_query_result, const Callable &p_callback = Callable()) override;
+	virtual void query_paths_async(const TypedArray<NavigationPathQueryParameters3D> &p_query_parameters, const TypedArray<NavigationPathQueryResult3D> &p_query_results, const Callable &p_callback = Callable()) override;
 
 	int get_process_info(ProcessInfo p_info) const override;
 
@@ -0,0 +1,144 @@
+/**************************************************************************/
+/*  nav_avoidance_spatial_hash_3d.h                                       */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/math/math_funcs_binary.h"
+#include "core/math/vector2.h"
+#include "core/math/vector2i.h"
+#include "core/templates/hashfuncs.h"
+#include "core/templates/local_vector.h"
+
+// Uniform grid over the XZ plane used as an alternative to the RVO agent kd-trees.
+// Cells are mapped into a power of two bucket table, so the grid is unbounded and
+// only uses memory proportional to the agent count.
+class NavAvoidanceSpatialHash3D {
+	real_t cell_size = 1.0;
+	uint32_t bucket_mask = 0;
+
+	// Agent indices sorted by bucket, bucket `b` owns the range [bucket_offsets[b], bucket_offsets[b + 1]).
+	LocalVector<uint32_t> bucket_offsets;
+	LocalVector<uint32_t> bucket_agents;
+
+	LocalVector<Vector2i> agent_cells;
+	LocalVector<uint32_t> agent_buckets;
+
+	_FORCE_INLINE_ uint32_t _get_cell_bucket(const Vector2i &p_cell) const {
+		return hash_murmur3_one_32(p_cell.y, hash_murmur3_one_32(p_cell.x)) & bucket_mask;
+	}
+
+public:
+	// Resizes the grid for the given agent count. Afterwards every agent index needs its position set before calling end_build().
+	void begin_build(uint32_t p_agent_count, real_t p_cell_size) {
+		cell_size = MAX(p_cell_size, (real_t)0.01);
+		const uint32_t bucket_count = Math::next_power_of_2(MAX(p_agent_count * 2, 16u));
+		bucket_mask = bucket_count - 1;
+
+		bucket_offsets.resize(bucket_count + 1);
+		bucket_agents.resize(p_agent_count);
+		agent_cells.resize(p_agent_count);
+		agent_buckets.resize(p_agent_count);
+	}
+
+	// Safe to call from multiple threads as long as each thread sets different agent indices.
+	_FORCE_INLINE_ void set_agent_position(uint32_t p_agent_index, const Vector2 &p_position) {
+		const Vector2i cell = Vector2i((p_position / cell_size).floor());
+		agent_cells[p_agent_index] = cell;
+		agent_buckets[p_agent_index] = _get_cell_bucket(cell);
+	}
+
+	void end_build() {
+		// Counting sort of the agents by bucket, keeps the agent order within a bucket stable.
+		memset(bucket_offsets.ptr(), 0, bucket_offsets.size() * sizeof(uint32_t));
+		for (uint32_t bucket : agent_buckets) {
+			bucket_offsets[bucket + 1]++;
+		}
+		for (uint32_t i = 1; i < bucket_offsets.size(); i++) {
+			bucket_offsets[i] += bucket_offsets[i - 1];
+		}
+		for (uint32_t i = 0; i < agent_buckets.size(); i++) {
+			// Uses the bucket start as write cursor and shifts it back in place below.
+			bucket_agents[bucket_offsets[agent_buckets[i]]++] = i;
+		}
+		for (uint32_t i = bucket_offsets.size() - 1; i > 0; i--) {
+			bucket_offsets[i] = bucket_offsets[i - 1];
+		}
+		bucket_offsets[0] = 0;
+	}
+
+	void clear() {
+		bucket_mask = 0;
+		bucket_offsets.clear();
+		bucket_agents.clear();
+		agent_cells.clear();
+		agent_buckets.clear();
+	}
+
+	// Calls p_visit_agent with the index of every agent in a cell within range of p_position.
+	// r_range_sq is read again for every cell so the visitor can shrink it while neighbors are found.
+	template <typename F>
+	void query(const Vector2 &p_position, real_t &r_range_sq, F p_visit_agent) const {
+		if (bucket_agents.is_empty()) {
+			return;
+		}
+
+		const real_t range = Math::sqrt(r_range_sq);
+		const Vector2i cell_begin = Vector2i(((p_position - Vector2(range, range)) / cell_size).floor());
+		const Vector2i cell_end = Vector2i(((p_position + Vector2(range, range)) / cell_size).floor());
+
+		// A range that covers more cells than there are buckets is cheaper to resolve by visiting everything.
+		if ((int64_t)(cell_end.x - cell_begin.x + 1) * (int64_t)(cell_end.y - cell_begin.y + 1) > (int64_t)bucket_mask + 1) {
+			for (uint32_t agent_index : bucket_agents) {
+				p_visit_agent(agent_index);
+			}
+			return;
+		}
+
+		for (int y = cell_begin.y; y <= cell_end.y; y++) {
+			const real_t distance_y = MAX((real_t)0.0, MAX(y * cell_size - p_position.y, p_position.y - (y + 1) * cell_size));
+			for (int x = cell_begin.x; x <= cell_end.x; x++) {
+				const real_t distance_x = MAX((real_t)0.0, MAX(x * cell_size - p_position.x, p_position.x - (x + 1) * cell_size));
+				if (distance_x * distance_x + distance_y * distance_y >= r_range_sq) {
+					continue;
+				}
+
+				const Vector2i cell = Vector2i(x, y);
+				const uint32_t bucket = _get_cell_bucket(cell);
+				for (uint32_t i = bucket_offsets[bucket]; i < bucket_offsets[bucket + 1]; i++) {
+					const uint32_t agent_index = bucket_agents[i];
+					// Different cells can share a bucket, only visit the agents of this cell.
+					if (agent_cells[agent_index] == cell) {
+						p_visit_agent(agent_index);
+					}
+				}
+			}
+		}
+	}
+};
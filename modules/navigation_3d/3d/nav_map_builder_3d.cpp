@@ -35,9 +35,52 @@
 #include "nav_region_iteration_3d.h"
 
 #include "core/config/project_settings.h"
+#include "core/templates/sort_array.h"
 
 using namespace Nav3D;
 
+struct PolygonBVHCmpX {
+	bool operator()(const PolygonBVHNode &p_left, const PolygonBVHNode &p_right) const {
+		return p_left.aabb.get_center().x < p_right.aabb.get_center().x;
+	}
+};
+
+struct PolygonBVHCmpY {
+	bool operator()(const PolygonBVHNode &p_left, const PolygonBVHNode &p_right) const {
+		return p_left.aabb.get_center().y < p_right.aabb.get_center().y;
+	}
+};
+
+struct PolygonBVHCmpZ {
+	bool operator()(const PolygonBVHNode &p_left, const PolygonBVHNode &p_right) const {
+		return p_left.aabb.get_center().z < p_right.aabb.get_center().z;
+	}
+};
+
+struct ClusterPolygonCmpX {
+	bool operator()(const ClusterPolygon *p_left, const ClusterPolygon *p_right) const {
+		return p_left->center.x < p_right->center.x;
+	}
+};
+
+struct ClusterPolygonCmpY {
+	bool operator()(const ClusterPolygon *p_left, const ClusterPolygon *p_right) const {
+		return p_left->center.y < p_right->center.y;
+	}
+};
+
+struct ClusterPolygonCmpZ {
+	bool operator()(const ClusterPolygon *p_left, const ClusterPolygon *p_right) const {
+		return p_left->center.z < p_right->center.z;
+	}
+};
+
+struct ClusterConnection {
+	uint32_t from_polygon_id = 0;
+	uint32_t to_polygon_id = 0;
+	real_t travel_cost = 0.0;
+};
+
 PointKey NavMapBuilder3D::get_point_key(const Vector3 &p_pos, const Vector3 &p_cell_size) {
 	const int x = static_cast<int>(Math::floor(p_pos.x / p_cell_size.x));
 	const int y = static_cast<int>(Math::floor(p_pos.y / p_cell_size.y));
@@ -62,6 +105,8 @@ void NavMapBuilder3D::build_navmap_iteration(NavMapIterationBuild3D &r_build) {
 
 	_build_step_gather_region_polygons(r_build);
 
+	_build_step_polygon_bvh(r_build);
+
 	_build_step_find_edge_connection_pairs(r_build);
 
 	_build_step_merge_edge_connection_pairs(r_build);
@@ -70,6 +115,8 @@ void NavMapBuilder3D::build_navmap_iteration(NavMapIterationBuild3D &r_build) {
 
 	_build_step_navlink_connections(r_build);
 
+	_build_step_polygon_clusters(r_build);
+
 	_build_update_map_iteration(r_build);
 }
 
@@ -100,6 +147,100 @@ void NavMapBuilder3D::_build_step_gather_region_polygons(NavMapIterationBuild3D
 	r_build.polygon_count = polygon_count;
 }
 
+void NavMapBuilder3D::_build_step_polygon_bvh(NavMapIterationBuild3D &r_build) {
+	NavMapIteration3D *map_iteration = r_build.map_iteration;
+
+	const LocalVector<Ref<NavRegionIteration3D>> &regions = map_iteration->region_iterations;
+	LocalVector<PolygonBVHNode> &polygon_bvh = map_iteration->polygon_bvh;
+	LocalVector<LocalVector<real_t>> &regions_polygons_accumulated_area = map_iteration->regions_polygons_accumulated_area;
+
+	polygon_bvh.clear();
+	map_iteration->polygon_bvh_root = -1;
+
+	regions_polygons_accumulated_area.clear();
+	regions_polygons_accumulated_area.resize(regions.size());
+
+	LocalVector<PolygonBVHNode> leaves;
+	leaves.reserve(r_build.polygon_count);
+
+	for (uint32_t region_index = 0; region_index < regions.size(); region_index++) {
+		const LocalVector<Polygon> &polygons = regions[region_index]->navmesh_polygons;
+
+		LocalVector<real_t> &accumulated_area = regions_polygons_accumulated_area[region_index];
+		accumulated_area.resize(polygons.size());
+		real_t region_accumulated_area = 0.0;
+
+		for (uint32_t polygon_index = 0; polygon_index < polygons.size(); polygon_index++) {
+			const Polygon &polygon = polygons[polygon_index];
+
+			region_accumulated_area += polygon.surface_area;
+			accumulated_area[polygon_index] = region_accumulated_area;
+
+			// Skip polygons that failed to build, they are not valid query results.
+			if (polygon.vertices.size() < 3) {
+				continue;
+			}
+
+			PolygonBVHNode leaf;
+			leaf.polygon = &polygon;
+			leaf.aabb.position = polygon.vertices[0];
+			for (uint32_t point_id = 1; point_id < polygon.vertices.size(); point_id++) {
+				leaf.aabb.expand_to(polygon.vertices[point_id]);
+			}
+			// Flat polygons have a zero-sized axis, give the segment tests some tolerance.
+			leaf.aabb.grow_by(CMP_EPSILON);
+			leaves.push_back(leaf);
+		}
+	}
+
+	if (leaves.is_empty()) {
+		return;
+	}
+
+	// A binary tree with one polygon per leaf never has more than twice the leaf count in nodes.
+	polygon_bvh.reserve(leaves.size() * 2);
+	map_iteration->polygon_bvh_root = _build_polygon_bvh_node(polygon_bvh, leaves.ptr(), leaves.size());
+}
+
+int32_t NavMapBuilder3D::_build_polygon_bvh_node(LocalVector<PolygonBVHNode> &r_bvh, PolygonBVHNode *p_leaves, uint32_t p_size) {
+	if (p_size == 1) {
+		r_bvh.push_back(p_leaves[0]);
+		return r_bvh.size() - 1;
+	}
+
+	AABB aabb = p_leaves[0].aabb;
+	for (uint32_t i = 1; i < p_size; i++) {
+		aabb.merge_with(p_leaves[i].aabb);
+	}
+
+	// Split at the median along the longest axis, this keeps the tree balanced.
+	const uint32_t half_size = p_size / 2;
+	switch (aabb.get_longest_axis_index()) {
+		case Vector3::AXIS_X: {
+			SortArray<PolygonBVHNode, PolygonBVHCmpX> sort_x;
+			sort_x.nth_element(0, p_size, half_size, p_leaves);
+		} break;
+		case Vector3::AXIS_Y: {
+			SortArray<PolygonBVHNode, PolygonBVHCmpY> sort_y;
+			sort_y.nth_element(0, p_size, half_size, p_leaves);
+		} break;
+		case Vector3::AXIS_Z: {
+			SortArray<PolygonBVHNode, PolygonBVHCmpZ> sort_z;
+			sort_z.nth_element(0, p_size, half_size, p_leaves);
+		} break;
+	}
+
+	const int32_t left = _build_polygon_bvh_node(r_bvh, p_leaves, half_size);
+	const int32_t right = _build_polygon_bvh_node(r_bvh, p_leaves + half_size, p_size - half_size);
+
+	PolygonBVHNode node;
+	node.aabb = aabb;
+	node.left = left;
+	node.right = right;
+	r_bvh.push_back(node);
+	return r_bvh.size() - 1;
+}
+
 void NavMapBuilder3D::_build_step_find_edge_connection_pairs(NavMapIterationBuild3D &r_build) {
 	PerformanceData &performance_data = r_build.performance_data;
 	NavMapIteration3D *map_iteration = r_build.map_iteration;
@@ -392,6 +533,256 @@ void NavMapBuilder3D::_build_step_navlink_connections(NavMapIterationBuild3D &r_
 	r_build.polygon_count = polygon_count;
 }
 
+void NavMapBuilder3D::_build_step_polygon_clusters(NavMapIterationBuild3D &r_build) {
+	NavMapIteration3D *map_iteration = r_build.map_iteration;
+
+	LocalVector<ClusterPolygon> &cluster_polygons = map_iteration->cluster_polygons;
+	LocalVector<PolygonCluster> &clusters = map_iteration->clusters;
+	LocalVector<ClusterPortal> &cluster_portals = map_iteration->cluster_portals;
+	LocalVector<ClusterPortalEdge> &cluster_portal_edges = map_iteration->cluster_portal_edges;
+
+	cluster_polygons.clear();
+	map_iteration->cluster_polygon_ids.clear();
+	clusters.clear();
+	cluster_portals.clear();
+	cluster_portal_edges.clear();
+
+	if (!r_build.use_hierarchical_pathfinding) {
+		return;
+	}
+
+	const LocalVector<Ref<NavRegionIteration3D>> &regions = map_iteration->region_iterations;
+	const LocalVector<Polygon> &navlink_polygons = map_iteration->navlink_polygons;
+	const HashMap<const NavBaseIteration3D *, LocalVector<LocalVector<Nav3D::Connection>>> &navbases_polygons_external_connections = map_iteration->navbases_polygons_external_connections;
+
+	// Polygon ids follow the order of the path query slots, region polygons first and link polygons last.
+	HashMap<const NavBaseIteration3D *, uint32_t> navbase_polygon_offsets;
+	uint32_t polygon_count = 0;
+	for (const Ref<NavRegionIteration3D> &region : regions) {
+		navbase_polygon_offsets[region.ptr()] = polygon_count;
+		polygon_count += region->navmesh_polygons.size();
+	}
+	for (const Polygon &polygon : navlink_polygons) {
+		navbase_polygon_offsets[polygon.owner] = polygon_count;
+		polygon_count += 1;
+	}
+
+	cluster_polygons.resize(polygon_count);
+	map_iteration->cluster_polygon_ids.reserve(polygon_count);
+
+	LocalVector<ClusterPolygon *> owner_polygons;
+
+	for (const Ref<NavRegionIteration3D> &region : regions) {
+		const LocalVector<Polygon> &polygons = region->navmesh_polygons;
+		const uint32_t owner_polygon_offset = navbase_polygon_offsets[region.ptr()];
+
+		owner_polygons.clear();
+		for (uint32_t polygon_index = 0; polygon_index < polygons.size(); polygon_index++) {
+			const Polygon &polygon = polygons[polygon_index];
+
+			ClusterPolygon &cluster_polygon = cluster_polygons[owner_polygon_offset + polygon_index];
+			cluster_polygon.polygon = &polygon;
+			for (const Vector3 &vertex : polygon.vertices) {
+				cluster_polygon.center += vertex;
+			}
+			if (!polygon.vertices.is_empty()) {
+				cluster_polygon.center /= polygon.vertices.size();
+			}
+			owner_polygons.push_back(&cluster_polygon);
+		}
+
+		if (!owner_polygons.is_empty()) {
+			_build_polygon_cluster(map_iteration, owner_polygons.ptr(), owner_polygons.size(), region.ptr(), owner_polygon_offset);
+		}
+	}
+
+	// Links are a single polygon each and get their own cluster.
+	for (const Polygon &polygon : navlink_polygons) {
+		const uint32_t owner_polygon_offset = navbase_polygon_offsets[polygon.owner];
+
+		ClusterPolygon *cluster_polygon = &cluster_polygons[owner_polygon_offset];
+		cluster_polygon->polygon = &polygon;
+		for (const Vector3 &vertex : polygon.vertices) {
+			cluster_polygon->center += vertex;
+		}
+		if (!polygon.vertices.is_empty()) {
+			cluster_polygon->center /= polygon.vertices.size();
+		}
+		_build_polygon_cluster(map_iteration, &cluster_polygon, 1, polygon.owner, owner_polygon_offset);
+	}
+
+	// Every connection between polygons of different clusters makes both polygons portals.
+	LocalVector<ClusterConnection> cluster_connections;
+	LocalVector<bool> polygons_are_portals;
+	polygons_are_portals.resize(polygon_count);
+	for (uint32_t polygon_id = 0; polygon_id < polygon_count; polygon_id++) {
+		polygons_are_portals[polygon_id] = false;
+	}
+
+	for (uint32_t polygon_id = 0; polygon_id < polygon_count; polygon_id++) {
+		const ClusterPolygon &from_polygon = cluster_polygons[polygon_id];
+		const NavBaseIteration3D *owner = from_polygon.polygon->owner;
+		const uint32_t navbase_local_polygon_id = from_polygon.polygon->id;
+
+		const LocalVector<LocalVector<Connection>> &navbase_polygons_to_connections = owner->get_internal_connections();
+		if (navbase_local_polygon_id < navbase_polygons_to_connections.size()) {
+			for (const Connection &connection : navbase_polygons_to_connections[navbase_local_polygon_id]) {
+				const uint32_t to_polygon_id = clusters[from_polygon.cluster].owner_polygon_offset + connection.polygon->id;
+				const ClusterPolygon &to_polygon = cluster_polygons[to_polygon_id];
+				if (to_polygon.cluster == from_polygon.cluster) {
+					continue;
+				}
+
+				polygons_are_portals[polygon_id] = true;
+				polygons_are_portals[to_polygon_id] = true;
+
+				ClusterConnection cluster_connection;
+				cluster_connection.from_polygon_id = polygon_id;
+				cluster_connection.to_polygon_id = to_polygon_id;
+				cluster_connection.travel_cost = NavMeshQueries3D::cluster_get_connection_travel_cost(from_polygon, connection, to_polygon);
+				cluster_connections.push_back(cluster_connection);
+			}
+		}
+
+		const LocalVector<LocalVector<Connection>> *navbase_polygons_external_connections = navbases_polygons_external_connections.getptr(owner);
+		if (navbase_polygons_external_connections == nullptr || navbase_local_polygon_id >= navbase_polygons_external_connections->size()) {
+			continue;
+		}
+
+		for (const Connection &connection : (*navbase_polygons_external_connections)[navbase_local_polygon_id]) {
+			const uint32_t *to_owner_polygon_offset = navbase_polygon_offsets.getptr(connection.polygon->owner);
+			ERR_CONTINUE(to_owner_polygon_offset == nullptr);
+
+			const uint32_t to_polygon_id = *to_owner_polygon_offset + connection.polygon->id;
+			const ClusterPolygon &to_polygon = cluster_polygons[to_polygon_id];
+
+			polygons_are_portals[polygon_id] = true;
+			polygons_are_portals[to_polygon_id] = true;
+
+			ClusterConnection cluster_connection;
+			cluster_connection.from_polygon_id = polygon_id;
+			cluster_connection.to_polygon_id = to_polygon_id;
+			cluster_connection.travel_cost = NavMeshQueries3D::cluster_get_connection_travel_cost(from_polygon, connection, to_polygon);
+			cluster_connections.push_back(cluster_connection);
+		}
+	}
+
+	// Portals are stored in cluster order so that each cluster references a consecutive range.
+	for (uint32_t cluster_index = 0; cluster_index < clusters.size(); cluster_index++) {
+		PolygonCluster &cluster = clusters[cluster_index];
+		cluster.portal_start = cluster_portals.size();
+
+		for (uint32_t i = 0; i < cluster.polygon_count; i++) {
+			const uint32_t polygon_id = map_iteration->cluster_polygon_ids[cluster.polygon_start + i];
+			if (!polygons_are_portals[polygon_id]) {
+				continue;
+			}
+
+			cluster_polygons[polygon_id].portal = cluster_portals.size();
+
+			ClusterPortal portal;
+			portal.polygon_id = polygon_id;
+			portal.cluster = cluster_index;
+			cluster_portals.push_back(portal);
+		}
+
+		cluster.portal_count = cluster_portals.size() - cluster.portal_start;
+	}
+
+	LocalVector<LocalVector<ClusterPortalEdge>> portals_edges;
+	portals_edges.resize(cluster_portals.size());
+
+	for (const ClusterConnection &cluster_connection : cluster_connections) {
+		ClusterPortalEdge edge;
+		edge.portal = cluster_polygons[cluster_connection.to_polygon_id].portal;
+		edge.travel_cost = cluster_connection.travel_cost;
+		portals_edges[cluster_polygons[cluster_connection.from_polygon_id].portal].push_back(edge);
+	}
+
+	// Precompute the travel costs between the portals of the same cluster.
+	LocalVector<real_t> travel_costs;
+	LocalVector<bool> closed;
+	for (uint32_t cluster_index = 0; cluster_index < clusters.size(); cluster_index++) {
+		const PolygonCluster &cluster = clusters[cluster_index];
+
+		for (uint32_t portal_index = cluster.portal_start; portal_index < cluster.portal_start + cluster.portal_count; portal_index++) {
+			NavMeshQueries3D::cluster_get_polygon_travel_costs(*map_iteration, cluster_index, cluster_portals[portal_index].polygon_id, travel_costs, closed);
+
+			for (uint32_t other_portal_index = cluster.portal_start; other_portal_index < cluster.portal_start + cluster.portal_count; other_portal_index++) {
+				if (other_portal_index == portal_index) {
+					continue;
+				}
+
+				const real_t travel_cost = travel_costs[cluster_polygons[cluster_portals[other_portal_index].polygon_id].cluster_polygon_index];
+				if (travel_cost == FLT_MAX) {
+					continue;
+				}
+
+				ClusterPortalEdge edge;
+				edge.portal = other_portal_index;
+				edge.travel_cost = travel_cost;
+				portals_edges[portal_index].push_back(edge);
+			}
+		}
+	}
+
+	for (uint32_t portal_index = 0; portal_index < cluster_portals.size(); portal_index++) {
+		ClusterPortal &portal = cluster_portals[portal_index];
+		portal.edge_start = cluster_portal_edges.size();
+		portal.edge_count = portals_edges[portal_index].size();
+		for (const ClusterPortalEdge &edge : portals_edges[portal_index]) {
+			cluster_portal_edges.push_back(edge);
+		}
+	}
+}
+
+void NavMapBuilder3D::_build_polygon_cluster(NavMapIteration3D *p_map_iteration, ClusterPolygon **p_polygons, uint32_t p_size, const NavBaseIteration3D *p_owner, uint32_t p_owner_polygon_offset) {
+	if (p_size > POLYGON_CLUSTER_SIZE_MAX) {
+		AABB bounds(p_polygons[0]->center, Vector3());
+		for (uint32_t i = 1; i < p_size; i++) {
+			bounds.expand_to(p_polygons[i]->center);
+		}
+
+		// Split at the median along the longest axis, same as the polygon BVH, to keep clusters compact.
+		const uint32_t half_size = p_size / 2;
+		switch (bounds.get_longest_axis_index()) {
+			case Vector3::AXIS_X: {
+				SortArray<ClusterPolygon *, ClusterPolygonCmpX> sort_x;
+				sort_x.nth_element(0, p_size, half_size, p_polygons);
+			} break;
+			case Vector3::AXIS_Y: {
+				SortArray<ClusterPolygon *, ClusterPolygonCmpY> sort_y;
+				sort_y.nth_element(0, p_size, half_size, p_polygons);
+			} break;
+			case Vector3::AXIS_Z: {
+				SortArray<ClusterPolygon *, ClusterPolygonCmpZ> sort_z;
+				sort_z.nth_element(0, p_size, half_size, p_polygons);
+			} break;
+		}
+
+		_build_polygon_cluster(p_map_iteration, p_polygons, half_size, p_owner, p_owner_polygon_offset);
+		_build_polygon_cluster(p_map_iteration, p_polygons + half_size, p_size - half_size, p_owner, p_owner_polygon_offset);
+		return;
+	}
+
+	LocalVector<uint32_t> &cluster_polygon_ids = p_map_iteration->cluster_polygon_ids;
+
+	PolygonCluster cluster;
+	cluster.owner = p_owner;
+	cluster.owner_polygon_offset = p_owner_polygon_offset;
+	cluster.polygon_start = cluster_polygon_ids.size();
+	cluster.polygon_count = p_size;
+
+	const uint32_t cluster_index = p_map_iteration->clusters.size();
+	for (uint32_t i = 0; i < p_size; i++) {
+		p_polygons[i]->cluster = cluster_index;
+		p_polygons[i]->cluster_polygon_index = i;
+		cluster_polygon_ids.push_back(p_polygons[i] - p_map_iteration->cluster_polygons.ptr());
+	}
+
+	p_map_iteration->clusters.push_back(cluster);
+}
+
 void NavMapBuilder3D::_build_update_map_iteration(NavMapIterationBuild3D &r_build) {
 	NavMapIteration3D *map_iteration = r_build.map_iteration;
 
@@ -425,6 +816,11 @@ void NavMapBuilder3D::_build_update_map_iteration(NavMapIterationBuild3D &r_buil
 		}
 
 		DEV_ASSERT(p_path_query_slot.path_corridor.size() == p_path_query_slot.poly_to_id.size());
+
+		p_path_query_slot.open_portals.clear();
+		p_path_query_slot.portal_search.clear();
+		p_path_query_slot.portal_search.resize(map_iteration->cluster_portals.size());
+		p_path_query_slot.clusters_in_corridor.resize(map_iteration->clusters.size());
 	}
 
 	map_iteration->path_query_slots_mutex.unlock();
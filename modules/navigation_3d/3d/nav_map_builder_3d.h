@@ -32,17 +32,26 @@
 
 #include "../nav_utils_3d.h"
 
+struct NavMapIteration3D;
 struct NavMapIterationBuild3D;
 
 class NavMapBuilder3D {
 	static void _build_step_gather_region_polygons(NavMapIterationBuild3D &r_build);
+	static void _build_step_polygon_bvh(NavMapIterationBuild3D &r_build);
 	static void _build_step_find_edge_connection_pairs(NavMapIterationBuild3D &r_build);
 	static void _build_step_merge_edge_connection_pairs(NavMapIterationBuild3D &r_build);
 	static void _build_step_edge_connection_margin_connections(NavMapIterationBuild3D &r_build);
 	static void _build_step_navlink_connections(NavMapIterationBuild3D &r_build);
+	static void _build_step_polygon_clusters(NavMapIterationBuild3D &r_build);
 	static void _build_update_map_iteration(NavMapIterationBuild3D &r_build);
 
+	static int32_t _build_polygon_bvh_node(LocalVector<Nav3D::PolygonBVHNode> &r_bvh, Nav3D::PolygonBVHNode *p_leaves, uint32_t p_size);
+	static void _build_polygon_cluster(NavMapIteration3D *p_map_iteration, Nav3D::ClusterPolygon **p_polygons, uint32_t p_size, const NavBaseIteration3D *p_owner, uint32_t p_owner_polygon_offset);
+
 public:
+	// Regions are split into clusters of at most this many polygons for the hierarchical path search.
+	static constexpr uint32_t POLYGON_CLUSTER_SIZE_MAX = 64;
+
 	static Nav3D::PointKey get_point_key(const Vector3 &p_pos, const Vector3 &p_cell_size);
 
 	static void build_navmap_iteration(NavMapIterationBuild3D &r_build);
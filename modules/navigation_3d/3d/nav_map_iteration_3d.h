@@ -45,6 +45,7 @@ struct NavMapIteration3D;
 struct NavMapIterationBuild3D {
 	Vector3 merge_rasterizer_cell_size;
 	bool use_edge_connections = true;
+	bool use_hierarchical_pathfinding = false;
 	real_t edge_connection_margin;
 	real_t link_connection_radius;
 	Nav3D::PerformanceData performance_data;
@@ -87,8 +88,25 @@ struct NavMapIteration3D {
 
 	LocalVector<Nav3D::Polygon> navlink_polygons;
 
+	// Bounding volume hierarchy over all region polygons, used by the closest point queries.
+	LocalVector<Nav3D::PolygonBVHNode> polygon_bvh;
+	int32_t polygon_bvh_root = -1;
+
+	// Accumulated polygon surface areas of each region, used by the uniform random point queries.
+	LocalVector<LocalVector<real_t>> regions_polygons_accumulated_area;
+
+	// Hierarchical path search abstraction, spatial clusters of polygons that share an owner,
+	// connected by a graph of the polygons on the cluster borders. Empty if not used by the map.
+	LocalVector<Nav3D::ClusterPolygon> cluster_polygons;
+	LocalVector<uint32_t> cluster_polygon_ids;
+	LocalVector<Nav3D::PolygonCluster> clusters;
+	LocalVector<Nav3D::ClusterPortal> cluster_portals;
+	LocalVector<Nav3D::ClusterPortalEdge> cluster_portal_edges;
+
 	HashMap<NavRegion3D *, Ref<NavRegionIteration3D>> region_ptr_to_region_iteration;
 
+	mutable NavMeshQueries3D::PathQueryCache path_query_cache;
+
 	LocalVector<NavMeshQueries3D::PathQuerySlot> path_query_slots;
 	Mutex path_query_slots_mutex;
 	Semaphore path_query_slots_semaphore;
@@ -102,7 +120,16 @@ struct NavMapIteration3D {
 		external_region_connections.clear();
 		navbases_polygons_external_connections.clear();
 		navlink_polygons.clear();
+		polygon_bvh.clear();
+		polygon_bvh_root = -1;
+		regions_polygons_accumulated_area.clear();
+		cluster_polygons.clear();
+		cluster_polygon_ids.clear();
+		clusters.clear();
+		cluster_portals.clear();
+		cluster_portal_edges.clear();
 		region_ptr_to_region_iteration.clear();
+		path_query_cache.clear();
 	}
 };
 
@@ -38,6 +38,7 @@
 #include "scene/resources/navigation_mesh.h"
 
 #include <Recast.h>
+#include <cfloat> // FLT_MAX
 
 NavMeshGenerator3D *NavMeshGenerator3D::singleton = nullptr;
 Mutex NavMeshGenerator3D::baking_navmesh_mutex;
@@ -48,6 +49,8 @@ bool NavMeshGenerator3D::baking_use_multiple_threads = true;
 bool NavMeshGenerator3D::baking_use_high_priority_threads = true;
 HashMap<Ref<NavigationMesh>, NavMeshGenerator3D::NavMeshGeneratorTask3D *> NavMeshGenerator3D::baking_navmeshes;
 HashMap<WorkerThreadPool::TaskID, NavMeshGenerator3D::NavMeshGeneratorTask3D *> NavMeshGenerator3D::generator_tasks;
+Mutex NavMeshGenerator3D::tile_cache_mutex;
+HashMap<ObjectID, NavMeshGenerator3D::NavMeshTileCache3D> NavMeshGenerator3D::tile_caches;
 LocalVector<NavMeshGeometryParser3D *> NavMeshGenerator3D::generator_parsers;
 
 static const char *_navmesh_bake_state_msgs[(size_t)NavMeshGenerator3D::NavMeshBakeState::BAKE_STATE_MAX] = {
@@ -127,6 +130,11 @@ void NavMeshGenerator3D::cleanup() {
 
 		baking_navmeshes.clear();
 
+		{
+			MutexLock tile_cache_lock(tile_cache_mutex);
+			tile_caches.clear();
+		}
+
 		for (KeyValue<WorkerThreadPool::TaskID, NavMeshGeneratorTask3D *> &E : generator_tasks) {
 			WorkerThreadPool::get_singleton()->wait_for_task_completion(E.key);
 			NavMeshGeneratorTask3D *generator_task = E.value;
@@ -302,6 +310,175 @@ void NavMeshGenerator3D::generator_parse_source_geometry_data(const Ref<Navigati
 	}
 }
 
+static bool _generator_build_polygons(rcContext *p_ctx, const rcConfig &p_cfg, const Ref<NavigationMesh> &p_navigation_mesh, const float *p_verts, int p_nverts, const int *p_tris, int p_ntris, const Vector<NavigationMeshSourceGeometryData3D::ProjectedObstruction> &p_projected_obstructions, NavMeshGenerator3D::NavMeshBakeState &r_bake_state, Vector<Vector3> &r_vertices, Vector<Vector<int>> &r_polygons) {
+	rcHeightfield *hf = nullptr;
+	rcCompactHeightfield *chf = nullptr;
+	rcContourSet *cset = nullptr;
+	rcPolyMesh *poly_mesh = nullptr;
+	rcPolyMeshDetail *detail_mesh = nullptr;
+
+	r_bake_state = NavMeshGenerator3D::NavMeshBakeState::BAKE_STATE_CREATE_HEIGHTFIELD; // step #3
+	hf = rcAllocHeightfield();
+
+	ERR_FAIL_NULL_V(hf, false);
+	ERR_FAIL_COND_V(!rcCreateHeightfield(p_ctx, *hf, p_cfg.width, p_cfg.height, p_cfg.bmin, p_cfg.bmax, p_cfg.cs, p_cfg.ch), false);
+
+	r_bake_state = NavMeshGenerator3D::NavMeshBakeState::BAKE_STATE_MARK_WALKABLE_TRIANGLES; // step #4
+	{
+		Vector<unsigned char> tri_areas;
+		tri_areas.resize(p_ntris);
+
+		ERR_FAIL_COND_V(tri_areas.is_empty(), false);
+
+		memset(tri_areas.ptrw(), 0, p_ntris * sizeof(unsigned char));
+		rcMarkWalkableTriangles(p_ctx, p_cfg.walkableSlopeAngle, p_verts, p_nverts, p_tris, p_ntris, tri_areas.ptrw());
+
+		ERR_FAIL_COND_V(!rcRasterizeTriangles(p_ctx, p_verts, p_nverts, p_tris, tri_areas.ptr(), p_ntris, *hf, p_cfg.walkableClimb), false);
+	}
+
+	if (p_navigation_mesh->get_filter_low_hanging_obstacles()) {
+		rcFilterLowHangingWalkableObstacles(p_ctx, p_cfg.walkableClimb, *hf);
+	}
+	if (p_navigation_mesh->get_filter_ledge_spans()) {
+		rcFilterLedgeSpans(p_ctx, p_cfg.walkableHeight, p_cfg.walkableClimb, *hf);
+	}
+	if (p_navigation_mesh->get_filter_walkable_low_height_spans()) {
+		rcFilterWalkableLowHeightSpans(p_ctx, p_cfg.walkableHeight, *hf);
+	}
+
+	r_bake_state = NavMeshGenerator3D::NavMeshBakeState::BAKE_STATE_CONSTRUCT_COMPACT_HEIGHTFIELD; // step #5
+
+	chf = rcAllocCompactHeightfield();
+
+	ERR_FAIL_NULL_V(chf, false);
+	ERR_FAIL_COND_V(!rcBuildCompactHeightfield(p_ctx, p_cfg.walkableHeight, p_cfg.walkableClimb, *hf, *chf), false);
+
+	rcFreeHeightField(hf);
+	hf = nullptr;
+
+	// Add obstacles to the source geometry. Those will be affected by e.g. agent_radius.
+	if (!p_projected_obstructions.is_empty()) {
+		for (const NavigationMeshSourceGeometryData3D::ProjectedObstruction &projected_obstruction : p_projected_obstructions) {
+			if (projected_obstruction.carve) {
+				continue;
+			}
+			if (projected_obstruction.vertices.is_empty() || projected_obstruction.vertices.size() % 3 != 0) {
+				continue;
+			}
+
+			const float *projected_obstruction_verts = projected_obstruction.vertices.ptr();
+			const int projected_obstruction_nverts = projected_obstruction.vertices.size() / 3;
+
+			rcMarkConvexPolyArea(p_ctx, projected_obstruction_verts, projected_obstruction_nverts, projected_obstruction.elevation, projected_obstruction.elevation + projected_obstruction.height, RC_NULL_AREA, *chf);
+		}
+	}
+
+	r_bake_state = NavMeshGenerator3D::NavMeshBakeState::BAKE_STATE_ERODE_WALKABLE_AREA; // step #6
+
+	ERR_FAIL_COND_V(!rcErodeWalkableArea(p_ctx, p_cfg.walkableRadius, *chf), false);
+
+	// Carve obstacles to the eroded geometry. Those will NOT be affected by e.g. agent_radius because that step is already done.
+	if (!p_projected_obstructions.is_empty()) {
+		for (const NavigationMeshSourceGeometryData3D::ProjectedObstruction &projected_obstruction : p_projected_obstructions) {
+			if (!projected_obstruction.carve) {
+				continue;
+			}
+			if (projected_obstruction.vertices.is_empty() || projected_obstruction.vertices.size() % 3 != 0) {
+				continue;
+			}
+
+			const float *projected_obstruction_verts = projected_obstruction.vertices.ptr();
+			const int projected_obstruction_nverts = projected_obstruction.vertices.size() / 3;
+
+			rcMarkConvexPolyArea(p_ctx, projected_obstruction_verts, projected_obstruction_nverts, projected_obstruction.elevation, projected_obstruction.elevation + projected_obstruction.height, RC_NULL_AREA, *chf);
+		}
+	}
+
+	r_bake_state = NavMeshGenerator3D::NavMeshBakeState::BAKE_STATE_SAMPLE_PARTITIONING; // step #7
+
+	if (p_navigation_mesh->get_sample_partition_type() == NavigationMesh::SAMPLE_PARTITION_WATERSHED) {
+		ERR_FAIL_COND_V(!rcBuildDistanceField(p_ctx, *chf), false);
+		ERR_FAIL_COND_V(!rcBuildRegions(p_ctx, *chf, p_cfg.borderSize, p_cfg.minRegionArea, p_cfg.mergeRegionArea), false);
+	} else if (p_navigation_mesh->get_sample_partition_type() == NavigationMesh::SAMPLE_PARTITION_MONOTONE) {
+		ERR_FAIL_COND_V(!rcBuildRegionsMonotone(p_ctx, *chf, p_cfg.borderSize, p_cfg.minRegionArea, p_cfg.mergeRegionArea), false);
+	} else {
+		ERR_FAIL_COND_V(!rcBuildLayerRegions(p_ctx, *chf, p_cfg.borderSize, p_cfg.minRegionArea), false);
+	}
+
+	r_bake_state = NavMeshGenerator3D::NavMeshBakeState::BAKE_STATE_CREATING_CONTOURS; // step #8
+
+	cset = rcAllocContourSet();
+
+	ERR_FAIL_NULL_V(cset, false);
+	ERR_FAIL_COND_V(!rcBuildContours(p_ctx, *chf, p_cfg.maxSimplificationError, p_cfg.maxEdgeLen, *cset), false);
+
+	r_bake_state = NavMeshGenerator3D::NavMeshBakeState::BAKE_STATE_CREATING_POLYMESH; // step #9
+
+	poly_mesh = rcAllocPolyMesh();
+	ERR_FAIL_NULL_V(poly_mesh, false);
+	ERR_FAIL_COND_V(!rcBuildPolyMesh(p_ctx, *cset, p_cfg.maxVertsPerPoly, *poly_mesh), false);
+
+	detail_mesh = rcAllocPolyMeshDetail();
+	ERR_FAIL_NULL_V(detail_mesh, false);
+	ERR_FAIL_COND_V(!rcBuildPolyMeshDetail(p_ctx, *poly_mesh, *chf, p_cfg.detailSampleDist, p_cfg.detailSampleMaxError, *detail_mesh), false);
+
+	rcFreeCompactHeightfield(chf);
+	chf = nullptr;
+	rcFreeContourSet(cset);
+	cset = nullptr;
+
+	r_bake_state = NavMeshGenerator3D::NavMeshBakeState::BAKE_STATE_CONVERTING_NATIVE_NAVMESH; // step #10
+
+	HashMap<Vector3, int> recast_vertex_to_native_index;
+	LocalVector<int> recast_index_to_native_index;
+	recast_index_to_native_index.resize(detail_mesh->nverts);
+
+	for (int i = 0; i < detail_mesh->nverts; i++) {
+		const float *v = &detail_mesh->verts[i * 3];
+		const Vector3 vertex = Vector3(v[0], v[1], v[2]);
+		int *existing_index_ptr = recast_vertex_to_native_index.getptr(vertex);
+		if (!existing_index_ptr) {
+			int new_index = recast_vertex_to_native_index.size();
+			recast_index_to_native_index[i] = new_index;
+			recast_vertex_to_native_index[vertex] = new_index;
+			r_vertices.push_back(vertex);
+		} else {
+			recast_index_to_native_index[i] = *existing_index_ptr;
+		}
+	}
+
+	for (int i = 0; i < detail_mesh->nmeshes; i++) {
+		const unsigned int *detail_mesh_m = &detail_mesh->meshes[i * 4];
+		const unsigned int detail_mesh_bverts = detail_mesh_m[0];
+		const unsigned int detail_mesh_m_btris = detail_mesh_m[2];
+		const unsigned int detail_mesh_ntris = detail_mesh_m[3];
+		const unsigned char *detail_mesh_tris = &detail_mesh->tris[detail_mesh_m_btris * 4];
+		for (unsigned int j = 0; j < detail_mesh_ntris; j++) {
+			Vector<int> nav_indices;
+			nav_indices.resize(3);
+			// Polygon order in recast is opposite than godot's
+			int index1 = ((int)(detail_mesh_bverts + detail_mesh_tris[j * 4 + 0]));
+			int index2 = ((int)(detail_mesh_bverts + detail_mesh_tris[j * 4 + 2]));
+			int index3 = ((int)(detail_mesh_bverts + detail_mesh_tris[j * 4 + 1]));
+
+			nav_indices.write[0] = recast_index_to_native_index[index1];
+			nav_indices.write[1] = recast_index_to_native_index[index2];
+			nav_indices.write[2] = recast_index_to_native_index[index3];
+
+			r_polygons.push_back(nav_indices);
+		}
+	}
+
+	r_bake_state = NavMeshGenerator3D::NavMeshBakeState::BAKE_STATE_BAKE_CLEANUP; // step #11
+
+	rcFreePolyMesh(poly_mesh);
+	poly_mesh = nullptr;
+	rcFreePolyMeshDetail(detail_mesh);
+	detail_mesh = nullptr;
+
+	return true;
+}
+
 void NavMeshGenerator3D::generator_bake_from_source_geometry_data(NavMeshGeneratorTask3D *p_generator_task) {
 	Ref<NavigationMesh> p_navigation_mesh = p_generator_task->navigation_mesh;
 	const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data = p_generator_task->source_geometry_data;
@@ -323,11 +500,6 @@ void NavMeshGenerator3D::generator_bake_from_source_geometry_data(NavMeshGenerat
 		return;
 	}
 
-	rcHeightfield *hf = nullptr;
-	rcCompactHeightfield *chf = nullptr;
-	rcContourSet *cset = nullptr;
-	rcPolyMesh *poly_mesh = nullptr;
-	rcPolyMeshDetail *detail_mesh = nullptr;
 	rcContext ctx;
 
 	p_generator_task->bake_state = NavMeshBakeState::BAKE_STATE_CONFIGURATION; // step #1
@@ -406,6 +578,17 @@ void NavMeshGenerator3D::generator_bake_from_source_geometry_data(NavMeshGenerat
 		cfg.bmax[2] = cfg.bmin[2] + baking_aabb.size[2];
 	}
 
+	if (p_navigation_mesh->get_tile_size() > 0.0) {
+		generator_bake_tiles_from_source_geometry_data(p_generator_task, cfg);
+		return;
+	}
+
+	{
+		// Not baking tiles (anymore), drop whatever tiles were kept from previous bakes.
+		MutexLock tile_cache_lock(tile_cache_mutex);
+		tile_caches.erase(p_navigation_mesh->get_instance_id());
+	}
+
 	p_generator_task->bake_state = NavMeshBakeState::BAKE_STATE_CALC_GRID_SIZE; // step #2
 	rcCalcGridSize(cfg.bmin, cfg.bmax, cfg.cs, &cfg.width, &cfg.height);
 
@@ -420,157 +603,334 @@ void NavMeshGenerator3D::generator_bake_from_source_geometry_data(NavMeshGenerat
 		return;
 	}
 
-	p_generator_task->bake_state = NavMeshBakeState::BAKE_STATE_CREATE_HEIGHTFIELD; // step #3
-	hf = rcAllocHeightfield();
+	Vector<Vector3> nav_vertices;
+	Vector<Vector<int>> nav_polygons;
 
-	ERR_FAIL_NULL(hf);
-	ERR_FAIL_COND(!rcCreateHeightfield(&ctx, *hf, cfg.width, cfg.height, cfg.bmin, cfg.bmax, cfg.cs, cfg.ch));
+	if (!_generator_build_polygons(&ctx, cfg, p_navigation_mesh, verts, nverts, tris, ntris, projected_obstructions, p_generator_task->bake_state, nav_vertices, nav_polygons)) {
+		return;
+	}
 
-	p_generator_task->bake_state = NavMeshBakeState::BAKE_STATE_MARK_WALKABLE_TRIANGLES; // step #4
-	{
-		Vector<unsigned char> tri_areas;
-		tri_areas.resize(ntris);
+	p_navigation_mesh->set_data(nav_vertices, nav_polygons);
 
-		ERR_FAIL_COND(tri_areas.is_empty());
+	p_generator_task->bake_state = NavMeshBakeState::BAKE_STATE_BAKE_FINISHED; // step #12
+}
 
-		memset(tri_areas.ptrw(), 0, ntris * sizeof(unsigned char));
-		rcMarkWalkableTriangles(&ctx, cfg.walkableSlopeAngle, verts, nverts, tris, ntris, tri_areas.ptrw());
+struct NavMeshGeneratorTile3D {
+	Vector2i coords;
+	uint32_t hash = HASH_MURMUR3_SEED;
+	float height_min = FLT_MAX;
+	float height_max = -FLT_MAX;
+	LocalVector<int> triangles;
+	Vector<NavigationMeshSourceGeometryData3D::ProjectedObstruction> projected_obstructions;
 
-		ERR_FAIL_COND(!rcRasterizeTriangles(&ctx, verts, nverts, tris, tri_areas.ptr(), ntris, *hf, cfg.walkableClimb));
-	}
+	bool baked = false;
+	Vector<Vector3> vertices;
+	Vector<Vector<int>> polygons;
+};
 
-	if (p_navigation_mesh->get_filter_low_hanging_obstacles()) {
-		rcFilterLowHangingWalkableObstacles(&ctx, cfg.walkableClimb, *hf);
-	}
-	if (p_navigation_mesh->get_filter_ledge_spans()) {
-		rcFilterLedgeSpans(&ctx, cfg.walkableHeight, cfg.walkableClimb, *hf);
+struct NavMeshGeneratorTileBake3D {
+	rcConfig config;
+	bool use_baking_aabb = false;
+	Ref<NavigationMesh> navigation_mesh;
+	const float *verts = nullptr;
+	int nverts = 0;
+	LocalVector<NavMeshGeneratorTile3D *> tiles;
+};
+
+static _FORCE_INLINE_ real_t _generator_snap_to_cell(real_t p_value, real_t p_cell_size) {
+	const real_t cells = p_value / p_cell_size;
+	const real_t cells_rounded = Math::round(cells);
+	return Math::abs(cells - cells_rounded) < (real_t)0.01 ? cells_rounded * p_cell_size : p_value;
+}
+
+static void _generator_bake_tile(void *p_arg, uint32_t p_index) {
+	NavMeshGeneratorTileBake3D *tile_bake = static_cast<NavMeshGeneratorTileBake3D *>(p_arg);
+	NavMeshGeneratorTile3D *tile = tile_bake->tiles[p_index];
+
+	rcConfig cfg = tile_bake->config;
+	const float tile_world_size = cfg.tileSize * cfg.cs;
+	const float border_world_size = cfg.borderSize * cfg.cs;
+
+	// Tiles are aligned to the world origin so that their bounds do not move when geometry elsewhere changes.
+	cfg.bmin[0] = tile->coords.x * tile_world_size;
+	cfg.bmin[2] = tile->coords.y * tile_world_size;
+	cfg.bmax[0] = cfg.bmin[0] + tile_world_size;
+	cfg.bmax[2] = cfg.bmin[2] + tile_world_size;
+
+	if (tile_bake->use_baking_aabb) {
+		cfg.bmin[0] = MAX(cfg.bmin[0], tile_bake->config.bmin[0]);
+		cfg.bmin[2] = MAX(cfg.bmin[2], tile_bake->config.bmin[2]);
+		cfg.bmax[0] = MIN(cfg.bmax[0], tile_bake->config.bmax[0]);
+		cfg.bmax[2] = MIN(cfg.bmax[2], tile_bake->config.bmax[2]);
+	} else {
+		// Keep the heightfield floor on the cell height grid so all tiles quantize heights the same way.
+		cfg.bmin[1] = Math::floor(tile->height_min / cfg.ch) * cfg.ch;
+		cfg.bmax[1] = tile->height_max;
 	}
-	if (p_navigation_mesh->get_filter_walkable_low_height_spans()) {
-		rcFilterWalkableLowHeightSpans(&ctx, cfg.walkableHeight, *hf);
+
+	cfg.bmin[0] -= border_world_size;
+	cfg.bmin[2] -= border_world_size;
+	cfg.bmax[0] += border_world_size;
+	cfg.bmax[2] += border_world_size;
+
+	rcCalcGridSize(cfg.bmin, cfg.bmax, cfg.cs, &cfg.width, &cfg.height);
+
+	rcContext ctx;
+	NavMeshGenerator3D::NavMeshBakeState bake_state = NavMeshGenerator3D::NavMeshBakeState::BAKE_STATE_NONE;
+
+	tile->baked = _generator_build_polygons(&ctx, cfg, tile_bake->navigation_mesh, tile_bake->verts, tile_bake->nverts, tile->triangles.ptr(), tile->triangles.size() / 3, tile->projected_obstructions, bake_state, tile->vertices, tile->polygons);
+
+	// Vertices on the shared edges of two tiles are computed from different heightfield origins.
+	// Snap them back onto the cell grid so both tiles agree on them and they can be welded.
+	Vector3 *tile_vertices_ptrw = tile->vertices.ptrw();
+	for (int i = 0; i < tile->vertices.size(); i++) {
+		Vector3 &vertex = tile_vertices_ptrw[i];
+		vertex.x = _generator_snap_to_cell(vertex.x, cfg.cs);
+		vertex.y = _generator_snap_to_cell(vertex.y, cfg.ch);
+		vertex.z = _generator_snap_to_cell(vertex.z, cfg.cs);
 	}
+}
 
-	p_generator_task->bake_state = NavMeshBakeState::BAKE_STATE_CONSTRUCT_COMPACT_HEIGHTFIELD; // step #5
+void NavMeshGenerator3D::generator_bake_tiles_from_source_geometry_data(NavMeshGeneratorTask3D *p_generator_task, const rcConfig &p_config) {
+	Ref<NavigationMesh> p_navigation_mesh = p_generator_task->navigation_mesh;
 
-	chf = rcAllocCompactHeightfield();
+	Vector<float> source_geometry_vertices;
+	Vector<int> source_geometry_indices;
+	Vector<NavigationMeshSourceGeometryData3D::ProjectedObstruction> projected_obstructions;
 
-	ERR_FAIL_NULL(chf);
-	ERR_FAIL_COND(!rcBuildCompactHeightfield(&ctx, cfg.walkableHeight, cfg.walkableClimb, *hf, *chf));
+	p_generator_task->source_geometry_data->get_data(
+			source_geometry_vertices,
+			source_geometry_indices,
+			projected_obstructions);
 
-	rcFreeHeightField(hf);
-	hf = nullptr;
+	const float *verts = source_geometry_vertices.ptr();
+	const int *tris = source_geometry_indices.ptr();
+	const int ntris = source_geometry_indices.size() / 3;
 
-	// Add obstacles to the source geometry. Those will be affected by e.g. agent_radius.
-	if (!projected_obstructions.is_empty()) {
-		for (const NavigationMeshSourceGeometryData3D::ProjectedObstruction &projected_obstruction : projected_obstructions) {
-			if (projected_obstruction.carve) {
-				continue;
-			}
-			if (projected_obstruction.vertices.is_empty() || projected_obstruction.vertices.size() % 3 != 0) {
-				continue;
-			}
+	NavMeshGeneratorTileBake3D tile_bake;
+	tile_bake.config = p_config;
+	tile_bake.use_baking_aabb = p_navigation_mesh->get_filter_baking_aabb().has_volume();
+	tile_bake.navigation_mesh = p_navigation_mesh;
+	tile_bake.verts = verts;
+	tile_bake.nverts = source_geometry_vertices.size() / 3;
 
-			const float *projected_obstruction_verts = projected_obstruction.vertices.ptr();
-			const int projected_obstruction_nverts = projected_obstruction.vertices.size() / 3;
+	// Tiles need a border wide enough for the agent erosion and region partitioning to match up with their neighbors.
+	rcConfig &cfg = tile_bake.config;
+	cfg.tileSize = MAX((int)Math::ceil(p_navigation_mesh->get_tile_size() / cfg.cs), 1);
+	cfg.borderSize = MAX(cfg.borderSize, cfg.walkableRadius + 3);
 
-			rcMarkConvexPolyArea(&ctx, projected_obstruction_verts, projected_obstruction_nverts, projected_obstruction.elevation, projected_obstruction.elevation + projected_obstruction.height, RC_NULL_AREA, *chf);
-		}
+	const float tile_world_size = cfg.tileSize * cfg.cs;
+	const float border_world_size = cfg.borderSize * cfg.cs;
+
+	p_generator_task->bake_state = NavMeshBakeState::BAKE_STATE_CALC_GRID_SIZE; // step #2
+
+	const Vector2i tiles_begin = Vector2i(Math::floor(cfg.bmin[0] / tile_world_size), Math::floor(cfg.bmin[2] / tile_world_size));
+	const Vector2i tiles_end = Vector2i(Math::floor(cfg.bmax[0] / tile_world_size), Math::floor(cfg.bmax[2] / tile_world_size)) + Vector2i(1, 1);
+	const Vector2i tiles_size = tiles_end - tiles_begin;
+
+	if ((int64_t)tiles_size.x * tiles_size.y > 1048576 && GLOBAL_GET("navigation/baking/use_crash_prevention_checks")) {
+		ERR_FAIL_MSG("Baking interrupted."
+					 "\nSource geometry covers too many tiles for the current Tile Size in the NavMesh Resource bake settings."
+					 "\nIt is advised to increase Tile Size and/or Cell Size in the NavMesh Resource bake settings."
+					 "\nIf you would like to try baking anyway, disable the 'navigation/baking/use_crash_prevention_checks' project setting.");
+		return;
 	}
 
-	p_generator_task->bake_state = NavMeshBakeState::BAKE_STATE_ERODE_WALKABLE_AREA; // step #6
+	// Bake settings affect every tile, if they changed nothing from the previous bake can be reused.
+	uint32_t config_hash = HASH_MURMUR3_SEED;
+	config_hash = hash_murmur3_one_float(cfg.cs, config_hash);
+	config_hash = hash_murmur3_one_float(cfg.ch, config_hash);
+	config_hash = hash_murmur3_one_float(cfg.walkableSlopeAngle, config_hash);
+	config_hash = hash_murmur3_one_float(cfg.maxSimplificationError, config_hash);
+	config_hash = hash_murmur3_one_float(cfg.detailSampleDist, config_hash);
+	config_hash = hash_murmur3_one_float(cfg.detailSampleMaxError, config_hash);
+	config_hash = hash_murmur3_one_32(cfg.tileSize, config_hash);
+	config_hash = hash_murmur3_one_32(cfg.borderSize, config_hash);
+	config_hash = hash_murmur3_one_32(cfg.walkableHeight, config_hash);
+	config_hash = hash_murmur3_one_32(cfg.walkableClimb, config_hash);
+	config_hash = hash_murmur3_one_32(cfg.walkableRadius, config_hash);
+	config_hash = hash_murmur3_one_32(cfg.maxEdgeLen, config_hash);
+	config_hash = hash_murmur3_one_32(cfg.minRegionArea, config_hash);
+	config_hash = hash_murmur3_one_32(cfg.mergeRegionArea, config_hash);
+	config_hash = hash_murmur3_one_32(cfg.maxVertsPerPoly, config_hash);
+	config_hash = hash_murmur3_one_32(p_navigation_mesh->get_sample_partition_type(), config_hash);
+	config_hash = hash_murmur3_one_32(p_navigation_mesh->get_filter_low_hanging_obstacles(), config_hash);
+	config_hash = hash_murmur3_one_32(p_navigation_mesh->get_filter_ledge_spans(), config_hash);
+	config_hash = hash_murmur3_one_32(p_navigation_mesh->get_filter_walkable_low_height_spans(), config_hash);
+	if (tile_bake.use_baking_aabb) {
+		for (int i = 0; i < 3; i++) {
+			config_hash = hash_murmur3_one_float(cfg.bmin[i], config_hash);
+			config_hash = hash_murmur3_one_float(cfg.bmax[i], config_hash);
+		}
+	}
+	config_hash = hash_fmix32(config_hash);
 
-	ERR_FAIL_COND(!rcErodeWalkableArea(&ctx, cfg.walkableRadius, *chf));
+	LocalVector<NavMeshGeneratorTile3D> tiles;
+	tiles.resize(tiles_size.x * tiles_size.y);
+	for (int z = 0; z < tiles_size.y; z++) {
+		for (int x = 0; x < tiles_size.x; x++) {
+			tiles[z * tiles_size.x + x].coords = tiles_begin + Vector2i(x, z);
+		}
+	}
 
-	// Carve obstacles to the eroded geometry. Those will NOT be affected by e.g. agent_radius because that step is already done.
-	if (!projected_obstructions.is_empty()) {
-		for (const NavigationMeshSourceGeometryData3D::ProjectedObstruction &projected_obstruction : projected_obstructions) {
-			if (!projected_obstruction.carve) {
-				continue;
-			}
-			if (projected_obstruction.vertices.is_empty() || projected_obstruction.vertices.size() % 3 != 0) {
-				continue;
-			}
+	// Sort the source triangles into every tile their bounds overlap, including the tile border.
+	// The tile hash covers the source geometry each tile sees, so unchanged tiles can be detected without baking them.
+	for (int i = 0; i < ntris; i++) {
+		const float *v0 = &verts[tris[i * 3 + 0] * 3];
+		const float *v1 = &verts[tris[i * 3 + 1] * 3];
+		const float *v2 = &verts[tris[i * 3 + 2] * 3];
 
-			const float *projected_obstruction_verts = projected_obstruction.vertices.ptr();
-			const int projected_obstruction_nverts = projected_obstruction.vertices.size() / 3;
+		const float triangle_min_y = MIN(v0[1], MIN(v1[1], v2[1]));
+		const float triangle_max_y = MAX(v0[1], MAX(v1[1], v2[1]));
+		if (tile_bake.use_baking_aabb && (triangle_max_y < cfg.bmin[1] || triangle_min_y > cfg.bmax[1])) {
+			continue;
+		}
 
-			rcMarkConvexPolyArea(&ctx, projected_obstruction_verts, projected_obstruction_nverts, projected_obstruction.elevation, projected_obstruction.elevation + projected_obstruction.height, RC_NULL_AREA, *chf);
+		const int x_begin = MAX((int)Math::floor((MIN(v0[0], MIN(v1[0], v2[0])) - border_world_size) / tile_world_size), tiles_begin.x);
+		const int x_end = MIN((int)Math::floor((MAX(v0[0], MAX(v1[0], v2[0])) + border_world_size) / tile_world_size), tiles_end.x - 1);
+		const int z_begin = MAX((int)Math::floor((MIN(v0[2], MIN(v1[2], v2[2])) - border_world_size) / tile_world_size), tiles_begin.y);
+		const int z_end = MIN((int)Math::floor((MAX(v0[2], MAX(v1[2], v2[2])) + border_world_size) / tile_world_size), tiles_end.y - 1);
+
+		for (int z = z_begin; z <= z_end; z++) {
+			for (int x = x_begin; x <= x_end; x++) {
+				NavMeshGeneratorTile3D &tile = tiles[(z - tiles_begin.y) * tiles_size.x + (x - tiles_begin.x)];
+				tile.triangles.push_back(tris[i * 3 + 0]);
+				tile.triangles.push_back(tris[i * 3 + 1]);
+				tile.triangles.push_back(tris[i * 3 + 2]);
+				for (int j = 0; j < 3; j++) {
+					tile.hash = hash_murmur3_one_float(v0[j], tile.hash);
+					tile.hash = hash_murmur3_one_float(v1[j], tile.hash);
+					tile.hash = hash_murmur3_one_float(v2[j], tile.hash);
+				}
+				tile.height_min = MIN(tile.height_min, triangle_min_y);
+				tile.height_max = MAX(tile.height_max, triangle_max_y);
+			}
 		}
 	}
 
-	p_generator_task->bake_state = NavMeshBakeState::BAKE_STATE_SAMPLE_PARTITIONING; // step #7
+	for (const NavigationMeshSourceGeometryData3D::ProjectedObstruction &projected_obstruction : projected_obstructions) {
+		if (projected_obstruction.vertices.is_empty() || projected_obstruction.vertices.size() % 3 != 0) {
+			continue;
+		}
+
+		const float *projected_obstruction_verts = projected_obstruction.vertices.ptr();
+		const int projected_obstruction_nverts = projected_obstruction.vertices.size() / 3;
 
-	if (p_navigation_mesh->get_sample_partition_type() == NavigationMesh::SAMPLE_PARTITION_WATERSHED) {
-		ERR_FAIL_COND(!rcBuildDistanceField(&ctx, *chf));
-		ERR_FAIL_COND(!rcBuildRegions(&ctx, *chf, cfg.borderSize, cfg.minRegionArea, cfg.mergeRegionArea));
-	} else if (p_navigation_mesh->get_sample_partition_type() == NavigationMesh::SAMPLE_PARTITION_MONOTONE) {
-		ERR_FAIL_COND(!rcBuildRegionsMonotone(&ctx, *chf, cfg.borderSize, cfg.minRegionArea, cfg.mergeRegionArea));
-	} else {
-		ERR_FAIL_COND(!rcBuildLayerRegions(&ctx, *chf, cfg.borderSize, cfg.minRegionArea));
+		Vector2 obstruction_min = Vector2(FLT_MAX, FLT_MAX);
+		Vector2 obstruction_max = Vector2(-FLT_MAX, -FLT_MAX);
+		for (int i = 0; i < projected_obstruction_nverts; i++) {
+			const Vector2 vertex = Vector2(projected_obstruction_verts[i * 3 + 0], projected_obstruction_verts[i * 3 + 2]);
+			obstruction_min = obstruction_min.min(vertex);
+			obstruction_max = obstruction_max.max(vertex);
+		}
+
+		const int x_begin = MAX((int)Math::floor((obstruction_min.x - border_world_size) / tile_world_size), tiles_begin.x);
+		const int x_end = MIN((int)Math::floor((obstruction_max.x + border_world_size) / tile_world_size), tiles_end.x - 1);
+		const int z_begin = MAX((int)Math::floor((obstruction_min.y - border_world_size) / tile_world_size), tiles_begin.y);
+		const int z_end = MIN((int)Math::floor((obstruction_max.y + border_world_size) / tile_world_size), tiles_end.y - 1);
+
+		for (int z = z_begin; z <= z_end; z++) {
+			for (int x = x_begin; x <= x_end; x++) {
+				NavMeshGeneratorTile3D &tile = tiles[(z - tiles_begin.y) * tiles_size.x + (x - tiles_begin.x)];
+				tile.projected_obstructions.push_back(projected_obstruction);
+				for (int i = 0; i < projected_obstruction.vertices.size(); i++) {
+					tile.hash = hash_murmur3_one_float(projected_obstruction_verts[i], tile.hash);
+				}
+				tile.hash = hash_murmur3_one_float(projected_obstruction.elevation, tile.hash);
+				tile.hash = hash_murmur3_one_float(projected_obstruction.height, tile.hash);
+				tile.hash = hash_murmur3_one_32(projected_obstruction.carve, tile.hash);
+			}
+		}
 	}
 
-	p_generator_task->bake_state = NavMeshBakeState::BAKE_STATE_CREATING_CONTOURS; // step #8
+	p_generator_task->bake_state = NavMeshBakeState::BAKE_STATE_CREATE_HEIGHTFIELD; // step #3
 
-	cset = rcAllocContourSet();
+	{
+		MutexLock tile_cache_lock(tile_cache_mutex);
 
-	ERR_FAIL_NULL(cset);
-	ERR_FAIL_COND(!rcBuildContours(&ctx, *chf, cfg.maxSimplificationError, cfg.maxEdgeLen, *cset));
+		// Drop the tiles kept for navigation meshes that no longer exist.
+		LocalVector<ObjectID> freed_navigation_meshes;
+		for (const KeyValue<ObjectID, NavMeshTileCache3D> &E : tile_caches) {
+			if (!ObjectDB::get_instance(E.key)) {
+				freed_navigation_meshes.push_back(E.key);
+			}
+		}
+		for (const ObjectID &freed_navigation_mesh : freed_navigation_meshes) {
+			tile_caches.erase(freed_navigation_mesh);
+		}
 
-	p_generator_task->bake_state = NavMeshBakeState::BAKE_STATE_CREATING_POLYMESH; // step #9
+		const NavMeshTileCache3D *tile_cache = tile_caches.getptr(p_navigation_mesh->get_instance_id());
 
-	poly_mesh = rcAllocPolyMesh();
-	ERR_FAIL_NULL(poly_mesh);
-	ERR_FAIL_COND(!rcBuildPolyMesh(&ctx, *cset, cfg.maxVertsPerPoly, *poly_mesh));
+		for (NavMeshGeneratorTile3D &tile : tiles) {
+			if (tile.triangles.is_empty()) {
+				continue;
+			}
+			tile.hash = hash_fmix32(tile.hash);
 
-	detail_mesh = rcAllocPolyMeshDetail();
-	ERR_FAIL_NULL(detail_mesh);
-	ERR_FAIL_COND(!rcBuildPolyMeshDetail(&ctx, *poly_mesh, *chf, cfg.detailSampleDist, cfg.detailSampleMaxError, *detail_mesh));
+			const NavMeshTile3D *cached_tile = nullptr;
+			if (tile_cache && tile_cache->config_hash == config_hash) {
+				cached_tile = tile_cache->tiles.getptr(tile.coords);
+			}
+			if (cached_tile && cached_tile->hash == tile.hash) {
+				tile.baked = true;
+				tile.vertices = cached_tile->vertices;
+				tile.polygons = cached_tile->polygons;
+			} else {
+				tile_bake.tiles.push_back(&tile);
+			}
+		}
+	}
 
-	rcFreeCompactHeightfield(chf);
-	chf = nullptr;
-	rcFreeContourSet(cset);
-	cset = nullptr;
+	if (use_threads && tile_bake.tiles.size() > 1) {
+		WorkerThreadPool::GroupID group_task_id = WorkerThreadPool::get_singleton()->add_native_group_task(&_generator_bake_tile, &tile_bake, tile_bake.tiles.size(), -1, baking_use_high_priority_threads, SNAME("NavMeshGeneratorBakeTiles3D"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task_id);
+	} else {
+		for (uint32_t i = 0; i < tile_bake.tiles.size(); i++) {
+			_generator_bake_tile(&tile_bake, i);
+		}
+	}
 
 	p_generator_task->bake_state = NavMeshBakeState::BAKE_STATE_CONVERTING_NATIVE_NAVMESH; // step #10
 
+	NavMeshTileCache3D new_tile_cache;
+	new_tile_cache.config_hash = config_hash;
+
 	Vector<Vector3> nav_vertices;
 	Vector<Vector<int>> nav_polygons;
 
-	HashMap<Vector3, int> recast_vertex_to_native_index;
-	LocalVector<int> recast_index_to_native_index;
-	recast_index_to_native_index.resize(detail_mesh->nverts);
+	HashMap<Vector3, int> tile_vertex_to_native_index;
+	LocalVector<int> tile_index_to_native_index;
 
-	for (int i = 0; i < detail_mesh->nverts; i++) {
-		const float *v = &detail_mesh->verts[i * 3];
-		const Vector3 vertex = Vector3(v[0], v[1], v[2]);
-		int *existing_index_ptr = recast_vertex_to_native_index.getptr(vertex);
-		if (!existing_index_ptr) {
-			int new_index = recast_vertex_to_native_index.size();
-			recast_index_to_native_index[i] = new_index;
-			recast_vertex_to_native_index[vertex] = new_index;
-			nav_vertices.push_back(vertex);
-		} else {
-			recast_index_to_native_index[i] = *existing_index_ptr;
+	for (const NavMeshGeneratorTile3D &tile : tiles) {
+		if (!tile.baked) {
+			continue;
 		}
-	}
-
-	for (int i = 0; i < detail_mesh->nmeshes; i++) {
-		const unsigned int *detail_mesh_m = &detail_mesh->meshes[i * 4];
-		const unsigned int detail_mesh_bverts = detail_mesh_m[0];
-		const unsigned int detail_mesh_m_btris = detail_mesh_m[2];
-		const unsigned int detail_mesh_ntris = detail_mesh_m[3];
-		const unsigned char *detail_mesh_tris = &detail_mesh->tris[detail_mesh_m_btris * 4];
-		for (unsigned int j = 0; j < detail_mesh_ntris; j++) {
-			Vector<int> nav_indices;
-			nav_indices.resize(3);
-			// Polygon order in recast is opposite than godot's
-			int index1 = ((int)(detail_mesh_bverts + detail_mesh_tris[j * 4 + 0]));
-			int index2 = ((int)(detail_mesh_bverts + detail_mesh_tris[j * 4 + 2]));
-			int index3 = ((int)(detail_mesh_bverts + detail_mesh_tris[j * 4 + 1]));
 
-			nav_indices.write[0] = recast_index_to_native_index[index1];
-			nav_indices.write[1] = recast_index_to_native_index[index2];
-			nav_indices.write[2] = recast_index_to_native_index[index3];
+		NavMeshTile3D &cached_tile = new_tile_cache.tiles[tile.coords];
+		cached_tile.hash = tile.hash;
+		cached_tile.vertices = tile.vertices;
+		cached_tile.polygons = tile.polygons;
+
+		tile_index_to_native_index.resize(tile.vertices.size());
+		for (int i = 0; i < tile.vertices.size(); i++) {
+			const Vector3 &vertex = tile.vertices[i];
+			int *existing_index_ptr = tile_vertex_to_native_index.getptr(vertex);
+			if (!existing_index_ptr) {
+				int new_index = tile_vertex_to_native_index.size();
+				tile_index_to_native_index[i] = new_index;
+				tile_vertex_to_native_index[vertex] = new_index;
+				nav_vertices.push_back(vertex);
+			} else {
+				tile_index_to_native_index[i] = *existing_index_ptr;
+			}
+		}
 
+		for (const Vector<int> &tile_polygon : tile.polygons) {
+			Vector<int> nav_indices;
+			nav_indices.resize(tile_polygon.size());
+			for (int i = 0; i < tile_polygon.size(); i++) {
+				nav_indices.write[i] = tile_index_to_native_index[tile_polygon[i]];
+			}
 			nav_polygons.push_back(nav_indices);
 		}
 	}
@@ -579,10 +939,10 @@ void NavMeshGenerator3D::generator_bake_from_source_geometry_data(NavMeshGenerat
 
 	p_generator_task->bake_state = NavMeshBakeState::BAKE_STATE_BAKE_CLEANUP; // step #11
 
-	rcFreePolyMesh(poly_mesh);
-	poly_mesh = nullptr;
-	rcFreePolyMeshDetail(detail_mesh);
-	detail_mesh = nullptr;
+	{
+		MutexLock tile_cache_lock(tile_cache_mutex);
+		tile_caches[p_navigation_mesh->get_instance_id()] = new_tile_cache;
+	}
 
 	p_generator_task->bake_state = NavMeshBakeState::BAKE_STATE_BAKE_FINISHED; // step #12
 }
@@ -37,6 +37,7 @@
 class Node;
 class NavigationMesh;
 class NavigationMeshSourceGeometryData3D;
+struct rcConfig;
 
 class NavMeshGenerator3D : public Object {
 	GDSOFTCLASS(NavMeshGenerator3D, Object);
@@ -96,9 +97,24 @@ private:
 
 	static HashMap<Ref<NavigationMesh>, NavMeshGeneratorTask3D *> baking_navmeshes;
 
+	struct NavMeshTile3D {
+		uint32_t hash = 0;
+		Vector<Vector3> vertices;
+		Vector<Vector<int>> polygons;
+	};
+
+	struct NavMeshTileCache3D {
+		uint32_t config_hash = 0;
+		HashMap<Vector2i, NavMeshTile3D> tiles;
+	};
+
+	static Mutex tile_cache_mutex;
+	static HashMap<ObjectID, NavMeshTileCache3D> tile_caches;
+
 	static void generator_parse_geometry_node(const Ref<NavigationMesh> &p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, Node *p_node, bool p_recurse_children);
 	static void generator_parse_source_geometry_data(const Ref<NavigationMesh> &p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, Node *p_root_node);
 	static void generator_bake_from_source_geometry_data(NavMeshGeneratorTask3D *p_generator_task);
+	static void generator_bake_tiles_from_source_geometry_data(NavMeshGeneratorTask3D *p_generator_task, const rcConfig &p_config);
 
 	static bool generator_emit_callback(const Callable &p_callback);
 
@@ -84,36 +84,7 @@ Vector3 NavMeshQueries3D::polygons_get_random_point(const LocalVector<Polygon> &
 		uint32_t rrp_polygon_index = region_E->value;
 		ERR_FAIL_UNSIGNED_INDEX_V(rrp_polygon_index, region_polygons.size(), Vector3());
 
-		const Polygon &rr_polygon = region_polygons[rrp_polygon_index];
-
-		real_t accumulated_polygon_area = 0;
-		RBMap<real_t, uint32_t> polygon_area_map;
-
-		for (uint32_t rpp_index = 2; rpp_index < rr_polygon.vertices.size(); rpp_index++) {
-			real_t face_area = Face3(rr_polygon.vertices[0], rr_polygon.vertices[rpp_index - 1], rr_polygon.vertices[rpp_index]).get_area();
-
-			if (face_area == 0.0) {
-				continue;
-			}
-			polygon_area_map[accumulated_polygon_area] = rpp_index;
-			accumulated_polygon_area += face_area;
-		}
-		if (polygon_area_map.is_empty() || accumulated_polygon_area == 0) {
-			// All faces have no real surface / no area.
-			return Vector3();
-		}
-
-		real_t polygon_area_map_pos = Math::random(real_t(0), accumulated_polygon_area);
-
-		RBMap<real_t, uint32_t>::Iterator polygon_E = polygon_area_map.find_closest(polygon_area_map_pos);
-		ERR_FAIL_COND_V(!polygon_E, Vector3());
-		uint32_t rrp_face_index = polygon_E->value;
-		ERR_FAIL_UNSIGNED_INDEX_V(rrp_face_index, rr_polygon.vertices.size(), Vector3());
-
-		const Face3 face(rr_polygon.vertices[0], rr_polygon.vertices[rrp_face_index - 1], rr_polygon.vertices[rrp_face_index]);
-
-		Vector3 face_random_position = face.get_random_point_inside();
-		return face_random_position;
+		return _polygon_get_random_point(region_polygons[rrp_polygon_index]);
 
 	} else {
 		uint32_t rrp_polygon_index = Math::random(int(0), region_polygons.size() - 1);
@@ -150,88 +121,141 @@ void NavMeshQueries3D::map_query_path(NavMap3D *map, const Ref<NavigationPathQue
 	ERR_FAIL_COND(p_query_parameters.is_null());
 	ERR_FAIL_COND(p_query_result.is_null());
 
-	using namespace NavigationDefaults3D;
-
 	NavMeshQueries3D::NavMeshPathQueryTask3D query_task;
-	query_task.start_position = p_query_parameters->get_start_position();
-	query_task.target_position = p_query_parameters->get_target_position();
-	query_task.navigation_layers = p_query_parameters->get_navigation_layers();
+	query_task_setup(query_task, p_query_parameters);
 	query_task.callback = p_callback;
 
+	map->query_path(query_task);
+
+	query_task_store_result(query_task, p_query_result);
+
+	if (query_task.callback.is_valid()) {
+		if (emit_callback(query_task.callback)) {
+			query_task.status = NavMeshPathQueryTask3D::TaskStatus::CALLBACK_DISPATCHED;
+		} else {
+			query_task.status = NavMeshPathQueryTask3D::TaskStatus::CALLBACK_FAILED;
+		}
+	}
+}
+
+void NavMeshQueries3D::query_task_setup(NavMeshPathQueryTask3D &r_query_task, const Ref<NavigationPathQueryParameters3D> &p_query_parameters) {
+	using namespace NavigationDefaults3D;
+
+	r_query_task.start_position = p_query_parameters->get_start_position();
+	r_query_task.target_position = p_query_parameters->get_target_position();
+	r_query_task.navigation_layers = p_query_parameters->get_navigation_layers();
+
 	const TypedArray<RID> &_excluded_regions = p_query_parameters->get_excluded_regions();
 	const TypedArray<RID> &_included_regions = p_query_parameters->get_included_regions();
 
 	uint32_t _excluded_region_count = _excluded_regions.size();
 	uint32_t _included_region_count = _included_regions.size();
 
-	query_task.exclude_regions = _excluded_region_count > 0;
-	query_task.include_regions = _included_region_count > 0;
+	r_query_task.exclude_regions = _excluded_region_count > 0;
+	r_query_task.include_regions = _included_region_count > 0;
 
-	if (query_task.exclude_regions) {
-		query_task.excluded_regions.resize(_excluded_region_count);
+	if (r_query_task.exclude_regions) {
+		r_query_task.excluded_regions.resize(_excluded_region_count);
 		for (uint32_t i = 0; i < _excluded_region_count; i++) {
-			query_task.excluded_regions[i] = _excluded_regions[i];
+			r_query_task.excluded_regions[i] = _excluded_regions[i];
 		}
 	}
 
-	if (query_task.include_regions) {
-		query_task.included_regions.resize(_included_region_count);
+	if (r_query_task.include_regions) {
+		r_query_task.included_regions.resize(_included_region_count);
 		for (uint32_t i = 0; i < _included_region_count; i++) {
-			query_task.included_regions[i] = _included_regions[i];
+			r_query_task.included_regions[i] = _included_regions[i];
 		}
 	}
 
 	switch (p_query_parameters->get_pathfinding_algorithm()) {
 		case NavigationPathQueryParameters3D::PathfindingAlgorithm::PATHFINDING_ALGORITHM_ASTAR: {
-			query_task.pathfinding_algorithm = PathfindingAlgorithm::PATHFINDING_ALGORITHM_ASTAR;
+			r_query_task.pathfinding_algorithm = PathfindingAlgorithm::PATHFINDING_ALGORITHM_ASTAR;
 		} break;
 		default: {
 			WARN_PRINT("No match for used PathfindingAlgorithm - fallback to default");
-			query_task.pathfinding_algorithm = PathfindingAlgorithm::PATHFINDING_ALGORITHM_ASTAR;
+			r_query_task.pathfinding_algorithm = PathfindingAlgorithm::PATHFINDING_ALGORITHM_ASTAR;
 		} break;
 	}
 
 	switch (p_query_parameters->get_path_postprocessing()) {
 		case NavigationPathQueryParameters3D::PathPostProcessing::PATH_POSTPROCESSING_CORRIDORFUNNEL: {
-			query_task.path_postprocessing = PathPostProcessing::PATH_POSTPROCESSING_CORRIDORFUNNEL;
+			r_query_task.path_postprocessing = PathPostProcessing::PATH_POSTPROCESSING_CORRIDORFUNNEL;
 		} break;
 		case NavigationPathQueryParameters3D::PathPostProcessing::PATH_POSTPROCESSING_EDGECENTERED: {
-			query_task.path_postprocessing = PathPostProcessing::PATH_POSTPROCESSING_EDGECENTERED;
+			r_query_task.path_postprocessing = PathPostProcessing::PATH_POSTPROCESSING_EDGECENTERED;
 		} break;
 		case NavigationPathQueryParameters3D::PathPostProcessing::PATH_POSTPROCESSING_NONE: {
-			query_task.path_postprocessing = PathPostProcessing::PATH_POSTPROCESSING_NONE;
+			r_query_task.path_postprocessing = PathPostProcessing::PATH_POSTPROCESSING_NONE;
 		} break;
 		default: {
 			WARN_PRINT("No match for used PathPostProcessing - fallback to default");
-			query_task.path_postprocessing = PathPostProcessing::PATH_POSTPROCESSING_CORRIDORFUNNEL;
+			r_query_task.path_postprocessing = PathPostProcessing::PATH_POSTPROCESSING_CORRIDORFUNNEL;
 		} break;
 	}
 
-	query_task.metadata_flags = (int64_t)p_query_parameters->get_metadata_flags();
-	query_task.simplify_path = p_query_parameters->get_simplify_path();
-	query_task.simplify_epsilon = p_query_parameters->get_simplify_epsilon();
-	query_task.path_return_max_length = p_query_parameters->get_path_return_max_length();
-	query_task.path_return_max_radius = p_query_parameters->get_path_return_max_radius();
-	query_task.path_search_max_polygons = p_query_parameters->get_path_search_max_polygons();
-	query_task.path_search_max_distance = p_query_parameters->get_path_search_max_distance();
-	query_task.status = NavMeshPathQueryTask3D::TaskStatus::QUERY_STARTED;
-
-	map->query_path(query_task);
+	r_query_task.metadata_flags = (int64_t)p_query_parameters->get_metadata_flags();
+	r_query_task.simplify_path = p_query_parameters->get_simplify_path();
+	r_query_task.simplify_epsilon = p_query_parameters->get_simplify_epsilon();
+	r_query_task.path_return_max_length = p_query_parameters->get_path_return_max_length();
+	r_query_task.path_return_max_radius = p_query_parameters->get_path_return_max_radius();
+	r_query_task.path_search_max_polygons = p_query_parameters->get_path_search_max_polygons();
+	r_query_task.path_search_max_distance = p_query_parameters->get_path_search_max_distance();
+	r_query_task.status = NavMeshPathQueryTask3D::TaskStatus::QUERY_STARTED;
+}
 
+void NavMeshQueries3D::query_task_store_result(const NavMeshPathQueryTask3D &p_query_task, Ref<NavigationPathQueryResult3D> p_query_result) {
 	p_query_result->set_data(
-			query_task.path_points,
-			query_task.path_meta_point_types,
-			query_task.path_meta_point_rids,
-			query_task.path_meta_point_owners);
-	p_query_result->set_path_length(query_task.path_length);
+			p_query_task.path_points,
+			p_query_task.path_meta_point_types,
+			p_query_task.path_meta_point_rids,
+			p_query_task.path_meta_point_owners);
+	p_query_result->set_path_length(p_query_task.path_length);
+}
 
-	if (query_task.callback.is_valid()) {
-		if (emit_callback(query_task.callback)) {
-			query_task.status = NavMeshPathQueryTask3D::TaskStatus::CALLBACK_DISPATCHED;
-		} else {
-			query_task.status = NavMeshPathQueryTask3D::TaskStatus::CALLBACK_FAILED;
+void NavMeshQueries3D::map_iteration_query_path(NavMeshPathQueryTask3D &p_query_task, NavMapIteration3D &p_map_iteration) {
+	p_map_iteration.path_query_slots_semaphore.wait();
+
+	p_map_iteration.path_query_slots_mutex.lock();
+	for (PathQuerySlot &p_path_query_slot : p_map_iteration.path_query_slots) {
+		if (!p_path_query_slot.in_use) {
+			p_path_query_slot.in_use = true;
+			p_query_task.path_query_slot = &p_path_query_slot;
+			break;
 		}
 	}
+	p_map_iteration.path_query_slots_mutex.unlock();
+
+	if (p_query_task.path_query_slot == nullptr) {
+		p_map_iteration.path_query_slots_semaphore.post();
+		ERR_FAIL_NULL_MSG(p_query_task.path_query_slot, "No unused NavMap3D path query slot found! This should never happen :(.");
+	}
+
+	p_query_task.map_up = p_map_iteration.map_up;
+
+	query_task_map_iteration_get_path(p_query_task, p_map_iteration);
+
+	p_map_iteration.path_query_slots_mutex.lock();
+	uint32_t used_slot_index = p_query_task.path_query_slot->slot_index;
+	p_map_iteration.path_query_slots[used_slot_index].in_use = false;
+	p_query_task.path_query_slot = nullptr;
+	p_map_iteration.path_query_slots_mutex.unlock();
+
+	p_map_iteration.path_query_slots_semaphore.post();
+}
+
+void NavMeshQueries3D::_query_batch_thread_query_path(void *p_arg, uint32_t p_index) {
+	NavMeshPathQueryBatch3D *query_batch = static_cast<NavMeshPathQueryBatch3D *>(p_arg);
+
+	NavMeshPathQueryTask3D &query_task = query_batch->query_tasks[p_index];
+	NavMapIteration3D *map_iteration = query_batch->query_map_iterations[p_index];
+
+	// Queries against maps without a synced iteration yield an empty path, same as `map_query_path()`.
+	if (map_iteration) {
+		map_iteration_query_path(query_task, *map_iteration);
+	}
+
+	query_task_store_result(query_task, query_task.query_result);
 }
 
 void NavMeshQueries3D::_query_task_find_start_end_positions(NavMeshPathQueryTask3D &p_query_task, const NavMapIteration3D &p_map_iteration) {
@@ -293,8 +317,15 @@ void NavMeshQueries3D::_query_task_search_polygon_connections(NavMeshPathQueryTa
 	Vector3 new_entry = Geometry3D::get_closest_point_to_segment(p_least_cost_poly.entry, p_connection.pathway_start, p_connection.pathway_end);
 	real_t new_traveled_distance = p_least_cost_poly.entry.distance_to(new_entry) * poly_travel_cost + p_poly_enter_cost + p_least_cost_poly.traveled_distance;
 
+	const uint32_t neighbor_poly_id = p_query_task.path_query_slot->poly_to_id[p_connection.polygon];
+
+	// Stay inside the cluster corridor found by the hierarchical search.
+	if (p_query_task.corridor_cluster_polygons && !p_query_task.path_query_slot->clusters_in_corridor[(*p_query_task.corridor_cluster_polygons)[neighbor_poly_id].cluster]) {
+		return;
+	}
+
 	// Check if the neighbor polygon has already been processed.
-	NavigationPoly &neighbor_poly = navigation_polys[p_query_task.path_query_slot->poly_to_id[p_connection.polygon]];
+	NavigationPoly &neighbor_poly = navigation_polys[neighbor_poly_id];
 	if (new_traveled_distance < neighbor_poly.traveled_distance) {
 		// Add the polygon to the heap of polygons to traverse next.
 		neighbor_poly.back_navigation_poly_id = p_least_cost_id;
@@ -316,6 +347,187 @@ void NavMeshQueries3D::_query_task_search_polygon_connections(NavMeshPathQueryTa
 	}
 }
 
+real_t NavMeshQueries3D::cluster_get_connection_travel_cost(const ClusterPolygon &p_from, const Connection &p_connection, const ClusterPolygon &p_to) {
+	const NavBaseIteration3D *from_owner = p_from.polygon->owner;
+	const NavBaseIteration3D *to_owner = p_to.polygon->owner;
+
+	const Vector3 pathway_center = (p_connection.pathway_start + p_connection.pathway_end) * 0.5;
+	real_t travel_cost = p_from.center.distance_to(pathway_center) * from_owner->get_travel_cost() + pathway_center.distance_to(p_to.center) * to_owner->get_travel_cost();
+	if (from_owner != to_owner) {
+		travel_cost += to_owner->get_enter_cost();
+	}
+	return travel_cost;
+}
+
+void NavMeshQueries3D::cluster_get_polygon_travel_costs(const NavMapIteration3D &p_map_iteration, uint32_t p_cluster, uint32_t p_polygon_id, LocalVector<real_t> &r_travel_costs, LocalVector<bool> &r_closed) {
+	const PolygonCluster &cluster = p_map_iteration.clusters[p_cluster];
+	const LocalVector<ClusterPolygon> &cluster_polygons = p_map_iteration.cluster_polygons;
+	const LocalVector<LocalVector<Connection>> &internal_connections = cluster.owner->get_internal_connections();
+
+	r_travel_costs.resize(cluster.polygon_count);
+	r_closed.resize(cluster.polygon_count);
+	for (uint32_t i = 0; i < cluster.polygon_count; i++) {
+		r_travel_costs[i] = FLT_MAX;
+		r_closed[i] = false;
+	}
+
+	const ClusterPolygon &source_polygon = cluster_polygons[p_polygon_id];
+	ERR_FAIL_COND(source_polygon.cluster != p_cluster);
+	r_travel_costs[source_polygon.cluster_polygon_index] = 0.0;
+
+	// Dijkstra over the polygons of the cluster. Clusters are small so a linear search
+	// for the next closest polygon is cheaper than maintaining a heap.
+	while (true) {
+		uint32_t closest_index = UINT32_MAX;
+		real_t closest_travel_cost = FLT_MAX;
+		for (uint32_t i = 0; i < cluster.polygon_count; i++) {
+			if (!r_closed[i] && r_travel_costs[i] < closest_travel_cost) {
+				closest_index = i;
+				closest_travel_cost = r_travel_costs[i];
+			}
+		}
+
+		if (closest_index == UINT32_MAX) {
+			break;
+		}
+		r_closed[closest_index] = true;
+
+		const ClusterPolygon &from_polygon = cluster_polygons[p_map_iteration.cluster_polygon_ids[cluster.polygon_start + closest_index]];
+		if (internal_connections.is_empty()) {
+			continue;
+		}
+
+		for (const Connection &connection : internal_connections[from_polygon.polygon->id]) {
+			const ClusterPolygon &to_polygon = cluster_polygons[cluster.owner_polygon_offset + connection.polygon->id];
+			if (to_polygon.cluster != p_cluster || r_closed[to_polygon.cluster_polygon_index]) {
+				continue;
+			}
+
+			const real_t travel_cost = closest_travel_cost + cluster_get_connection_travel_cost(from_polygon, connection, to_polygon);
+			if (travel_cost < r_travel_costs[to_polygon.cluster_polygon_index]) {
+				r_travel_costs[to_polygon.cluster_polygon_index] = travel_cost;
+			}
+		}
+	}
+}
+
+void NavMeshQueries3D::_query_task_find_cluster_corridor(NavMeshPathQueryTask3D &p_query_task, const NavMapIteration3D &p_map_iteration) {
+	p_query_task.corridor_cluster_polygons = nullptr;
+
+	if (p_map_iteration.clusters.is_empty()) {
+		return;
+	}
+
+	PathQuerySlot *path_query_slot = p_query_task.path_query_slot;
+	const LocalVector<ClusterPolygon> &cluster_polygons = p_map_iteration.cluster_polygons;
+	const LocalVector<PolygonCluster> &clusters = p_map_iteration.clusters;
+	const LocalVector<ClusterPortal> &cluster_portals = p_map_iteration.cluster_portals;
+	const LocalVector<ClusterPortalEdge> &cluster_portal_edges = p_map_iteration.cluster_portal_edges;
+
+	const uint32_t begin_polygon_id = path_query_slot->poly_to_id[p_query_task.begin_polygon];
+	const uint32_t end_polygon_id = path_query_slot->poly_to_id[p_query_task.end_polygon];
+	const uint32_t begin_cluster_index = cluster_polygons[begin_polygon_id].cluster;
+	const uint32_t end_cluster_index = cluster_polygons[end_polygon_id].cluster;
+
+	// Paths inside of a single cluster are short, the polygon search handles them directly.
+	if (begin_cluster_index == end_cluster_index) {
+		return;
+	}
+
+	cluster_get_polygon_travel_costs(p_map_iteration, begin_cluster_index, begin_polygon_id, path_query_slot->cluster_begin_travel_costs, path_query_slot->cluster_polygons_closed);
+	cluster_get_polygon_travel_costs(p_map_iteration, end_cluster_index, end_polygon_id, path_query_slot->cluster_end_travel_costs, path_query_slot->cluster_polygons_closed);
+
+	LocalVector<ClusterPortalSearchNode> &portal_search = path_query_slot->portal_search;
+	for (ClusterPortalSearchNode &portal_search_node : portal_search) {
+		portal_search_node.reset();
+	}
+
+	Heap<ClusterPortalSearchNode *, ClusterPortalSearchCostGreaterThan, ClusterPortalSearchHeapIndexer> &open_portals = path_query_slot->open_portals;
+	open_portals.clear();
+
+	const Vector3 &end_point = p_query_task.end_position;
+
+	// Start from all portals of the begin cluster that the begin polygon can reach.
+	const PolygonCluster &begin_cluster = clusters[begin_cluster_index];
+	for (uint32_t portal_index = begin_cluster.portal_start; portal_index < begin_cluster.portal_start + begin_cluster.portal_count; portal_index++) {
+		const ClusterPolygon &portal_polygon = cluster_polygons[cluster_portals[portal_index].polygon_id];
+		const real_t traveled_cost = path_query_slot->cluster_begin_travel_costs[portal_polygon.cluster_polygon_index];
+		if (traveled_cost == FLT_MAX) {
+			continue;
+		}
+
+		ClusterPortalSearchNode &portal_search_node = portal_search[portal_index];
+		portal_search_node.traveled_cost = traveled_cost;
+		portal_search_node.cost_to_destination = portal_polygon.center.distance_to(end_point);
+		open_portals.push(&portal_search_node);
+	}
+
+	// This is an implementation of the A* algorithm on the portal graph.
+	int32_t end_portal_index = -1;
+	real_t end_travel_cost = FLT_MAX;
+
+	while (!open_portals.is_empty()) {
+		ClusterPortalSearchNode *portal_search_node = open_portals.pop();
+		if (portal_search_node->total_travel_cost() >= end_travel_cost) {
+			break;
+		}
+
+		const uint32_t portal_index = portal_search_node - portal_search.ptr();
+		const ClusterPortal &portal = cluster_portals[portal_index];
+
+		if (portal.cluster == end_cluster_index) {
+			const real_t portal_end_travel_cost = path_query_slot->cluster_end_travel_costs[cluster_polygons[portal.polygon_id].cluster_polygon_index];
+			if (portal_end_travel_cost != FLT_MAX && portal_search_node->traveled_cost + portal_end_travel_cost < end_travel_cost) {
+				end_travel_cost = portal_search_node->traveled_cost + portal_end_travel_cost;
+				end_portal_index = portal_index;
+			}
+		}
+
+		for (uint32_t edge_index = portal.edge_start; edge_index < portal.edge_start + portal.edge_count; edge_index++) {
+			const ClusterPortalEdge &edge = cluster_portal_edges[edge_index];
+			const ClusterPortal &next_portal = cluster_portals[edge.portal];
+			ClusterPortalSearchNode &next_portal_search_node = portal_search[edge.portal];
+
+			const real_t traveled_cost = portal_search_node->traveled_cost + edge.travel_cost;
+			if (traveled_cost >= next_portal_search_node.traveled_cost) {
+				continue;
+			}
+
+			if (next_portal.cluster != portal.cluster && !_query_task_is_connection_owner_usable(p_query_task, clusters[next_portal.cluster].owner)) {
+				continue;
+			}
+
+			next_portal_search_node.back_portal = portal_index;
+			next_portal_search_node.traveled_cost = traveled_cost;
+			next_portal_search_node.cost_to_destination = cluster_polygons[next_portal.polygon_id].center.distance_to(end_point);
+
+			if (next_portal_search_node.heap_index != open_portals.INVALID_INDEX) {
+				open_portals.shift(next_portal_search_node.heap_index);
+			} else {
+				open_portals.push(&next_portal_search_node);
+			}
+		}
+	}
+
+	if (end_portal_index < 0) {
+		// No route on the portal graph, the polygon search handles the unreachable end polygon.
+		return;
+	}
+
+	LocalVector<bool> &clusters_in_corridor = path_query_slot->clusters_in_corridor;
+	for (uint32_t i = 0; i < clusters_in_corridor.size(); i++) {
+		clusters_in_corridor[i] = false;
+	}
+
+	clusters_in_corridor[begin_cluster_index] = true;
+	clusters_in_corridor[end_cluster_index] = true;
+	for (int32_t portal_index = end_portal_index; portal_index >= 0; portal_index = portal_search[portal_index].back_portal) {
+		clusters_in_corridor[cluster_portals[portal_index].cluster] = true;
+	}
+
+	p_query_task.corridor_cluster_polygons = &cluster_polygons;
+}
+
 void NavMeshQueries3D::_query_task_build_path_corridor(NavMeshPathQueryTask3D &p_query_task, const NavMapIteration3D &p_map_iteration) {
 	const Vector3 p_target_position = p_query_task.target_position;
 	const Polygon *begin_poly = p_query_task.begin_polygon;
@@ -399,6 +611,25 @@ void NavMeshQueries3D::_query_task_build_path_corridor(NavMeshPathQueryTask3D &p
 		poly_enter_cost = 0;
 		// When the heap of traversable polygons is empty at this point it means the end polygon is
 		// unreachable.
+		if (traversable_polys.is_empty() && p_query_task.corridor_cluster_polygons && !path_search_max_reached) {
+			// The cluster corridor is based on estimated costs, search the whole map before treating the end polygon as unreachable.
+			p_query_task.corridor_cluster_polygons = nullptr;
+
+			for (NavigationPoly &nav_poly : navigation_polys) {
+				nav_poly.reset();
+			}
+			least_cost_id = p_query_task.path_query_slot->poly_to_id[begin_poly];
+			navigation_polys[least_cost_id].poly = begin_poly;
+			navigation_polys[least_cost_id].entry = begin_point;
+			navigation_polys[least_cost_id].back_navigation_edge_pathway_start = begin_point;
+			navigation_polys[least_cost_id].back_navigation_edge_pathway_end = begin_point;
+			navigation_polys[least_cost_id].traveled_distance = 0.f;
+			reachable_end = nullptr;
+			distance_to_reachable_end = FLT_MAX;
+			processed_polygon_count = 0;
+			continue;
+		}
+
 		if (traversable_polys.is_empty()) {
 			// Thus use the further reachable polygon
 			ERR_BREAK_MSG(is_reachable == false, "Invalid navigation index or connection pointers. Check preceding navmesh geometry or placement errors.");
@@ -511,6 +742,99 @@ void NavMeshQueries3D::_query_task_build_path_corridor(NavMeshPathQueryTask3D &p
 	}
 }
 
+bool NavMeshQueries3D::_query_task_get_path_cache_key(const NavMeshPathQueryTask3D &p_query_task, PathQueryCacheKey &r_key) {
+	// Region filters are not part of the key, these queries always search.
+	if (p_query_task.exclude_regions || p_query_task.include_regions) {
+		return false;
+	}
+
+	r_key.begin_polygon = p_query_task.begin_polygon;
+	r_key.end_polygon = p_query_task.end_polygon;
+	r_key.navigation_layers = p_query_task.navigation_layers;
+	r_key.pathfinding_algorithm = p_query_task.pathfinding_algorithm;
+	r_key.path_postprocessing = p_query_task.path_postprocessing;
+	r_key.path_search_max_polygons = p_query_task.path_search_max_polygons;
+	r_key.path_search_max_distance = p_query_task.path_search_max_distance;
+	return true;
+}
+
+bool NavMeshQueries3D::_query_task_load_cached_path_corridor(NavMeshPathQueryTask3D &p_query_task, const NavMapIteration3D &p_map_iteration, const PathQueryCacheKey &p_key) {
+	PathQueryCache &path_query_cache = p_map_iteration.path_query_cache;
+	LocalVector<NavigationPoly> &navigation_polys = p_query_task.path_query_slot->path_corridor;
+
+	MutexLock lock(path_query_cache.mutex);
+
+	const LocalVector<PathQueryCacheCorridorPoly> *corridor = path_query_cache.corridors.getptr(p_key);
+	if (corridor == nullptr) {
+		path_query_cache.miss_count.increment();
+		return false;
+	}
+	path_query_cache.hit_count.increment();
+
+	for (NavigationPoly &polygon : navigation_polys) {
+		polygon.reset();
+	}
+
+	// Rebuild the back linked corridor, the entry points depend on the begin position of this query.
+	int prev_poly_id = -1;
+	for (const PathQueryCacheCorridorPoly &corridor_poly : *corridor) {
+		const uint32_t poly_id = p_query_task.path_query_slot->poly_to_id[corridor_poly.poly];
+		NavigationPoly &navigation_poly = navigation_polys[poly_id];
+		navigation_poly.poly = corridor_poly.poly;
+
+		if (prev_poly_id == -1) {
+			navigation_poly.entry = p_query_task.begin_position;
+			navigation_poly.back_navigation_edge_pathway_start = p_query_task.begin_position;
+			navigation_poly.back_navigation_edge_pathway_end = p_query_task.begin_position;
+			navigation_poly.traveled_distance = 0.0;
+		} else {
+			const NavigationPoly &prev_navigation_poly = navigation_polys[prev_poly_id];
+			navigation_poly.back_navigation_poly_id = prev_poly_id;
+			navigation_poly.back_navigation_edge = corridor_poly.back_navigation_edge;
+			navigation_poly.back_navigation_edge_pathway_start = corridor_poly.back_navigation_edge_pathway_start;
+			navigation_poly.back_navigation_edge_pathway_end = corridor_poly.back_navigation_edge_pathway_end;
+			navigation_poly.entry = Geometry3D::get_closest_point_to_segment(prev_navigation_poly.entry, corridor_poly.back_navigation_edge_pathway_start, corridor_poly.back_navigation_edge_pathway_end);
+			navigation_poly.traveled_distance = prev_navigation_poly.traveled_distance + prev_navigation_poly.entry.distance_to(navigation_poly.entry) * prev_navigation_poly.poly->owner->get_travel_cost();
+		}
+
+		prev_poly_id = poly_id;
+	}
+
+	p_query_task.least_cost_id = prev_poly_id;
+	return true;
+}
+
+void NavMeshQueries3D::_query_task_store_cached_path_corridor(NavMeshPathQueryTask3D &p_query_task, const NavMapIteration3D &p_map_iteration, const PathQueryCacheKey &p_key) {
+	// A corridor to the closest reachable polygon depends on the target position, only cache complete routes.
+	if (p_query_task.begin_polygon != p_key.begin_polygon || p_query_task.end_polygon != p_key.end_polygon) {
+		return;
+	}
+
+	const LocalVector<NavigationPoly> &navigation_polys = p_query_task.path_query_slot->path_corridor;
+
+	LocalVector<PathQueryCacheCorridorPoly> corridor;
+	for (int poly_id = p_query_task.least_cost_id; poly_id != -1; poly_id = navigation_polys[poly_id].back_navigation_poly_id) {
+		const NavigationPoly &navigation_poly = navigation_polys[poly_id];
+
+		PathQueryCacheCorridorPoly corridor_poly;
+		corridor_poly.poly = navigation_poly.poly;
+		corridor_poly.back_navigation_edge = navigation_poly.back_navigation_edge;
+		corridor_poly.back_navigation_edge_pathway_start = navigation_poly.back_navigation_edge_pathway_start;
+		corridor_poly.back_navigation_edge_pathway_end = navigation_poly.back_navigation_edge_pathway_end;
+		corridor.push_back(corridor_poly);
+	}
+	corridor.reverse();
+
+	PathQueryCache &path_query_cache = p_map_iteration.path_query_cache;
+	MutexLock lock(path_query_cache.mutex);
+
+	if (path_query_cache.corridors.size() >= PATH_QUERY_CACHE_SIZE_MAX && !path_query_cache.corridors.has(p_key)) {
+		// HashMap keeps insertion order, so the first element is the oldest corridor.
+		path_query_cache.corridors.remove(path_query_cache.corridors.begin());
+	}
+	path_query_cache.corridors[p_key] = corridor;
+}
+
 void NavMeshQueries3D::query_task_map_iteration_get_path(NavMeshPathQueryTask3D &p_query_task, const NavMapIteration3D &p_map_iteration) {
 	p_query_task.path_clear();
 
@@ -530,11 +854,22 @@ void NavMeshQueries3D::query_task_map_iteration_get_path(NavMeshPathQueryTask3D
 		return;
 	}
 
-	_query_task_build_path_corridor(p_query_task, p_map_iteration);
+	PathQueryCacheKey path_cache_key;
+	const bool use_path_cache = _query_task_get_path_cache_key(p_query_task, path_cache_key);
 
-	if (p_query_task.status == NavMeshPathQueryTask3D::TaskStatus::QUERY_FINISHED || p_query_task.status == NavMeshPathQueryTask3D::TaskStatus::QUERY_FAILED) {
-		_query_task_process_path_result_limits(p_query_task);
-		return;
+	if (!use_path_cache || !_query_task_load_cached_path_corridor(p_query_task, p_map_iteration, path_cache_key)) {
+		_query_task_find_cluster_corridor(p_query_task, p_map_iteration);
+
+		_query_task_build_path_corridor(p_query_task, p_map_iteration);
+
+		if (p_query_task.status == NavMeshPathQueryTask3D::TaskStatus::QUERY_FINISHED || p_query_task.status == NavMeshPathQueryTask3D::TaskStatus::QUERY_FAILED) {
+			_query_task_process_path_result_limits(p_query_task);
+			return;
+		}
+
+		if (use_path_cache) {
+			_query_task_store_cached_path_corridor(p_query_task, p_map_iteration, path_cache_key);
+		}
 	}
 
 	// Post-Process path.
@@ -878,65 +1213,79 @@ void NavMeshQueries3D::_query_task_post_process_nopostprocessing(NavMeshPathQuer
 }
 
 Vector3 NavMeshQueries3D::map_iteration_get_closest_point_to_segment(const NavMapIteration3D &p_map_iteration, const Vector3 &p_from, const Vector3 &p_to, const bool p_use_collision) {
-	bool use_collision = p_use_collision;
 	Vector3 closest_point;
+
+	const LocalVector<PolygonBVHNode> &polygon_bvh = p_map_iteration.polygon_bvh;
+	if (p_map_iteration.polygon_bvh_root < 0) {
+		return closest_point;
+	}
+
+	int32_t stack[POLYGON_BVH_STACK_SIZE];
+	uint32_t stack_size = 0;
+
+	// An intersection with the segment always wins over any other point, pick the one closest to the segment start.
 	real_t closest_point_distance = FLT_MAX;
+	bool collided = false;
 
-	const LocalVector<Ref<NavRegionIteration3D>> &regions = p_map_iteration.region_iterations;
-	for (const Ref<NavRegionIteration3D> &region : regions) {
-		for (const Polygon &polygon : region->get_navmesh_polygons()) {
-			// For each face check the distance to the segment.
-			for (uint32_t point_id = 2; point_id < polygon.vertices.size(); point_id += 1) {
-				const Face3 face(polygon.vertices[0], polygon.vertices[point_id - 1], polygon.vertices[point_id]);
-				Vector3 intersection_point;
-				if (face.intersects_segment(p_from, p_to, &intersection_point)) {
-					const real_t d = p_from.distance_to(intersection_point);
-					if (!use_collision) {
-						closest_point = intersection_point;
-						use_collision = true;
-						closest_point_distance = d;
-					} else if (closest_point_distance > d) {
-						closest_point = intersection_point;
-						closest_point_distance = d;
-					}
-				}
-				// If segment does not itersect face, check the distance from segment's endpoints.
-				else if (!use_collision) {
-					const Vector3 p_from_closest = face.get_closest_point_to(p_from);
-					const real_t d_p_from = p_from.distance_to(p_from_closest);
-					if (closest_point_distance > d_p_from) {
-						closest_point = p_from_closest;
-						closest_point_distance = d_p_from;
-					}
+	stack[stack_size++] = p_map_iteration.polygon_bvh_root;
+	while (stack_size > 0) {
+		const PolygonBVHNode &node = polygon_bvh[stack[--stack_size]];
+		if (!node.aabb.intersects_segment(p_from, p_to)) {
+			continue;
+		}
 
-					const Vector3 p_to_closest = face.get_closest_point_to(p_to);
-					const real_t d_p_to = p_to.distance_to(p_to_closest);
-					if (closest_point_distance > d_p_to) {
-						closest_point = p_to_closest;
-						closest_point_distance = d_p_to;
-					}
+		if (node.polygon) {
+			Vector3 intersection_point;
+			if (_polygon_intersect_segment(*node.polygon, p_from, p_to, intersection_point)) {
+				const real_t d = p_from.distance_to(intersection_point);
+				if (d < closest_point_distance) {
+					closest_point = intersection_point;
+					closest_point_distance = d;
+					collided = true;
 				}
 			}
-			// Finally, check for a case when shortest distance is between some point located on a face's edge and some point located on a line segment.
-			if (!use_collision) {
-				for (uint32_t point_id = 0; point_id < polygon.vertices.size(); point_id += 1) {
-					Vector3 a, b;
-
-					Geometry3D::get_closest_points_between_segments(
-							p_from,
-							p_to,
-							polygon.vertices[point_id],
-							polygon.vertices[(point_id + 1) % polygon.vertices.size()],
-							a,
-							b);
-
-					const real_t d = a.distance_to(b);
-					if (d < closest_point_distance) {
-						closest_point_distance = d;
-						closest_point = b;
-					}
-				}
+			continue;
+		}
+
+		stack[stack_size++] = node.left;
+		stack[stack_size++] = node.right;
+	}
+
+	if (collided || p_use_collision) {
+		return closest_point;
+	}
+
+	// The segment does not intersect any polygon, find the polygon point with the shortest distance to the segment.
+	closest_point_distance = FLT_MAX;
+
+	stack[stack_size++] = p_map_iteration.polygon_bvh_root;
+	while (stack_size > 0) {
+		const PolygonBVHNode &node = polygon_bvh[stack[--stack_size]];
+		if (closest_point_distance < FLT_MAX && !node.aabb.grow(closest_point_distance).intersects_segment(p_from, p_to)) {
+			continue;
+		}
+
+		if (node.polygon) {
+			Vector3 polygon_closest_point;
+			const real_t d = _polygon_get_closest_point_to_segment(*node.polygon, p_from, p_to, polygon_closest_point);
+			if (d < closest_point_distance) {
+				closest_point = polygon_closest_point;
+				closest_point_distance = d;
 			}
+			continue;
+		}
+
+		// Visit the child nearest to the segment first so that the other one is more likely to be culled.
+		const Vector3 left_center = polygon_bvh[node.left].aabb.get_center();
+		const Vector3 right_center = polygon_bvh[node.right].aabb.get_center();
+		const real_t left_distance = left_center.distance_squared_to(Geometry3D::get_closest_point_to_segment(left_center, p_from, p_to));
+		const real_t right_distance = right_center.distance_squared_to(Geometry3D::get_closest_point_to_segment(right_center, p_from, p_to));
+		if (left_distance < right_distance) {
+			stack[stack_size++] = node.right;
+			stack[stack_size++] = node.left;
+		} else {
+			stack[stack_size++] = node.left;
+			stack[stack_size++] = node.right;
 		}
 	}
 
@@ -962,70 +1311,48 @@ ClosestPointQueryResult NavMeshQueries3D::map_iteration_get_closest_point_info(c
 	ClosestPointQueryResult result;
 	real_t closest_point_distance_squared = FLT_MAX;
 
-	const LocalVector<Ref<NavRegionIteration3D>> &regions = p_map_iteration.region_iterations;
-	for (const Ref<NavRegionIteration3D> &region : regions) {
-		for (const Polygon &polygon : region->get_navmesh_polygons()) {
-			Vector3 plane_normal = (polygon.vertices[1] - polygon.vertices[0]).cross(polygon.vertices[2] - polygon.vertices[0]);
+	const LocalVector<PolygonBVHNode> &polygon_bvh = p_map_iteration.polygon_bvh;
+	if (p_map_iteration.polygon_bvh_root < 0) {
+		return result;
+	}
+
+	int32_t stack[POLYGON_BVH_STACK_SIZE];
+	uint32_t stack_size = 0;
+
+	stack[stack_size++] = p_map_iteration.polygon_bvh_root;
+	while (stack_size > 0) {
+		const PolygonBVHNode &node = polygon_bvh[stack[--stack_size]];
+		if (_aabb_get_distance_squared_to_point(node.aabb, p_point) >= closest_point_distance_squared) {
+			continue;
+		}
+
+		if (node.polygon) {
 			Vector3 closest_on_polygon;
-			real_t closest = FLT_MAX;
-			bool inside = true;
-			Vector3 previous = polygon.vertices[polygon.vertices.size() - 1];
-			for (uint32_t point_id = 0; point_id < polygon.vertices.size(); ++point_id) {
-				Vector3 edge = polygon.vertices[point_id] - previous;
-				Vector3 to_point = p_point - previous;
-				Vector3 edge_to_point_pormal = edge.cross(to_point);
-				bool clockwise = edge_to_point_pormal.dot(plane_normal) > 0;
-				// If we are not clockwise, the point will never be inside the polygon and so the closest point will be on an edge.
-				if (!clockwise) {
-					inside = false;
-					real_t point_projected_on_edge = edge.dot(to_point);
-					real_t edge_square = edge.length_squared();
-
-					if (point_projected_on_edge > edge_square) {
-						real_t distance = polygon.vertices[point_id].distance_squared_to(p_point);
-						if (distance < closest) {
-							closest_on_polygon = polygon.vertices[point_id];
-							closest = distance;
-						}
-					} else if (point_projected_on_edge < 0.f) {
-						real_t distance = previous.distance_squared_to(p_point);
-						if (distance < closest) {
-							closest_on_polygon = previous;
-							closest = distance;
-						}
-					} else {
-						// If we project on this edge, this will be the closest point.
-						real_t percent = point_projected_on_edge / edge_square;
-						closest_on_polygon = previous + percent * edge;
-						break;
-					}
-				}
-				previous = polygon.vertices[point_id];
-			}
+			Vector3 plane_normal;
+			const real_t distance_squared = _polygon_get_closest_point(*node.polygon, p_point, closest_on_polygon, plane_normal);
+			if (distance_squared < closest_point_distance_squared) {
+				closest_point_distance_squared = distance_squared;
+				result.point = closest_on_polygon;
+				result.normal = plane_normal.normalized();
+				result.owner = node.polygon->owner->get_self();
 
-			if (inside) {
-				Vector3 plane_normalized = plane_normal.normalized();
-				real_t distance = plane_normalized.dot(p_point - polygon.vertices[0]);
-				real_t distance_squared = distance * distance;
-				if (distance_squared < closest_point_distance_squared) {
-					closest_point_distance_squared = distance_squared;
-					result.point = p_point - plane_normalized * distance;
-					result.normal = plane_normalized;
-					result.owner = polygon.owner->get_self();
-
-					if (Math::is_zero_approx(distance)) {
-						break;
-					}
-				}
-			} else {
-				real_t distance = closest_on_polygon.distance_squared_to(p_point);
-				if (distance < closest_point_distance_squared) {
-					closest_point_distance_squared = distance;
-					result.point = closest_on_polygon;
-					result.normal = plane_normal.normalized();
-					result.owner = polygon.owner->get_self();
+				if (closest_point_distance_squared < CMP_EPSILON2) {
+					// The point is on the polygon, nothing can be closer.
+					break;
 				}
 			}
+			continue;
+		}
+
+		// Visit the nearest child first so that the other one is more likely to be culled.
+		const real_t left_distance_squared = _aabb_get_distance_squared_to_point(polygon_bvh[node.left].aabb, p_point);
+		const real_t right_distance_squared = _aabb_get_distance_squared_to_point(polygon_bvh[node.right].aabb, p_point);
+		if (left_distance_squared < right_distance_squared) {
+			stack[stack_size++] = node.right;
+			stack[stack_size++] = node.left;
+		} else {
+			stack[stack_size++] = node.left;
+			stack[stack_size++] = node.right;
 		}
 	}
 
@@ -1081,9 +1408,25 @@ Vector3 NavMeshQueries3D::map_iteration_get_random_point(const NavMapIteration3D
 		uint32_t random_region_index = E->value;
 		ERR_FAIL_UNSIGNED_INDEX_V(random_region_index, accessible_regions.size(), Vector3());
 
-		const Ref<NavRegionIteration3D> &random_region = p_map_iteration.region_iterations[accessible_regions[random_region_index]];
+		const uint32_t random_region_iteration_index = accessible_regions[random_region_index];
+		const Ref<NavRegionIteration3D> &random_region = p_map_iteration.region_iterations[random_region_iteration_index];
+		const LocalVector<real_t> &accumulated_area = p_map_iteration.regions_polygons_accumulated_area[random_region_iteration_index];
+		ERR_FAIL_COND_V(accumulated_area.is_empty(), Vector3());
+
+		// Binary search the first polygon whose accumulated surface area exceeds the random position.
+		const real_t random_area_position = Math::random(real_t(0), accumulated_area[accumulated_area.size() - 1]);
+		uint32_t low = 0;
+		uint32_t high = accumulated_area.size() - 1;
+		while (low < high) {
+			const uint32_t middle = (low + high) / 2;
+			if (accumulated_area[middle] > random_area_position) {
+				high = middle;
+			} else {
+				low = middle + 1;
+			}
+		}
 
-		return NavMeshQueries3D::polygons_get_random_point(random_region->navmesh_polygons, p_navigation_layers, p_uniformly);
+		return _polygon_get_random_point(random_region->navmesh_polygons[low]);
 
 	} else {
 		uint32_t random_region_index = Math::random(int(0), accessible_regions.size() - 1);
@@ -1243,6 +1586,161 @@ RID NavMeshQueries3D::polygons_get_closest_point_owner(const LocalVector<Polygon
 	return cp.owner;
 }
 
+real_t NavMeshQueries3D::_aabb_get_distance_squared_to_point(const AABB &p_aabb, const Vector3 &p_point) {
+	return p_point.clamp(p_aabb.position, p_aabb.position + p_aabb.size).distance_squared_to(p_point);
+}
+
+real_t NavMeshQueries3D::_polygon_get_closest_point(const Polygon &p_polygon, const Vector3 &p_point, Vector3 &r_closest_point, Vector3 &r_plane_normal) {
+	const LocalVector<Vector3> &vertices = p_polygon.vertices;
+
+	r_plane_normal = (vertices[1] - vertices[0]).cross(vertices[2] - vertices[0]);
+	Vector3 closest_on_polygon;
+	real_t closest = FLT_MAX;
+	bool inside = true;
+	Vector3 previous = vertices[vertices.size() - 1];
+	for (uint32_t point_id = 0; point_id < vertices.size(); ++point_id) {
+		Vector3 edge = vertices[point_id] - previous;
+		Vector3 to_point = p_point - previous;
+		Vector3 edge_to_point_pormal = edge.cross(to_point);
+		bool clockwise = edge_to_point_pormal.dot(r_plane_normal) > 0;
+		// If we are not clockwise, the point will never be inside the polygon and so the closest point will be on an edge.
+		if (!clockwise) {
+			inside = false;
+			real_t point_projected_on_edge = edge.dot(to_point);
+			real_t edge_square = edge.length_squared();
+
+			if (point_projected_on_edge > edge_square) {
+				real_t distance = vertices[point_id].distance_squared_to(p_point);
+				if (distance < closest) {
+					closest_on_polygon = vertices[point_id];
+					closest = distance;
+				}
+			} else if (point_projected_on_edge < 0.f) {
+				real_t distance = previous.distance_squared_to(p_point);
+				if (distance < closest) {
+					closest_on_polygon = previous;
+					closest = distance;
+				}
+			} else {
+				// If we project on this edge, this will be the closest point.
+				real_t percent = point_projected_on_edge / edge_square;
+				closest_on_polygon = previous + percent * edge;
+				break;
+			}
+		}
+		previous = vertices[point_id];
+	}
+
+	if (inside) {
+		Vector3 plane_normalized = r_plane_normal.normalized();
+		real_t distance = plane_normalized.dot(p_point - vertices[0]);
+		r_closest_point = p_point - plane_normalized * distance;
+		return distance * distance;
+	}
+
+	r_closest_point = closest_on_polygon;
+	return closest_on_polygon.distance_squared_to(p_point);
+}
+
+bool NavMeshQueries3D::_polygon_intersect_segment(const Polygon &p_polygon, const Vector3 &p_from, const Vector3 &p_to, Vector3 &r_intersection_point) {
+	const LocalVector<Vector3> &vertices = p_polygon.vertices;
+
+	bool intersects = false;
+	real_t closest_distance = FLT_MAX;
+	for (uint32_t point_id = 2; point_id < vertices.size(); point_id += 1) {
+		const Face3 face(vertices[0], vertices[point_id - 1], vertices[point_id]);
+		Vector3 intersection_point;
+		if (face.intersects_segment(p_from, p_to, &intersection_point)) {
+			const real_t d = p_from.distance_squared_to(intersection_point);
+			if (d < closest_distance) {
+				closest_distance = d;
+				r_intersection_point = intersection_point;
+				intersects = true;
+			}
+		}
+	}
+
+	return intersects;
+}
+
+real_t NavMeshQueries3D::_polygon_get_closest_point_to_segment(const Polygon &p_polygon, const Vector3 &p_from, const Vector3 &p_to, Vector3 &r_closest_point) {
+	const LocalVector<Vector3> &vertices = p_polygon.vertices;
+
+	real_t closest_point_distance = FLT_MAX;
+
+	// Check the distance from the segment's endpoints to each face.
+	for (uint32_t point_id = 2; point_id < vertices.size(); point_id += 1) {
+		const Face3 face(vertices[0], vertices[point_id - 1], vertices[point_id]);
+
+		const Vector3 p_from_closest = face.get_closest_point_to(p_from);
+		const real_t d_p_from = p_from.distance_to(p_from_closest);
+		if (closest_point_distance > d_p_from) {
+			r_closest_point = p_from_closest;
+			closest_point_distance = d_p_from;
+		}
+
+		const Vector3 p_to_closest = face.get_closest_point_to(p_to);
+		const real_t d_p_to = p_to.distance_to(p_to_closest);
+		if (closest_point_distance > d_p_to) {
+			r_closest_point = p_to_closest;
+			closest_point_distance = d_p_to;
+		}
+	}
+
+	// Check for a case when shortest distance is between some point located on a face's edge and some point located on a line segment.
+	for (uint32_t point_id = 0; point_id < vertices.size(); point_id += 1) {
+		Vector3 a, b;
+
+		Geometry3D::get_closest_points_between_segments(
+				p_from,
+				p_to,
+				vertices[point_id],
+				vertices[(point_id + 1) % vertices.size()],
+				a,
+				b);
+
+		const real_t d = a.distance_to(b);
+		if (d < closest_point_distance) {
+			closest_point_distance = d;
+			r_closest_point = b;
+		}
+	}
+
+	return closest_point_distance;
+}
+
+Vector3 NavMeshQueries3D::_polygon_get_random_point(const Polygon &p_polygon) {
+	const LocalVector<Vector3> &vertices = p_polygon.vertices;
+
+	real_t accumulated_polygon_area = 0;
+	RBMap<real_t, uint32_t> polygon_area_map;
+
+	for (uint32_t rpp_index = 2; rpp_index < vertices.size(); rpp_index++) {
+		real_t face_area = Face3(vertices[0], vertices[rpp_index - 1], vertices[rpp_index]).get_area();
+
+		if (face_area == 0.0) {
+			continue;
+		}
+		polygon_area_map[accumulated_polygon_area] = rpp_index;
+		accumulated_polygon_area += face_area;
+	}
+	if (polygon_area_map.is_empty() || accumulated_polygon_area == 0) {
+		// All faces have no real surface / no area.
+		return Vector3();
+	}
+
+	real_t polygon_area_map_pos = Math::random(real_t(0), accumulated_polygon_area);
+
+	RBMap<real_t, uint32_t>::Iterator polygon_E = polygon_area_map.find_closest(polygon_area_map_pos);
+	ERR_FAIL_COND_V(!polygon_E, Vector3());
+	uint32_t rrp_face_index = polygon_E->value;
+	ERR_FAIL_UNSIGNED_INDEX_V(rrp_face_index, vertices.size(), Vector3());
+
+	const Face3 face(vertices[0], vertices[rrp_face_index - 1], vertices[rrp_face_index]);
+
+	return face.get_random_point_inside();
+}
+
 void NavMeshQueries3D::_query_task_clip_path(NavMeshPathQueryTask3D &p_query_task, const NavigationPoly *from_poly, const Vector3 &p_to_point, const NavigationPoly *p_to_poly) {
 	Vector3 from = p_query_task.path_points[p_query_task.path_points.size() - 1];
 	const LocalVector<NavigationPoly> &p_navigation_polys = p_query_task.path_query_slot->path_corridor;
@@ -32,7 +32,11 @@
 
 #include "../nav_utils_3d.h"
 
+#include "core/object/worker_thread_pool.h"
+#include "core/os/mutex.h"
 #include "core/templates/a_hash_map.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/safe_refcount.h"
 #include "servers/nav_heap.h"
 #include "servers/navigation_3d/navigation_constants_3d.h"
 #include "servers/navigation_3d/navigation_path_query_parameters_3d.h"
@@ -46,12 +50,80 @@ struct NavMapIteration3D;
 
 class NavMeshQueries3D {
 public:
+	// Polygon BVH traversal stack size, the median split keeps the tree depth at log2 of the polygon count.
+	static constexpr uint32_t POLYGON_BVH_STACK_SIZE = 64;
+
 	struct PathQuerySlot {
 		LocalVector<Nav3D::NavigationPoly> path_corridor;
 		Heap<Nav3D::NavigationPoly *, Nav3D::NavPolyTravelCostGreaterThan, Nav3D::NavPolyHeapIndexer> traversable_polys;
 		bool in_use = false;
 		uint32_t slot_index = 0;
 		AHashMap<const Nav3D::Polygon *, uint32_t> poly_to_id;
+
+		// Hierarchical search on the cluster portal graph.
+		LocalVector<Nav3D::ClusterPortalSearchNode> portal_search;
+		Heap<Nav3D::ClusterPortalSearchNode *, Nav3D::ClusterPortalSearchCostGreaterThan, Nav3D::ClusterPortalSearchHeapIndexer> open_portals;
+		LocalVector<real_t> cluster_begin_travel_costs;
+		LocalVector<real_t> cluster_end_travel_costs;
+		LocalVector<bool> cluster_polygons_closed;
+		LocalVector<bool> clusters_in_corridor;
+	};
+
+	// Maximum number of path corridors cached per map iteration, the oldest corridor is dropped first.
+	static constexpr uint32_t PATH_QUERY_CACHE_SIZE_MAX = 256;
+
+	struct PathQueryCacheKey {
+		const Nav3D::Polygon *begin_polygon = nullptr;
+		const Nav3D::Polygon *end_polygon = nullptr;
+		uint32_t navigation_layers = 0;
+		PathfindingAlgorithm pathfinding_algorithm = PathfindingAlgorithm::PATHFINDING_ALGORITHM_ASTAR;
+		PathPostProcessing path_postprocessing = PathPostProcessing::PATH_POSTPROCESSING_CORRIDORFUNNEL;
+		int path_search_max_polygons = 0;
+		float path_search_max_distance = 0.0;
+
+		static uint32_t hash(const PathQueryCacheKey &p_key) {
+			uint32_t h = hash_murmur3_one_64((uint64_t)p_key.begin_polygon);
+			h = hash_murmur3_one_64((uint64_t)p_key.end_polygon, h);
+			h = hash_murmur3_one_32(p_key.navigation_layers, h);
+			h = hash_murmur3_one_32((uint32_t)p_key.pathfinding_algorithm, h);
+			h = hash_murmur3_one_32((uint32_t)p_key.path_postprocessing, h);
+			h = hash_murmur3_one_32((uint32_t)p_key.path_search_max_polygons, h);
+			h = hash_murmur3_one_float(p_key.path_search_max_distance, h);
+			return hash_fmix32(h);
+		}
+
+		bool operator==(const PathQueryCacheKey &p_key) const {
+			return begin_polygon == p_key.begin_polygon &&
+					end_polygon == p_key.end_polygon &&
+					navigation_layers == p_key.navigation_layers &&
+					pathfinding_algorithm == p_key.pathfinding_algorithm &&
+					path_postprocessing == p_key.path_postprocessing &&
+					path_search_max_polygons == p_key.path_search_max_polygons &&
+					path_search_max_distance == p_key.path_search_max_distance;
+		}
+	};
+
+	struct PathQueryCacheCorridorPoly {
+		const Nav3D::Polygon *poly = nullptr;
+		int back_navigation_edge = -1;
+		Vector3 back_navigation_edge_pathway_start;
+		Vector3 back_navigation_edge_pathway_end;
+	};
+
+	// Polygon corridors of finished path searches. The path points are not cached because they
+	// depend on the exact start and target positions, only the polygon search is skipped on a hit.
+	struct PathQueryCache {
+		Mutex mutex;
+		HashMap<PathQueryCacheKey, LocalVector<PathQueryCacheCorridorPoly>, PathQueryCacheKey> corridors;
+
+		// Counted since the last read by the map, not reset when the cache is cleared.
+		SafeNumeric<uint32_t> hit_count;
+		SafeNumeric<uint32_t> miss_count;
+
+		void clear() {
+			MutexLock lock(mutex);
+			corridors.clear();
+		}
 	};
 
 	struct NavMeshPathQueryTask3D {
@@ -95,6 +167,9 @@ public:
 		NavMap3D *map = nullptr;
 		PathQuerySlot *path_query_slot = nullptr;
 
+		// Set while the corridor search is restricted to the clusters found by the hierarchical search.
+		const LocalVector<Nav3D::ClusterPolygon> *corridor_cluster_polygons = nullptr;
+
 		// Path points.
 		LocalVector<Vector3> path_points;
 		LocalVector<int32_t> path_meta_point_types;
@@ -122,6 +197,20 @@ public:
 		}
 	};
 
+	struct NavMeshPathQueryBatch3D {
+		LocalVector<NavMeshPathQueryTask3D> query_tasks;
+
+		// The map iteration each query task runs against, nullptr if the map had no iteration yet.
+		LocalVector<NavMapIteration3D *> query_map_iterations;
+
+		// Unique maps and their iterations used by the batch, held as users until the batch is finished.
+		LocalVector<NavMap3D *> maps;
+		LocalVector<NavMapIteration3D *> map_iterations;
+
+		Callable callback;
+		WorkerThreadPool::GroupID group_task_id = WorkerThreadPool::INVALID_TASK_ID;
+	};
+
 	static bool emit_callback(const Callable &p_callback);
 
 	static Vector3 polygons_get_random_point(const LocalVector<Nav3D::Polygon> &p_polygons, uint32_t p_navigation_layers, bool p_uniformly);
@@ -139,11 +228,26 @@ public:
 	static Nav3D::ClosestPointQueryResult map_iteration_get_closest_point_info(const NavMapIteration3D &p_map_iteration, const Vector3 &p_point);
 	static Vector3 map_iteration_get_random_point(const NavMapIteration3D &p_map_iteration, uint32_t p_navigation_layers, bool p_uniformly);
 
+	static real_t _aabb_get_distance_squared_to_point(const AABB &p_aabb, const Vector3 &p_point);
+	static real_t _polygon_get_closest_point(const Nav3D::Polygon &p_polygon, const Vector3 &p_point, Vector3 &r_closest_point, Vector3 &r_plane_normal);
+	static bool _polygon_intersect_segment(const Nav3D::Polygon &p_polygon, const Vector3 &p_from, const Vector3 &p_to, Vector3 &r_intersection_point);
+	static real_t _polygon_get_closest_point_to_segment(const Nav3D::Polygon &p_polygon, const Vector3 &p_from, const Vector3 &p_to, Vector3 &r_closest_point);
+	static Vector3 _polygon_get_random_point(const Nav3D::Polygon &p_polygon);
+
 	static void map_query_path(NavMap3D *map, const Ref<NavigationPathQueryParameters3D> &p_query_parameters, Ref<NavigationPathQueryResult3D> p_query_result, const Callable &p_callback);
+	static void map_iteration_query_path(NavMeshPathQueryTask3D &p_query_task, NavMapIteration3D &p_map_iteration);
+
+	static void query_task_setup(NavMeshPathQueryTask3D &r_query_task, const Ref<NavigationPathQueryParameters3D> &p_query_parameters);
+	static void query_task_store_result(const NavMeshPathQueryTask3D &p_query_task, Ref<NavigationPathQueryResult3D> p_query_result);
+	static void _query_batch_thread_query_path(void *p_arg, uint32_t p_index);
 
 	static void query_task_map_iteration_get_path(NavMeshPathQueryTask3D &p_query_task, const NavMapIteration3D &p_map_iteration);
 	static void _query_task_push_back_point_with_metadata(NavMeshPathQueryTask3D &p_query_task, const Vector3 &p_point, const Nav3D::Polygon *p_point_polygon);
 	static void _query_task_find_start_end_positions(NavMeshPathQueryTask3D &p_query_task, const NavMapIteration3D &p_map_iteration);
+	static bool _query_task_get_path_cache_key(const NavMeshPathQueryTask3D &p_query_task, PathQueryCacheKey &r_key);
+	static bool _query_task_load_cached_path_corridor(NavMeshPathQueryTask3D &p_query_task, const NavMapIteration3D &p_map_iteration, const PathQueryCacheKey &p_key);
+	static void _query_task_store_cached_path_corridor(NavMeshPathQueryTask3D &p_query_task, const NavMapIteration3D &p_map_iteration, const PathQueryCacheKey &p_key);
+	static void _query_task_find_cluster_corridor(NavMeshPathQueryTask3D &p_query_task, const NavMapIteration3D &p_map_iteration);
 	static void _query_task_build_path_corridor(NavMeshPathQueryTask3D &p_query_task, const NavMapIteration3D &p_map_iteration);
 	static void _query_task_post_process_corridorfunnel(NavMeshPathQueryTask3D &p_query_task);
 	static void _query_task_post_process_edgecentered(NavMeshPathQueryTask3D &p_query_task);
@@ -155,6 +259,9 @@ public:
 
 	static void _query_task_search_polygon_connections(NavMeshPathQueryTask3D &p_query_task, const Nav3D::Connection &p_connection, uint32_t p_least_cost_id, const Nav3D::NavigationPoly &p_least_cost_poly, real_t p_poly_enter_cost, const Vector3 &p_end_point);
 
+	static void cluster_get_polygon_travel_costs(const NavMapIteration3D &p_map_iteration, uint32_t p_cluster, uint32_t p_polygon_id, LocalVector<real_t> &r_travel_costs, LocalVector<bool> &r_closed);
+	static real_t cluster_get_connection_travel_cost(const Nav3D::ClusterPolygon &p_from, const Nav3D::Connection &p_connection, const Nav3D::ClusterPolygon &p_to);
+
 	static void simplify_path_segment(int p_start_inx, int p_end_inx, const LocalVector<Vector3> &p_points, real_t p_epsilon, LocalVector<uint32_t> &r_simplified_path_indices);
 	static LocalVector<uint32_t> get_simplified_path_indices(const LocalVector<Vector3> &p_path, real_t p_epsilon);
 
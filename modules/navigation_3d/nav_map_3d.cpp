@@ -111,6 +111,22 @@ void NavMap3D::set_use_edge_connections(bool p_enabled) {
 	iteration_dirty = true;
 }
 
+void NavMap3D::set_use_hierarchical_pathfinding(bool p_enabled) {
+	if (use_hierarchical_pathfinding == p_enabled) {
+		return;
+	}
+	use_hierarchical_pathfinding = p_enabled;
+	iteration_dirty = true;
+}
+
+void NavMap3D::set_use_avoidance_spatial_hash(bool p_enabled) {
+	if (use_avoidance_spatial_hash == p_enabled) {
+		return;
+	}
+	use_avoidance_spatial_hash = p_enabled;
+	agents_dirty = true;
+}
+
 void NavMap3D::set_edge_connection_margin(real_t p_edge_connection_margin) {
 	if (edge_connection_margin == p_edge_connection_margin) {
 		return;
@@ -151,34 +167,26 @@ void NavMap3D::query_path(NavMeshQueries3D::NavMeshPathQueryTask3D &p_query_task
 
 	GET_MAP_ITERATION();
 
-	map_iteration.path_query_slots_semaphore.wait();
-
-	map_iteration.path_query_slots_mutex.lock();
-	for (NavMeshQueries3D::PathQuerySlot &p_path_query_slot : map_iteration.path_query_slots) {
-		if (!p_path_query_slot.in_use) {
-			p_path_query_slot.in_use = true;
-			p_query_task.path_query_slot = &p_path_query_slot;
-			break;
-		}
-	}
-	map_iteration.path_query_slots_mutex.unlock();
+	NavMeshQueries3D::map_iteration_query_path(p_query_task, map_iteration);
+}
 
-	if (p_query_task.path_query_slot == nullptr) {
-		map_iteration.path_query_slots_semaphore.post();
-		ERR_FAIL_NULL_MSG(p_query_task.path_query_slot, "No unused NavMap3D path query slot found! This should never happen :(.");
+NavMapIteration3D *NavMap3D::acquire_iteration() {
+	if (iteration_id == 0) {
+		return nullptr;
 	}
 
-	p_query_task.map_up = map_iteration.map_up;
-
-	NavMeshQueries3D::query_task_map_iteration_get_path(p_query_task, map_iteration);
+	// While the iteration has users the map will not rebuild into its slot, so it stays unchanged until released.
+	iteration_slot_rwlock.read_lock();
+	NavMapIteration3D *map_iteration = &iteration_slots[iteration_slot_index];
+	map_iteration->users.increment();
+	iteration_slot_rwlock.read_unlock();
 
-	map_iteration.path_query_slots_mutex.lock();
-	uint32_t used_slot_index = p_query_task.path_query_slot->slot_index;
-	map_iteration.path_query_slots[used_slot_index].in_use = false;
-	p_query_task.path_query_slot = nullptr;
-	map_iteration.path_query_slots_mutex.unlock();
+	return map_iteration;
+}
 
-	map_iteration.path_query_slots_semaphore.post();
+void NavMap3D::release_iteration(NavMapIteration3D *p_map_iteration) {
+	ERR_FAIL_NULL(p_map_iteration);
+	p_map_iteration->users.decrement();
 }
 
 Vector3 NavMap3D::get_closest_point_to_segment(const Vector3 &p_from, const Vector3 &p_to, const bool p_use_collision) const {
@@ -367,6 +375,7 @@ void NavMap3D::_build_iteration() {
 
 	iteration_build.merge_rasterizer_cell_size = get_merge_rasterizer_cell_size();
 	iteration_build.use_edge_connections = get_use_edge_connections();
+	iteration_build.use_hierarchical_pathfinding = get_use_hierarchical_pathfinding();
 	iteration_build.edge_connection_margin = get_edge_connection_margin();
 	iteration_build.link_connection_radius = get_link_connection_radius();
 
@@ -434,6 +443,18 @@ void NavMap3D::sync() {
 	performance_data.pm_link_count = links.size();
 	performance_data.pm_obstacle_count = obstacles.size();
 
+	// Path queries since the last sync, on either iteration slot.
+	performance_data.pm_path_cache_hit_count = 0;
+	performance_data.pm_path_cache_miss_count = 0;
+	for (NavMapIteration3D &iteration_slot : iteration_slots) {
+		const uint32_t hit_count = iteration_slot.path_query_cache.hit_count.get();
+		const uint32_t miss_count = iteration_slot.path_query_cache.miss_count.get();
+		iteration_slot.path_query_cache.hit_count.sub(hit_count);
+		iteration_slot.path_query_cache.miss_count.sub(miss_count);
+		performance_data.pm_path_cache_hit_count += hit_count;
+		performance_data.pm_path_cache_miss_count += miss_count;
+	}
+
 	_sync_async_tasks();
 
 	_sync_dirty_map_update_requests();
@@ -566,6 +587,32 @@ void NavMap3D::_update_rvo_obstacles_tree_2d() {
 void NavMap3D::_update_rvo_agents_tree_2d() {
 	// Cannot use LocalVector here as RVO library expects std::vector to build KdTree.
 	std::vector<RVO2D::Agent2D *> raw_agents;
+
+	if (use_avoidance_spatial_hash) {
+		// The kd-tree is not queried, only make sure it does not keep pointers to removed agents.
+		rvo_simulation_2d.kdTree_->buildAgentTree(raw_agents);
+
+		real_t neighbor_distance_sum = 0.0;
+		for (NavAgent3D *agent : active_2d_avoidance_agents) {
+			neighbor_distance_sum += agent->get_rvo_agent_2d()->neighborDist_;
+		}
+		const real_t cell_size = active_2d_avoidance_agents.is_empty() ? 1.0 : neighbor_distance_sum / active_2d_avoidance_agents.size();
+
+		avoidance_spatial_hash_2d.begin_build(active_2d_avoidance_agents.size(), cell_size);
+		if (use_threads && avoidance_use_multiple_threads) {
+			WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &NavMap3D::_update_avoidance_spatial_hash_2d_agent, active_2d_avoidance_agents.ptr(), active_2d_avoidance_agents.size(), -1, true, SNAME("RVOAvoidanceSpatialHash2D"));
+			WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+		} else {
+			for (uint32_t i = 0; i < active_2d_avoidance_agents.size(); i++) {
+				_update_avoidance_spatial_hash_2d_agent(i, active_2d_avoidance_agents.ptr());
+			}
+		}
+		avoidance_spatial_hash_2d.end_build();
+		return;
+	}
+
+	avoidance_spatial_hash_2d.clear();
+
 	raw_agents.reserve(active_2d_avoidance_agents.size());
 	for (NavAgent3D *agent : active_2d_avoidance_agents) {
 		raw_agents.push_back(agent->get_rvo_agent_2d());
@@ -576,6 +623,32 @@ void NavMap3D::_update_rvo_agents_tree_2d() {
 void NavMap3D::_update_rvo_agents_tree_3d() {
 	// Cannot use LocalVector here as RVO library expects std::vector to build KdTree.
 	std::vector<RVO3D::Agent3D *> raw_agents;
+
+	if (use_avoidance_spatial_hash) {
+		// The kd-tree is not queried, only make sure it does not keep pointers to removed agents.
+		rvo_simulation_3d.kdTree_->buildAgentTree(raw_agents);
+
+		real_t neighbor_distance_sum = 0.0;
+		for (NavAgent3D *agent : active_3d_avoidance_agents) {
+			neighbor_distance_sum += agent->get_rvo_agent_3d()->neighborDist_;
+		}
+		const real_t cell_size = active_3d_avoidance_agents.is_empty() ? 1.0 : neighbor_distance_sum / active_3d_avoidance_agents.size();
+
+		avoidance_spatial_hash_3d.begin_build(active_3d_avoidance_agents.size(), cell_size);
+		if (use_threads && avoidance_use_multiple_threads) {
+			WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &NavMap3D::_update_avoidance_spatial_hash_3d_agent, active_3d_avoidance_agents.ptr(), active_3d_avoidance_agents.size(), -1, true, SNAME("RVOAvoidanceSpatialHash3D"));
+			WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+		} else {
+			for (uint32_t i = 0; i < active_3d_avoidance_agents.size(); i++) {
+				_update_avoidance_spatial_hash_3d_agent(i, active_3d_avoidance_agents.ptr());
+			}
+		}
+		avoidance_spatial_hash_3d.end_build();
+		return;
+	}
+
+	avoidance_spatial_hash_3d.clear();
+
 	raw_agents.reserve(active_3d_avoidance_agents.size());
 	for (NavAgent3D *agent : active_3d_avoidance_agents) {
 		raw_agents.push_back(agent->get_rvo_agent_3d());
@@ -583,6 +656,56 @@ void NavMap3D::_update_rvo_agents_tree_3d() {
 	rvo_simulation_3d.kdTree_->buildAgentTree(raw_agents);
 }
 
+void NavMap3D::_update_avoidance_spatial_hash_2d_agent(uint32_t p_index, NavAgent3D **p_agents) {
+	const RVO2D::Vector2 &position = p_agents[p_index]->get_rvo_agent_2d()->position_;
+	avoidance_spatial_hash_2d.set_agent_position(p_index, Vector2(position.x(), position.y()));
+}
+
+void NavMap3D::_update_avoidance_spatial_hash_3d_agent(uint32_t p_index, NavAgent3D **p_agents) {
+	const RVO3D::Vector3 &position = p_agents[p_index]->get_rvo_agent_3d()->position_;
+	avoidance_spatial_hash_3d.set_agent_position(p_index, Vector2(position.x(), position.z()));
+}
+
+void NavMap3D::_compute_rvo_agent_neighbors_2d(RVO2D::Agent2D *p_rvo_agent) {
+	if (!use_avoidance_spatial_hash) {
+		p_rvo_agent->computeNeighbors(&rvo_simulation_2d);
+		return;
+	}
+
+	// Same as RVO2D::Agent2D::computeNeighbors() but with the agent neighbors found through the spatial hash.
+	p_rvo_agent->obstacleNeighbors_.clear();
+	const float obstacle_range = p_rvo_agent->timeHorizonObst_ * p_rvo_agent->maxSpeed_ + p_rvo_agent->radius_;
+	rvo_simulation_2d.kdTree_->computeObstacleNeighbors(p_rvo_agent, obstacle_range * obstacle_range);
+
+	p_rvo_agent->agentNeighbors_.clear();
+	if (p_rvo_agent->maxNeighbors_ > 0) {
+		float range_sq = p_rvo_agent->neighborDist_ * p_rvo_agent->neighborDist_;
+		real_t query_range_sq = range_sq;
+		avoidance_spatial_hash_2d.query(Vector2(p_rvo_agent->position_.x(), p_rvo_agent->position_.y()), query_range_sq, [&](uint32_t p_agent_index) {
+			p_rvo_agent->insertAgentNeighbor(active_2d_avoidance_agents[p_agent_index]->get_rvo_agent_2d(), range_sq);
+			query_range_sq = range_sq;
+		});
+	}
+}
+
+void NavMap3D::_compute_rvo_agent_neighbors_3d(RVO3D::Agent3D *p_rvo_agent) {
+	if (!use_avoidance_spatial_hash) {
+		p_rvo_agent->computeNeighbors(&rvo_simulation_3d);
+		return;
+	}
+
+	// Same as RVO3D::Agent3D::computeNeighbors() but with the agent neighbors found through the spatial hash.
+	p_rvo_agent->agentNeighbors_.clear();
+	if (p_rvo_agent->maxNeighbors_ > 0) {
+		float range_sq = p_rvo_agent->neighborDist_ * p_rvo_agent->neighborDist_;
+		real_t query_range_sq = range_sq;
+		avoidance_spatial_hash_3d.query(Vector2(p_rvo_agent->position_.x(), p_rvo_agent->position_.z()), query_range_sq, [&](uint32_t p_agent_index) {
+			p_rvo_agent->insertAgentNeighbor(active_3d_avoidance_agents[p_agent_index]->get_rvo_agent_3d(), range_sq);
+			query_range_sq = range_sq;
+		});
+	}
+}
+
 void NavMap3D::_update_rvo_simulation() {
 	if (obstacles_dirty) {
 		_update_rvo_obstacles_tree_2d();
@@ -594,14 +717,14 @@ void NavMap3D::_update_rvo_simulation() {
 }
 
 void NavMap3D::compute_single_avoidance_step_2d(uint32_t index, NavAgent3D **agent) {
-	(*(agent + index))->get_rvo_agent_2d()->computeNeighbors(&rvo_simulation_2d);
+	_compute_rvo_agent_neighbors_2d((*(agent + index))->get_rvo_agent_2d());
 	(*(agent + index))->get_rvo_agent_2d()->computeNewVelocity(&rvo_simulation_2d);
 	(*(agent + index))->get_rvo_agent_2d()->update(&rvo_simulation_2d);
 	(*(agent + index))->update();
 }
 
 void NavMap3D::compute_single_avoidance_step_3d(uint32_t index, NavAgent3D **agent) {
-	(*(agent + index))->get_rvo_agent_3d()->computeNeighbors(&rvo_simulation_3d);
+	_compute_rvo_agent_neighbors_3d((*(agent + index))->get_rvo_agent_3d());
 	(*(agent + index))->get_rvo_agent_3d()->computeNewVelocity(&rvo_simulation_3d);
 	(*(agent + index))->get_rvo_agent_3d()->update(&rvo_simulation_3d);
 	(*(agent + index))->update();
@@ -617,7 +740,7 @@ void NavMap3D::step(double p_delta_time) {
 			WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
 		} else {
 			for (NavAgent3D *agent : active_2d_avoidance_agents) {
-				agent->get_rvo_agent_2d()->computeNeighbors(&rvo_simulation_2d);
+				_compute_rvo_agent_neighbors_2d(agent->get_rvo_agent_2d());
 				agent->get_rvo_agent_2d()->computeNewVelocity(&rvo_simulation_2d);
 				agent->get_rvo_agent_2d()->update(&rvo_simulation_2d);
 				agent->update();
@@ -631,7 +754,7 @@ void NavMap3D::step(double p_delta_time) {
 			WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
 		} else {
 			for (NavAgent3D *agent : active_3d_avoidance_agents) {
-				agent->get_rvo_agent_3d()->computeNeighbors(&rvo_simulation_3d);
+				_compute_rvo_agent_neighbors_3d(agent->get_rvo_agent_3d());
 				agent->get_rvo_agent_3d()->computeNewVelocity(&rvo_simulation_3d);
 				agent->get_rvo_agent_3d()->update(&rvo_simulation_3d);
 				agent->update();
@@ -30,6 +30,7 @@
 
 #pragma once
 
+#include "3d/nav_avoidance_spatial_hash_3d.h"
 #include "3d/nav_map_iteration_3d.h"
 #include "3d/nav_mesh_queries_3d.h"
 #include "nav_rid_3d.h"
@@ -66,6 +67,10 @@ class NavMap3D : public NavRid3D {
 	float merge_rasterizer_cell_scale = 0.1;
 
 	bool use_edge_connections = true;
+
+	/// Builds a cluster portal graph so long path queries search a coarse graph first.
+	bool use_hierarchical_pathfinding = false;
+
 	/// This value is used to detect the near edges to connect.
 	real_t edge_connection_margin = NavigationDefaults3D::EDGE_CONNECTION_MARGIN;
 
@@ -91,6 +96,11 @@ class NavMap3D : public NavRid3D {
 	/// dirty flag when one of the agent's arrays are modified
 	bool agents_dirty = true;
 
+	/// Finds avoidance neighbors with a spatial hash instead of the RVO kd-trees.
+	bool use_avoidance_spatial_hash = false;
+	NavAvoidanceSpatialHash3D avoidance_spatial_hash_2d;
+	NavAvoidanceSpatialHash3D avoidance_spatial_hash_3d;
+
 	/// All the Agents (even the controlled one)
 	LocalVector<NavAgent3D *> agents;
 
@@ -184,6 +194,16 @@ public:
 		return use_edge_connections;
 	}
 
+	void set_use_hierarchical_pathfinding(bool p_enabled);
+	bool get_use_hierarchical_pathfinding() const {
+		return use_hierarchical_pathfinding;
+	}
+
+	void set_use_avoidance_spatial_hash(bool p_enabled);
+	bool get_use_avoidance_spatial_hash() const {
+		return use_avoidance_spatial_hash;
+	}
+
 	void set_edge_connection_margin(real_t p_edge_connection_margin);
 	real_t get_edge_connection_margin() const {
 		return edge_connection_margin;
@@ -199,6 +219,9 @@ public:
 
 	void query_path(NavMeshQueries3D::NavMeshPathQueryTask3D &p_query_task);
 
+	NavMapIteration3D *acquire_iteration();
+	void release_iteration(NavMapIteration3D *p_map_iteration);
+
 	Vector3 get_closest_point_to_segment(const Vector3 &p_from, const Vector3 &p_to, const bool p_use_collision) const;
 	Vector3 get_closest_point(const Vector3 &p_point) const;
 	Vector3 get_closest_point_normal(const Vector3 &p_point) const;
@@ -250,6 +273,8 @@ public:
 	int get_pm_edge_connection_count() const { return performance_data.pm_edge_connection_count; }
 	int get_pm_edge_free_count() const { return performance_data.pm_edge_free_count; }
 	int get_pm_obstacle_count() const { return performance_data.pm_obstacle_count; }
+	int get_pm_path_cache_hit_count() const { return performance_data.pm_path_cache_hit_count; }
+	int get_pm_path_cache_miss_count() const { return performance_data.pm_path_cache_miss_count; }
 
 	int get_region_connections_count(NavRegion3D *p_region) const;
 	Vector3 get_region_connection_pathway_start(NavRegion3D *p_region, int p_connection_id) const;
@@ -281,6 +306,12 @@ private:
 	void compute_single_avoidance_step_2d(uint32_t index, NavAgent3D **agent);
 	void compute_single_avoidance_step_3d(uint32_t index, NavAgent3D **agent);
 
+	void _compute_rvo_agent_neighbors_2d(RVO2D::Agent2D *p_rvo_agent);
+	void _compute_rvo_agent_neighbors_3d(RVO3D::Agent3D *p_rvo_agent);
+
+	void _update_avoidance_spatial_hash_2d_agent(uint32_t p_index, NavAgent3D **p_agents);
+	void _update_avoidance_spatial_hash_3d_agent(uint32_t p_index, NavAgent3D **p_agents);
+
 	void _sync_avoidance();
 	void _update_rvo_simulation();
 	void _update_rvo_obstacles_tree_2d();
@@ -30,6 +30,7 @@
 
 #pragma once
 
+#include "core/math/aabb.h"
 #include "core/math/vector3.h"
 #include "core/templates/hashfuncs.h"
 #include "core/templates/local_vector.h"
@@ -106,6 +107,98 @@ struct Polygon {
 	real_t surface_area = 0.0;
 };
 
+struct PolygonBVHNode {
+	AABB aabb;
+
+	/// Child node indices, -1 on leaf nodes.
+	int32_t left = -1;
+	int32_t right = -1;
+
+	/// Polygon of a leaf node.
+	const Polygon *polygon = nullptr;
+};
+
+struct ClusterPolygon {
+	const Polygon *polygon = nullptr;
+
+	/// Center of the polygon vertices, used to estimate travel costs on the cluster portal graph.
+	Vector3 center;
+
+	/// Cluster that contains this polygon and the index of the polygon inside of it.
+	uint32_t cluster = 0;
+	uint32_t cluster_polygon_index = 0;
+
+	/// Portal of this polygon, -1 if the polygon has no connections to other clusters.
+	int32_t portal = -1;
+};
+
+struct PolygonCluster {
+	/// Navigation region or link that contains all polygons of this cluster.
+	const NavBaseIteration3D *owner = nullptr;
+
+	/// Map polygon id of the first polygon of the owner, polygon ids of the owner are consecutive.
+	uint32_t owner_polygon_offset = 0;
+
+	/// Range of this cluster in the map cluster polygon ids.
+	uint32_t polygon_start = 0;
+	uint32_t polygon_count = 0;
+
+	/// Range of this cluster in the map cluster portals.
+	uint32_t portal_start = 0;
+	uint32_t portal_count = 0;
+};
+
+struct ClusterPortalEdge {
+	uint32_t portal = 0;
+	real_t travel_cost = 0.0;
+};
+
+struct ClusterPortal {
+	/// Map polygon id of the polygon that connects to other clusters.
+	uint32_t polygon_id = 0;
+	uint32_t cluster = 0;
+
+	/// Range of this portal in the map cluster portal edges.
+	uint32_t edge_start = 0;
+	uint32_t edge_count = 0;
+};
+
+struct ClusterPortalSearchNode {
+	/// Index in the heap of open portals.
+	uint32_t heap_index = UINT32_MAX;
+
+	/// Previous portal on the search path, -1 for portals reached from the begin polygon.
+	int32_t back_portal = -1;
+
+	/// The cost traveled until now (g cost).
+	real_t traveled_cost = FLT_MAX;
+	/// The estimated cost to the destination (h cost).
+	real_t cost_to_destination = 0.0;
+
+	real_t total_travel_cost() const {
+		return traveled_cost + cost_to_destination;
+	}
+
+	void reset() {
+		heap_index = UINT32_MAX;
+		back_portal = -1;
+		traveled_cost = FLT_MAX;
+		cost_to_destination = 0.0;
+	}
+};
+
+struct ClusterPortalSearchCostGreaterThan {
+	bool operator()(const ClusterPortalSearchNode *p_node_a, const ClusterPortalSearchNode *p_node_b) const {
+		return p_node_a->total_travel_cost() > p_node_b->total_travel_cost();
+	}
+};
+
+struct ClusterPortalSearchHeapIndexer {
+	void operator()(ClusterPortalSearchNode *p_node, uint32_t p_heap_index) const {
+		p_node->heap_index = p_heap_index;
+	}
+};
+
 struct NavigationPoly {
 	/// This poly.
 	const Polygon *poly = nullptr;
@@ -192,6 +285,8 @@ struct PerformanceData {
 	int pm_edge_connection_count = 0;
 	int pm_edge_free_count = 0;
 	int pm_obstacle_count = 0;
+	int pm_path_cache_hit_count = 0;
+	int pm_path_cache_miss_count = 0;
 
 	void reset() {
 		pm_region_count = 0;
@@ -203,6 +298,8 @@ struct PerformanceData {
 		pm_edge_connection_count = 0;
 		pm_edge_free_count = 0;
 		pm_obstacle_count = 0;
+		pm_path_cache_hit_count = 0;
+		pm_path_cache_miss_count = 0;
 	}
 };
 
@@ -325,18 +325,28 @@ Ref<Image> CompressedTexture2D::load_image_from_file(Ref<FileAccess> f, int p_si
 				continue;
 			}
 
-			Vector<uint8_t> pv;
-			pv.resize(size);
-			{
-				uint8_t *wr = pv.ptrw();
-				f->get_buffer(wr, size);
-			}
-
 			Ref<Image> img;
-			if (data_format == DATA_FORMAT_PNG && Image::png_unpacker) {
-				img = Image::png_unpacker(pv);
-			} else if (data_format == DATA_FORMAT_WEBP && Image::webp_unpacker) {
-				img = Image::webp_unpacker(pv);
+			Span<uint8_t> mapped = f->get_buffer_span(size);
+			if (mapped.size() == size) {
+				// Decode straight from the memory mapped file, without copying the compressed data.
+				if (data_format == DATA_FORMAT_PNG && Image::_png_mem_unpacker_func) {
+					img = Image::_png_mem_unpacker_func(mapped.ptr(), size);
+				} else if (data_format == DATA_FORMAT_WEBP && Image::_webp_mem_loader_func) {
+					img = Image::_webp_mem_loader_func(mapped.ptr(), size);
+				}
+			} else {
+				Vector<uint8_t> pv;
+				pv.resize(size);
+				{
+					uint8_t *wr = pv.ptrw();
+					f->get_buffer(wr, size);
+				}
+
+				if (data_format == DATA_FORMAT_PNG && Image::png_unpacker) {
+					img = Image::png_unpacker(pv);
+				} else if (data_format == DATA_FORMAT_WEBP && Image::webp_unpacker) {
+					img = Image::webp_unpacker(pv);
+				}
 			}
 
 			if (img.is_null() || img->is_empty()) {
@@ -921,7 +921,7 @@ void ResourceLoaderText::set_translation_remapped(bool p_remapped) {
 }
 
 ResourceLoaderText::ResourceLoaderText() :
-		stream(false), format_version(FORMAT_VERSION) {}
+		format_version(FORMAT_VERSION) {}
 
 void ResourceLoaderText::get_dependencies(Ref<FileAccess> p_f, List<String> *p_dependencies, bool p_add_types) {
 	open(p_f);
@@ -998,7 +998,7 @@ Error ResourceLoaderText::rename_dependencies(Ref<FileAccess> p_f, const String
 
 	String base_path = local_path.get_base_dir();
 
-	uint64_t tag_end = f->get_position();
+	uint64_t tag_end = stream.get_position();
 
 	while (true) {
 		Error err = VariantParser::parse_tag(&stream, lines, error_text, next_tag, &rp);
@@ -1081,7 +1081,7 @@ Error ResourceLoaderText::rename_dependencies(Ref<FileAccess> p_f, const String
 			s += " path=\"" + path + "\" id=\"" + id + "\"]";
 			fw->store_line(s); // Bundled.
 
-			tag_end = f->get_position();
+			tag_end = stream.get_position();
 		}
 	}
 
@@ -78,6 +78,13 @@ public:
 	virtual void map_set_use_edge_connections(RID p_map, bool p_enabled) = 0;
 	virtual bool map_get_use_edge_connections(RID p_map) const = 0;
 
+	virtual void map_set_use_hierarchical_pathfinding(RID p_map, bool p_enabled) = 0;
+	virtual bool map_get_use_hierarchical_pathfinding(RID p_map) const = 0;
+
+	/// Set the map's avoidance to find agent neighbors with a spatial hash instead of kd-trees.
+	virtual void map_set_use_avoidance_spatial_hash(RID p_map, bool p_enabled) = 0;
+	virtual bool map_get_use_avoidance_spatial_hash(RID p_map) const = 0;
+
 	virtual void map_set_edge_connection_margin(RID p_map, real_t p_connection_margin) = 0;
 	virtual real_t map_get_edge_connection_margin(RID p_map) const = 0;
 
@@ -278,6 +285,7 @@ public:
 	/* QUERY API */
 
 	virtual void query_path(const Ref<NavigationPathQueryParameters3D> &p_query_parameters, Ref<NavigationPathQueryResult3D> p_query_result, const Callable &p_callback = Callable()) = 0;
+	virtual void query_paths_async(const TypedArray<NavigationPathQueryParameters3D> &p_query_parameters, const TypedArray<NavigationPathQueryResult3D> &p_query_results, const Callable &p_callback = Callable()) = 0;
 
 	/* NAVMESH BAKE API */
 
@@ -331,6 +339,8 @@ public:
 		INFO_EDGE_CONNECTION_COUNT,
 		INFO_EDGE_FREE_COUNT,
 		INFO_OBSTACLE_COUNT,
+		INFO_PATH_CACHE_HIT_COUNT,
+		INFO_PATH_CACHE_MISS_COUNT,
 	};
 
 	virtual int get_process_info(ProcessInfo p_info) const = 0;
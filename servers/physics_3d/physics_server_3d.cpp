@@ -383,6 +383,71 @@ Dictionary PhysicsDirectSpaceState3D::_intersect_ray(RequiredParam<PhysicsRayQue
 	return d;
 }
 
+Dictionary PhysicsDirectSpaceState3D::_intersect_rays(RequiredParam<PhysicsRayQueryParameters3D> rp_ray_query, const PackedVector3Array &p_from, const PackedVector3Array &p_to) {
+	EXTRACT_PARAM_OR_FAIL_V(p_ray_query, rp_ray_query, Dictionary());
+	ERR_FAIL_COND_V_MSG(p_from.size() != p_to.size(), Dictionary(), "The from and to arrays must have the same size.");
+
+	int count = p_from.size();
+	LocalVector<RayResult> results;
+	results.resize(count);
+	intersect_rays(p_ray_query->get_parameters(), p_from.ptr(), p_to.ptr(), count, results.ptr());
+
+	PackedByteArray hit;
+	PackedVector3Array position;
+	PackedVector3Array normal;
+	PackedInt32Array face_index;
+	PackedInt64Array collider_id;
+	PackedInt32Array shape;
+	hit.resize(count);
+	position.resize(count);
+	normal.resize(count);
+	face_index.resize(count);
+	collider_id.resize(count);
+	shape.resize(count);
+
+	uint8_t *hit_w = hit.ptrw();
+	Vector3 *position_w = position.ptrw();
+	Vector3 *normal_w = normal.ptrw();
+	int32_t *face_index_w = face_index.ptrw();
+	int64_t *collider_id_w = collider_id.ptrw();
+	int32_t *shape_w = shape.ptrw();
+	for (int i = 0; i < count; i++) {
+		const RayResult &result = results[i];
+		bool collided = result.rid.is_valid();
+		hit_w[i] = collided;
+		position_w[i] = result.position;
+		normal_w[i] = result.normal;
+		face_index_w[i] = result.face_index;
+		collider_id_w[i] = (int64_t)result.collider_id;
+		shape_w[i] = collided ? result.shape : -1;
+	}
+
+	Dictionary d;
+	d["hit"] = hit;
+	d["position"] = position;
+	d["normal"] = normal;
+	d["face_index"] = face_index;
+	d["collider_id"] = collider_id;
+	d["shape"] = shape;
+
+	return d;
+}
+
+int PhysicsDirectSpaceState3D::intersect_rays(const RayParameters &p_parameters, const Vector3 *p_from, const Vector3 *p_to, int p_count, RayResult *r_results) {
+	RayParameters parameters = p_parameters;
+	int hits = 0;
+	for (int i = 0; i < p_count; i++) {
+		parameters.from = p_from[i];
+		parameters.to = p_to[i];
+		if (intersect_ray(parameters, r_results[i])) {
+			hits++;
+		} else {
+			r_results[i] = RayResult();
+		}
+	}
+	return hits;
+}
+
 TypedArray<Dictionary> PhysicsDirectSpaceState3D::_intersect_point(RequiredParam<PhysicsPointQueryParameters3D> rp_point_query, int p_max_results) {
 	EXTRACT_PARAM_OR_FAIL_V(p_point_query, rp_point_query, TypedArray<Dictionary>());
 
@@ -488,6 +553,7 @@ PhysicsDirectSpaceState3D::PhysicsDirectSpaceState3D() {
 void PhysicsDirectSpaceState3D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("intersect_point", "parameters", "max_results"), &PhysicsDirectSpaceState3D::_intersect_point, DEFVAL(32));
 	ClassDB::bind_method(D_METHOD("intersect_ray", "parameters"), &PhysicsDirectSpaceState3D::_intersect_ray);
+	ClassDB::bind_method(D_METHOD("intersect_rays", "parameters", "from", "to"), &PhysicsDirectSpaceState3D::_intersect_rays);
 	ClassDB::bind_method(D_METHOD("intersect_shape", "parameters", "max_results"), &PhysicsDirectSpaceState3D::_intersect_shape, DEFVAL(32));
 	ClassDB::bind_method(D_METHOD("cast_motion", "parameters"), &PhysicsDirectSpaceState3D::_cast_motion);
 	ClassDB::bind_method(D_METHOD("collide_shape", "parameters", "max_results"), &PhysicsDirectSpaceState3D::_collide_shape, DEFVAL(32));
@@ -0,0 +1,103 @@
+/**************************************************************************/
+/*  bench_gdscript.cpp                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+#include "tests/benchmarks/benchmark.h"
+
+#include "tests/test_macros.h"
+
+TEST_FORCE_LINK(bench_gdscript)
+
+#include "modules/modules_enabled.gen.h" // For gdscript.
+
+#ifdef MODULE_GDSCRIPT_ENABLED
+
+#include "modules/gdscript/gdscript.h"
+#include "modules/gdscript/gdscript_native_code.h"
+
+namespace BenchGDScript {
+
+static const int LOOP_COUNT = 1000;
+
+// Only uses typed opcodes, so it can be compiled to native code.
+static const char *TYPED_SCRIPT = R"(
+static func integrate(count: int) -> float:
+	var position := 0.0
+	var velocity := 1.0
+	var damping := 0.99
+	var hits := 0
+	for _i in range(count):
+		velocity = velocity * damping + 0.5
+		position += velocity * 0.016
+		if position > 10.0:
+			hits += 1
+	return position + hits
+)";
+
+static Ref<GDScript> _load_script() {
+	GDScriptLanguage::get_singleton()->init();
+	Ref<GDScript> scr;
+	scr.instantiate();
+	scr->set_source_code(TYPED_SCRIPT);
+	Error err = scr->reload();
+	ERR_FAIL_COND_V(err != OK, Ref<GDScript>());
+	return scr;
+}
+
+static void _call_integrate(uint64_t p_iterations, bool p_native) {
+	static const Ref<GDScript> scr = _load_script();
+	ERR_FAIL_COND(scr.is_null());
+
+	if (p_native && !GDScriptNativeCode::has_native_code(scr->get_member_functions()[StringName("integrate")])) {
+		WARN_PRINT_ONCE("GDScript/integrate_native runs in the VM, build with `gdscript_native_code=<file>` from an export of this script to compare.");
+	}
+
+	GDScriptNativeCode::set_enabled(p_native);
+
+	for (uint64_t i = 0; i < p_iterations; i++) {
+		Variant ret = scr->call(SNAME("integrate"), LOOP_COUNT);
+		Benchmarks::do_not_optimize(ret);
+	}
+
+	GDScriptNativeCode::set_enabled(true);
+}
+
+static void bench_integrate_vm(uint64_t p_iterations) {
+	_call_integrate(p_iterations, false);
+}
+
+static void bench_integrate_native(uint64_t p_iterations) {
+	_call_integrate(p_iterations, true);
+}
+
+BENCHMARK("GDScript/integrate_vm", &bench_integrate_vm);
+BENCHMARK("GDScript/integrate_native", &bench_integrate_native);
+
+} // namespace BenchGDScript
+
+#endif // MODULE_GDSCRIPT_ENABLED
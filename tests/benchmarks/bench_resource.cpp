@@ -0,0 +1,161 @@
+/**************************************************************************/
+/*  bench_resource.cpp                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "tests/benchmarks/benchmark.h"
+
+#include "core/io/file_access.h"
+#include "core/io/resource_loader.h"
+#include "core/io/resource_saver.h"
+#include "scene/resources/animation.h"
+#include "tests/test_macros.h"
+#include "tests/test_utils.h"
+
+TEST_FORCE_LINK(bench_resource)
+
+namespace BenchResource {
+
+// Roughly the size of the surface data of a detailed mesh.
+static const int VERTEX_COUNT = 65536;
+static const int ANIMATION_KEY_COUNT = 16384;
+
+static String _save_mesh_arrays() {
+	// Laid out like the surfaces of an ArrayMesh, which needs a rendering server to be created.
+	PackedByteArray vertex_data;
+	vertex_data.resize(VERTEX_COUNT * 12);
+	PackedByteArray attribute_data;
+	attribute_data.resize(VERTEX_COUNT * 16);
+	PackedByteArray index_data;
+	index_data.resize(VERTEX_COUNT * 6);
+	PackedVector3Array vertices;
+	vertices.resize(VERTEX_COUNT);
+	PackedFloat32Array weights;
+	weights.resize(VERTEX_COUNT * 4);
+	for (int i = 0; i < VERTEX_COUNT; i++) {
+		vertex_data.set(i * 12, i & 0xff);
+		vertices.set(i, Vector3(i, i * 0.5, i * 0.25));
+		weights.set(i * 4, 1.0);
+	}
+
+	Dictionary surface;
+	surface["vertex_data"] = vertex_data;
+	surface["attribute_data"] = attribute_data;
+	surface["index_data"] = index_data;
+	surface["vertices"] = vertices;
+	surface["weights"] = weights;
+
+	Ref<Resource> resource;
+	resource.instantiate();
+	resource->set_meta("surface", surface);
+
+	const String path = TestUtils::get_temp_path("bench_mesh_arrays.res");
+	ResourceSaver::save(resource, path);
+	return path;
+}
+
+static String _save_animation() {
+	Ref<Animation> animation;
+	animation.instantiate();
+	animation->set_length(ANIMATION_KEY_COUNT / 30.0);
+	for (int track = 0; track < 4; track++) {
+		int position_track = animation->add_track(Animation::TYPE_POSITION_3D);
+		int value_track = animation->add_track(Animation::TYPE_VALUE);
+		animation->track_set_path(position_track, NodePath(vformat("Bone%d", track)));
+		animation->track_set_path(value_track, NodePath(vformat("Bone%d:scale", track)));
+		for (int i = 0; i < ANIMATION_KEY_COUNT; i++) {
+			animation->position_track_insert_key(position_track, i / 30.0, Vector3(i, track, 0));
+		}
+		for (int i = 0; i < ANIMATION_KEY_COUNT / 16; i++) {
+			animation->track_insert_key(value_track, i * 16 / 30.0, Vector3(1, 1, 1));
+		}
+	}
+
+	const String path = TestUtils::get_temp_path("bench_animation.res");
+	ResourceSaver::save(animation, path);
+	return path;
+}
+
+static void bench_load_mesh_arrays(uint64_t p_iterations) {
+	static const String path = _save_mesh_arrays();
+	for (uint64_t i = 0; i < p_iterations; i++) {
+		Ref<Resource> resource = ResourceLoader::load(path, "", ResourceFormatLoader::CACHE_MODE_IGNORE);
+		Benchmarks::do_not_optimize(resource);
+	}
+}
+
+static void bench_load_animation(uint64_t p_iterations) {
+	static const String path = _save_animation();
+	for (uint64_t i = 0; i < p_iterations; i++) {
+		Ref<Resource> resource = ResourceLoader::load(path, "", ResourceFormatLoader::CACHE_MODE_IGNORE);
+		Benchmarks::do_not_optimize(resource);
+	}
+}
+
+static void bench_save_mesh_arrays(uint64_t p_iterations) {
+	for (uint64_t i = 0; i < p_iterations; i++) {
+		String path = _save_mesh_arrays();
+		Benchmarks::do_not_optimize(path);
+	}
+}
+
+// The two ways the loader can read the data of packed arrays, over the whole saved mesh arrays.
+static void bench_read_mesh_arrays_buffer(uint64_t p_iterations) {
+	static const String path = _save_mesh_arrays();
+	Ref<FileAccess> f = FileAccess::open(path, FileAccess::READ);
+	Vector<uint8_t> data;
+	data.resize(f->get_length());
+	for (uint64_t i = 0; i < p_iterations; i++) {
+		f->seek(0);
+		f->get_buffer(data.ptrw(), data.size());
+		Benchmarks::do_not_optimize(data);
+	}
+}
+
+static void bench_read_mesh_arrays_span(uint64_t p_iterations) {
+	static const String path = _save_mesh_arrays();
+	Ref<FileAccess> f = FileAccess::open(path, FileAccess::READ);
+	Vector<uint8_t> data;
+	data.resize(f->get_length());
+	for (uint64_t i = 0; i < p_iterations; i++) {
+		f->seek(0);
+		Span<uint8_t> span = f->get_buffer_span(data.size());
+		if (span.size() == uint64_t(data.size())) {
+			memcpy(data.ptrw(), span.ptr(), span.size());
+		}
+		Benchmarks::do_not_optimize(data);
+	}
+}
+
+BENCHMARK("ResourceLoader/binary_mesh_arrays", &bench_load_mesh_arrays);
+BENCHMARK("ResourceLoader/binary_animation", &bench_load_animation);
+BENCHMARK("ResourceSaver/binary_mesh_arrays", &bench_save_mesh_arrays);
+BENCHMARK("FileAccess/read_mesh_arrays_buffer", &bench_read_mesh_arrays_buffer);
+BENCHMARK("FileAccess/read_mesh_arrays_span", &bench_read_mesh_arrays_span);
+
+} // namespace BenchResource
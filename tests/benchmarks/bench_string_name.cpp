@@ -0,0 +1,119 @@
+/**************************************************************************/
+/*  bench_string_name.cpp                                                 */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+#include "tests/benchmarks/benchmark.h"
+
+#include "core/os/os.h"
+#include "core/os/thread.h"
+#include "core/string/string_name.h"
+#include "core/templates/local_vector.h"
+#include "tests/test_macros.h"
+
+TEST_FORCE_LINK(bench_string_name)
+
+namespace BenchStringName {
+
+static const int NAME_COUNT = 256;
+
+struct Names {
+	LocalVector<String> strings;
+	// Keeps the names interned, so the lookups find existing entries like for method and property names.
+	LocalVector<StringName> interned;
+
+	Names() {
+		for (int i = 0; i < NAME_COUNT; i++) {
+			strings.push_back(vformat("bench_string_name_%d", i));
+			interned.push_back(StringName(strings[i]));
+		}
+	}
+};
+
+static const Names &_get_names() {
+	static const Names names;
+	return names;
+}
+
+struct LookupTask {
+	const Names *names = nullptr;
+	uint64_t iterations = 0;
+	uint32_t offset = 0;
+
+	static void run(void *p_data) {
+		const LookupTask *task = static_cast<const LookupTask *>(p_data);
+		uint32_t hashes = 0;
+		for (uint64_t i = 0; i < task->iterations; i++) {
+			const StringName name = StringName(task->names->strings[(i + task->offset) % NAME_COUNT]);
+			hashes += name.hash();
+		}
+		Benchmarks::do_not_optimize(hashes);
+	}
+};
+
+static void _lookup(uint64_t p_iterations, uint32_t p_thread_count) {
+	const Names &names = _get_names();
+
+	LocalVector<LookupTask> tasks;
+	tasks.resize(p_thread_count);
+	for (uint32_t i = 0; i < p_thread_count; i++) {
+		tasks[i].names = &names;
+		tasks[i].iterations = p_iterations;
+		tasks[i].offset = i * 17;
+	}
+
+	if (p_thread_count == 1) {
+		LookupTask::run(&tasks[0]);
+		return;
+	}
+
+	// Every thread does all the iterations, so the time per iteration grows with contention.
+	LocalVector<Thread> threads;
+	threads.resize(p_thread_count);
+	for (uint32_t i = 0; i < p_thread_count; i++) {
+		threads[i].start(&LookupTask::run, &tasks[i]);
+	}
+	for (Thread &thread : threads) {
+		thread.wait_to_finish();
+	}
+}
+
+static void bench_lookup(uint64_t p_iterations) {
+	_lookup(p_iterations, 1);
+}
+
+BENCHMARK("StringName/lookup", &bench_lookup);
+
+#ifdef THREADS_ENABLED
+static void bench_lookup_contended(uint64_t p_iterations) {
+	_lookup(p_iterations, CLAMP(OS::get_singleton()->get_processor_count(), 2, 8));
+}
+
+BENCHMARK("StringName/lookup_contended", &bench_lookup_contended);
+#endif // THREADS_ENABLED
+
+} // namespace BenchStringName
@@ -0,0 +1,162 @@
+/**************************************************************************/
+/*  bench_templates.cpp                                                   */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "tests/benchmarks/benchmark.h"
+
+#include "core/templates/a_hash_map.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/vector.h"
+#include "tests/test_macros.h"
+
+TEST_FORCE_LINK(bench_templates)
+
+namespace BenchTemplates {
+
+static const int ELEMENT_COUNT = 1024;
+
+typedef HashMap<int, int> IntHashMap;
+typedef AHashMap<int, int> IntAHashMap;
+
+template <typename M>
+static void bench_map_insert(uint64_t p_iterations) {
+	for (uint64_t i = 0; i < p_iterations; i++) {
+		M map;
+		for (int j = 0; j < ELEMENT_COUNT; j++) {
+			map.insert(j * 7919, j);
+		}
+		Benchmarks::do_not_optimize(map);
+	}
+}
+
+template <typename M>
+static void bench_map_lookup(uint64_t p_iterations) {
+	M map;
+	for (int j = 0; j < ELEMENT_COUNT; j++) {
+		map.insert(j * 7919, j);
+	}
+
+	int sum = 0;
+	for (uint64_t i = 0; i < p_iterations; i++) {
+		const int *value = map.getptr((int)(i % (ELEMENT_COUNT * 2)) * 7919);
+		if (value) {
+			sum += *value;
+		}
+	}
+	Benchmarks::do_not_optimize(sum);
+}
+
+template <typename M>
+static void bench_map_iterate(uint64_t p_iterations) {
+	M map;
+	for (int j = 0; j < ELEMENT_COUNT; j++) {
+		map.insert(j * 7919, j);
+	}
+
+	int sum = 0;
+	for (uint64_t i = 0; i < p_iterations; i++) {
+		for (const KeyValue<int, int> &E : map) {
+			sum += E.value;
+		}
+	}
+	Benchmarks::do_not_optimize(sum);
+}
+
+static void bench_local_vector_push_back(uint64_t p_iterations) {
+	for (uint64_t i = 0; i < p_iterations; i++) {
+		LocalVector<int> vector;
+		for (int j = 0; j < ELEMENT_COUNT; j++) {
+			vector.push_back(j);
+		}
+		Benchmarks::do_not_optimize(vector);
+	}
+}
+
+static void bench_local_vector_iterate(uint64_t p_iterations) {
+	LocalVector<int> vector;
+	for (int j = 0; j < ELEMENT_COUNT; j++) {
+		vector.push_back(j);
+	}
+
+	int sum = 0;
+	for (uint64_t i = 0; i < p_iterations; i++) {
+		for (const int value : vector) {
+			sum += value;
+		}
+	}
+	Benchmarks::do_not_optimize(sum);
+}
+
+static void bench_cowdata_push_back(uint64_t p_iterations) {
+	for (uint64_t i = 0; i < p_iterations; i++) {
+		Vector<int> vector;
+		for (int j = 0; j < ELEMENT_COUNT; j++) {
+			vector.push_back(j);
+		}
+		Benchmarks::do_not_optimize(vector);
+	}
+}
+
+static void bench_cowdata_copy_on_write(uint64_t p_iterations) {
+	Vector<int> source;
+	source.resize(ELEMENT_COUNT);
+
+	for (uint64_t i = 0; i < p_iterations; i++) {
+		// The copy shares the data until it's written to.
+		Vector<int> copy = source;
+		copy.write[0] = (int)i;
+		Benchmarks::do_not_optimize(copy);
+	}
+}
+
+static void bench_cowdata_read(uint64_t p_iterations) {
+	Vector<int> vector;
+	vector.resize(ELEMENT_COUNT);
+
+	int sum = 0;
+	for (uint64_t i = 0; i < p_iterations; i++) {
+		sum += vector[i % ELEMENT_COUNT];
+	}
+	Benchmarks::do_not_optimize(sum);
+}
+
+BENCHMARK("HashMap/insert_1024", &bench_map_insert<IntHashMap>);
+BENCHMARK("HashMap/lookup", &bench_map_lookup<IntHashMap>);
+BENCHMARK("HashMap/iterate_1024", &bench_map_iterate<IntHashMap>);
+BENCHMARK("AHashMap/insert_1024", &bench_map_insert<IntAHashMap>);
+BENCHMARK("AHashMap/lookup", &bench_map_lookup<IntAHashMap>);
+BENCHMARK("AHashMap/iterate_1024", &bench_map_iterate<IntAHashMap>);
+BENCHMARK("LocalVector/push_back_1024", &bench_local_vector_push_back);
+BENCHMARK("LocalVector/iterate_1024", &bench_local_vector_iterate);
+BENCHMARK("CowData/push_back_1024", &bench_cowdata_push_back);
+BENCHMARK("CowData/copy_on_write_1024", &bench_cowdata_copy_on_write);
+BENCHMARK("CowData/read", &bench_cowdata_read);
+
+} // namespace BenchTemplates
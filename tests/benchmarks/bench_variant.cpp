@@ -0,0 +1,176 @@
+/**************************************************************************/
+/*  bench_variant.cpp                                                     */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "tests/benchmarks/benchmark.h"
+
+#include "core/string/string_name.h"
+#include "core/variant/array.h"
+#include "core/variant/dictionary.h"
+#include "core/variant/variant.h"
+#include "tests/test_macros.h"
+
+TEST_FORCE_LINK(bench_variant)
+
+namespace BenchVariant {
+
+static const int ELEMENT_COUNT = 1024;
+
+static void bench_string_name_intern_existing(uint64_t p_iterations) {
+	const String name = "benchmark_existing_name";
+	StringName existing = name;
+
+	for (uint64_t i = 0; i < p_iterations; i++) {
+		StringName interned = name;
+		Benchmarks::do_not_optimize(interned);
+	}
+}
+
+static void bench_string_name_intern_new(uint64_t p_iterations) {
+	for (uint64_t i = 0; i < p_iterations; i++) {
+		// Released right away, so every iteration adds and removes a table entry.
+		StringName interned = "benchmark_new_name_" + itos(i % ELEMENT_COUNT);
+		Benchmarks::do_not_optimize(interned);
+	}
+}
+
+static void bench_string_name_compare(uint64_t p_iterations) {
+	StringName a = "benchmark_name_a";
+	StringName b = "benchmark_name_b";
+
+	int equal = 0;
+	for (uint64_t i = 0; i < p_iterations; i++) {
+		equal += (i & 1) ? (a == b) : (a == a);
+	}
+	Benchmarks::do_not_optimize(equal);
+}
+
+static void bench_variant_construct_int(uint64_t p_iterations) {
+	for (uint64_t i = 0; i < p_iterations; i++) {
+		Variant v = (int64_t)i;
+		Benchmarks::do_not_optimize(v);
+	}
+}
+
+static void bench_variant_construct_string(uint64_t p_iterations) {
+	const String string = "benchmark";
+	for (uint64_t i = 0; i < p_iterations; i++) {
+		Variant v = string;
+		Benchmarks::do_not_optimize(v);
+	}
+}
+
+static void bench_variant_construct_transform(uint64_t p_iterations) {
+	const Transform3D transform;
+	for (uint64_t i = 0; i < p_iterations; i++) {
+		Variant v = transform;
+		Benchmarks::do_not_optimize(v);
+	}
+}
+
+static void bench_variant_evaluate_add(uint64_t p_iterations) {
+	Variant a = 1;
+	Variant b = 2.5;
+	for (uint64_t i = 0; i < p_iterations; i++) {
+		bool valid = false;
+		Variant r;
+		Variant::evaluate(Variant::OP_ADD, a, b, r, valid);
+		Benchmarks::do_not_optimize(r);
+	}
+}
+
+static void bench_variant_validated_add(uint64_t p_iterations) {
+	Variant a = 1;
+	Variant b = 2.5;
+	Variant r = 0.0;
+	Variant::ValidatedOperatorEvaluator evaluator = Variant::get_validated_operator_evaluator(Variant::OP_ADD, Variant::INT, Variant::FLOAT);
+	for (uint64_t i = 0; i < p_iterations; i++) {
+		evaluator(&a, &b, &r);
+		Benchmarks::do_not_optimize(r);
+	}
+}
+
+static void bench_dictionary_set(uint64_t p_iterations) {
+	Dictionary dictionary;
+	for (uint64_t i = 0; i < p_iterations; i++) {
+		dictionary[(int64_t)(i % ELEMENT_COUNT)] = (int64_t)i;
+	}
+	Benchmarks::do_not_optimize(dictionary);
+}
+
+static void bench_dictionary_get(uint64_t p_iterations) {
+	Dictionary dictionary;
+	for (int j = 0; j < ELEMENT_COUNT; j++) {
+		dictionary["key_" + itos(j)] = j;
+	}
+	LocalVector<Variant> keys;
+	for (int j = 0; j < ELEMENT_COUNT; j++) {
+		keys.push_back("key_" + itos(j));
+	}
+
+	for (uint64_t i = 0; i < p_iterations; i++) {
+		Variant value = dictionary.get(keys[i % ELEMENT_COUNT], Variant());
+		Benchmarks::do_not_optimize(value);
+	}
+}
+
+static void bench_array_push_back(uint64_t p_iterations) {
+	for (uint64_t i = 0; i < p_iterations; i++) {
+		Array array;
+		for (int j = 0; j < ELEMENT_COUNT; j++) {
+			array.push_back(j);
+		}
+		Benchmarks::do_not_optimize(array);
+	}
+}
+
+static void bench_array_get(uint64_t p_iterations) {
+	Array array;
+	array.resize(ELEMENT_COUNT);
+
+	for (uint64_t i = 0; i < p_iterations; i++) {
+		const Variant &value = array[i % ELEMENT_COUNT];
+		Benchmarks::do_not_optimize(value);
+	}
+}
+
+BENCHMARK("StringName/intern_existing", &bench_string_name_intern_existing);
+BENCHMARK("StringName/intern_new", &bench_string_name_intern_new);
+BENCHMARK("StringName/compare", &bench_string_name_compare);
+BENCHMARK("Variant/construct_int", &bench_variant_construct_int);
+BENCHMARK("Variant/construct_string", &bench_variant_construct_string);
+BENCHMARK("Variant/construct_transform3d", &bench_variant_construct_transform);
+BENCHMARK("Variant/evaluate_add", &bench_variant_evaluate_add);
+BENCHMARK("Variant/validated_add", &bench_variant_validated_add);
+BENCHMARK("Dictionary/set", &bench_dictionary_set);
+BENCHMARK("Dictionary/get", &bench_dictionary_get);
+BENCHMARK("Array/push_back_1024", &bench_array_push_back);
+BENCHMARK("Array/get", &bench_array_get);
+
+} // namespace BenchVariant
@@ -0,0 +1,124 @@
+/**************************************************************************/
+/*  bench_variant_parser.cpp                                              */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "tests/benchmarks/benchmark.h"
+
+#include "core/io/file_access.h"
+#include "core/io/resource_loader.h"
+#include "core/variant/variant_parser.h"
+#include "tests/test_macros.h"
+#include "tests/test_utils.h"
+
+TEST_FORCE_LINK(bench_variant_parser)
+
+namespace BenchVariantParser {
+
+static const int NODE_COUNT = 1000;
+static const int POINT_COUNT = 4096;
+
+// A scene laid out like the ones generated for levels: many nodes with a few properties each, and some bulk data.
+static String _generate_scene(bool p_with_sub_resources) {
+	String points;
+	for (int i = 0; i < POINT_COUNT; i++) {
+		points += vformat("%s%.3f, %.3f, %.3f", i > 0 ? ", " : "", i * 0.5, i * 0.25, -i * 0.125);
+	}
+
+	String scene = "[gd_scene format=3]\n\n";
+	if (p_with_sub_resources) {
+		scene += "[sub_resource type=\"Resource\" id=\"Resource_points\"]\n";
+		scene += "metadata/points = PackedVector3Array(" + points + ")\n\n";
+	}
+	scene += "[node name=\"Root\" type=\"Node\"]\n";
+	if (!p_with_sub_resources) {
+		scene += "metadata/points = PackedVector3Array(" + points + ")\n";
+	}
+	scene += "\n";
+	for (int i = 0; i < NODE_COUNT; i++) {
+		scene += vformat("[node name=\"Node%d\" type=\"Node\" parent=\".\"]\n", i);
+		scene += vformat("editor_description = \"Generated node %d, \\\"quoted\\\" and \\u00fcnicode\"\n", i);
+		scene += vformat("metadata/transform = Transform3D(1, 0, 0, 0, 1, 0, 0, 0, 1, %d, %.2f, -%d)\n", i, i * 0.5, i);
+		scene += vformat("metadata/tags = [&\"tag_%d\", \"label\", %d, true]\n", i % 16, i);
+		if (p_with_sub_resources && i % 10 == 0) {
+			scene += "metadata/points = SubResource(\"Resource_points\")\n";
+		}
+		scene += "\n";
+	}
+	return scene;
+}
+
+static void _parse_all(VariantParser::Stream *p_stream) {
+	int line = 1;
+	String error_text;
+	VariantParser::Tag tag;
+	String assign;
+	Variant value;
+	while (VariantParser::parse_tag_assign_eof(p_stream, line, error_text, tag, assign, value) == OK) {
+		Benchmarks::do_not_optimize(value);
+	}
+}
+
+static String _save_scene_text(const String &p_name, bool p_with_sub_resources) {
+	const String path = TestUtils::get_temp_path(p_name);
+	Ref<FileAccess> f = FileAccess::open(path, FileAccess::WRITE);
+	f->store_string(_generate_scene(p_with_sub_resources));
+	return path;
+}
+
+static void bench_parse_string(uint64_t p_iterations) {
+	static const String scene = _generate_scene(false);
+	for (uint64_t i = 0; i < p_iterations; i++) {
+		VariantParser::StreamString stream;
+		stream.s = scene;
+		_parse_all(&stream);
+	}
+}
+
+static void bench_parse_file(uint64_t p_iterations) {
+	static const String path = _save_scene_text("bench_parse_file.txt", false);
+	for (uint64_t i = 0; i < p_iterations; i++) {
+		VariantParser::StreamFile stream;
+		stream.f = FileAccess::open(path, FileAccess::READ);
+		_parse_all(&stream);
+	}
+}
+
+static void bench_load_text_scene(uint64_t p_iterations) {
+	static const String path = _save_scene_text("bench_load_text_scene.tscn", true);
+	for (uint64_t i = 0; i < p_iterations; i++) {
+		Ref<Resource> scene = ResourceLoader::load(path, "", ResourceFormatLoader::CACHE_MODE_IGNORE);
+		Benchmarks::do_not_optimize(scene);
+	}
+}
+
+BENCHMARK("VariantParser/parse_scene_string", &bench_parse_string);
+BENCHMARK("VariantParser/parse_scene_file", &bench_parse_file);
+BENCHMARK("ResourceLoader/text_scene", &bench_load_text_scene);
+
+} // namespace BenchVariantParser
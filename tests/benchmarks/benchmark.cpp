@@ -0,0 +1,146 @@
+/**************************************************************************/
+/*  benchmark.cpp                                                         */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "benchmark.h"
+
+#include "core/io/file_access.h"
+#include "core/io/json.h"
+#include "core/os/os.h"
+#include "core/templates/local_vector.h"
+#include "core/version.h"
+#include "tests/test_macros.h"
+
+TEST_FORCE_LINK(benchmark)
+
+namespace Benchmarks {
+
+// Each sample runs for at least this long, so the timer resolution doesn't matter.
+static const uint64_t SAMPLE_MIN_USEC = 20000;
+static const int SAMPLE_COUNT = 7;
+
+struct BenchmarkEntry {
+	String name;
+	BenchmarkFunc function = nullptr;
+};
+
+static LocalVector<BenchmarkEntry> *benchmarks = nullptr;
+
+const void *volatile value_sink = nullptr;
+
+int register_benchmark(const String &p_name, BenchmarkFunc p_function) {
+	if (!benchmarks) {
+		benchmarks = new LocalVector<BenchmarkEntry>;
+	}
+	benchmarks->push_back({ p_name, p_function });
+	return 0;
+}
+
+static uint64_t _run_sample(BenchmarkFunc p_function, uint64_t p_iterations) {
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	p_function(p_iterations);
+	return OS::get_singleton()->get_ticks_usec() - begin;
+}
+
+static Dictionary _run_benchmark(const BenchmarkEntry &p_benchmark) {
+	// Find how many iterations make a sample long enough.
+	uint64_t iterations = 1;
+	uint64_t usec = _run_sample(p_benchmark.function, iterations);
+	while (usec < SAMPLE_MIN_USEC / 10) {
+		iterations *= 10;
+		usec = _run_sample(p_benchmark.function, iterations);
+	}
+	iterations = MAX(iterations, iterations * SAMPLE_MIN_USEC / MAX(usec, (uint64_t)1));
+
+	LocalVector<double> ns_per_op;
+	for (int i = 0; i < SAMPLE_COUNT; i++) {
+		ns_per_op.push_back(_run_sample(p_benchmark.function, iterations) * 1000.0 / iterations);
+	}
+	ns_per_op.sort();
+
+	double total = 0.0;
+	for (double ns : ns_per_op) {
+		total += ns;
+	}
+
+	Dictionary result;
+	result["name"] = p_benchmark.name;
+	result["iterations"] = iterations;
+	result["samples"] = SAMPLE_COUNT;
+	result["ns_per_op_min"] = ns_per_op[0];
+	result["ns_per_op_median"] = ns_per_op[SAMPLE_COUNT / 2];
+	result["ns_per_op_mean"] = total / SAMPLE_COUNT;
+	return result;
+}
+
+static void run_benchmarks() {
+	String filter;
+	String output_path;
+
+	const List<String> args = OS::get_singleton()->get_cmdline_args();
+	for (const List<String>::Element *E = args.front(); E; E = E->next()) {
+		if (E->get() == "--benchmark-filter" && E->next()) {
+			filter = E->next()->get();
+		} else if (E->get() == "--benchmark-output" && E->next()) {
+			output_path = E->next()->get();
+		}
+	}
+
+	Array results;
+	if (benchmarks) {
+		for (const BenchmarkEntry &benchmark : *benchmarks) {
+			if (!filter.is_empty() && !benchmark.name.contains(filter)) {
+				continue;
+			}
+			Dictionary result = _run_benchmark(benchmark);
+			if (!output_path.is_empty()) {
+				print_line(vformat("%s: %.2f ns/op", benchmark.name, (double)result["ns_per_op_median"]));
+			}
+			results.push_back(result);
+		}
+	}
+
+	Dictionary report;
+	report["version"] = GODOT_VERSION_FULL_BUILD;
+	report["benchmarks"] = results;
+	String json = JSON::stringify(report, "\t", false);
+
+	if (output_path.is_empty()) {
+		print_line(json);
+		return;
+	}
+
+	Ref<FileAccess> f = FileAccess::open(output_path, FileAccess::WRITE);
+	ERR_FAIL_COND_MSG(f.is_null(), vformat("Cannot write benchmark results to \"%s\".", output_path));
+	f->store_string(json);
+}
+
+} // namespace Benchmarks
+
+REGISTER_TEST_COMMAND("benchmarks", &Benchmarks::run_benchmarks);
@@ -0,0 +1,60 @@
+/**************************************************************************/
+/*  benchmark.h                                                           */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/string/ustring.h"
+#include <thirdparty/doctest/doctest.h>
+
+// Microbenchmarks, built with the `benchmarks=yes` SCons option.
+// Run them all with `godot --test benchmarks`, optionally with:
+// `--benchmark-filter <text>` to only run the benchmarks whose name contains the text,
+// `--benchmark-output <path>` to save the results to a JSON file instead of printing them.
+
+namespace Benchmarks {
+
+// A benchmark runs its body the given number of times, the runner picks the count.
+typedef void (*BenchmarkFunc)(uint64_t p_iterations);
+
+int register_benchmark(const String &p_name, BenchmarkFunc p_function);
+
+extern const void *volatile value_sink;
+
+// Prevents the compiler from optimizing away a value computed by a benchmark.
+template <typename T>
+_FORCE_INLINE_ void do_not_optimize(const T &p_value) {
+	value_sink = &p_value;
+}
+
+} // namespace Benchmarks
+
+#define BENCHMARK(m_name, m_function) \
+	DOCTEST_GLOBAL_NO_WARNINGS(DOCTEST_ANONYMOUS(GODOT_BENCHMARK_ANON_VAR_), \
+			Benchmarks::register_benchmark(m_name, m_function))
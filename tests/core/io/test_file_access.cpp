@@ -250,6 +250,64 @@ TEST_CASE("[FileAccess] Get/Store floating point half precision values") {
 	}
 }
 
+TEST_CASE("[FileAccess] Read compressed file spanning many blocks") {
+	const String file_path = TestUtils::get_temp_path("compressed_blocks.bin");
+
+	// Enough data for dozens of blocks, so bulk reads and read-ahead are both exercised.
+	PackedByteArray reference;
+	reference.resize(4096 * 40 + 123);
+	for (int64_t i = 0; i < reference.size(); i++) {
+		reference.write[i] = (i * 7 + i / 4096) % 251;
+	}
+
+	{
+		Ref<FileAccess> f = FileAccess::open_compressed(file_path, FileAccess::WRITE, FileAccess::COMPRESSION_ZSTD);
+		REQUIRE(f.is_valid());
+		f->store_buffer(reference);
+	}
+
+	Ref<FileAccess> f = FileAccess::open_compressed(file_path, FileAccess::READ, FileAccess::COMPRESSION_ZSTD);
+	REQUIRE(f.is_valid());
+	CHECK(f->get_length() == (uint64_t)reference.size());
+
+	SUBCASE("Single bulk read") {
+		const Vector<uint8_t> data = f->get_buffer(reference.size());
+		CHECK(data == reference);
+		CHECK(f->get_position() == (uint64_t)reference.size());
+	}
+
+	SUBCASE("Bulk read starting inside a block") {
+		f->seek(1000);
+		const Vector<uint8_t> data = f->get_buffer(4096 * 10);
+		CHECK(data == reference.slice(1000, 1000 + 4096 * 10));
+		CHECK(f->get_8() == reference[1000 + 4096 * 10]);
+
+		// Seeking back into the last block of the bulk read.
+		f->seek(1000 + 4096 * 10 - 1);
+		CHECK(f->get_8() == reference[1000 + 4096 * 10 - 1]);
+	}
+
+	SUBCASE("Sequential small reads") {
+		bool matches = true;
+		for (int64_t i = 0; i < reference.size(); i += 4) {
+			const Vector<uint8_t> data = f->get_buffer(4);
+			matches = matches && data == reference.slice(i, MIN(i + 4, reference.size()));
+		}
+		CHECK(matches);
+	}
+
+	SUBCASE("Random seeks") {
+		const int64_t positions[] = { 4096 * 39, 17, 4096 * 12 + 5, 4096 * 40 + 100, 4096 * 13 };
+		for (int64_t position : positions) {
+			f->seek(position);
+			CHECK(f->get_8() == reference[position]);
+		}
+	}
+
+	f->close();
+	DirAccess::remove_file_or_error(file_path);
+}
+
 TEST_CASE("[FileAccess] Cursor positioning") {
 	Ref<FileAccess> f = FileAccess::open(TestUtils::get_data_path("line_endings_lf.test.txt"), FileAccess::READ);
 	REQUIRE(f.is_valid());
@@ -297,4 +355,70 @@ TEST_CASE("[FileAccess] Cursor positioning") {
 	}
 }
 
+TEST_CASE("[FileAccess] Get buffer span") {
+	Ref<FileAccess> f = FileAccess::open(TestUtils::get_data_path("line_endings_lf.test.txt"), FileAccess::READ);
+	REQUIRE(f.is_valid());
+
+	const Vector<uint8_t> full = f->get_buffer(f->get_length());
+	f->seek(0);
+
+	if (!f->get_mapped_contents()) {
+		// Memory mapping isn't available on this platform, spans must be empty.
+		CHECK(f->get_buffer_span(4).is_empty());
+		CHECK(f->get_position() == 0);
+		return;
+	}
+
+	SUBCASE("Span matches the file contents and advances the cursor") {
+		f->seek(2);
+		Span<uint8_t> span = f->get_buffer_span(5);
+		REQUIRE(span.size() == 5);
+		CHECK(memcmp(span.ptr(), full.ptr() + 2, 5) == 0);
+		CHECK(f->get_position() == 7);
+		CHECK(f->get_8() == full[7]);
+	}
+
+	SUBCASE("Span past the end of the file is empty") {
+		f->seek(full.size() - 2);
+		CHECK(f->get_buffer_span(3).is_empty());
+		CHECK(f->get_position() == (uint64_t)full.size() - 2);
+	}
+}
+
+TEST_CASE("[FileAccess] Get buffer span after the file grew") {
+	const String path = TestUtils::get_temp_path("buffer_span_grow.txt");
+	{
+		Ref<FileAccess> w = FileAccess::open(path, FileAccess::WRITE);
+		REQUIRE(w.is_valid());
+		w->store_string("0123456789");
+	}
+
+	Ref<FileAccess> f = FileAccess::open(path, FileAccess::READ);
+	REQUIRE(f.is_valid());
+	if (!f->get_mapped_contents()) {
+		return;
+	}
+	CHECK(f->get_mapped_length() == 10);
+
+	{
+		Ref<FileAccess> w = FileAccess::open(path, FileAccess::READ_WRITE);
+		REQUIRE(w.is_valid());
+		w->seek_end();
+		w->store_string("abcdef");
+	}
+
+	// Only the mapped bytes can be returned as a span, the rest must be copied.
+	f->seek(8);
+	CHECK(f->get_buffer_span(4).is_empty());
+	CHECK(f->get_position() == 8);
+	const Vector<uint8_t> rest = f->get_buffer(4);
+	REQUIRE(rest.size() == 4);
+	CHECK(memcmp(rest.ptr(), "89ab", 4) == 0);
+
+	f->seek(2);
+	Span<uint8_t> span = f->get_buffer_span(8);
+	REQUIRE(span.size() == 8);
+	CHECK(memcmp(span.ptr(), "23456789", 8) == 0);
+}
+
 } // namespace TestFileAccess
@@ -33,6 +33,7 @@
 TEST_FORCE_LINK(test_pck_packer)
 
 #include "core/io/file_access.h"
+#include "core/io/file_access_pack.h"
 #include "core/io/pck_packer.h"
 #include "core/os/os.h"
 #include "tests/test_utils.h"
@@ -120,4 +121,70 @@ TEST_CASE("[PCKPacker] Pack a PCK file with some files and directories") {
 			"The generated non-empty PCK file shouldn't be too large.");
 }
 
+TEST_CASE("[PCKPacker] Deduplicate and compress files") {
+	// Compresses well, and is large enough to make a difference in size when stored twice.
+	Vector<uint8_t> data;
+	data.resize(64 * 1024);
+	for (int i = 0; i < data.size(); i++) {
+		data.write[i] = (i / 16) % 8;
+	}
+
+	const String plain_pck_path = TestUtils::get_temp_path("output_plain.pck");
+	const String dedup_pck_path = TestUtils::get_temp_path("output_dedup.pck");
+	const String compressed_pck_path = TestUtils::get_temp_path("output_compressed.pck");
+
+	PCKPacker plain_packer;
+	REQUIRE(plain_packer.pck_start(plain_pck_path) == OK);
+
+	PCKPacker dedup_packer;
+	dedup_packer.set_deduplication_enabled(true);
+	CHECK(dedup_packer.is_deduplication_enabled());
+	REQUIRE(dedup_packer.pck_start(dedup_pck_path) == OK);
+
+	PCKPacker compressed_packer;
+	compressed_packer.set_deduplication_enabled(true);
+	compressed_packer.set_compression_enabled(true);
+	CHECK(compressed_packer.is_compression_enabled());
+	REQUIRE(compressed_packer.pck_start(compressed_pck_path) == OK);
+
+	for (PCKPacker *packer : { &plain_packer, &dedup_packer, &compressed_packer }) {
+		CHECK(packer->add_file_from_buffer("a/data.bin", data) == OK);
+		CHECK(packer->add_file_from_buffer("b/data.bin", data) == OK);
+		CHECK(packer->add_file_from_buffer("c/data.bin", data) == OK);
+		CHECK(packer->flush() == OK);
+	}
+
+	const int64_t plain_size = FileAccess::get_file_as_bytes(plain_pck_path).size();
+	const int64_t dedup_size = FileAccess::get_file_as_bytes(dedup_pck_path).size();
+	const int64_t compressed_size = FileAccess::get_file_as_bytes(compressed_pck_path).size();
+
+	CHECK_MESSAGE(
+			plain_size >= 3 * data.size(),
+			"Without deduplication, every copy of the file should be stored.");
+	CHECK_MESSAGE(
+			dedup_size < 2 * data.size(),
+			"With deduplication, the file should only be stored once.");
+	CHECK_MESSAGE(
+			compressed_size < data.size() / 4,
+			"With compression, the file should be stored compressed.");
+
+	// Read the files back through the packs, like an exported project would.
+	REQUIRE(PackedData::get_singleton()->add_pack(dedup_pck_path, true, 0) == OK);
+	Ref<FileAccess> dedup_file = PackedData::get_singleton()->try_open_path("res://b/data.bin");
+	REQUIRE(dedup_file.is_valid());
+	CHECK(dedup_file->get_length() == uint64_t(data.size()));
+	CHECK_MESSAGE(
+			dedup_file->get_buffer(data.size()) == data,
+			"A deduplicated file should read back the same as its source.");
+	dedup_file.unref();
+
+	REQUIRE(PackedData::get_singleton()->add_pack(compressed_pck_path, true, 0) == OK);
+	Ref<FileAccess> compressed_file = PackedData::get_singleton()->try_open_path("res://c/data.bin");
+	REQUIRE(compressed_file.is_valid());
+	CHECK(compressed_file->get_length() == uint64_t(data.size()));
+	CHECK_MESSAGE(
+			compressed_file->get_buffer(data.size()) == data,
+			"A compressed file should read back the same as its source.");
+}
+
 } // namespace TestPCKPacker
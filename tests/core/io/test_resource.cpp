@@ -32,15 +32,61 @@
 
 TEST_FORCE_LINK(test_resource)
 
+#include "core/config/project_settings.h"
 #include "core/io/resource.h"
 #include "core/io/resource_loader.h"
 #include "core/io/resource_saver.h"
 #include "core/object/class_db.h"
+#include "core/os/safe_binary_mutex.h"
 #include "scene/main/node.h"
 #include "tests/test_utils.h"
 
 #include <functional>
 
+class TestResourceLoaderInternalsAccessor {
+public:
+	static Vector<String> get_load_dependencies(const String &p_path) {
+		MutexLock thread_load_lock(ResourceLoader::thread_load_mutex);
+		const Vector<String> *dependencies = ResourceLoader::load_dependencies.getptr(p_path);
+		return dependencies ? *dependencies : Vector<String>();
+	}
+
+	// Prefetches the known dependencies of the path as if a load of it was starting, then lets go of them right away.
+	static Vector<String> prefetch_and_release(const String &p_path) {
+		ResourceLoader::_read_load_dependencies();
+		MutexLock thread_load_lock(ResourceLoader::thread_load_mutex);
+		ResourceLoader::ThreadLoadTask load_task;
+		load_task.local_path = p_path;
+		ResourceLoader::_prefetch_dependencies(load_task);
+
+		Vector<String> prefetched;
+		for (const ResourceLoader::LoadToken *token : load_task.prefetch_tokens) {
+			prefetched.push_back(token->local_path);
+		}
+		ResourceLoader::_release_prefetch_tokens(load_task);
+		return prefetched;
+	}
+
+	static const decltype(ResourceLoader::thread_load_mutex) &get_mutex() {
+		return ResourceLoader::thread_load_mutex;
+	}
+
+	static bool is_queued(const String &p_path) {
+		MutexLock thread_load_lock(ResourceLoader::thread_load_mutex);
+		const ResourceLoader::ThreadLoadTask *load_task = ResourceLoader::thread_load_tasks.getptr(p_path);
+		return load_task && load_task->queued;
+	}
+
+	static bool is_loading(const String &p_path) {
+		MutexLock thread_load_lock(ResourceLoader::thread_load_mutex);
+		return ResourceLoader::thread_load_tasks.has(p_path);
+	}
+
+	static void release_cancelled_loads() {
+		ResourceLoader::_release_cancelled_load_tokens();
+	}
+};
+
 namespace TestResource {
 
 enum TestDuplicateMode {
@@ -573,6 +619,50 @@ TEST_CASE("[Resource] Saving and loading") {
 			"The loaded child resource name should be equal to the expected value.");
 }
 
+TEST_CASE("[Resource] Saving and loading packed arrays") {
+	// Odd sizes, so the arrays that follow one another need padding to stay aligned.
+	PackedByteArray bytes = { 1, 2, 3 };
+	PackedInt32Array ints32 = { -1, 2, 0x7fffffff };
+	PackedInt64Array ints64 = { -1, 0x7fffffffffffffff };
+	PackedFloat32Array floats32 = { 0.5, -1.25, 3.0 };
+	PackedFloat64Array floats64 = { 0.1, -1e100 };
+	PackedVector2Array vectors2 = { Vector2(1, 2) };
+	PackedVector3Array vectors3 = { Vector3(1, 2, 3), Vector3(-4, 5, -6) };
+	PackedColorArray colors = { Color(0.1, 0.2, 0.3, 0.4) };
+	PackedVector4Array vectors4 = { Vector4(1, 2, 3, 4) };
+
+	Ref<Resource> resource = memnew(Resource);
+	resource->set_meta("bytes", bytes);
+	resource->set_meta("ints32", ints32);
+	resource->set_meta("ints64", ints64);
+	resource->set_meta("floats32", floats32);
+	resource->set_meta("floats64", floats64);
+	resource->set_meta("vectors2", vectors2);
+	resource->set_meta("vectors3", vectors3);
+	resource->set_meta("colors", colors);
+	resource->set_meta("vectors4", vectors4);
+
+	const String save_path = TestUtils::get_temp_path("packed_arrays.res");
+	CHECK(ResourceSaver::save(resource, save_path) == OK);
+	// Also go through the compressed file, which may not keep the positions of the data.
+	const String save_path_compressed = TestUtils::get_temp_path("packed_arrays_compressed.res");
+	CHECK(ResourceSaver::save(resource, save_path_compressed, ResourceSaver::FLAG_COMPRESS) == OK);
+
+	for (const String &path : { save_path, save_path_compressed }) {
+		const Ref<Resource> loaded = ResourceLoader::load(path, "", ResourceFormatLoader::CACHE_MODE_IGNORE);
+		REQUIRE(loaded.is_valid());
+		CHECK(PackedByteArray(loaded->get_meta("bytes")) == bytes);
+		CHECK(PackedInt32Array(loaded->get_meta("ints32")) == ints32);
+		CHECK(PackedInt64Array(loaded->get_meta("ints64")) == ints64);
+		CHECK(PackedFloat32Array(loaded->get_meta("floats32")) == floats32);
+		CHECK(PackedFloat64Array(loaded->get_meta("floats64")) == floats64);
+		CHECK(PackedVector2Array(loaded->get_meta("vectors2")) == vectors2);
+		CHECK(PackedVector3Array(loaded->get_meta("vectors3")) == vectors3);
+		CHECK(PackedColorArray(loaded->get_meta("colors")) == colors);
+		CHECK(PackedVector4Array(loaded->get_meta("vectors4")) == vectors4);
+	}
+}
+
 TEST_CASE("[Resource] Breaking circular references on save") {
 	Ref<Resource> resource_a = memnew(Resource);
 	resource_a->set_name("A");
@@ -628,4 +718,132 @@ TEST_CASE("[Resource] Breaking circular references on save") {
 	resource_c->remove_meta("next");
 }
 
+TEST_CASE("[Resource] Threaded load priorities and cancellation") {
+	Ref<Resource> resource = memnew(Resource);
+	const String save_path_a = TestUtils::get_temp_path("threaded_a.res");
+	const String save_path_b = TestUtils::get_temp_path("threaded_b.res");
+	const String save_path_c = TestUtils::get_temp_path("threaded_c.res");
+	ResourceSaver::save(resource, save_path_a);
+	ResourceSaver::save(resource, save_path_b);
+	ResourceSaver::save(resource, save_path_c);
+
+	// Only one load at a time, so the others have to wait for their turn.
+	ResourceLoader::set_threaded_load_budget(1, 0);
+	CHECK(ResourceLoader::get_threaded_load_max_tasks() == 1);
+	CHECK(ResourceLoader::get_threaded_load_max_bytes() == 0);
+
+	CHECK(ResourceLoader::load_threaded_request(save_path_a) == OK);
+	CHECK(ResourceLoader::load_threaded_request(save_path_b) == OK);
+	CHECK(ResourceLoader::load_threaded_request(save_path_c) == OK);
+
+	CHECK(ResourceLoader::load_threaded_get_priority(save_path_c) == 0);
+	CHECK(ResourceLoader::load_threaded_set_priority(save_path_c, 10) == OK);
+	CHECK(ResourceLoader::load_threaded_get_priority(save_path_c) == 10);
+
+	CHECK(ResourceLoader::load_threaded_cancel(save_path_a) == OK);
+	CHECK(ResourceLoader::load_threaded_cancel(save_path_b) == OK);
+	CHECK(ResourceLoader::load_threaded_cancel(save_path_c) == OK);
+
+	CHECK_MESSAGE(
+			ResourceLoader::load_threaded_get_status(save_path_b) == ResourceLoader::THREAD_LOAD_INVALID_RESOURCE,
+			"A cancelled load should not be available anymore.");
+	CHECK_MESSAGE(
+			ResourceLoader::load_threaded_cancel(save_path_b) == ERR_INVALID_PARAMETER,
+			"A cancelled load can't be cancelled again.");
+	CHECK(ResourceLoader::load_threaded_set_priority(save_path_b, 1) == ERR_INVALID_PARAMETER);
+
+	ResourceLoader::set_threaded_load_budget(0, 0);
+}
+
+#ifdef THREADS_ENABLED
+TEST_CASE("[Resource] Threaded loads are dispatched by priority") {
+	Ref<Resource> resource = memnew(Resource);
+	const String save_path_a = TestUtils::get_temp_path("priority_a.res");
+	const String save_path_b = TestUtils::get_temp_path("priority_b.res");
+	const String save_path_c = TestUtils::get_temp_path("priority_c.res");
+	ResourceSaver::save(resource, save_path_a);
+	ResourceSaver::save(resource, save_path_b);
+	ResourceSaver::save(resource, save_path_c);
+	const String local_path_a = ProjectSettings::get_singleton()->localize_path(save_path_a);
+	const String local_path_b = ProjectSettings::get_singleton()->localize_path(save_path_b);
+	const String local_path_c = ProjectSettings::get_singleton()->localize_path(save_path_c);
+
+	ResourceLoader::set_threaded_load_budget(1, 0);
+	{
+		// Hold the running load back, so the queue can't move on its own while it's checked.
+		MutexLock thread_load_lock(TestResourceLoaderInternalsAccessor::get_mutex());
+
+		CHECK(ResourceLoader::load_threaded_request(save_path_a) == OK);
+		CHECK(ResourceLoader::load_threaded_request(save_path_b) == OK);
+		CHECK(ResourceLoader::load_threaded_request(save_path_c) == OK);
+		CHECK_FALSE(TestResourceLoaderInternalsAccessor::is_queued(local_path_a));
+		CHECK(TestResourceLoaderInternalsAccessor::is_queued(local_path_b));
+		CHECK(TestResourceLoaderInternalsAccessor::is_queued(local_path_c));
+
+		CHECK(ResourceLoader::load_threaded_set_priority(save_path_c, 10) == OK);
+		// Room for one more load, which should go to the highest priority, even though it was requested last.
+		ResourceLoader::set_threaded_load_budget(2, 0);
+		CHECK_MESSAGE(
+				!TestResourceLoaderInternalsAccessor::is_queued(local_path_c),
+				"The load with the highest priority should be dispatched first.");
+		CHECK(TestResourceLoaderInternalsAccessor::is_queued(local_path_b));
+	}
+
+	CHECK(ResourceLoader::load_threaded_get(save_path_a).is_valid());
+	CHECK(ResourceLoader::load_threaded_get(save_path_b).is_valid());
+	CHECK(ResourceLoader::load_threaded_get(save_path_c).is_valid());
+	ResourceLoader::set_threaded_load_budget(0, 0);
+}
+#endif // THREADS_ENABLED
+
+TEST_CASE("[Resource] Threaded load prefetches known dependencies") {
+	Ref<Resource> dependency = memnew(Resource);
+	dependency->set_name("Dependency");
+	const String dependency_path = TestUtils::get_temp_path("prefetch_dependency.res");
+	REQUIRE(ResourceSaver::save(dependency, dependency_path, ResourceSaver::FLAG_CHANGE_PATH) == OK);
+
+	Ref<Resource> resource = memnew(Resource);
+	resource->set_meta("dependency", dependency);
+	const String save_path = TestUtils::get_temp_path("prefetch_resource.res");
+	REQUIRE(ResourceSaver::save(resource, save_path) == OK);
+	// Nothing stays cached, so the loads below read the files.
+	resource.unref();
+	dependency.unref();
+
+	const String local_path = ProjectSettings::get_singleton()->localize_path(save_path);
+	const String dependency_local_path = ProjectSettings::get_singleton()->localize_path(dependency_path);
+
+	CHECK(ResourceLoader::load_threaded_request(save_path, "", true) == OK);
+	Ref<Resource> loaded = ResourceLoader::load_threaded_get(save_path);
+	REQUIRE(loaded.is_valid());
+	CHECK(Ref<Resource>(loaded->get_meta("dependency"))->get_name() == "Dependency");
+	CHECK_MESSAGE(
+			TestResourceLoaderInternalsAccessor::get_load_dependencies(local_path) == Vector<String>{ dependency_local_path },
+			"The dependencies of a completed load should be recorded.");
+	loaded.unref();
+
+	// A prefetch that's no longer needed is let go without waiting for it.
+	CHECK(TestResourceLoaderInternalsAccessor::prefetch_and_release(local_path) == Vector<String>{ dependency_local_path });
+	Ref<Resource> loaded_dependency = ResourceLoader::load(dependency_path);
+	CHECK(loaded_dependency.is_valid());
+	loaded_dependency.unref();
+	TestResourceLoaderInternalsAccessor::release_cancelled_loads();
+	CHECK_MESSAGE(
+			!TestResourceLoaderInternalsAccessor::is_loading(dependency_local_path),
+			"A released prefetch should be gone once it's done.");
+
+	// The resource doesn't use the dependency anymore, so it shouldn't be prefetched next time.
+	resource = memnew(Resource);
+	REQUIRE(ResourceSaver::save(resource, save_path) == OK);
+	resource.unref();
+	CHECK(ResourceLoader::load_threaded_request(save_path, "", true) == OK);
+	loaded = ResourceLoader::load_threaded_get(save_path);
+	REQUIRE(loaded.is_valid());
+	CHECK_FALSE(loaded->has_meta("dependency"));
+	CHECK_MESSAGE(
+			TestResourceLoaderInternalsAccessor::get_load_dependencies(local_path).is_empty(),
+			"The recorded dependencies should be refreshed on every load.");
+	TestResourceLoaderInternalsAccessor::release_cancelled_loads();
+}
+
 } // namespace TestResource
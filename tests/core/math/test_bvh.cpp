@@ -0,0 +1,134 @@
+/**************************************************************************/
+/*  test_bvh.cpp                                                          */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "tests/test_macros.h"
+
+TEST_FORCE_LINK(test_bvh)
+
+#include "core/math/bvh.h"
+
+namespace TestBVH {
+
+struct TestItem {
+	int id = 0;
+};
+
+template <typename T>
+class TestPairFunction {
+public:
+	static bool user_pair_check(const T *p_a, const T *p_b) {
+		return true;
+	}
+};
+
+template <typename T>
+class TestCullFunction {
+public:
+	static bool user_cull_check(const T *p_a, const T *p_b) {
+		return true;
+	}
+};
+
+typedef BVH_Manager<TestItem, 1, true, 32, TestPairFunction<TestItem>, TestCullFunction<TestItem>> TestBVH;
+
+static void *_pair_callback(void *p_self, uint32_t p_id_a, TestItem *p_item_a, int p_subindex_a, uint32_t p_id_b, TestItem *p_item_b, int p_subindex_b) {
+	static_cast<Vector<String> *>(p_self)->push_back(vformat("pair %d %d", p_item_a->id, p_item_b->id));
+	return nullptr;
+}
+
+static void _unpair_callback(void *p_self, uint32_t p_id_a, TestItem *p_item_a, int p_subindex_a, uint32_t p_id_b, TestItem *p_item_b, int p_subindex_b, void *p_pair_data) {
+	static_cast<Vector<String> *>(p_self)->push_back(vformat("unpair %d %d", p_item_a->id, p_item_b->id));
+}
+
+// Moves a grid of items around for a few ticks, and returns the pair and unpair callbacks in the order they were sent.
+static Vector<String> _record_pairing(int p_grid_size, bool p_thread_pairing) {
+	Vector<String> events;
+	TestBVH bvh;
+	bvh.params_set_thread_pairing(p_thread_pairing);
+	bvh.set_pair_callback(_pair_callback, &events);
+	bvh.set_unpair_callback(_unpair_callback, &events);
+
+	const int item_count = p_grid_size * p_grid_size * p_grid_size;
+	LocalVector<TestItem> items;
+	items.resize(item_count);
+	LocalVector<Vector3> positions;
+	LocalVector<BVHHandle> handles;
+	for (int i = 0; i < item_count; i++) {
+		items[i].id = i;
+		positions.push_back(Vector3(i % p_grid_size, (i / p_grid_size) % p_grid_size, i / (p_grid_size * p_grid_size)));
+		handles.push_back(bvh.create(&items[i], true, 0, 1, AABB(positions[i], Vector3(0.4, 0.4, 0.4))));
+	}
+	bvh.update();
+
+	// Overlap the neighbors.
+	for (int i = 0; i < item_count; i++) {
+		bvh.move(handles[i], AABB(positions[i] - Vector3(0.1, 0.1, 0.1), Vector3(1.2, 1.2, 1.2)));
+	}
+	bvh.update();
+
+	// Move every other item away, onto each other.
+	for (int i = 0; i < item_count; i += 2) {
+		bvh.move(handles[i], AABB(Vector3(100, 0, 0) + positions[i] * 0.25, Vector3(1.2, 1.2, 1.2)));
+	}
+	bvh.update();
+
+	// Shrink everything back.
+	for (int i = 0; i < item_count; i++) {
+		bvh.move(handles[i], AABB(positions[i], Vector3(0.4, 0.4, 0.4)));
+	}
+	bvh.update();
+
+	for (const BVHHandle &handle : handles) {
+		bvh.erase(handle);
+	}
+	return events;
+}
+
+TEST_CASE("[BVH] Threaded pairing sends the same callbacks as serial pairing") {
+	SUBCASE("Few items") {
+		// Too few changed items to spread the pairing over threads.
+		const Vector<String> serial = _record_pairing(3, false);
+		const Vector<String> threaded = _record_pairing(3, true);
+		CHECK_FALSE(serial.is_empty());
+		CHECK(threaded == serial);
+	}
+
+	SUBCASE("Many items") {
+		// Every item changes on each tick, well above the number needed to pair on threads.
+		const Vector<String> serial = _record_pairing(8, false);
+		const Vector<String> threaded = _record_pairing(8, true);
+		CHECK(serial.size() > 512);
+		CHECK_MESSAGE(
+				threaded == serial,
+				"The pair and unpair callbacks should be sent in the same order when pairing on threads.");
+	}
+}
+
+} // namespace TestBVH
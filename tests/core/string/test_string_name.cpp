@@ -0,0 +1,118 @@
+/**************************************************************************/
+/*  test_string_name.cpp                                                  */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+#include "tests/test_macros.h"
+
+TEST_FORCE_LINK(test_string_name)
+
+#include "core/os/os.h"
+#include "core/os/thread.h"
+#include "core/string/string_name.h"
+
+namespace TestStringName {
+
+TEST_CASE("[StringName] Interning") {
+	const StringName from_chars = StringName("test_string_name_interning");
+	const StringName from_string = StringName(String("test_string_name_interning"));
+
+	CHECK(from_chars == from_string);
+	CHECK(from_chars.data_unique_pointer() == from_string.data_unique_pointer());
+	CHECK(from_chars.hash() == String("test_string_name_interning").hash());
+	CHECK(from_chars != StringName("test_string_name_interning_other"));
+
+	CHECK(StringName("").is_empty());
+	CHECK(StringName(String()).is_empty());
+}
+
+TEST_CASE("[StringName] Interning again after release") {
+	{
+		const StringName released = StringName("test_string_name_released");
+		CHECK(released == "test_string_name_released");
+	}
+
+	const StringName name = StringName("test_string_name_released");
+	CHECK(name == "test_string_name_released");
+	CHECK(name == StringName(String("test_string_name_released")));
+}
+
+#ifdef THREADS_ENABLED
+struct ConcurrentInterning {
+	static constexpr int NAME_COUNT = 512;
+	static constexpr int ROUNDS = 20;
+
+	Vector<String> names;
+	LocalVector<LocalVector<StringName>> results;
+	SafeNumeric<uint32_t> next_thread_idx;
+
+	static void run(void *p_data) {
+		ConcurrentInterning *tester = static_cast<ConcurrentInterning *>(p_data);
+		LocalVector<StringName> &result = tester->results[tester->next_thread_idx.postincrement()];
+		result.resize(NAME_COUNT);
+
+		for (int round = 0; round < ROUNDS; round++) {
+			for (int i = 0; i < NAME_COUNT; i++) {
+				// Only the last round is kept, so entries are also removed concurrently.
+				const StringName name = (round + i) % 2 ? StringName(tester->names[i]) : StringName(tester->names[i].utf8().get_data());
+				if (round == ROUNDS - 1) {
+					result[i] = name;
+				}
+			}
+		}
+	}
+};
+
+// Threads intern and release the same names at the same time, which would
+// let sanitizers find races in the table.
+TEST_CASE("[StringName] Concurrent interning") {
+	ConcurrentInterning tester;
+	for (int i = 0; i < ConcurrentInterning::NAME_COUNT; i++) {
+		tester.names.push_back(vformat("test_string_name_concurrent_%d", i));
+	}
+
+	const uint32_t thread_count = MAX(2, OS::get_singleton()->get_processor_count());
+	tester.results.resize(thread_count);
+	LocalVector<Thread> threads;
+	threads.resize(thread_count);
+	for (Thread &thread : threads) {
+		thread.start(&ConcurrentInterning::run, &tester);
+	}
+	for (Thread &thread : threads) {
+		thread.wait_to_finish();
+	}
+
+	for (uint32_t i = 0; i < thread_count; i++) {
+		REQUIRE(tester.results[i].size() == ConcurrentInterning::NAME_COUNT);
+		for (int j = 0; j < ConcurrentInterning::NAME_COUNT; j++) {
+			CHECK_MESSAGE(tester.results[i][j] == StringName(tester.names[j]), "All threads should get the same interned name.");
+		}
+	}
+}
+#endif // THREADS_ENABLED
+
+} // namespace TestStringName
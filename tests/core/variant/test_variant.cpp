@@ -32,8 +32,10 @@
 
 TEST_FORCE_LINK(test_variant)
 
+#include "core/io/file_access.h"
 #include "core/variant/variant.h"
 #include "core/variant/variant_parser.h"
+#include "tests/test_utils.h"
 
 namespace TestVariant {
 
@@ -1785,6 +1787,48 @@ TEST_CASE("[Variant] Writer and parser array") {
 	CHECK_MESSAGE(a_parsed == Variant(a), "Should parse back.");
 }
 
+TEST_CASE("[Variant] Parser reading from a file") {
+	const String path = TestUtils::get_temp_path("variant_parser.cfg");
+	const String tag_text = "[tag name=\"value\"]\n";
+	{
+		Ref<FileAccess> f = FileAccess::open(path, FileAccess::WRITE);
+		REQUIRE(f.is_valid());
+		f->store_string(tag_text);
+		f->store_string(String::utf8("text = \"h\u00e9llo \\\"w\u00f6rld\\\" \\t\u4e16\u754c\"\n"));
+		f->store_string(String::utf8("name = &\"\u00fcber\"\n"));
+		f->store_string("vectors = PackedVector3Array(1, 2, 3, -4.5, 5e2, 6)\n");
+	}
+
+	VariantParser::StreamFile stream;
+	stream.f = FileAccess::open(path, FileAccess::READ);
+	REQUIRE(stream.f.is_valid());
+
+	String errs;
+	int line = 1;
+	VariantParser::Tag tag;
+	CHECK(VariantParser::parse_tag(&stream, line, errs, tag) == OK);
+	CHECK(tag.name == "tag");
+	CHECK(tag.fields["name"] == "value");
+	CHECK_MESSAGE(stream.get_position() == (uint64_t)tag_text.utf8().length() - 1, "The position should not include the characters read ahead.");
+
+	String assign;
+	Variant value;
+	CHECK(VariantParser::parse_tag_assign_eof(&stream, line, errs, tag, assign, value) == OK);
+	CHECK(assign == "text");
+	CHECK(value == String::utf8("h\u00e9llo \"w\u00f6rld\" \t\u4e16\u754c"));
+
+	CHECK(VariantParser::parse_tag_assign_eof(&stream, line, errs, tag, assign, value) == OK);
+	CHECK(assign == "name");
+	CHECK(value.get_type() == Variant::STRING_NAME);
+	CHECK(StringName(value) == StringName(String::utf8("\u00fcber")));
+
+	CHECK(VariantParser::parse_tag_assign_eof(&stream, line, errs, tag, assign, value) == OK);
+	CHECK(assign == "vectors");
+	CHECK(value == PackedVector3Array({ Vector3(1, 2, 3), Vector3(-4.5, 500, 6) }));
+
+	CHECK(VariantParser::parse_tag_assign_eof(&stream, line, errs, tag, assign, value) == ERR_FILE_EOF);
+}
+
 TEST_CASE("[Variant] Writer recursive array") {
 	// There is no way to accurately represent a recursive array,
 	// the only thing we can do is make sure the writer doesn't blow up
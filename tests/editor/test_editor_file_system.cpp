@@ -0,0 +1,135 @@
+/**************************************************************************/
+/*  test_editor_file_system.cpp                                           */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "tests/test_macros.h"
+
+TEST_FORCE_LINK(test_editor_file_system)
+
+#ifdef TOOLS_ENABLED
+
+#include "core/io/dir_access.h"
+#include "core/io/file_access.h"
+#include "editor/file_system/editor_file_system.h"
+#include "tests/test_utils.h"
+
+class TestEditorFileSystemInternalsAccessor {
+public:
+	static bool fetch_cached_import(const String &p_cache_path, const String &p_key, const String &p_base_path, List<String> *r_import_variants, Variant *r_metadata) {
+		return EditorFileSystem::_fetch_cached_import(p_cache_path, p_key, p_base_path, r_import_variants, r_metadata);
+	}
+
+	static void store_cached_import(const String &p_cache_path, const String &p_key, const String &p_base_path, const String &p_save_extension, const List<String> &p_import_variants, const Variant &p_metadata) {
+		EditorFileSystem::_store_cached_import(p_cache_path, p_key, p_base_path, p_save_extension, p_import_variants, p_metadata);
+	}
+};
+
+namespace TestEditorFileSystem {
+
+static void _write_file(const String &p_path, const String &p_contents) {
+	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::WRITE);
+	REQUIRE(f.is_valid());
+	f->store_string(p_contents);
+}
+
+static void _remove_dir(const String &p_path) {
+	Ref<DirAccess> da = DirAccess::open(p_path);
+	if (da.is_valid()) {
+		da->erase_contents_recursive();
+		DirAccess::remove_absolute(p_path);
+	}
+}
+
+TEST_CASE("[EditorFileSystem] Import cache") {
+	const String cache_path = TestUtils::get_temp_path("import_cache");
+	const String imported_path = TestUtils::get_temp_path("import_cache_imported");
+	_remove_dir(cache_path);
+	_remove_dir(imported_path);
+	DirAccess::make_dir_recursive_absolute(imported_path);
+
+	const String key = String("icon.png").sha256_text();
+	const String base_path = imported_path.path_join("icon.png-0123456789abcdef");
+
+	SUBCASE("Stored entries should be fetched back") {
+		_write_file(base_path + ".s3tc.ctex", "s3tc");
+		_write_file(base_path + ".etc2.ctex", "etc2");
+		_write_file(base_path + ".editor.meta", "meta");
+
+		List<String> variants;
+		variants.push_back("s3tc");
+		variants.push_back("etc2");
+		Dictionary metadata;
+		metadata["vram_texture"] = true;
+		TestEditorFileSystemInternalsAccessor::store_cached_import(cache_path, key, base_path, "ctex", variants, metadata);
+
+		// The entry is complete, and no temporary directory is left behind.
+		const String entry_dir = cache_path.path_join(key.left(2)).path_join(key);
+		CHECK(FileAccess::exists(entry_dir.path_join("manifest.cfg")));
+		CHECK(DirAccess::get_directories_at(cache_path.path_join(key.left(2))).size() == 1);
+
+		DirAccess::remove_absolute(base_path + ".s3tc.ctex");
+		DirAccess::remove_absolute(base_path + ".etc2.ctex");
+		DirAccess::remove_absolute(base_path + ".editor.meta");
+
+		List<String> fetched_variants;
+		Variant fetched_metadata;
+		CHECK(TestEditorFileSystemInternalsAccessor::fetch_cached_import(cache_path, key, base_path, &fetched_variants, &fetched_metadata));
+		CHECK(fetched_variants.size() == 2);
+		CHECK(fetched_variants.front()->get() == "s3tc");
+		CHECK(fetched_variants.back()->get() == "etc2");
+		CHECK(fetched_metadata == Variant(metadata));
+		CHECK(FileAccess::get_file_as_string(base_path + ".s3tc.ctex") == "s3tc");
+		CHECK(FileAccess::get_file_as_string(base_path + ".etc2.ctex") == "etc2");
+		CHECK(FileAccess::get_file_as_string(base_path + ".editor.meta") == "meta");
+
+		// Storing the same key again keeps the existing entry.
+		_write_file(base_path + ".s3tc.ctex", "changed");
+		TestEditorFileSystemInternalsAccessor::store_cached_import(cache_path, key, base_path, "ctex", variants, metadata);
+		CHECK(FileAccess::get_file_as_string(entry_dir.path_join(String(".s3tc.ctex").md5_text())) == "s3tc");
+	}
+
+	SUBCASE("Entries without a manifest should be skipped") {
+		const String entry_dir = cache_path.path_join(key.left(2)).path_join(key);
+		DirAccess::make_dir_recursive_absolute(entry_dir);
+		_write_file(entry_dir.path_join(String(".ctex").md5_text()), "partial");
+
+		List<String> fetched_variants;
+		Variant fetched_metadata;
+		CHECK_FALSE(TestEditorFileSystemInternalsAccessor::fetch_cached_import(cache_path, key, base_path, &fetched_variants, &fetched_metadata));
+		CHECK(fetched_variants.is_empty());
+		CHECK_FALSE(FileAccess::exists(base_path + ".ctex"));
+	}
+
+	_remove_dir(cache_path);
+	_remove_dir(imported_path);
+}
+
+} // namespace TestEditorFileSystem
+
+#endif // TOOLS_ENABLED
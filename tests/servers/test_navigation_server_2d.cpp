@@ -678,6 +678,21 @@ TEST_SUITE("[Navigation2D]") {
 			CHECK_NE(navigation_server->map_get_path(map, Vector2(0, 0), Vector2(10, 10), false).size(), 0);
 		}
 
+		SUBCASE("Closest point queries on the map should match the region queries") {
+			const Vector2 points[] = { Vector2(10, -30), Vector2(-150, 80), Vector2(500, 500), Vector2(1500, -300), Vector2(-2000, 2000) };
+			for (const Vector2 &point : points) {
+				CHECK(navigation_server->map_get_closest_point(map, point).is_equal_approx(navigation_server->region_get_closest_point(region, point)));
+				CHECK_EQ(navigation_server->map_get_closest_point_owner(map, point), region);
+			}
+		}
+
+		SUBCASE("Uniform random points should be on the map") {
+			const Rect2 bounds = Rect2(Vector2(-1000.0, -1000.0), Vector2(2000.0, 2000.0)).grow(1.0);
+			for (int i = 0; i < 16; i++) {
+				CHECK(bounds.has_point(navigation_server->map_get_random_point(map, 1, true)));
+			}
+		}
+
 		SUBCASE("Elaborate query with 'CORRIDORFUNNEL' post-processing should yield non-empty result") {
 			Ref<NavigationPathQueryParameters2D> query_parameters;
 			query_parameters.instantiate();
@@ -37,6 +37,7 @@ TEST_FORCE_LINK(test_navigation_server_3d)
 #ifdef MODULE_NAVIGATION_3D_ENABLED
 
 #include "core/object/callable_mp.h"
+#include "core/os/os.h"
 #include "scene/3d/mesh_instance_3d.h"
 #include "scene/main/scene_tree.h"
 #include "scene/main/window.h"
@@ -426,6 +427,65 @@ TEST_SUITE("[Navigation3D]") {
 		navigation_server->free_rid(map);
 	}
 
+	TEST_CASE("[NavigationServer3D] Server should make agents avoid each other when avoidance uses spatial hash") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+
+		RID map = navigation_server->map_create();
+		RID agent_1 = navigation_server->agent_create();
+		RID agent_2 = navigation_server->agent_create();
+		RID agent_3 = navigation_server->agent_create();
+
+		navigation_server->map_set_active(map, true);
+		navigation_server->map_set_use_avoidance_spatial_hash(map, true);
+		CHECK(navigation_server->map_get_use_avoidance_spatial_hash(map));
+
+		navigation_server->agent_set_map(agent_1, map);
+		navigation_server->agent_set_avoidance_enabled(agent_1, true);
+		navigation_server->agent_set_position(agent_1, Vector3(0, 0, 0));
+		navigation_server->agent_set_radius(agent_1, 1);
+		navigation_server->agent_set_neighbor_distance(agent_1, 5);
+		navigation_server->agent_set_velocity(agent_1, Vector3(1, 0, 0));
+		CallableMock agent_1_avoidance_callback_mock;
+		navigation_server->agent_set_avoidance_callback(agent_1, callable_mp(&agent_1_avoidance_callback_mock, &CallableMock::function1));
+
+		navigation_server->agent_set_map(agent_2, map);
+		navigation_server->agent_set_avoidance_enabled(agent_2, true);
+		navigation_server->agent_set_position(agent_2, Vector3(2.5, 0, 0.5));
+		navigation_server->agent_set_radius(agent_2, 1);
+		navigation_server->agent_set_neighbor_distance(agent_2, 5);
+		navigation_server->agent_set_velocity(agent_2, Vector3(-1, 0, 0));
+		CallableMock agent_2_avoidance_callback_mock;
+		navigation_server->agent_set_avoidance_callback(agent_2, callable_mp(&agent_2_avoidance_callback_mock, &CallableMock::function1));
+
+		// Far outside the neighbor distance of the other agents, should not affect them or be affected.
+		navigation_server->agent_set_map(agent_3, map);
+		navigation_server->agent_set_avoidance_enabled(agent_3, true);
+		navigation_server->agent_set_position(agent_3, Vector3(100, 0, 100));
+		navigation_server->agent_set_radius(agent_3, 1);
+		navigation_server->agent_set_neighbor_distance(agent_3, 5);
+		navigation_server->agent_set_velocity(agent_3, Vector3(1, 0, 0));
+		CallableMock agent_3_avoidance_callback_mock;
+		navigation_server->agent_set_avoidance_callback(agent_3, callable_mp(&agent_3_avoidance_callback_mock, &CallableMock::function1));
+
+		navigation_server->physics_process(0.0); // Give server some cycles to commit.
+		CHECK_EQ(agent_1_avoidance_callback_mock.function1_calls, 1);
+		CHECK_EQ(agent_2_avoidance_callback_mock.function1_calls, 1);
+		CHECK_EQ(agent_3_avoidance_callback_mock.function1_calls, 1);
+		Vector3 agent_1_safe_velocity = agent_1_avoidance_callback_mock.function1_latest_arg0;
+		Vector3 agent_2_safe_velocity = agent_2_avoidance_callback_mock.function1_latest_arg0;
+		Vector3 agent_3_safe_velocity = agent_3_avoidance_callback_mock.function1_latest_arg0;
+		CHECK_MESSAGE(agent_1_safe_velocity.x > 0, "agent 1 should move a bit along desired velocity (+X)");
+		CHECK_MESSAGE(agent_2_safe_velocity.x < 0, "agent 2 should move a bit along desired velocity (-X)");
+		CHECK_MESSAGE(agent_1_safe_velocity.z < 0, "agent 1 should move a bit to the side so that it avoids agent 2");
+		CHECK_MESSAGE(agent_2_safe_velocity.z > 0, "agent 2 should move a bit to the side so that it avoids agent 1");
+		CHECK_MESSAGE(agent_3_safe_velocity.is_equal_approx(Vector3(1, 0, 0)), "agent 3 should keep its desired velocity");
+
+		navigation_server->free_rid(agent_3);
+		navigation_server->free_rid(agent_2);
+		navigation_server->free_rid(agent_1);
+		navigation_server->free_rid(map);
+	}
+
 	TEST_CASE("[NavigationServer3D] Server should make agents avoid dynamic obstacles when avoidance enabled") {
 		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
 
@@ -708,6 +768,23 @@ TEST_SUITE("[Navigation3D]") {
 			CHECK_NE(navigation_server->map_get_path(map, Vector3(0, 0, 0), Vector3(10, 0, 10), false).size(), 0);
 		}
 
+		SUBCASE("Closest point queries on the map should match the region queries") {
+			const Vector3 points[] = { Vector3(0, 0, 0), Vector3(2, 3, -1), Vector3(20, 0, 0), Vector3(-7, -2, 8), Vector3(4.5, 1, 4.5) };
+			for (const Vector3 &point : points) {
+				CHECK(navigation_server->map_get_closest_point(map, point).is_equal_approx(navigation_server->region_get_closest_point(region, point)));
+				CHECK_EQ(navigation_server->map_get_closest_point_owner(map, point), region);
+			}
+			CHECK(navigation_server->map_get_closest_point_to_segment(map, Vector3(20, 1, 0), Vector3(20, -1, 0), false).is_equal_approx(navigation_server->region_get_closest_point_to_segment(region, Vector3(20, 1, 0), Vector3(20, -1, 0), false)));
+			CHECK(navigation_server->map_get_closest_point_to_segment(map, Vector3(1, 1, 1), Vector3(1, -1, 1), true).is_equal_approx(navigation_server->region_get_closest_point_to_segment(region, Vector3(1, 1, 1), Vector3(1, -1, 1), true)));
+		}
+
+		SUBCASE("Uniform random points should be on the map") {
+			const AABB bounds = AABB(Vector3(-5.0, -1.0, -5.0), Vector3(10.0, 2.0, 10.0));
+			for (int i = 0; i < 16; i++) {
+				CHECK(bounds.has_point(navigation_server->map_get_random_point(map, 1, true)));
+			}
+		}
+
 		SUBCASE("'map_get_closest_point_to_segment' with 'use_collision' should return default if segment doesn't intersect map") {
 			CHECK_EQ(navigation_server->map_get_closest_point_to_segment(map, Vector3(1, 2, 1), Vector3(1, 1, 1), true), Vector3());
 		}
@@ -808,11 +885,99 @@ TEST_SUITE("[Navigation3D]") {
 			CHECK_EQ(query_result->get_path().size(), 0);
 		}
 
+		SUBCASE("Batched asynchronous queries should yield the same paths as single queries") {
+			TypedArray<NavigationPathQueryParameters3D> batch_parameters;
+			TypedArray<NavigationPathQueryResult3D> batch_results;
+			const Vector3 targets[] = { Vector3(10, 0, 10), Vector3(-10, 0, 10), Vector3(10, 0, -10), Vector3(-10, 0, -10) };
+			for (const Vector3 &target : targets) {
+				Ref<NavigationPathQueryParameters3D> query_parameters;
+				query_parameters.instantiate();
+				query_parameters->set_map(map);
+				query_parameters->set_start_position(Vector3(0, 0, 0));
+				query_parameters->set_target_position(target);
+				batch_parameters.push_back(query_parameters);
+				Ref<NavigationPathQueryResult3D> query_result;
+				query_result.instantiate();
+				batch_results.push_back(query_result);
+			}
+
+			CallableMock batch_callback_mock;
+			navigation_server->query_paths_async(batch_parameters, batch_results, callable_mp(&batch_callback_mock, &CallableMock::function1).bind(Variant()));
+			for (int i = 0; i < 1000 && batch_callback_mock.function1_calls == 0; i++) {
+				OS::get_singleton()->delay_usec(1000);
+				navigation_server->process(0.0); // Give server some cycles to dispatch the callback.
+			}
+			CHECK_EQ(batch_callback_mock.function1_calls, 1);
+
+			for (int i = 0; i < batch_parameters.size(); i++) {
+				Ref<NavigationPathQueryResult3D> single_result;
+				single_result.instantiate();
+				navigation_server->query_path(batch_parameters[i], single_result);
+				const Ref<NavigationPathQueryResult3D> batch_result = batch_results[i];
+				CHECK_NE(batch_result->get_path().size(), 0);
+				CHECK_EQ(batch_result->get_path(), single_result->get_path());
+			}
+		}
+
 		navigation_server->free_rid(region);
 		navigation_server->free_rid(map);
 		navigation_server->physics_process(0.0); // Give server some cycles to commit.
 	}
 
+	TEST_CASE("[NavigationServer3D] Server should bake tiled navigation mesh incrementally") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+		Ref<NavigationMesh> navigation_mesh = memnew(NavigationMesh);
+		navigation_mesh->set_tile_size(5.0);
+		Ref<NavigationMeshSourceGeometryData3D> source_geometry = memnew(NavigationMeshSourceGeometryData3D);
+
+		Array arr;
+		arr.resize(RSE::ARRAY_MAX);
+		BoxMesh::create_mesh_array(arr, Vector3(20.0, 0.001, 20.0));
+		source_geometry->add_mesh_array(arr, Transform3D());
+		navigation_server->bake_from_source_geometry_data(navigation_mesh, source_geometry, Callable());
+		CHECK_NE(navigation_mesh->get_polygon_count(), 0);
+		CHECK_NE(navigation_mesh->get_vertices().size(), 0);
+
+		const Vector<Vector3> vertices = navigation_mesh->get_vertices();
+		const int polygon_count = navigation_mesh->get_polygon_count();
+
+		SUBCASE("Rebaking unchanged source geometry should yield the same navigation mesh") {
+			navigation_server->bake_from_source_geometry_data(navigation_mesh, source_geometry, Callable());
+			CHECK_EQ(navigation_mesh->get_polygon_count(), polygon_count);
+			CHECK(navigation_mesh->get_vertices() == vertices);
+		}
+
+		SUBCASE("Rebaking changed source geometry should take the change into account") {
+			Array box_arr;
+			box_arr.resize(RSE::ARRAY_MAX);
+			BoxMesh::create_mesh_array(box_arr, Vector3(2.0, 2.0, 2.0));
+			source_geometry->add_mesh_array(box_arr, Transform3D(Basis(), Vector3(6.0, 1.0, 6.0)));
+			navigation_server->bake_from_source_geometry_data(navigation_mesh, source_geometry, Callable());
+			CHECK_NE(navigation_mesh->get_polygon_count(), 0);
+			CHECK_FALSE(navigation_mesh->get_vertices() == vertices);
+		}
+
+		SUBCASE("Paths should cross tile borders") {
+			RID map = navigation_server->map_create();
+			RID region = navigation_server->region_create();
+			navigation_server->map_set_active(map, true);
+			navigation_server->map_set_use_async_iterations(map, false);
+			navigation_server->region_set_use_async_iterations(region, false);
+			navigation_server->region_set_map(region, map);
+			navigation_server->region_set_navigation_mesh(region, navigation_mesh);
+			navigation_server->physics_process(0.0); // Give server some cycles to commit.
+
+			const Vector<Vector3> path = navigation_server->map_get_path(map, Vector3(-8.0, 0.0, -8.0), Vector3(8.0, 0.0, 8.0), true);
+			REQUIRE_FALSE(path.is_empty());
+			const Vector3 path_end = path[path.size() - 1];
+			CHECK_LT(Vector2(path_end.x, path_end.z).distance_to(Vector2(8.0, 8.0)), 0.1);
+
+			navigation_server->free_rid(region);
+			navigation_server->free_rid(map);
+			navigation_server->physics_process(0.0); // Give server some cycles to commit.
+		}
+	}
+
 	// FIXME: The race condition mentioned below is actually a problem and fails on CI (GH-90613).
 	/*
 	TEST_CASE("[NavigationServer3D] Server should be able to bake asynchronously") {
@@ -834,6 +999,76 @@ TEST_SUITE("[Navigation3D]") {
 	}
 	*/
 
+	TEST_CASE("[NavigationServer3D] Server should find paths with path caching and hierarchical pathfinding") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+
+		// A grid with enough polygons to be split into multiple clusters.
+		const int grid_size = 16;
+		Ref<NavigationMesh> navigation_mesh;
+		navigation_mesh.instantiate();
+		Vector<Vector3> vertices;
+		for (int z = 0; z <= grid_size; z++) {
+			for (int x = 0; x <= grid_size; x++) {
+				vertices.push_back(Vector3(x, 0, z));
+			}
+		}
+		navigation_mesh->set_vertices(vertices);
+		for (int z = 0; z < grid_size; z++) {
+			for (int x = 0; x < grid_size; x++) {
+				const int index = z * (grid_size + 1) + x;
+				navigation_mesh->add_polygon({ index, index + 1, index + grid_size + 2, index + grid_size + 1 });
+			}
+		}
+
+		RID map = navigation_server->map_create();
+		RID region = navigation_server->region_create();
+		navigation_server->map_set_active(map, true);
+		navigation_server->map_set_use_async_iterations(map, false);
+		navigation_server->region_set_use_async_iterations(region, false);
+		navigation_server->region_set_map(region, map);
+		navigation_server->region_set_navigation_mesh(region, navigation_mesh);
+		navigation_server->physics_process(0.0); // Give server some cycles to commit.
+
+		Ref<NavigationPathQueryParameters3D> query_parameters;
+		query_parameters.instantiate();
+		query_parameters->set_map(map);
+		query_parameters->set_start_position(Vector3(0.5, 0, 0.5));
+		query_parameters->set_target_position(Vector3(grid_size - 0.5, 0, grid_size - 0.5));
+
+		Ref<NavigationPathQueryResult3D> flat_query_result;
+		flat_query_result.instantiate();
+		navigation_server->query_path(query_parameters, flat_query_result);
+		REQUIRE_NE(flat_query_result->get_path().size(), 0);
+
+		// Repeated queries reuse the cached path corridor.
+		Ref<NavigationPathQueryResult3D> cached_query_result;
+		cached_query_result.instantiate();
+		navigation_server->query_path(query_parameters, cached_query_result);
+		CHECK_EQ(cached_query_result->get_path(), flat_query_result->get_path());
+
+		navigation_server->physics_process(0.0); // Give server some cycles to update the process info.
+		CHECK_EQ(navigation_server->get_process_info(NavigationServer3D::INFO_PATH_CACHE_MISS_COUNT), 1);
+		CHECK_EQ(navigation_server->get_process_info(NavigationServer3D::INFO_PATH_CACHE_HIT_COUNT), 1);
+
+		navigation_server->map_set_use_hierarchical_pathfinding(map, true);
+		navigation_server->physics_process(0.0); // Give server some cycles to commit.
+		CHECK(navigation_server->map_get_use_hierarchical_pathfinding(map));
+
+		Ref<NavigationPathQueryResult3D> hierarchical_query_result;
+		hierarchical_query_result.instantiate();
+		navigation_server->query_path(query_parameters, hierarchical_query_result);
+		const Vector<Vector3> hierarchical_path = hierarchical_query_result->get_path();
+		REQUIRE_NE(hierarchical_path.size(), 0);
+		CHECK(hierarchical_path[0].is_equal_approx(flat_query_result->get_path()[0]));
+		CHECK(hierarchical_path[hierarchical_path.size() - 1].is_equal_approx(Vector3(grid_size - 0.5, 0, grid_size - 0.5)));
+		// The coarse search trades path optimality for speed, but on an open grid it should stay close.
+		CHECK(hierarchical_query_result->get_path_length() < flat_query_result->get_path_length() * 1.1);
+
+		navigation_server->free_rid(region);
+		navigation_server->free_rid(map);
+		navigation_server->physics_process(0.0); // Give server some cycles to commit.
+	}
+
 	TEST_CASE("[NavigationServer3D] Server should simplify path properly") {
 		real_t simplify_epsilon = 0.2;
 		Vector<Vector3> source_path;
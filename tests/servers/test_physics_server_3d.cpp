@@ -0,0 +1,237 @@
+/**************************************************************************/
+/*  test_physics_server_3d.cpp                                            */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "tests/test_macros.h"
+
+TEST_FORCE_LINK(test_physics_server_3d)
+
+#include "modules/modules_enabled.gen.h" // For Godot Physics 3D.
+
+#if !defined(PHYSICS_3D_DISABLED) && defined(MODULE_GODOT_PHYSICS_3D_ENABLED)
+
+#include "servers/physics_3d/physics_server_3d.h"
+
+namespace TestPhysicsServer3D {
+
+// Stacks of boxes resting on the ground, the scene used to measure the cost of resting contacts.
+struct StackingScene {
+	static constexpr int STACK_COUNT = 4;
+	static constexpr int STACK_HEIGHT = 5;
+
+	RID space;
+	RID ground_shape;
+	RID ground;
+	RID box_shape;
+	LocalVector<RID> boxes;
+
+	StackingScene() {
+		PhysicsServer3D *server = PhysicsServer3D::get_singleton();
+
+		space = server->space_create();
+		server->space_set_active(space, true);
+
+		ground_shape = server->world_boundary_shape_create();
+		server->shape_set_data(ground_shape, Plane(Vector3(0, 1, 0), 0));
+		ground = server->body_create();
+		server->body_set_mode(ground, PhysicsServer3D::BODY_MODE_STATIC);
+		server->body_add_shape(ground, ground_shape);
+		server->body_set_space(ground, space);
+
+		box_shape = server->box_shape_create();
+		server->shape_set_data(box_shape, Vector3(0.5, 0.5, 0.5));
+		for (int i = 0; i < STACK_COUNT; i++) {
+			for (int j = 0; j < STACK_HEIGHT; j++) {
+				RID box = server->body_create();
+				server->body_set_mode(box, PhysicsServer3D::BODY_MODE_RIGID);
+				server->body_add_shape(box, box_shape);
+				server->body_set_state(box, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), Vector3(i * 3.0, 0.5 + j, 0)));
+				server->body_set_space(box, space);
+				boxes.push_back(box);
+			}
+		}
+	}
+
+	~StackingScene() {
+		PhysicsServer3D *server = PhysicsServer3D::get_singleton();
+		for (const RID &box : boxes) {
+			server->free_rid(box);
+		}
+		server->free_rid(box_shape);
+		server->free_rid(ground);
+		server->free_rid(ground_shape);
+		server->free_rid(space);
+	}
+
+	void step(int p_frames) {
+		PhysicsServer3D *server = PhysicsServer3D::get_singleton();
+		for (int i = 0; i < p_frames; i++) {
+			server->sync();
+			server->flush_queries();
+			server->end_sync();
+			server->step(1.0 / 60.0);
+		}
+	}
+
+	Vector3 get_box_position(int p_stack, int p_height) const {
+		Transform3D xform = PhysicsServer3D::get_singleton()->body_get_state(boxes[p_stack * STACK_HEIGHT + p_height], PhysicsServer3D::BODY_STATE_TRANSFORM);
+		return xform.origin;
+	}
+};
+
+TEST_CASE("[PhysicsServer3D][SceneTree] Stacks of resting boxes") {
+	PhysicsServer3D *server = PhysicsServer3D::get_singleton();
+	server->set_active(true);
+
+	StackingScene scene;
+
+	SUBCASE("Stacks should stay upright") {
+		scene.step(300);
+
+		for (int i = 0; i < StackingScene::STACK_COUNT; i++) {
+			for (int j = 0; j < StackingScene::STACK_HEIGHT; j++) {
+				Vector3 position = scene.get_box_position(i, j);
+				CHECK(position.x == doctest::Approx(i * 3.0).epsilon(0.05));
+				CHECK(position.y == doctest::Approx(0.5 + j).epsilon(0.05));
+			}
+		}
+	}
+
+	SUBCASE("Resting contacts should be kept while the stacks stay awake") {
+		for (const RID &box : scene.boxes) {
+			server->body_set_state(box, PhysicsServer3D::BODY_STATE_CAN_SLEEP, false);
+			server->body_set_max_contacts_reported(box, 8);
+		}
+		scene.step(300);
+
+		// Every box rests on the ground or on another box, and reports it on each frame.
+		for (int frame = 0; frame < 10; frame++) {
+			scene.step(1);
+			CHECK(server->get_process_info(PhysicsServer3D::INFO_ACTIVE_OBJECTS) == StackingScene::STACK_COUNT * StackingScene::STACK_HEIGHT);
+			for (const RID &box : scene.boxes) {
+				PhysicsDirectBodyState3D *state = server->body_get_direct_state(box);
+				REQUIRE(state);
+				CHECK(state->get_contact_count() > 0);
+			}
+		}
+
+		// Moving boxes must give them new contacts.
+		server->body_set_state(scene.boxes[0], PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), Vector3(0, 0.45, 0)));
+		server->body_set_state(scene.boxes[StackingScene::STACK_HEIGHT - 1], PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), Vector3(0, StackingScene::STACK_HEIGHT, 0)));
+		scene.step(60);
+		for (int j = 0; j < StackingScene::STACK_HEIGHT; j++) {
+			Vector3 position = scene.get_box_position(0, j);
+			CHECK(position.x == doctest::Approx(0.0).epsilon(0.05));
+			CHECK(position.y == doctest::Approx(0.5 + j).epsilon(0.05));
+		}
+	}
+
+	SUBCASE("Resting stacks should go to sleep and cost nothing to step") {
+		scene.step(600);
+
+		for (const RID &box : scene.boxes) {
+			CHECK(bool(server->body_get_state(box, PhysicsServer3D::BODY_STATE_SLEEPING)));
+		}
+
+		scene.step(1);
+		CHECK(server->get_process_info(PhysicsServer3D::INFO_ACTIVE_OBJECTS) == 0);
+	}
+
+	server->set_active(false);
+}
+
+static void _check_batched_rays(PhysicsDirectSpaceState3D *p_space_state, int p_ray_count) {
+	// Vertical rays over the stacks, and a few high horizontal ones that miss everything.
+	LocalVector<Vector3> from;
+	LocalVector<Vector3> to;
+	for (int i = 0; i < p_ray_count; i++) {
+		if (i % 7 == 6) {
+			from.push_back(Vector3(-20, 20 + i * 0.01, 0));
+			to.push_back(Vector3(20, 20 + i * 0.01, 0));
+		} else {
+			const Vector3 origin = Vector3(-1.0 + 12.0 * i / p_ray_count, 10, -0.7 + 1.4 * (i % 5) / 4);
+			from.push_back(origin);
+			to.push_back(origin - Vector3(0, 11, 0));
+		}
+	}
+
+	PhysicsDirectSpaceState3D::RayParameters parameters;
+	LocalVector<PhysicsDirectSpaceState3D::RayResult> results;
+	results.resize(p_ray_count);
+	const int hits = p_space_state->intersect_rays(parameters, from.ptr(), to.ptr(), p_ray_count, results.ptr());
+
+	int expected_hits = 0;
+	for (int i = 0; i < p_ray_count; i++) {
+		parameters.from = from[i];
+		parameters.to = to[i];
+		PhysicsDirectSpaceState3D::RayResult expected;
+		const bool hit = p_space_state->intersect_ray(parameters, expected);
+		const PhysicsDirectSpaceState3D::RayResult &result = results[i];
+		CHECK_MESSAGE(result.rid.is_valid() == hit, vformat("Ray %d should hit the same as a single ray.", i));
+		if (!hit) {
+			continue;
+		}
+		expected_hits++;
+		CHECK(result.rid == expected.rid);
+		CHECK(result.collider_id == expected.collider_id);
+		CHECK(result.shape == expected.shape);
+		CHECK(result.position.is_equal_approx(expected.position));
+		CHECK(result.normal.is_equal_approx(expected.normal));
+	}
+	CHECK(hits == expected_hits);
+	CHECK(expected_hits > 0);
+	CHECK(expected_hits < p_ray_count);
+}
+
+TEST_CASE("[PhysicsServer3D][SceneTree] Batched ray queries") {
+	PhysicsServer3D *server = PhysicsServer3D::get_singleton();
+	server->set_active(true);
+
+	StackingScene scene;
+	scene.step(1);
+	// Like during the physics process, where the space state is accessible.
+	server->sync();
+	PhysicsDirectSpaceState3D *space_state = server->space_get_direct_state(scene.space);
+	REQUIRE(space_state);
+
+	SUBCASE("Few rays, cast on the calling thread") {
+		_check_batched_rays(space_state, 13);
+	}
+
+	SUBCASE("Many rays, spread over worker threads") {
+		_check_batched_rays(space_state, 517);
+	}
+
+	server->end_sync();
+	server->set_active(false);
+}
+
+} // namespace TestPhysicsServer3D
+
+#endif // !defined(PHYSICS_3D_DISABLED) && defined(MODULE_GODOT_PHYSICS_3D_ENABLED)